@@ -1,8 +1,18 @@
 #include "device_chart.h"
 #include "../utils/font_manager.h"
+#include "../mqtt/log_categories.h"
 #include <QtCharts/QLegend>
 #include <QtCharts/QLegendMarker>
 #include <QLabel>
+#include <QEvent>
+#include <QSettings>
+
+namespace {
+const int kMinWindowPoints = 5;
+const int kMaxWindowPoints = 24 * 60 * 60;  // 1초 간격으로 하루
+const int kMaxAnimatedPoints = 60;          // 이보다 많으면 애니메이션이 갱신을 못 따라감
+const int kMaxMarkerPoints = 120;           // 툴팁용 포인트는 점이 적을 때만 (많으면 선만)
+}
 
 DeviceChart::DeviceChart(const QString &deviceName, QObject *parent)
     : QObject(parent)
@@ -18,9 +28,62 @@ DeviceChart::DeviceChart(const QString &deviceName, QObject *parent)
     , deviceName(deviceName)
     , timeCounter(0)
 {
+    speedDataHistory.setCapacity(defaultWindowSize());
+
+    QSettings settings("VisionCraft", "client_qt");
+    const SeriesDecimator::Mode mode = SeriesDecimator::modeFromString(settings.value("chart/decimation", "lttb").toString());
+    currentDecimator.setMode(mode);
+    averageDecimator.setMode(mode);
+
     initializeChart();
 }
 
+int DeviceChart::defaultWindowSize() const
+{
+    // chart/window_points: 0(기본)이면 장비별 기본값
+    QSettings settings("VisionCraft", "client_qt");
+    int points = settings.value("chart/window_points", 0).toInt();
+    if (points <= 0) points = (deviceName == "컨베이어") ? 5 : 9;
+    return qBound(kMinWindowPoints, points, kMaxWindowPoints);
+}
+
+void DeviceChart::setWindowSize(int points)
+{
+    points = qBound(kMinWindowPoints, points, kMaxWindowPoints);
+    if (points == speedDataHistory.capacity()) return;
+
+    speedDataHistory.setCapacity(points);
+    reloadSeries();
+    qDebug() << "[DeviceChart]" << deviceName << "표시 구간:" << points << "점";
+    updateChart();
+}
+
+void DeviceChart::reloadSeries()
+{
+    // 원형 버퍼에 남은 것으로 다시 채움 (가장 최근 점의 x = timeCounter - 1)
+    currentDecimator.clear();
+    averageDecimator.clear();
+    const int count = speedDataHistory.size();
+    for (int i = 0; i < count; ++i) {
+        const SpeedDataPoint &point = speedDataHistory.at(i);
+        const double x = timeCounter - count + i;
+        currentDecimator.append(QPointF(x, point.currentSpeed));
+        averageDecimator.append(QPointF(x, point.averageSpeed));
+    }
+}
+
+void DeviceChart::retargetDecimators()
+{
+    // 그림 영역 너비 (레이아웃 전이면 뷰 너비)
+    int width = chart ? qRound(chart->plotArea().width()) : 0;
+    if (width <= 0 && chartView) width = chartView->width();
+    if (width <= 0) width = 400;
+
+    const int window = speedDataHistory.capacity();
+    currentDecimator.setTarget(window, width);
+    averageDecimator.setTarget(window, width);
+}
+
 DeviceChart::~DeviceChart()
 {
     // parent가 있으므로 자동 삭제됨
@@ -36,6 +99,9 @@ void DeviceChart::initializeChart()
     qDebug() << "=== DeviceChart 초기화 시작 ===" << deviceName;
 
     timeCounter = 0;
+    speedDataHistory.clear();   // x(순번)가 0부터 다시 시작하므로 이전 점도 비움
+    currentDecimator.clear();
+    averageDecimator.clear();
     setupChart();
     setupUI();
     setupTooltips();
@@ -174,6 +240,13 @@ void DeviceChart::setupChart()
     //  차트뷰 설정 - 테두리 제거
     chartView->setRenderHint(QPainter::Antialiasing);
     chartView->setFrameStyle(QFrame::NoFrame);
+    chartView->installEventFilter(this);      // 숨김/표시에 맞춰 애니메이션 끄고 밀린 갱신 그리기
+
+    // 그림 영역 너비가 바뀌면 줄이는 단위도 다시
+    connect(chart, &QChart::plotAreaChanged, this, [this](const QRectF &area) {
+        const int width = qRound(area.width());
+        if (width > 0 && width != currentDecimator.plotWidth() && !speedDataHistory.isEmpty()) updateChart();
+    });
 
     qDebug() << " setupChart() 완료:" << deviceName;
 }
@@ -184,60 +257,10 @@ void DeviceChart::updateXAxisLabels()
     int dataCount = speedDataHistory.size();
 
     if (dataCount > 0) {
-        if (deviceName == "피더") {
-            //  피더 - 실제 시간 기준 라벨
-            // int startTime = timeCounter - dataCount + 1;
-            // int endTime = timeCounter;
-
-            // QString axisTitle = QString("시간 (%1~%2분)").arg(qMax(0, startTime)).arg(endTime);
-            // axisX->setTitleText(axisTitle);
-
-            // qDebug() << "피더 X축 제목 업데이트:" << axisTitle;
-
-            // int maxDataPoints = 9;  // 피더는 9개
-            // int displayStartTime = 0;
-
-            // if (dataCount >= maxDataPoints) {
-            //     displayStartTime = timeCounter - maxDataPoints + 1;
-            //     displayStartTime = qMax(0, displayStartTime);
-            // }
-
-            // int endTime = displayStartTime + 8;  // 0-8 범위
-            // QString axisTitle = QString("시간 (%1~%2분)").arg(displayStartTime).arg(endTime);
-            // axisX->setTitleText(axisTitle);
-
-            // int endTime = timeCounter;
-            // int startTime = qMax(0, timeCounter - (dataCount - 1));
-
-            // QString axisTitle = QString("시간 (%1~%2분)").arg(startTime).arg(endTime);
-            // axisX->setTitleText(axisTitle);
-
-            // qDebug() << "피더 X축 제목 업데이트:" << axisTitle;
-
-            int maxDataPoints = 9;  // 현재 addSpeedData에서 사용하는 값
-            int displayStartTime = 0;
-
-            if (dataCount >= maxDataPoints) {
-                displayStartTime = timeCounter - maxDataPoints + 1;
-                displayStartTime = qMax(0, displayStartTime);
-            }
-
-            int endTime = displayStartTime + (dataCount - 1);  // 실제 데이터 범위
-            QString axisTitle = QString("시간 (%1~%2분)").arg(displayStartTime).arg(endTime);
-            axisX->setTitleText(axisTitle);
-
-            qDebug() << "피더 X축 제목 업데이트:" << axisTitle;
-
-        } else {
-            //  컨베이어 - 기존 방식 유지
-            int endTime = timeCounter;
-            int startTime = qMax(0, timeCounter - (dataCount - 1));
-
-            QString axisTitle = QString("시간 (%1~%2분)").arg(startTime).arg(endTime);
-            axisX->setTitleText(axisTitle);
-
-            qDebug() << "컨베이어 X축 제목 업데이트:" << axisTitle;
-        }
+        int endTime = timeCounter - 1;                      // 가장 최근 점
+        int startTime = qMax(0, endTime - (dataCount - 1)); // 실제 데이터 범위
+        QString axisTitle = QString("시간 (%1~%2분)").arg(startTime).arg(endTime);
+        axisX->setTitleText(axisTitle);
     }
 }
 
@@ -392,15 +415,15 @@ void DeviceChart::setupTooltips()
 void DeviceChart::addSpeedData(int currentSpeed, int averageSpeed) {
     timeCounter++;  // 항상 증가 (1,2,3,4,5...)
 
-    //  0 데이터든 아니든 무조건 차트에 추가
-    SpeedDataPoint newPoint(QDateTime::currentDateTime(), currentSpeed, averageSpeed);
-    speedDataHistory.append(newPoint);
-
-    // 최대 개수 제한
-    int maxDataPoints = (deviceName == "컨베이어") ? 5 : 9;
-    while (speedDataHistory.size() > maxDataPoints) {
-        speedDataHistory.removeFirst();
-    }
+    //  0 데이터든 아니든 무조건 차트에 추가 (구간이 차면 가장 오래된 점을 덮어씀)
+    speedDataHistory.push(SpeedDataPoint(QDateTime::currentDateTime(), currentSpeed, averageSpeed));
+    const double x = timeCounter - 1;
+    currentDecimator.append(QPointF(x, currentSpeed));
+    averageDecimator.append(QPointF(x, averageSpeed));
+    // 원형 버퍼에서 밀려난 점은 여기서도 버림 (차트가 안 보여 그리지 않는 동안에도)
+    const double oldest = x - speedDataHistory.size() + 1;
+    currentDecimator.dropBefore(oldest);
+    averageDecimator.dropBefore(oldest);
 
     updateChart();  // 0도 정상적으로 차트에 표시
 }
@@ -458,97 +481,85 @@ void DeviceChart::addSpeedData(int currentSpeed, int averageSpeed) {
 void DeviceChart::updateChart()
 {
     if (speedDataHistory.isEmpty()) {
-        qDebug() << "데이터가 없어서 차트 업데이트 건너뜀";
+        qCDebug(lcLive) << "데이터가 없어서 차트 업데이트 건너뜀";
         return;
     }
 
-    // 기존 데이터 클리어
-    currentSpeedSeries->clear();
-    averageSpeedSeries->clear();
-    currentSpeedPoints->clear();
-    averageSpeedPoints->clear();
-
-
-    // 컨베이어와 피더별로 다른 윈도우 크기
-    int maxDataPoints = (deviceName == "컨베이어") ? 5 : 9;
-    int dataCount = speedDataHistory.size();
-
-    qDebug() << deviceName << "데이터 개수:" << dataCount << "timeCounter:" << timeCounter;
-
-    // 실제 슬라이딩을 위한 데이터 인덱스 계산
-    int startIndex = qMax(0, dataCount - maxDataPoints);  // 데이터 배열에서 시작 인덱스
-
-    // 차트에 표시할 시간 범위 계산 (항상 연속된 정수)
-    int displayStartTime = 0;  // 항상 0부터 시작
-    if (dataCount >= maxDataPoints) {
-        // 데이터가 충분할 때: 슬라이딩 시작
-        displayStartTime = timeCounter - maxDataPoints + 1;
-        // 하지만 음수가 되지 않도록 보장
-        displayStartTime = qMax(0, displayStartTime);
+    // 안 보이면 데이터만 쌓고 다시 보일 때 한 번 그림
+    if (chartView && !chartView->isVisible()) {
+        chartDirty = true;
+        return;
     }
-    //  피더 차트 - 간단하고 정확한 방식
-    if (deviceName == "피더") {
-        int startIndex = qMax(0, dataCount - maxDataPoints);
-        int displayStartTime = 0;
-
-        if (dataCount >= maxDataPoints) {
-            displayStartTime = timeCounter - maxDataPoints + 1;
-            displayStartTime = qMax(0, displayStartTime);
-        }
-
-        for (int i = startIndex; i < dataCount; ++i) {
-            const SpeedDataPoint &point = speedDataHistory[i];
-            int chartTimeIndex = displayStartTime + (i - startIndex);  // 컨베이어와 동일
-
-            // 라인 데이터
-            currentSpeedSeries->append(chartTimeIndex, point.currentSpeed);
-            averageSpeedSeries->append(chartTimeIndex, point.averageSpeed);
-
-            // 포인트 데이터 (툴팁용)
-            currentSpeedPoints->append(chartTimeIndex, point.currentSpeed);
-            averageSpeedPoints->append(chartTimeIndex, point.averageSpeed);
-
-            qDebug() << "피더 차트 시간:" << chartTimeIndex << "분, 현재:" << point.currentSpeed << "RPM, 평균:" << point.averageSpeed << "RPM";
-        }
-
-        int rangeStart = displayStartTime;
-        int rangeEnd = displayStartTime + 8;  // 9까지
-        axisX->setRange(rangeStart, rangeEnd);
-        qDebug() << "피더 X축 범위:" << rangeStart << "~" << rangeEnd << "분";
+    chartDirty = false;
 
+    qint64 intervalMs = -1;
+    if (lastUpdate.isValid()) {
+        intervalMs = lastUpdate.restart();
     } else {
-        //  컨베이어 차트 - 기존 방식 유지 (이미 정확함)
-        int startIndex = qMax(0, dataCount - maxDataPoints);
-        int displayStartTime = 0;
+        lastUpdate.start();
+    }
+    updateAnimation(intervalMs);
+
+    const int window = speedDataHistory.capacity();
+    const int dataCount = speedDataHistory.size();
+
+    // 차트에 표시할 시간 - 구간이 차기 전에는 0부터, 차면 최근 구간만큼 슬라이딩
+    const int newestTime = timeCounter - 1;
+    const int displayStartTime = qMax(0, newestTime - window + 1);
+
+    // 그림 너비에 맞춰 줄임 (append 때 끝 버킷만 바뀌어 여기서는 버킷 수만큼만)
+    retargetDecimators();
+    const QVector<QPointF> &currentLine = currentDecimator.points();
+    const QVector<QPointF> &averageLine = averageDecimator.points();
+
+    // 시리즈마다 한 번에 교체 (점마다 신호/다시 그리기가 일어나지 않음)
+    currentSpeedSeries->replace(currentLine);
+    averageSpeedSeries->replace(averageLine);
+    if (dataCount <= kMaxMarkerPoints && currentLine.size() == dataCount) {
+        currentSpeedPoints->replace(currentLine);
+        averageSpeedPoints->replace(averageLine);
+    } else if (currentSpeedPoints->count() > 0) {
+        currentSpeedPoints->clear();
+        averageSpeedPoints->clear();
+    }
 
-        if (dataCount >= maxDataPoints) {
-            displayStartTime = timeCounter - maxDataPoints + 1;
-            displayStartTime = qMax(0, displayStartTime);
-        }
+    axisX->setRange(displayStartTime, displayStartTime + window - 1);
 
-        for (int i = startIndex; i < dataCount; ++i) {
-            const SpeedDataPoint &point = speedDataHistory[i];
-            int chartTimeIndex = displayStartTime + (i - startIndex);
+    // X축 제목 업데이트
+    updateXAxisLabels();
 
-            currentSpeedSeries->append(chartTimeIndex, point.currentSpeed);
-            averageSpeedSeries->append(chartTimeIndex, point.averageSpeed);
-            currentSpeedPoints->append(chartTimeIndex, point.currentSpeed);
-            averageSpeedPoints->append(chartTimeIndex, point.averageSpeed);
+    // 통계가 올 때마다 불리므로 기본은 안 찍음 (visioncraft.live)
+    const SpeedDataPoint &latest = speedDataHistory.last();
+    qCDebug(lcLive) << deviceName << "차트 업데이트 - 점:" << dataCount << "/" << window << "→ 그린 점:" << currentLine.size()
+             << "현재:" << latest.currentSpeed << "RPM, 평균:" << latest.averageSpeed << "RPM"
+             << "X축:" << displayStartTime << "~" << displayStartTime + window - 1 << "분";
+    if (currentDecimator.stats().appended % 600 == 0) qDebug().noquote() << deviceName << currentDecimator.report();
+}
 
-            qDebug() << "컨베이어 차트 시간:" << chartTimeIndex << "분, 현재:" << point.currentSpeed << "RPM, 평균:" << point.averageSpeed << "RPM";
-        }
+void DeviceChart::updateAnimation(qint64 intervalMs)
+{
+    // 애니메이션이 끝나기 전에 다음 갱신이 오거나 점이 많으면 끔
+    const bool animate = speedDataHistory.size() <= kMaxAnimatedPoints
+                         && (intervalMs < 0 || intervalMs >= chart->animationDuration());
+    const QChart::AnimationOptions options = animate ? QChart::SeriesAnimations : QChart::NoAnimation;
+    if (chart->animationOptions() == options) return;
+
+    chart->setAnimationOptions(options);
+    qDebug() << "[DeviceChart]" << deviceName << "애니메이션" << (animate ? "켬" : "끔")
+             << "- 갱신 간격:" << intervalMs << "ms, 점:" << speedDataHistory.size();
+}
 
-        // 컨베이어 X축 범위
-        int rangeStart = displayStartTime;
-        int rangeEnd = displayStartTime + maxDataPoints - 1;
-        axisX->setRange(rangeStart, rangeEnd);
-        qDebug() << "컨베이어 X축 범위:" << rangeStart << "~" << rangeEnd << "분";
+bool DeviceChart::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == chartView) {
+        if (event->type() == QEvent::Hide) {
+            chart->setAnimationOptions(QChart::NoAnimation);
+        } else if (event->type() == QEvent::Show && chartDirty) {
+            // 숨어 있는 동안 쌓인 데이터를 한 번에 그림
+            updateChart();
+        }
     }
-
-    // X축 제목 업데이트
-    updateXAxisLabels();
-
-    qDebug() << "차트 업데이트 완료:" << deviceName;
+    return QObject::eventFilter(watched, event);
 }
 
 // void DeviceChart::updateXAxisLabels()
@@ -598,7 +609,11 @@ void DeviceChart::refreshChart()
 void DeviceChart::clearAllData() {
     currentSpeedSeries->clear();
     averageSpeedSeries->clear();
+    currentSpeedPoints->clear();
+    averageSpeedPoints->clear();
     speedDataHistory.clear();  // 데이터만 클리어
+    currentDecimator.clear();
+    averageDecimator.clear();
     //  timeCounter는 리셋하지 않음! (이게 0->1->2 문제의 원인이었음)
     qDebug() << "차트 데이터 클리어 (timeCounter 유지:" << timeCounter << ")";
 }
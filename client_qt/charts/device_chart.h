@@ -21,16 +21,30 @@
 #include <QVBoxLayout>
 #include <QToolTip>
 #include <QCursor>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QPointF>
+#include "ring_buffer.h"
+#include "series_decimator.h"
 
 struct SpeedDataPoint {
     QDateTime timestamp;
-    int currentSpeed;
-    int averageSpeed;
+    int currentSpeed = 0;
+    int averageSpeed = 0;
 
+    SpeedDataPoint() = default;
     SpeedDataPoint(const QDateTime &time, int current, int average)
         : timestamp(time), currentSpeed(current), averageSpeed(average) {}
 };
 
+// 속도 차트 (피더/컨베이어)
+// - 최근 표시 구간만 고정 용량 원형 버퍼에 (기본 컨베이어 5개, 피더 9개, chart/window_points로 최대 86,400개)
+// - 시리즈에 넘기기 전에 SeriesDecimator로 그림 너비의 약 2배 점까지 줄임 (chart/decimation: lttb 기본, minmax)
+//   → 한 교대분 1초 데이터도 갱신마다 넘기는 점 수는 같음
+// - 갱신은 시리즈마다 replace() 한 번 (clear + append 반복 없이)
+// - 갱신이 잦거나(애니메이션 시간보다 짧은 간격) 점이 많거나 차트가 안 보이면 애니메이션 끔
+//   안 보이는 동안은 데이터만 쌓고 다시 보일 때 한 번 그림
+
 class DeviceChart : public QObject
 {
     Q_OBJECT
@@ -52,6 +66,13 @@ public:
     void refreshChart();
     void clearAllData();
 
+    // 표시 구간 (점 개수) - 줄이면 최근 것만 남김
+    void setWindowSize(int points);
+    int windowSize() const { return speedDataHistory.capacity(); }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 signals:
     void refreshRequested(const QString &deviceName);
 
@@ -73,8 +94,18 @@ private:
 
     // 데이터 관련 멤버
     QString deviceName;
-    QList<SpeedDataPoint> speedDataHistory;
-    static const int MAX_DATA_POINTS = 10;
+    RingBuffer<SpeedDataPoint> speedDataHistory;
+    int defaultWindowSize() const;
+
+    // 시리즈에 넘길 점 - x는 데이터마다 고정된 순번 (timeCounter - 1), 줄인 결과는 툴팁 포인트도 같이 씀
+    SeriesDecimator currentDecimator;
+    SeriesDecimator averageDecimator;
+    void retargetDecimators();
+    void reloadSeries();
+
+    QElapsedTimer lastUpdate;           // 갱신 간격 (애니메이션 켤지)
+    bool chartDirty = false;            // 안 보일 때 들어온 데이터가 있음
+    void updateAnimation(qint64 intervalMs);
 
     //int getMaxDataPoints() const;
 
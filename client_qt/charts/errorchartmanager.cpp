@@ -1,5 +1,6 @@
 #include "errorchartmanager.h"
 #include "../utils/font_manager.h"
+#include "../mqtt/device_registry.h"
 
 #include <QDate>
 #include <QDateTime>
@@ -27,23 +28,64 @@ void ErrorChartManager::processErrorData(const QJsonObject& errorJson)
 {
     const QString deviceId  = errorJson["device_id"].toString();
     const qint64  tsMillis  = errorJson["timestamp"].toVariant().toLongLong();
-    if (deviceId.isEmpty() || tsMillis == 0) return;
+    if (addErrorDay(deviceId, tsMillis)) refreshBars();
+}
+
+void ErrorChartManager::processErrorRecords(const QVector<LogRecord>& records)
+{
+    // 대량 응답은 전부 집계한 뒤 막대를 한 번만 갱신
+    bool changed = false;
+    for (const LogRecord& record : records) {
+        changed |= addErrorDay(record.deviceId, record.timestamp);
+    }
+    if (changed) refreshBars();
+}
+
+bool ErrorChartManager::addErrorDay(const QString& deviceId, qint64 tsMillis)
+{
+    if (deviceId.isEmpty() || tsMillis == 0) return false;
 
     const QDateTime dt       = QDateTime::fromMSecsSinceEpoch(tsMillis);
     const QString   monthKey = dt.toString("yyyy-MM");
     const QString   dayKey   = dt.toString("yyyy-MM-dd");
 
-    const QString deviceType =
-        deviceId.contains("feeder",   Qt::CaseInsensitive)  ? "feeder"   :
-            deviceId.contains("conveyor", Qt::CaseInsensitive)  ? "conveyor" :
-            QString();
+    // feeder_01, feeder_07 → feeder (라인이 늘어도 종류별 막대 하나)
+    const QString deviceType = DeviceRegistry::kindOf(deviceId.toLower());
+    if (deviceType.isEmpty()) return false;
 
-    if (deviceType.isEmpty()) return;
+    QSet<QString>& days = m_monthlyErrorDays[monthKey][deviceType];
+    if (days.contains(dayKey)) return false;
+    days.insert(dayKey);
+    barSetFor(deviceType);
+    return true;
+}
 
-    if (!m_monthlyErrorDays[monthKey][deviceType].contains(dayKey)) {
-        m_monthlyErrorDays[monthKey][deviceType].insert(dayKey);
-        refreshBars();
-    }
+QBarSet* ErrorChartManager::barSetFor(const QString& kind)
+{
+    const int existing = m_kinds.indexOf(kind);
+    if (existing >= 0) return m_sets[existing];
+
+    // 피더 주황, 컨베이어 파랑, 그 밖의 종류는 순서대로
+    static const QVector<QPair<QString, QString>> palette = {
+        {"#fb923c", "#ea580c"}, {"#60a5fa", "#2563eb"}, {"#4ade80", "#16a34a"},
+        {"#c084fc", "#9333ea"}, {"#f87171", "#dc2626"}, {"#94a3b8", "#475569"}
+    };
+    const int colorIndex = kind == "feeder"   ? 0 :
+                           kind == "conveyor" ? 1 :
+                           2 + (m_kinds.size() % (palette.size() - 2));
+
+    QBarSet* set = new QBarSet(kind);
+    QLinearGradient grad(0,0,0,1);
+    grad.setCoordinateMode(QGradient::ObjectBoundingMode);
+    grad.setColorAt(0.0, QColor(palette[colorIndex].first));
+    grad.setColorAt(1.0, QColor(palette[colorIndex].second));
+    set->setBrush(QBrush(grad));
+    for (int i=0;i<6;i++) set->append(0);
+
+    m_kinds.append(kind);
+    m_sets.append(set);
+    m_series->append(set);
+    return set;
 }
 
 /* ---------- private ---------- */
@@ -56,26 +98,11 @@ void ErrorChartManager::initChart()
     m_chart->legend()->setVisible(false); // 범례 숨김
     m_chart->setAnimationOptions(QChart::SeriesAnimations);
 
-    /* 2. 막대 세트 */
-    m_setFeeder   = new QBarSet("feeder");
-    m_setConveyor = new QBarSet("conveyor");
-
-    QLinearGradient gradFeeder(0,0,0,1);
-    gradFeeder.setCoordinateMode(QGradient::ObjectBoundingMode);
-    gradFeeder.setColorAt(0.0, QColor("#fb923c"));
-    gradFeeder.setColorAt(1.0, QColor("#ea580c"));
-    m_setFeeder->setBrush(QBrush(gradFeeder));
-
-    QLinearGradient gradConv(0,0,0,1);
-    gradConv.setCoordinateMode(QGradient::ObjectBoundingMode);
-    gradConv.setColorAt(0.0, QColor("#60a5fa"));
-    gradConv.setColorAt(1.0, QColor("#2563eb"));
-    m_setConveyor->setBrush(QBrush(gradConv));
-
+    /* 2. 막대 세트 - 피더/컨베이어는 처음부터, 다른 종류는 오류가 처음 들어올 때 */
     m_series = new QBarSeries;
-    m_series->append(m_setFeeder);
-    m_series->append(m_setConveyor);
     m_chart->addSeries(m_series);
+    barSetFor("feeder");
+    barSetFor("conveyor");
 
     /* 3. 배경 패턴 */
     m_chart->setBackgroundBrush(QBrush(Qt::white)); // 배경 흰색
@@ -110,28 +137,25 @@ void ErrorChartManager::initChart()
                                            .arg(set->at(idx)));
                 }
             });
-
-    /* 첫 데이터 0으로 초기화 */
-    for (int i=0;i<6;i++){ m_setFeeder->append(0); m_setConveyor->append(0); }
 }
 
 void ErrorChartManager::refreshBars()
 {
-    m_setFeeder->remove(0, m_setFeeder->count());
-    m_setConveyor->remove(0, m_setConveyor->count());
-
     int yMax = 5;
     const QDate now = QDate::currentDate();
     const int currentYear = now.year();
 
-    // 1-6월 데이터 가져오기
-    for (int month = 1; month <= 6; ++month){
-        const QString key = QString("%1-%2").arg(currentYear).arg(month, 2, 10, QChar('0'));
-        const int fCnt   = m_monthlyErrorDays[key]["feeder"].size();
-        const int cCnt   = m_monthlyErrorDays[key]["conveyor"].size();
-        m_setFeeder->append(fCnt);
-        m_setConveyor->append(cCnt);
-        yMax = qMax(yMax, qMax(fCnt,cCnt)+2);
+    for (int s = 0; s < m_sets.size(); ++s) {
+        QBarSet* set = m_sets[s];
+        set->remove(0, set->count());
+
+        // 1-6월 데이터 가져오기
+        for (int month = 1; month <= 6; ++month){
+            const QString key = QString("%1-%2").arg(currentYear).arg(month, 2, 10, QChar('0'));
+            const int cnt = m_monthlyErrorDays.value(key).value(m_kinds[s]).size();
+            set->append(cnt);
+            yMax = qMax(yMax, cnt+2);
+        }
     }
     m_axisY->setRange(0, yMax);
 }
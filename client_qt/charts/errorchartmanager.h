@@ -11,6 +11,8 @@
 #include <QJsonObject>
 #include <QSet>
 #include <QMap>
+#include <QVector>
+#include "../mqtt/query_response_decoder.h"
 
 class ErrorChartManager : public QObject
 {
@@ -21,22 +23,25 @@ public:
 
     QChartView* chartView() const;                // 차트 뷰 반환
     void        processErrorData(const QJsonObject& errorJson);
+    void        processErrorRecords(const QVector<LogRecord>& records);   // 쿼리 응답 일괄 반영
 
 private:
     void initChart();                             // 한 번만 호출
     void refreshBars();                           // 막대 업데이트
+    bool addErrorDay(const QString& deviceId, qint64 tsMillis);   // 새 오류일이면 true
+    QBarSet* barSetFor(const QString& kind);      // 기기 종류별 막대 (처음 나온 종류면 그때 추가)
     QStringList recentSixMonths() const;          // X축 레이블
 
     /* Qt Charts 구성 요소 */
     QChart*          m_chart          { nullptr };
     QChartView*      m_chartView      { nullptr };
     QBarSeries*      m_series         { nullptr };
-    QBarSet*         m_setFeeder      { nullptr };
-    QBarSet*         m_setConveyor    { nullptr };
+    QVector<QString> m_kinds;                     // 막대 세트 인덱스 → 기기 종류 (feeder, conveyor ...)
+    QVector<QBarSet*> m_sets;
     QBarCategoryAxis*m_axisX          { nullptr };
     QValueAxis*      m_axisY          { nullptr };
 
-    /* 월별‧디바이스별 오류일 집계   monthKey -> device -> {dayStrings} */
+    /* 월별‧기기 종류별 오류일 집계   monthKey -> kind -> {dayStrings} */
     QMap<QString, QMap<QString, QSet<QString>>> m_monthlyErrorDays;
 };
 
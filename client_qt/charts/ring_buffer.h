@@ -0,0 +1,63 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <QtGlobal>
+#include <vector>
+
+// 고정 용량 원형 버퍼 - 꽉 차면 가장 오래된 것을 덮어씀 (removeFirst처럼 앞을 당기지 않음)
+// at(0)이 가장 오래된 것, at(size()-1)이 가장 최근 것
+template <typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(int capacity = 1)
+        : m_items(static_cast<size_t>(qMax(1, capacity)))
+    {
+    }
+
+    int capacity() const { return static_cast<int>(m_items.size()); }
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    bool isFull() const { return m_size == capacity(); }
+
+    void push(const T &item)
+    {
+        m_items[static_cast<size_t>((m_head + m_size) % capacity())] = item;
+        if (m_size < capacity()) {
+            m_size++;
+        } else {
+            m_head = (m_head + 1) % capacity();
+        }
+    }
+
+    const T &at(int index) const { return m_items[static_cast<size_t>((m_head + index) % capacity())]; }
+    const T &first() const { return at(0); }
+    const T &last() const { return at(m_size - 1); }
+
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    // 용량을 바꿔도 최근 것부터 남김
+    void setCapacity(int capacity)
+    {
+        capacity = qMax(1, capacity);
+        if (capacity == this->capacity()) return;
+
+        const int kept = qMin(m_size, capacity);
+        std::vector<T> items(static_cast<size_t>(capacity));
+        for (int i = 0; i < kept; ++i) items[static_cast<size_t>(i)] = at(m_size - kept + i);
+        m_items.swap(items);
+        m_head = 0;
+        m_size = kept;
+    }
+
+private:
+    std::vector<T> m_items;
+    int m_head = 0;     // 가장 오래된 것의 자리
+    int m_size = 0;
+};
+
+#endif // RING_BUFFER_H
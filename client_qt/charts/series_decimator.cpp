@@ -0,0 +1,212 @@
+#include "series_decimator.h"
+
+#include <QtMath>
+#include <cmath>
+
+SeriesDecimator::SeriesDecimator(Mode mode)
+    : m_mode(mode)
+{
+}
+
+SeriesDecimator::Mode SeriesDecimator::modeFromString(const QString &name)
+{
+    return name.compare("minmax", Qt::CaseInsensitive) == 0 ? Mode::MinMax : Mode::Lttb;
+}
+
+void SeriesDecimator::setMode(Mode mode)
+{
+    if (mode == m_mode) return;
+    m_mode = mode;
+    // 버킷 폭이 모드에 따라 다름 (MinMax는 열마다 두 점, LTTB는 반 열마다 한 점)
+    if (m_plotWidth > 0 && m_bucketWidth > 0) {
+        const double span = m_bucketWidth * (m_mode == Mode::MinMax ? 2.0 * m_plotWidth : m_plotWidth);
+        m_bucketWidth = 0;
+        setTarget(span, m_plotWidth);
+    }
+}
+
+void SeriesDecimator::setTarget(double xSpan, int plotWidth)
+{
+    plotWidth = qMax(1, plotWidth);
+    const double width = xSpan / (m_mode == Mode::MinMax ? plotWidth : 2.0 * plotWidth);
+    if (width <= 0) return;
+    if (plotWidth == m_plotWidth && qFuzzyCompare(width, m_bucketWidth)) return;
+
+    m_plotWidth = plotWidth;
+    m_bucketWidth = width;
+    rebuild();
+}
+
+qint64 SeriesDecimator::columnOf(double x) const
+{
+    if (m_bucketWidth <= 0) return 0;
+    return static_cast<qint64>(std::floor(x / m_bucketWidth));
+}
+
+void SeriesDecimator::add(Bucket &bucket, const QPointF &point)
+{
+    bucket.points.append(point);
+    const int index = bucket.points.size() - 1;
+    if (point.y() < bucket.points[bucket.minIndex].y()) bucket.minIndex = index;
+    if (point.y() > bucket.points[bucket.maxIndex].y()) bucket.maxIndex = index;
+    bucket.sumX += point.x();
+    bucket.sumY += point.y();
+    bucket.dirty = true;
+}
+
+void SeriesDecimator::recompute(Bucket &bucket)
+{
+    bucket.minIndex = 0;
+    bucket.maxIndex = 0;
+    bucket.sumX = 0;
+    bucket.sumY = 0;
+    for (int i = 0; i < bucket.points.size(); ++i) {
+        const QPointF &point = bucket.points[i];
+        if (point.y() < bucket.points[bucket.minIndex].y()) bucket.minIndex = i;
+        if (point.y() > bucket.points[bucket.maxIndex].y()) bucket.maxIndex = i;
+        bucket.sumX += point.x();
+        bucket.sumY += point.y();
+    }
+    bucket.dirty = true;
+}
+
+void SeriesDecimator::append(const QPointF &point)
+{
+    const qint64 column = columnOf(point.x());
+    if (m_buckets.empty() || column > m_buckets.back().column) {
+        Bucket bucket;
+        bucket.column = column;
+        m_buckets.push_back(bucket);
+    }
+    add(m_buckets.back(), point);
+    // 앞 버킷은 "다음 버킷 평균"이 바뀜
+    if (m_buckets.size() >= 2) m_buckets[m_buckets.size() - 2].dirty = true;
+
+    m_count++;
+    m_stats.appended++;
+}
+
+void SeriesDecimator::dropBefore(double x)
+{
+    bool dropped = false;
+    while (!m_buckets.empty()) {
+        Bucket &front = m_buckets.front();
+        if (front.points.last().x() < x) {
+            m_count -= front.points.size();
+            m_buckets.pop_front();
+            dropped = true;
+            continue;
+        }
+        int keep = 0;
+        while (keep < front.points.size() && front.points[keep].x() < x) keep++;
+        if (keep > 0) {
+            front.points.remove(0, keep);
+            m_count -= keep;
+            recompute(front);
+            dropped = true;
+        }
+        break;
+    }
+    // 첫 버킷은 LTTB에서 첫 점을 고르므로 앞이 바뀌면 다시
+    if (dropped && !m_buckets.empty()) m_buckets.front().dirty = true;
+}
+
+void SeriesDecimator::clear()
+{
+    m_buckets.clear();
+    m_count = 0;
+    m_output.clear();
+}
+
+void SeriesDecimator::rebuild()
+{
+    QVector<QPointF> all;
+    all.reserve(m_count);
+    for (const Bucket &bucket : m_buckets) all += bucket.points;
+
+    m_buckets.clear();
+    m_count = 0;
+    for (const QPointF &point : all) {
+        const qint64 column = columnOf(point.x());
+        if (m_buckets.empty() || column > m_buckets.back().column) {
+            Bucket bucket;
+            bucket.column = column;
+            m_buckets.push_back(bucket);
+        }
+        add(m_buckets.back(), point);
+        m_count++;
+    }
+    m_stats.rebuilds++;
+}
+
+const QVector<QPointF> &SeriesDecimator::points()
+{
+    m_output.clear();
+
+    // 충분히 적으면 그대로
+    if (m_bucketWidth <= 0 || m_count <= 2 * m_plotWidth) {
+        m_output.reserve(m_count);
+        for (const Bucket &bucket : m_buckets) m_output += bucket.points;
+        m_stats.lastOutput = m_output.size();
+        return m_output;
+    }
+
+    const int buckets = static_cast<int>(m_buckets.size());
+    m_output.reserve(m_mode == Mode::MinMax ? 2 * buckets : buckets);
+
+    if (m_mode == Mode::MinMax) {
+        for (const Bucket &bucket : m_buckets) {
+            const int first = qMin(bucket.minIndex, bucket.maxIndex);
+            const int second = qMax(bucket.minIndex, bucket.maxIndex);
+            m_output.append(bucket.points[first]);
+            if (second != first) m_output.append(bucket.points[second]);
+        }
+        m_stats.lastOutput = m_output.size();
+        return m_output;
+    }
+
+    // LTTB - 앞 버킷에서 고른 점 a, 다음 버킷 평균 c와 만드는 삼각형이 가장 큰 점
+    for (int i = 0; i < buckets; ++i) {
+        Bucket &bucket = m_buckets[i];
+        QPointF previous;
+        QPointF selected;
+        if (i == 0) {
+            selected = bucket.points.first();
+        } else if (i == buckets - 1) {
+            selected = bucket.points.last();
+        } else {
+            previous = m_buckets[i - 1].selected;
+            if (!bucket.dirty && bucket.previous == previous) {
+                selected = bucket.selected;
+            } else {
+                const Bucket &next = m_buckets[i + 1];
+                const double cx = next.sumX / next.points.size();
+                const double cy = next.sumY / next.points.size();
+                double bestArea = -1;
+                for (const QPointF &point : bucket.points) {
+                    const double area = std::abs((previous.x() - cx) * (point.y() - previous.y())
+                                                 - (previous.x() - point.x()) * (cy - previous.y()));
+                    if (area > bestArea) {
+                        bestArea = area;
+                        selected = point;
+                    }
+                }
+                m_stats.selections++;
+            }
+        }
+        bucket.previous = previous;
+        bucket.selected = selected;
+        bucket.dirty = false;
+        m_output.append(selected);
+    }
+    m_stats.lastOutput = m_output.size();
+    return m_output;
+}
+
+QString SeriesDecimator::report() const
+{
+    return QString("[SeriesDecimator] %1 - 원본 %2점 → %3점 (너비 %4px, 버킷 %5개), 누적 추가 %6, 다시 나눔 %7회, LTTB 다시 고름 %8")
+        .arg(m_mode == Mode::MinMax ? "MinMax" : "LTTB")
+        .arg(m_count).arg(m_stats.lastOutput).arg(m_plotWidth).arg(m_buckets.size())
+        .arg(m_stats.appended).arg(m_stats.rebuilds).arg(m_stats.selections);
+}
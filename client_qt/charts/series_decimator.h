@@ -0,0 +1,84 @@
+#ifndef SERIES_DECIMATOR_H
+#define SERIES_DECIMATOR_H
+
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include <deque>
+
+// 긴 시계열을 차트에 넘기기 전에 그림 너비의 약 2배 점으로 줄임
+// - x를 고정 폭 버킷(열)으로 나눠 들고 있음, 버킷 번호는 절대 위치 (floor(x / 폭)) → 창이 밀려도 기존 버킷은 그대로
+//   * MinMax: 픽셀 열마다 최솟값/최댓값 두 점 (튀는 값을 놓치지 않음)
+//   * Lttb: 열 반 칸마다 Largest-Triangle-Three-Buckets로 한 점 (모양이 매끄러움)
+// - append/dropBefore는 끝 버킷만 건드림, LTTB 선택은 버킷마다 캐시해서 바뀐 버킷(보통 끝 두세 개)만 다시 고름
+// - 점이 그림 너비의 2배 이하면 그대로 넘김
+class SeriesDecimator
+{
+public:
+    enum class Mode {
+        MinMax,
+        Lttb
+    };
+
+    struct Stats {
+        quint64 appended = 0;
+        quint64 rebuilds = 0;       // 표시 폭/너비가 바뀌어 버킷을 다시 나눔
+        quint64 selections = 0;     // LTTB로 다시 고른 버킷 수 (캐시 못 쓴 것)
+        int lastOutput = 0;
+    };
+
+    explicit SeriesDecimator(Mode mode = Mode::Lttb);
+
+    void setMode(Mode mode);
+    Mode mode() const { return m_mode; }
+
+    // 표시할 x 폭과 그림 너비(px) - 바뀌면 들고 있는 점을 다시 나눔
+    void setTarget(double xSpan, int plotWidth);
+    int plotWidth() const { return m_plotWidth; }
+
+    // x는 늘어나는 순서로
+    void append(const QPointF &point);
+    // x보다 앞선 점을 버림 (창에서 밀려남)
+    void dropBefore(double x);
+    void clear();
+
+    int rawCount() const { return m_count; }
+    // 줄인 점 (다음 호출까지 유효)
+    const QVector<QPointF> &points();
+
+    Stats stats() const { return m_stats; }
+    QString report() const;
+
+    static Mode modeFromString(const QString &name);
+
+private:
+    struct Bucket {
+        qint64 column = 0;
+        QVector<QPointF> points;
+        int minIndex = 0;
+        int maxIndex = 0;
+        double sumX = 0;
+        double sumY = 0;
+
+        // LTTB 선택 캐시 - 자기 점이나 다음 버킷 평균이 바뀌면 dirty, 앞 버킷 선택이 바뀌어도 다시 고름
+        bool dirty = true;
+        QPointF previous;
+        QPointF selected;
+    };
+
+    qint64 columnOf(double x) const;
+    static void add(Bucket &bucket, const QPointF &point);
+    static void recompute(Bucket &bucket);
+    void rebuild();
+
+    Mode m_mode;
+    double m_bucketWidth = 0;       // x 단위, 0이면 아직 목표 없음 (그대로 넘김)
+    int m_plotWidth = 0;
+    std::deque<Bucket> m_buckets;
+    int m_count = 0;
+    QVector<QPointF> m_output;
+
+    Stats m_stats;
+};
+
+#endif // SERIES_DECIMATOR_H
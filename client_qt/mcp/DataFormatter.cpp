@@ -1,4 +1,6 @@
 #include "DataFormatter.h"
+#include "../mqtt/command_queue.h"
+#include "../mqtt/device_registry.h"
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QRegularExpression>
@@ -465,19 +467,8 @@ QString formatMqttControlResult(const QString& rawResult) {
             QString topic = match.captured(1);
             QString command = match.captured(2);
             
-            // 디바이스 이름 변환
-            QString deviceName;
-            if (topic.contains("feeder_02")) {
-                deviceName = "피더 2번";
-            } else if (topic.contains("factory/conveyor_02")) {
-                deviceName = "컨베이어 2번";
-            } else if (topic.contains("conveyor_03")) {
-                deviceName = "컨베이어 3번";
-            } else if (topic.contains("robot_arm_01")) {
-                deviceName = "로봇팔";
-            } else {
-                deviceName = topic;
-            }
+            // 디바이스 이름 변환 (feeder_02/cmd → 피더 2번)
+            QString deviceName = DeviceRegistry::instance()->displayName(CommandQueue::deviceIdForTopic(topic));
             
             // 명령 한글화
             QString commandKr = (command == "on") ? "가동" : "정지";
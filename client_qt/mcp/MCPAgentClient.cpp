@@ -2,6 +2,8 @@
 #include "ToolExamples.h"
 #include "DataFormatter.h"
 #include "chatbot_widget.h"
+#include "../mqtt/command_queue.h"
+#include "../mqtt/device_registry.h"
 #include <QNetworkRequest>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -394,57 +396,37 @@ void MCPAgentClient::executeToolWithParameters(const QString& toolName, const QJ
         qDebug() << "추출된 명령:" << command;
         qDebug() << "MQTT 연결 상태:" << (m_mqttClient ? m_mqttClient->state() : -1);
         
-        if (m_mqttClient && m_mqttClient->state() == QMqttClient::Connected) {
-            // MQTT 명령 전송
-            qDebug() << "MQTT 발행 시도:" << "토픽=" << topic << "페이로드=" << command;
-            m_mqttClient->publish(QMqttTopicName(topic), command.toUtf8());
-            qDebug() << "MQTT 발행 완료";
-            
-            // 기기 ID 추출
-            QString deviceId;
-            if (topic == "feeder_02/cmd") deviceId = "feeder_02";
-            else if (topic == "conveyor_03/cmd") deviceId = "conveyor_03";
-            else {
-                emit errorOccurred("지원하지 않는 기기입니다.");
+        // 기기 ID 추출 - DeviceRegistry가 아는 제어 대상만
+        QString deviceId = CommandQueue::deviceIdForTopic(topic);
+        if (!DeviceRegistry::instance()->isActuator(deviceId)) {
+            emit errorOccurred("지원하지 않는 기기입니다.");
+            setPipelineState(PipelineState::IDLE);
+            return;
+        }
+
+        if (auto* chatBot = qobject_cast<ChatBotWidget*>(parent())) {
+            // 현재 기기 상태 확인 (실제 기기가 <device>/status로 보고한 값)
+            QString currentState = chatBot->deviceState(deviceId);
+            QString deviceKorean = DeviceRegistry::instance()->displayName(deviceId);
+
+            // 현재 상태와 요청된 명령이 같은지 확인
+            if (currentState == command) {
+                QString actionText = (command == "on") ? "이미 켜져있습니다" : "이미 꺼져있습니다";
+                emit logMessage(QString("ℹ️ %1은(는) %2.").arg(deviceKorean, actionText), 0);
+
+                // 파이프라인 완료
+                emit pipelineCompleted(QString("ℹ️ %1은(는) %2.").arg(deviceKorean, actionText));
                 setPipelineState(PipelineState::IDLE);
                 return;
             }
-            
-            // ChatBotWidget에 제어 대기 상태 설정
-            if (auto* chatBot = qobject_cast<ChatBotWidget*>(parent())) {
-                // 현재 기기 상태 확인
-                QString currentState = chatBot->m_deviceStates.value(deviceId, "off");
-                QString deviceKorean = (deviceId == "feeder_02") ? "피더 2번" : "컨베이어 3번";
-                
-                // 현재 상태와 요청된 명령이 같은지 확인
-                if (currentState == command) {
-                    QString actionText = (command == "on") ? "이미 켜져있습니다" : "이미 꺼져있습니다";
-                    emit logMessage(QString("ℹ️ %1은(는) %2.").arg(deviceKorean, actionText), 0);
-                    
-                    // 파이프라인 완료
-                    emit pipelineCompleted(QString("ℹ️ %1은(는) %2.").arg(deviceKorean, actionText));
-                    setPipelineState(PipelineState::IDLE);
-                    return;
-                }
-                
-                // 대기 중인 제어 명령 저장
-                chatBot->m_pendingControls[deviceId] = command;
-                
-                // 5초 타임아웃 타이머 설정
-                QTimer* timer = new QTimer(chatBot);
-                timer->setSingleShot(true);
-                connect(timer, &QTimer::timeout, chatBot, [chatBot, deviceId]() {
-                    chatBot->handleMqttControlTimeout(deviceId);
-                });
-                timer->start(5000);
-                chatBot->m_controlTimers[deviceId] = timer;
-                
-                emit logMessage("🔧 기기 제어 명령을 전송했습니다. 응답을 기다리는 중...", 0);
-            }
+
+            // 명령 큐로 전송 - 연결이 끊겨 있으면 보관, 기기 상태가 확인되면 챗봇에 결과 표시
+            chatBot->sendDeviceCommand(deviceId, topic, command, "mcp");
+            emit logMessage("🔧 기기 제어 명령을 전송했습니다. 응답을 기다리는 중...", 0);
         } else {
-            emit errorOccurred("MQTT 연결이 되어있지 않습니다.");
+            CommandQueue::instance()->submit(topic, command, "mcp");
         }
-        
+
         setPipelineState(PipelineState::IDLE);
         return;
     }
@@ -20,6 +20,11 @@
 #include <QScrollBar>
 #include <QtMqtt/QMqttClient>
 #include <QtMqtt/QMqttTopicName>
+#include "../mqtt/mqtt_hub.h"
+#include "../mqtt/message_ingest.h"
+#include "../mqtt/command_queue.h"
+#include "../mqtt/poll_scheduler.h"
+#include "../mqtt/device_registry.h"
 #include <QPropertyAnimation>
 #include <QEasingCurve>
 
@@ -158,8 +163,6 @@ ChatBotWidget::ChatBotWidget(QWidget *parent)
     addMessage(welcome);
 
     initializeMqttClient();
-    m_deviceStates["feeder_02"] = "off";
-    m_deviceStates["conveyor_03"] = "off";
 }
 
 void ChatBotWidget::updateSizeMode(SizeMode newMode)
@@ -719,239 +722,115 @@ QString ChatBotWidget::getCurrentTime()
 
 void ChatBotWidget::initializeMqttClient()
 {
-    m_mqttClient = new QMqttClient(this);
-    m_mqttClient->setHostname("mqtt.kwon.pics");
-    m_mqttClient->setPort(1883);
+    // 앱 전체가 공유하는 MqttHub 연결 사용 (챗봇 전용 연결 없음)
+    MqttHub *hub = MqttHub::instance();
+    m_mqttClient = hub->client();
 
-    connect(m_mqttClient, &QMqttClient::connected, this, &ChatBotWidget::onMqttConnected);
+    connect(hub, &MqttHub::connected, this, &ChatBotWidget::onMqttConnected);
 
-    // MQTT 서버에 연결
-    m_mqttClient->connectToHost();
-}
-
-// onMqttConnected 메서드 수정 - 응답 토픽 구독 추가
-void ChatBotWidget::onMqttConnected()
-{
-    qDebug() << "ChatBot MQTT Connected";
-
-    // 기기 상태 토픽 구독
-    QStringList statusTopics = {
-                                "feeder_02/status",
-                                "conveyor_03/status"};
-
-    for (const QString &topic : statusTopics)
-    {
-        auto sub = m_mqttClient->subscribe(topic);
-        if (sub)
-        {
-            connect(sub, &QMqttSubscription::messageReceived,
-                    this, &ChatBotWidget::onMqttStatusReceived);
-            qDebug() << "ChatBot subscribed to:" << topic;
-        }
-    }
-
-    // 기기 명령 토픽도 구독 (기기 시뮬레이션용)
-    QStringList commandTopics = {
-                                 "feeder_02/cmd",
-                                 "conveyor_03/cmd"};
+    // 기기 상태, 통계, 불량률은 수신 계층에서 한 번만 파싱된 것을 받음
+    MessageIngest *ingest = MessageIngest::instance();
+    connect(ingest, &MessageIngest::deviceStatus, this, &ChatBotWidget::onDeviceStatus);
+    connect(ingest, &MessageIngest::speedStats, this, &ChatBotWidget::onSpeedStats);
+    connect(ingest, &MessageIngest::failureStats, this, &ChatBotWidget::onFailureStats);
 
-    for (const QString &topic : commandTopics)
-    {
-        auto sub = m_mqttClient->subscribe(topic);
-        if (sub)
-        {
-            connect(sub, &QMqttSubscription::messageReceived,
-                    this, &ChatBotWidget::onMqttCommandReceived);
-            qDebug() << "ChatBot subscribed to command topic:" << topic;
-        }
-    }
+    // 챗봇이 열려 있는 동안은 불량률 캐시가 오래되지 않게 (컨베이어 창과 같은 key라 발행은 한 번)
+    PollScheduler::instance()->registerPoll("conveyor_01/failure-rate", "factory/conveyor_01/log/request", 60000,
+                                            []() { return QByteArray("{}"); }, this);
 
     // 데이터베이스 쿼리 응답 토픽 구독
-    auto queryResponseSub = m_mqttClient->subscribe(QString("factory/query/response"));
-    if (queryResponseSub)
-    {
-        connect(queryResponseSub, &QMqttSubscription::messageReceived,
-                this, &ChatBotWidget::onMqttMessageReceived);
-    }
-
-    // 통계 응답 토픽 구독
-    auto statsSub = m_mqttClient->subscribe(QString("factory/+/msg/statistics"));
-    if (statsSub)
-    {
-        connect(statsSub, &QMqttSubscription::messageReceived,
-                this, &ChatBotWidget::onMqttMessageReceived);
-    }
+    hub->subscribe("factory/query/response", this, &ChatBotWidget::onQueryResponseMessage);
 
-    // 불량률 정보 토픽 구독
-    auto failureSub = m_mqttClient->subscribe(QString("factory/+/log/info"));
-    if (failureSub)
-    {
-        connect(failureSub, &QMqttSubscription::messageReceived,
-                this, &ChatBotWidget::onMqttMessageReceived);
-    }
+    // MQTT 서버에 연결 (이미 연결 중이면 무시됨)
+    hub->connectToBroker();
 }
 
-// MQTT 상태 메시지 수신 처리
-void ChatBotWidget::onMqttStatusReceived(const QMqttMessage &message)
+void ChatBotWidget::onMqttConnected()
 {
-    QString topic = message.topic().name();
-    QString payload = QString::fromUtf8(message.payload());
-
-    qDebug() << "ChatBot received status:" << topic << payload;
-
-    // 기기 ID 추출
-    QString deviceId;
-    if (topic == "feeder_02/status")
-        deviceId = "feeder_02";
-    else if (topic == "conveyor_03/status")
-        deviceId = "conveyor_03";
-    else
-        return; // 지원하지 않는 기기
-
-    // 대기 중인 제어 명령이 있는지 확인
-    if (m_pendingControls.contains(deviceId))
-    {
-        QString expectedCommand = m_pendingControls[deviceId];
+    qDebug() << "ChatBot MQTT Connected (공유 연결)";
+}
 
-        if (payload == expectedCommand)
-        {
-            // 타이머 정지
-            if (m_controlTimers.contains(deviceId))
-            {
-                m_controlTimers[deviceId]->stop();
-                m_controlTimers[deviceId]->deleteLater();
-                m_controlTimers.remove(deviceId);
-            }
-            m_pendingControls.remove(deviceId);
+// MQTT 상태 메시지 수신 처리 (제어 명령 확인은 CommandQueue가 담당)
+void ChatBotWidget::onDeviceStatus(const DeviceStatusPtr &status)
+{
+    // 제어 대상 기기만 (DeviceRegistry가 on/off 응답으로 구분)
+    if (!DeviceRegistry::instance()->isActuator(status->deviceId))
+        return;
 
-            // 성공 메시지
-            QString deviceKorean = getDeviceKoreanName(deviceId);
-            QString actionText = (expectedCommand == "on") ? "켜졌습니다" : "꺼졌습니다";
+    qDebug() << "ChatBot received status:" << status->deviceId << status->status;
+}
 
-            ChatMessage successMsg = {
-                                      "bot",
-                                      QString("✅ %1이 %2.").arg(deviceKorean, actionText),
-                                      getCurrentTime()};
-            addMessage(successMsg);
-        }
-    }
+QString ChatBotWidget::deviceState(const QString &deviceId) const
+{
+    return CommandQueue::instance()->lastStatus(deviceId);
 }
 
-// 타임아웃 처리
-void ChatBotWidget::handleMqttControlTimeout(const QString &deviceId)
+void ChatBotWidget::sendDeviceCommand(const QString &deviceId, const QString &topic, const QString &command,
+                                      const QString &source)
 {
-    if (m_pendingControls.contains(deviceId))
-    {
-        m_pendingControls.remove(deviceId);
+    const QString deviceKorean = getDeviceKoreanName(deviceId);
 
-        QString deviceKorean = getDeviceKoreanName(deviceId);
-        ChatMessage errorMsg = {
-                                "bot",
-                                QString("⚠️ %1 제어 응답 시간이 초과되었습니다. 기기 상태를 확인해주세요.").arg(deviceKorean),
-                                getCurrentTime()};
-        addMessage(errorMsg);
-    }
+    CommandQueue::instance()->submit(topic, command, source, this, [this, deviceKorean](const CommandResult &result) {
+        QString text;
+        if (result.ok())
+        {
+            QString actionText = (result.command == "on") ? "켜졌습니다" : "꺼졌습니다";
+            text = QString("✅ %1이 %2. (응답 %3ms)").arg(deviceKorean, actionText).arg(result.rttMs);
+        }
+        else if (result.outcome == CommandResult::TimedOut)
+        {
+            text = QString("⚠️ %1 제어 응답 시간이 초과되었습니다. 기기 상태를 확인해주세요.").arg(deviceKorean);
+        }
+        else if (result.outcome == CommandResult::Superseded)
+        {
+            text = QString("ℹ️ %1 정지 명령이 들어와 이전 명령은 취소되었습니다.").arg(deviceKorean);
+        }
+        else
+        {
+            text = QString("⚠️ MQTT 서버에 연결되지 않아 %1 제어 명령을 보내지 못했습니다.").arg(deviceKorean);
+        }
 
-    // 타이머 제거
-    if (m_controlTimers.contains(deviceId))
-    {
-        m_controlTimers[deviceId]->deleteLater();
-        m_controlTimers.remove(deviceId);
-    }
+        ChatMessage resultMsg = {"bot", text, getCurrentTime()};
+        addMessage(resultMsg);
+    });
 }
 
-// 기기 이름 한글 변환 헬퍼
+// 기기 이름 한글 변환 헬퍼 (feeder_02 → 피더 2번)
 QString ChatBotWidget::getDeviceKoreanName(const QString &deviceId)
 {
-    if (deviceId == "feeder_02")
-        return "피더 2번";
-    else if (deviceId == "conveyor_03")
-        return "컨베이어 3번";
-    return deviceId;
+    return DeviceRegistry::instance()->displayName(deviceId);
 }
 
-// MQTT 명령 수신 처리 (기기 시뮬레이션)
-void ChatBotWidget::onMqttCommandReceived(const QMqttMessage &message)
+// 데이터베이스 쿼리 응답
+void ChatBotWidget::onQueryResponseMessage(const QByteArray &message, const QMqttTopicName &topicName)
 {
-    QString topic = message.topic().name();
-    QString command = QString::fromUtf8(message.payload());
-
-    qDebug() << "ChatBot received command:" << topic << command;
+    Q_UNUSED(topicName);
+    QJsonObject response = QJsonDocument::fromJson(message).object();
 
-    // 기기 ID 추출
-    QString deviceId;
-    if (topic == "feeder_02/cmd")
-        deviceId = "feeder_02";
-    else if (topic == "conveyor_03/cmd")
-        deviceId = "conveyor_03";
-    else
-        return; // 지원하지 않는 기기
-
-    // 기기 상태 업데이트
-    m_deviceStates[deviceId] = command;
-
-    // 상태 토픽으로 응답 발행 (기기 시뮬레이션)
-    QString statusTopic = QString("%1/status").arg(deviceId.split("/")[0]);
-    QTimer::singleShot(500, this, [this, statusTopic, command]()
-                       {
-                           if (m_mqttClient && m_mqttClient->state() == QMqttClient::Connected) {
-                               m_mqttClient->publish(QMqttTopicName(statusTopic), command.toUtf8());
-                               qDebug() << "기기 시뮬레이션 응답:" << statusTopic << "->" << command;
-                           } });
+    QString queryId = response["query_id"].toString();
+    if (queryId == m_currentQueryId)
+    {
+        processMqttQueryResponse(response);
+    }
 }
 
-void ChatBotWidget::onMqttMessageReceived(const QMqttMessage &message)
+// 통계 응답 (factory/+/msg/statistics)
+void ChatBotWidget::onSpeedStats(const SpeedStatsPtr &stats)
 {
-    QString topic = message.topic().name();
-    QJsonDocument doc = QJsonDocument::fromJson(message.payload());
-    QJsonObject response = doc.object();
-
-    qDebug() << "ChatBot MQTT 수신:" << topic;
-
-    // 데이터베이스 쿼리 응답
-    if (topic == "factory/query/response")
+    // MCPAgentClient에 데이터 캐싱 (출력하지 않음)
+    if (mcpClient)
     {
-        QString queryId = response["query_id"].toString();
-        if (queryId == m_currentQueryId)
-        {
-            processMqttQueryResponse(response);
-        }
+        mcpClient->cacheStatisticsData(stats->deviceId, stats->average, stats->currentSpeed);
     }
-    // 통계 응답
-    else if (topic.contains("/msg/statistics"))
-    {
-        QString deviceId = response["device_id"].toString();
-        double avgSpeed = response["average"].toDouble();
-        double currentSpeed = response["current_speed"].toDouble();
-
-        // MCPAgentClient에 데이터 캐싱 (출력하지 않음)
-        if (mcpClient)
-        {
-            mcpClient->cacheStatisticsData(deviceId, avgSpeed, currentSpeed);
-        }
+}
 
-        qDebug() << "통계 데이터 캐시됨:" << deviceId << "평균:" << avgSpeed << "현재:" << currentSpeed;
-    }
-    // 불량률 정보
-    else if (topic.contains("/log/info"))
+// 불량률 정보 (factory/+/log/info, factory/+/log/response)
+void ChatBotWidget::onFailureStats(const FailureStatsPtr &stats)
+{
+    // MCPAgentClient에 데이터 캐싱 (출력하지 않음)
+    if (mcpClient)
     {
-        QJsonObject msgData = response["message"].toObject();
-        if (msgData.contains("failure"))
-        {
-            QString deviceId = topic.split('/')[1];
-            double failureRate = msgData["failure"].toString().toDouble() * 100;
-            int total = msgData["total"].toString().toInt();
-            int pass = msgData["pass"].toString().toInt();
-            int fail = msgData["fail"].toString().toInt();
-
-            // MCPAgentClient에 데이터 캐싱 (출력하지 않음)
-            if (mcpClient)
-            {
-                mcpClient->cacheFailureStatsData(deviceId, failureRate, total, pass, fail);
-            }
-
-            qDebug() << "불량률 데이터 캐시됨:" << deviceId << "불량률:" << failureRate << "%";
-        }
+        mcpClient->cacheFailureStatsData(stats->deviceId, stats->failureRate, stats->total, stats->pass, stats->fail);
     }
 }
 
@@ -1010,73 +889,40 @@ void ChatBotWidget::processMqttQueryResponse(const QJsonObject &response)
 
 void ChatBotWidget::controlMqttDevice(const QString &deviceName, const QString &action)
 {
-    if (!m_mqttClient || m_mqttClient->state() != QMqttClient::Connected)
+    QString topic = getTopicForDevice(deviceName);
+    if (topic.isEmpty())
     {
         ChatMessage errorMsg = {
                                 "bot",
-                                "⚠️ MQTT 서버에 연결되지 않았습니다. 잠시 후 다시 시도해주세요.",
+                                QString("⚠️ 알 수 없는 장비이거나 제어할 수 없는 장비입니다: %1").arg(deviceName),
                                 getCurrentTime()};
         addMessage(errorMsg);
         return;
     }
 
-    QString topic = getTopicForDevice(deviceName);
-    if (topic.isEmpty())
-    {
-        // 컨베이어2인지 확인
-        QString device = deviceName.toLower();
-        if (device.contains("컨베이어2") || device.contains("컨베이어 2") || device.contains("컨베이어02"))
-        {
-            ChatMessage errorMsg = {
-                                    "bot",
-                                    "컨베이어2는 지원하지 않는 기능입니다.",
-                                    getCurrentTime()};
-            addMessage(errorMsg);
-        }
-        else
-        {
-            ChatMessage errorMsg = {
-                                    "bot",
-                                    QString("⚠️ 알 수 없는 장비입니다: %1").arg(deviceName),
-                                    getCurrentTime()};
-            addMessage(errorMsg);
-        }
-        return;
-    }
-
     QString command = (action == "켜" || action == "시작" || action == "가동" || action == "on") ? "on" : "off";
 
-    m_mqttClient->publish(QMqttTopicName(topic), command.toUtf8());
+    // 성공 메시지는 기기가 상태를 보고했을 때 (sendDeviceCommand 콜백)
+    sendDeviceCommand(CommandQueue::deviceIdForTopic(topic), topic, command);
 
-    QString actionText = (command == "on") ? "켜짐" : "꺼짐";
-    ChatMessage successMsg = {
-                              "bot",
-                              QString("✅ %1이(가) %2되었습니다.").arg(deviceName, actionText),
-                              getCurrentTime()};
-    addMessage(successMsg);
+    ChatMessage sentMsg = {
+                           "bot",
+                           QString("🔧 %1 제어 명령을 보냈습니다. 기기 응답을 기다리는 중...").arg(deviceName),
+                           getCurrentTime()};
+    addMessage(sentMsg);
 
-    qDebug() << "MQTT 명령 전송:" << topic << "->" << command;
+    qDebug() << "MQTT 명령 요청:" << topic << "->" << command;
 }
 
 QString ChatBotWidget::getTopicForDevice(const QString &deviceName)
 {
-    // 장비명을 토픽으로 매핑
-    QString device = deviceName.toLower();
-
-    if (device.contains("피더2") || device.contains("피더 2") || device.contains("피더02") || device == "feeder_02")
-    {
-        return "feeder_02/cmd";
-    }
-    else if (device.contains("컨베이어2") || device.contains("컨베이어 2") || device.contains("컨베이어02") || device == "conveyor_02")
-    {
-        return ""; // 컨베이어2는 지원하지 않음
-    }
-    else if (device.contains("컨베이어3") || device.contains("컨베이어 3") || device.contains("컨베이어03") || device == "conveyor_03")
-    {
-        return "conveyor_03/cmd";
-    }
+    // 장비명 → 기기 ID → 제어 토픽 (DeviceRegistry가 발견한 제어 대상만)
+    DeviceRegistry *registry = DeviceRegistry::instance();
+    const int index = registry->indexOf(registry->resolve(deviceName));
+    if (index < 0 || registry->roleAt(index) != DeviceRegistry::Actuator)
+        return ""; // 알 수 없는 장비 또는 라인 기기
 
-    return ""; // 알 수 없는 장비
+    return registry->commandTopic(index);
 }
 
 QString ChatBotWidget::getKoreanToolName(const QString &englishToolName)
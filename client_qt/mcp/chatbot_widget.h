@@ -7,6 +7,7 @@
 #include <QtMqtt/QMqttClient>
 #include <QtMqtt/QMqttMessage>
 #include "DataStructures.h"
+#include "../mqtt/message_types.h"
 
 class QLabel;
 class QPushButton;
@@ -33,13 +34,11 @@ public:
     void setGemini(GeminiRequester *requester);
     void setMcpServerUrl(const QString &url);
 
-    // MQTT 제어 관련 - public으로 이동
-    QMap<QString, QTimer *> m_controlTimers;  // 기기별 타이머
-    QMap<QString, QString> m_pendingControls; // 대기 중인 제어 명령
-    void handleMqttControlTimeout(const QString &deviceId);
-
-    // 기기 상태 시뮬레이션
-    QHash<QString, QString> m_deviceStates; // deviceId -> "on"/"off"
+    // 기기 제어 (챗봇/MCP 공통) - CommandQueue로 보내고 기기 상태가 확인되면 결과 메시지 표시
+    void sendDeviceCommand(const QString &deviceId, const QString &topic, const QString &command,
+                           const QString &source = "chatbot");
+    // 기기가 마지막으로 보고한 상태 ("on"/"off"), 아직 모르면 빈 문자열
+    QString deviceState(const QString &deviceId) const;
 
 signals:
     void closed(); // 닫기 버튼 눌렸을 때
@@ -146,9 +145,10 @@ private:
     QVBoxLayout* m_titleBox = nullptr;
 
 private slots:
-    void onMqttMessageReceived(const QMqttMessage &message);
-    void onMqttStatusReceived(const QMqttMessage &message);
-    void onMqttCommandReceived(const QMqttMessage &message);
+    void onQueryResponseMessage(const QByteArray &message, const QMqttTopicName &topicName);
+    void onSpeedStats(const SpeedStatsPtr &stats);
+    void onFailureStats(const FailureStatsPtr &stats);
+    void onDeviceStatus(const DeviceStatusPtr &status);
 };
 
 #endif // CHATBOT_WIDGET_H
@@ -0,0 +1,196 @@
+#include "capture_journal.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QDebug>
+
+namespace {
+const qint64 kMegabyte = 1024 * 1024;
+const qint64 kMaxQueuedBytes = 32 * kMegabyte;  // 이만큼 밀리면 버림 (GUI 스레드를 막지 않음)
+const int kFlushIntervalMs = 500;
+const quint64 kReportEvery = 10000;
+
+QString environmentValue()
+{
+    return qEnvironmentVariable("VISIONCRAFT_CAPTURE").trimmed();
+}
+}
+
+CaptureJournal* CaptureJournal::instance()
+{
+    static QPointer<CaptureJournal> journal;
+    if (!journal) {
+        journal = new CaptureJournal(QCoreApplication::instance());
+    }
+    return journal;
+}
+
+bool CaptureJournal::isEnabled()
+{
+    static const bool enabled = [] {
+        const QString env = environmentValue();
+        if (!env.isEmpty()) return env != "0";
+        return QSettings("VisionCraft", "client_qt").value("capture/enabled", false).toBool();
+    }();
+    return enabled;
+}
+
+CaptureJournal::CaptureJournal(QObject *parent)
+    : QObject(parent)
+{
+    QSettings settings("VisionCraft", "client_qt");
+    m_segmentBytes = qMax<qint64>(1, settings.value("capture/segment_mb", 64).toLongLong()) * kMegabyte;
+    m_maxBytes = qMax<qint64>(m_segmentBytes, settings.value("capture/max_mb", 1024).toLongLong() * kMegabyte);
+
+    const QString env = environmentValue();
+    if (!env.isEmpty() && env != "1") {
+        m_directory = QDir(env).absolutePath();
+    } else {
+        m_directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/capture";
+    }
+    QDir().mkpath(m_directory);
+
+    m_thread = QThread::create([this]() { writerLoop(); });
+    m_thread->setObjectName("CaptureJournal");
+    m_thread->start(QThread::LowPriority);
+
+    qDebug() << "[CaptureJournal] 수신 기록 시작:" << m_directory
+             << "세그먼트" << m_segmentBytes / kMegabyte << "MB, 상한" << m_maxBytes / kMegabyte << "MB";
+}
+
+CaptureJournal::~CaptureJournal()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+    qDebug().noquote() << report();
+}
+
+void CaptureJournal::record(const QString &topic, const QByteArray &payload, quint8 qos, bool retain, qint64 receivedAtMs)
+{
+    Journal::Record record;
+    record.receivedAtMs = receivedAtMs;
+    record.qos = qos;
+    record.retain = retain;
+    record.topic = topic.toUtf8();
+    record.payload = payload;
+    QByteArray encoded = Journal::encode(record);
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_queuedBytes + encoded.size() > kMaxQueuedBytes) {
+            m_dropped++;
+            return;
+        }
+        m_queuedBytes += encoded.size();
+        m_queue.append(std::move(encoded));
+        m_wake.wakeOne();
+    }
+
+    if (++m_recorded % kReportEvery == 0) {
+        qDebug().noquote() << report();
+    }
+}
+
+/* ---------- 쓰기 스레드 ---------- */
+
+void CaptureJournal::writerLoop()
+{
+    JournalSegmentWriter writer;
+    QVector<QByteArray> batch;
+
+    for (;;) {
+        bool stopping = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_queue.isEmpty() && !m_stopping) {
+                m_wake.wait(&m_mutex, kFlushIntervalMs);
+            }
+            batch.swap(m_queue);
+            m_queuedBytes = 0;
+            stopping = m_stopping;
+        }
+
+        for (const QByteArray &encoded : std::as_const(batch)) {
+            if (!writer.isOpen() && !rotate(writer)) {
+                m_dropped++;
+                continue;
+            }
+            if (writer.append(encoded)) {
+                m_bytes += encoded.size();
+                continue;
+            }
+            // 세그먼트가 참 (세그먼트보다 큰 메시지는 새 세그먼트에도 못 들어가니 버림)
+            if (!rotate(writer) || !writer.append(encoded)) {
+                m_dropped++;
+                continue;
+            }
+            m_bytes += encoded.size();
+        }
+        batch.clear();
+
+        if (stopping) break;
+    }
+    writer.close();
+}
+
+bool CaptureJournal::rotate(JournalSegmentWriter &writer)
+{
+    writer.close();
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const QString path = m_directory + "/" + Journal::segmentFileName(now, m_sequence++);
+    if (!writer.open(path, m_segmentBytes, now)) return false;
+
+    m_segments++;
+    enforceCap();
+    return true;
+}
+
+void CaptureJournal::enforceCap()
+{
+    // 지금 쓰는 세그먼트(마지막)는 미리 잡은 크기로 계산
+    QStringList files = Journal::segmentFiles(m_directory);
+    qint64 total = 0;
+    for (const QString &file : std::as_const(files)) total += QFileInfo(file).size();
+
+    while (total > m_maxBytes && files.size() > 1) {
+        const QString oldest = files.takeFirst();
+        total -= QFileInfo(oldest).size();
+        if (QFile::remove(oldest)) {
+            m_deletedSegments++;
+            qDebug() << "[CaptureJournal] 용량 상한 - 오래된 세그먼트 삭제:" << QFileInfo(oldest).fileName();
+        }
+    }
+}
+
+/* ---------- 통계 ---------- */
+
+CaptureJournal::Stats CaptureJournal::stats() const
+{
+    Stats stats;
+    stats.recorded = m_recorded;
+    stats.bytes = m_bytes;
+    stats.dropped = m_dropped;
+    stats.segments = m_segments;
+    stats.deletedSegments = m_deletedSegments;
+    return stats;
+}
+
+QString CaptureJournal::report() const
+{
+    const Stats s = stats();
+    return QString("[CaptureJournal] 기록 %1건, %2 MB 씀, 버림 %3, 세그먼트 %4개 (삭제 %5) - %6")
+        .arg(s.recorded).arg(s.bytes / double(kMegabyte), 0, 'f', 1).arg(s.dropped)
+        .arg(s.segments).arg(s.deletedSegments).arg(m_directory);
+}
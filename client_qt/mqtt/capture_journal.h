@@ -0,0 +1,68 @@
+#ifndef CAPTURE_JOURNAL_H
+#define CAPTURE_JOURNAL_H
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include "journal_format.h"
+
+// 수신한 MQTT 메시지를 모두 저널 파일로 남김 (현장 문제 재현, 실제 트래픽으로 수신 성능 측정용)
+// - MqttHub가 메시지를 라우팅하기 전에 record() - GUI 스레드는 인코딩해서 큐에 넣기만 함
+// - 파일 쓰기는 전용 스레드: 세그먼트(기본 64MB)를 mmap 해서 채우고, 차면 다음 세그먼트
+// - 전체 크기 상한(기본 1GB)을 넘으면 가장 오래된 세그먼트부터 삭제
+// - 켜기: 환경 변수 VISIONCRAFT_CAPTURE=1 (또는 저장 폴더 경로), 설정 capture/enabled
+//   크기: capture/segment_mb, capture/max_mb
+class CaptureJournal : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 recorded = 0;
+        quint64 bytes = 0;
+        quint64 dropped = 0;        // 쓰기가 밀려 큐가 가득 찼을 때 버린 메시지
+        quint64 segments = 0;       // 만든 세그먼트 수
+        quint64 deletedSegments = 0;
+    };
+
+    static CaptureJournal* instance();
+    static bool isEnabled();
+    ~CaptureJournal() override;
+
+    // GUI 스레드에서 호출 (MqttHub::dispatch)
+    void record(const QString &topic, const QByteArray &payload, quint8 qos, bool retain, qint64 receivedAtMs);
+
+    QString directory() const { return m_directory; }
+    Stats stats() const;
+    QString report() const;
+
+private:
+    explicit CaptureJournal(QObject *parent = nullptr);
+
+    void writerLoop();
+    bool rotate(JournalSegmentWriter &writer);
+    void enforceCap();
+
+    QString m_directory;
+    qint64 m_segmentBytes = 0;
+    qint64 m_maxBytes = 0;
+    int m_sequence = 0;
+
+    QThread *m_thread = nullptr;
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QVector<QByteArray> m_queue;            // 인코딩된 레코드 (m_mutex)
+    qint64 m_queuedBytes = 0;
+    bool m_stopping = false;
+
+    std::atomic<quint64> m_recorded{0};
+    std::atomic<quint64> m_bytes{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_segments{0};
+    std::atomic<quint64> m_deletedSegments{0};
+};
+
+#endif // CAPTURE_JOURNAL_H
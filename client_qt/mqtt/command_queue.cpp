@@ -0,0 +1,384 @@
+#include "command_queue.h"
+#include "mqtt_hub.h"
+#include "message_ingest.h"
+#include "device_registry.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUuid>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace {
+const int kMaxInFlight = 8;                     // 전체 동시 전송 중 명령 수
+const qint64 kOutboxTtlMs = 5 * 60 * 1000;      // 보관함 유효 시간 (오래된 기동 명령은 보내지 않음)
+const int kReportEvery = 20;
+}
+
+CommandQueue* CommandQueue::instance()
+{
+    static QPointer<CommandQueue> queue;
+    if (!queue) {
+        qRegisterMetaType<CommandResult>("CommandResult");
+        queue = new CommandQueue(QCoreApplication::instance());
+    }
+    return queue;
+}
+
+CommandQueue::CommandQueue(QObject *parent)
+    : QObject(parent)
+{
+    m_deadlineTimer = new QTimer(this);
+    m_deadlineTimer->setSingleShot(true);
+    connect(m_deadlineTimer, &QTimer::timeout, this, &CommandQueue::onDeadlineTimer);
+
+    connect(MqttHub::instance(), &MqttHub::connected, this, &CommandQueue::onConnected);
+    connect(MessageIngest::instance(), &MessageIngest::deviceStatus, this, &CommandQueue::onDeviceStatus);
+
+    loadOutbox();
+    pump();
+    scheduleDeadline();
+}
+
+QString CommandQueue::deviceIdForTopic(const QString &topic)
+{
+    // feeder_02/cmd → feeder_02, factory/conveyor_02/cmd → conveyor_02
+    QStringList parts = topic.split('/', Qt::SkipEmptyParts);
+    if (!parts.isEmpty() && parts.last() == "cmd") parts.removeLast();
+    return parts.isEmpty() ? topic : parts.last();
+}
+
+bool CommandQueue::isStopCommand(const QString &command)
+{
+    return command.compare("off", Qt::CaseInsensitive) == 0 || command.compare("stop", Qt::CaseInsensitive) == 0;
+}
+
+QString CommandQueue::submit(const QString &topic, const QString &command, const QString &source,
+                             QObject *context, Callback callback,
+                             const QString &expectedStatus, int ackTimeoutMs)
+{
+    Command entry;
+    entry.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    entry.deviceId = deviceIdForTopic(topic);
+    entry.topic = topic;
+    entry.command = command;
+    entry.expectedStatus = expectedStatus.isEmpty() ? command : expectedStatus;
+    entry.source = source;
+    entry.context = context;
+    entry.hasContext = (context != nullptr);
+    entry.callback = std::move(callback);
+    entry.ackTimeoutMs = ackTimeoutMs;
+    entry.createdAt = QDateTime::currentMSecsSinceEpoch();
+
+    // 기기 목록에 제어 대상으로 (토픽이 <device>/cmd가 아니면 기억)
+    DeviceRegistry::instance()->noteCommandTopic(entry.deviceId, topic);
+
+    const QString id = entry.id;
+    const bool stop = isStopCommand(command);
+    m_commands.insert(id, entry);
+    // 정지 명령은 보관함에서도 맨 앞 (연결되면 가장 먼저)
+    if (stop) m_waiting.prepend(id);
+    else m_waiting.append(id);
+    m_counters.submitted++;
+
+    if (stop) {
+        // 같은 기기로 아직 안 보낸 명령은 정지 뒤에 보내면 안 됨 → 취소
+        QStringList queued;
+        for (const QString &waitingId : std::as_const(m_waiting)) {
+            const Command &other = m_commands[waitingId];
+            if (waitingId != id && other.deviceId == entry.deviceId && !isStopCommand(other.command)) {
+                queued.append(waitingId);
+            }
+        }
+        for (const QString &queuedId : queued) finish(queuedId, CommandResult::Superseded);
+    }
+
+    pump();
+    if (!m_commands.value(id).sentAt) {
+        qDebug() << "[CommandQueue] 대기:" << entry.deviceId << command << "(" << source << ")"
+                 << (MqttHub::instance()->isConnected() ? "- 같은 기기 명령 처리 중" : "- 연결 안 됨, 보관함에 저장");
+    }
+    saveOutbox();
+    scheduleDeadline();
+    return id;
+}
+
+bool CommandQueue::hasPending(const QString &deviceId) const
+{
+    for (const Command &command : m_commands) {
+        if (command.deviceId == deviceId) return true;
+    }
+    return false;
+}
+
+void CommandQueue::pump()
+{
+    if (!MqttHub::instance()->isConnected()) return;
+
+    bool changed = false;
+    QStringList superseded;     // 정지 명령에 밀린 확인 전 명령 (돌고 난 뒤 finish - 도는 중에 목록이 바뀌지 않게)
+    for (auto it = m_waiting.begin(); it != m_waiting.end(); ) {
+        auto command = m_commands.find(*it);
+        if (command == m_commands.end()) {
+            it = m_waiting.erase(it);
+            changed = true;
+            continue;
+        }
+        // 정지 명령은 동시 발행 수/같은 기기 순서를 기다리지 않음
+        // 나머지는 같은 기기 앞 명령이 확인/시간 초과될 때까지 기다림 (순서 유지)
+        const bool stop = isStopCommand(command->command);
+        if (!stop && (m_inFlight.size() >= kMaxInFlight || m_inFlight.contains(command->deviceId))) {
+            ++it;
+            continue;
+        }
+        if (!publish(command.value())) break;
+
+        // 확인 전이던 같은 기기 명령은 정지가 대신함 (status는 정지 쪽 확인으로)
+        const QString previous = m_inFlight.value(command->deviceId);
+        if (!previous.isEmpty()) superseded.append(previous);
+        m_inFlight.insert(command->deviceId, command->id);
+        it = m_waiting.erase(it);
+        changed = true;
+    }
+
+    if (changed) saveOutbox();
+    for (const QString &id : superseded) finish(id, CommandResult::Superseded);
+}
+
+bool CommandQueue::publish(Command &command)
+{
+    // 명령은 QoS 1 (브로커까지는 확실히 전달, 실제 동작 여부는 status로 확인)
+    if (!MqttHub::instance()->publish(command.topic, command.command.toUtf8(), 1)) return false;
+
+    command.sentAt = QDateTime::currentMSecsSinceEpoch();
+    command.deadline = command.sentAt + command.ackTimeoutMs;
+    m_counters.published++;
+    qDebug() << "[CommandQueue] 발행:" << command.topic << command.command << "(" << command.source << ")"
+             << "대기" << (command.sentAt - command.createdAt) << "ms";
+    return true;
+}
+
+void CommandQueue::onConnected()
+{
+    if (!m_waiting.isEmpty()) {
+        qDebug() << "[CommandQueue] 연결됨 - 보관함 명령" << m_waiting.size() << "건 전송";
+    }
+    expireOutbox();
+    pump();
+    scheduleDeadline();
+}
+
+void CommandQueue::onDeviceStatus(const DeviceStatusPtr &status)
+{
+    m_lastStatus.insert(status->deviceId, status->status);
+
+    const QString id = m_inFlight.value(status->deviceId);
+    if (id.isEmpty()) return;
+
+    auto it = m_commands.constFind(id);
+    if (it != m_commands.cend() && status->status == it->expectedStatus) {
+        finish(id, CommandResult::Acked);
+    }
+}
+
+void CommandQueue::finish(const QString &commandId, CommandResult::Outcome outcome)
+{
+    auto it = m_commands.find(commandId);
+    if (it == m_commands.end()) return;
+
+    const Command command = it.value();
+    m_commands.erase(it);
+    if (m_inFlight.value(command.deviceId) == commandId) m_inFlight.remove(command.deviceId);
+    const bool wasWaiting = m_waiting.removeAll(commandId) > 0;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    CommandResult result;
+    result.outcome = outcome;
+    result.commandId = commandId;
+    result.deviceId = command.deviceId;
+    result.command = command.command;
+    result.source = command.source;
+    result.lastStatus = m_lastStatus.value(command.deviceId);
+    result.queuedMs = (command.sentAt ? command.sentAt : now) - command.createdAt;
+    result.rttMs = command.sentAt ? now - command.sentAt : 0;
+
+    QueryEngine::LatencyHistogram &histogram = m_rtt[command.deviceId];
+    switch (outcome) {
+    case CommandResult::Acked:
+        histogram.add(result.rttMs);
+        m_counters.acked++;
+        qDebug() << "[CommandQueue] 확인:" << command.deviceId << command.command << "RTT" << result.rttMs << "ms";
+        if (m_counters.acked % kReportEvery == 0) qDebug().noquote() << rttReport();
+        break;
+    case CommandResult::TimedOut:
+        histogram.timeouts++;
+        m_counters.timedOut++;
+        qDebug() << "[CommandQueue] 상태 확인 안 됨:" << command.deviceId << command.command
+                 << "마지막 상태:" << result.lastStatus;
+        break;
+    case CommandResult::Expired:
+        m_counters.expired++;
+        qDebug() << "[CommandQueue] 보관함 유효 시간 지남, 보내지 않음:" << command.deviceId << command.command;
+        break;
+    case CommandResult::Superseded:
+        m_counters.superseded++;
+        qDebug() << "[CommandQueue] 정지 명령으로 취소:" << command.deviceId << command.command
+                 << (command.sentAt ? "(확인 전)" : "(대기 중)");
+        break;
+    }
+
+    if (command.callback && (!command.hasContext || command.context)) {
+        command.callback(result);
+    }
+    emit commandFinished(result);
+
+    if (wasWaiting) saveOutbox();
+    pump();
+    scheduleDeadline();
+}
+
+void CommandQueue::expireOutbox()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QStringList expired;
+    for (const QString &id : std::as_const(m_waiting)) {
+        if (m_commands.value(id).createdAt + kOutboxTtlMs <= now) expired.append(id);
+    }
+    for (const QString &id : expired) finish(id, CommandResult::Expired);
+}
+
+void CommandQueue::scheduleDeadline()
+{
+    qint64 nearest = std::numeric_limits<qint64>::max();
+    for (const Command &command : std::as_const(m_commands)) {
+        nearest = qMin(nearest, command.sentAt ? command.deadline : command.createdAt + kOutboxTtlMs);
+    }
+
+    if (nearest == std::numeric_limits<qint64>::max()) {
+        m_deadlineTimer->stop();
+        return;
+    }
+    const qint64 wait = qMax<qint64>(0, nearest - QDateTime::currentMSecsSinceEpoch());
+    m_deadlineTimer->start(static_cast<int>(qMin<qint64>(wait, std::numeric_limits<int>::max())));
+}
+
+void CommandQueue::onDeadlineTimer()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QStringList timedOut;
+    for (auto it = m_commands.cbegin(); it != m_commands.cend(); ++it) {
+        if (it->sentAt && it->deadline <= now) timedOut.append(it.key());
+    }
+    for (const QString &id : timedOut) finish(id, CommandResult::TimedOut);
+
+    expireOutbox();
+    scheduleDeadline();
+}
+
+QString CommandQueue::rttReport() const
+{
+    QStringList lines;
+    lines << QString("[CommandQueue] 접수 %1, 발행 %2, 확인 %3, 시간 초과 %4, 만료 %5, 정지로 취소 %6")
+                 .arg(m_counters.submitted).arg(m_counters.published).arg(m_counters.acked)
+                 .arg(m_counters.timedOut).arg(m_counters.expired).arg(m_counters.superseded);
+
+    QStringList devices = m_rtt.keys();
+    std::sort(devices.begin(), devices.end());
+    for (const QString &device : devices) {
+        const QueryEngine::LatencyHistogram &h = m_rtt[device];
+        lines << QString("  %1: 확인 %2건, 평균 %3ms, p50 ≤%4ms, p95 ≤%5ms, 최대 %6ms, 시간 초과 %7")
+                     .arg(device).arg(h.count)
+                     .arg(h.count ? h.totalMs / static_cast<qint64>(h.count) : 0)
+                     .arg(h.percentile(0.5)).arg(h.percentile(0.95)).arg(h.maxMs).arg(h.timeouts);
+    }
+    return lines.join('\n');
+}
+
+/* ---------- 보관함 (연결 안 된 동안 / 재시작 대비) ---------- */
+
+QString CommandQueue::outboxPath() const
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(dir);
+    return dir + "/command_outbox.json";
+}
+
+void CommandQueue::saveOutbox() const
+{
+    const QString path = outboxPath();
+    if (m_waiting.isEmpty()) {
+        QFile::remove(path);
+        return;
+    }
+
+    QJsonArray entries;
+    for (const QString &id : m_waiting) {
+        const Command &command = m_commands[id];
+        QJsonObject entry;
+        entry["id"] = command.id;
+        entry["topic"] = command.topic;
+        entry["command"] = command.command;
+        entry["expected_status"] = command.expectedStatus;
+        entry["source"] = command.source;
+        entry["created_at"] = static_cast<double>(command.createdAt);
+        entry["ack_timeout_ms"] = command.ackTimeoutMs;
+        entries.append(entry);
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "[CommandQueue] 보관함 저장 실패:" << path;
+        return;
+    }
+    file.write(QJsonDocument(entries).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+void CommandQueue::loadOutbox()
+{
+    QFile file(outboxPath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const QJsonArray entries = QJsonDocument::fromJson(file.readAll()).array();
+    file.close();
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (const QJsonValue &value : entries) {
+        const QJsonObject entry = value.toObject();
+
+        Command command;
+        command.id = entry.value("id").toString();
+        command.topic = entry.value("topic").toString();
+        command.deviceId = deviceIdForTopic(command.topic);
+        command.command = entry.value("command").toString();
+        command.expectedStatus = entry.value("expected_status").toString(command.command);
+        command.source = entry.value("source").toString();
+        command.createdAt = static_cast<qint64>(entry.value("created_at").toDouble());
+        command.ackTimeoutMs = entry.value("ack_timeout_ms").toInt(5000);
+
+        if (command.id.isEmpty() || command.topic.isEmpty()) continue;
+        if (command.createdAt + kOutboxTtlMs <= now) {
+            m_counters.expired++;
+            qDebug() << "[CommandQueue] 보관함의 오래된 명령 버림:" << command.deviceId << command.command;
+            continue;
+        }
+
+        m_commands.insert(command.id, command);
+        m_waiting.append(command.id);
+        m_counters.restored++;
+    }
+
+    if (m_counters.restored > 0) {
+        qDebug() << "[CommandQueue] 보관함에서 명령" << m_counters.restored << "건 복구";
+    }
+    saveOutbox();
+}
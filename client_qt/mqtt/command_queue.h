@@ -0,0 +1,125 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <functional>
+#include "message_types.h"
+#include "query_engine.h"
+
+// 기기 제어 명령 한 건의 결과
+struct CommandResult {
+    enum Outcome {
+        Acked,          // <device>/status 로 기대한 상태가 돌아옴
+        TimedOut,       // 보냈지만 마감까지 상태 확인 안 됨
+        Expired,        // 연결이 안 돼서 보관함에 있다가 유효 시간이 지남 (안 보냄)
+        Superseded      // 같은 기기에 정지(off/stop) 명령이 들어와 취소됨 (대기 중이었거나 확인 전)
+    };
+
+    Outcome outcome = Acked;
+    QString commandId;
+    QString deviceId;
+    QString command;
+    QString source;         // 누가 보냈는지 ("feeder", "conveyor", "home", "chatbot", "mcp")
+    QString lastStatus;     // 마지막으로 받은 기기 상태 (시간 초과 시 원인 파악용)
+    qint64  rttMs = 0;      // 발행 → 상태 확인 (실제 동작까지 걸린 시간)
+    qint64  queuedMs = 0;   // 접수 → 발행 (보관함/대기열에 있던 시간)
+
+    bool ok() const { return outcome == Acked; }
+};
+
+// 기기 제어 명령 파이프라인
+// - 같은 기기로는 한 번에 하나만 발행 (응답 상태가 어느 명령 것인지 헷갈리지 않게), 전체 동시 발행 수 제한
+// - 정지 명령(off/stop)은 두 제한을 건너뛰고 바로 발행, 같은 기기의 대기 중인 명령과 확인 전 명령은 취소
+// - 연결이 끊겨 있으면 보관함(파일)에 넣었다가 연결되면 순서대로 보냄, 오래된 명령은 버림
+// - <device>/status 로 기대한 상태가 오면 확인 처리, 기기별 명령→상태 왕복 시간 히스토그램
+class CommandQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Callback = std::function<void(const CommandResult &result)>;
+
+    struct Counters {
+        quint64 submitted = 0;
+        quint64 published = 0;
+        quint64 acked = 0;
+        quint64 timedOut = 0;
+        quint64 expired = 0;
+        quint64 restored = 0;       // 재시작 후 보관함에서 복구
+        quint64 superseded = 0;     // 정지 명령으로 취소
+    };
+
+    static CommandQueue* instance();
+
+    // topic: <device>/cmd 또는 factory/<device>/cmd, expectedStatus가 비어있으면 command와 같은 상태를 기다림
+    // context가 파괴되면 콜백은 호출되지 않는다 (명령 자체는 계속 진행)
+    QString submit(const QString &topic, const QString &command, const QString &source,
+                   QObject *context = nullptr, Callback callback = nullptr,
+                   const QString &expectedStatus = QString(), int ackTimeoutMs = 5000);
+
+    static QString deviceIdForTopic(const QString &topic);
+    static bool isStopCommand(const QString &command);
+
+    // 마지막으로 받은 기기 상태 ("on", "off" ...), 모르면 빈 문자열
+    QString lastStatus(const QString &deviceId) const { return m_lastStatus.value(deviceId); }
+    bool hasPending(const QString &deviceId) const;
+
+    QHash<QString, QueryEngine::LatencyHistogram> rttHistograms() const { return m_rtt; }
+    QString rttReport() const;
+    Counters counters() const { return m_counters; }
+
+signals:
+    void commandFinished(const CommandResult &result);
+
+private slots:
+    void onConnected();
+    void onDeviceStatus(const DeviceStatusPtr &status);
+    void onDeadlineTimer();
+
+private:
+    explicit CommandQueue(QObject *parent = nullptr);
+
+    struct Command {
+        QString id;
+        QString deviceId;
+        QString topic;
+        QString command;
+        QString expectedStatus;
+        QString source;
+        QPointer<QObject> context;
+        Callback callback;
+        bool hasContext = false;    // context 없이 제출된 명령은 콜백 조건 없이 결과만 시그널로
+        int ackTimeoutMs = 5000;
+        qint64 createdAt = 0;       // epoch ms
+        qint64 sentAt = 0;          // 0이면 아직 안 보냄
+        qint64 deadline = 0;        // 보낸 뒤 상태 확인 마감
+    };
+
+    void pump();
+    bool publish(Command &command);
+    void finish(const QString &commandId, CommandResult::Outcome outcome);
+    void scheduleDeadline();
+    void expireOutbox();
+
+    void saveOutbox() const;
+    void loadOutbox();
+    QString outboxPath() const;
+
+    QHash<QString, Command> m_commands;         // id → 명령 (대기 + 전송 중)
+    QList<QString> m_waiting;                   // 아직 안 보낸 명령 (접수 순서)
+    QHash<QString, QString> m_inFlight;         // deviceId → 전송 중 명령 id
+
+    QHash<QString, QString> m_lastStatus;
+    QHash<QString, QueryEngine::LatencyHistogram> m_rtt;
+    Counters m_counters;
+
+    QTimer *m_deadlineTimer = nullptr;
+};
+
+Q_DECLARE_METATYPE(CommandResult)
+
+#endif // COMMAND_QUEUE_H
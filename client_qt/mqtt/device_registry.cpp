@@ -0,0 +1,341 @@
+#include "device_registry.h"
+#include "message_ingest.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QSettings>
+#include <QDebug>
+
+namespace {
+struct KindAlias {
+    const char *kind;
+    const char *display;
+    const char *pattern;    // 자연어 별칭 (소문자 기준)
+};
+
+const KindAlias kKinds[] = {
+    {"feeder",    "피더",     "피더|feeder"},
+    {"conveyor",  "컨베이어", "컨베이어|conveyor"},
+    {"robot_arm", "로봇팔",   "로봇\\s*팔|robot[\\s_]*arm"},
+};
+
+// 처음 실행할 때만 쓰는 기본 목록 (이후에는 발견한 기기가 QSettings에 저장됨)
+struct SeedDevice {
+    const char *id;
+    DeviceRegistry::Role role;
+    const char *commandTopic;
+};
+
+const SeedDevice kSeedDevices[] = {
+    {"feeder_01",    DeviceRegistry::Sensor,   ""},
+    {"conveyor_01",  DeviceRegistry::Sensor,   ""},
+    {"feeder_02",    DeviceRegistry::Actuator, ""},
+    {"conveyor_03",  DeviceRegistry::Actuator, ""},
+    {"conveyor_02",  DeviceRegistry::Actuator, "factory/conveyor_02/cmd"},
+    {"robot_arm_01", DeviceRegistry::Actuator, ""},
+};
+
+const char *kSettingsGroup = "devices";
+const qint64 kExpiryMs = 30LL * 24 * 60 * 60 * 1000;   // 이만큼 수신이 없던 기기는 시작할 때 뺌
+}
+
+DeviceRegistry* DeviceRegistry::instance()
+{
+    static QPointer<DeviceRegistry> registry;
+    if (!registry) {
+        registry = new DeviceRegistry(QCoreApplication::instance());
+    }
+    return registry;
+}
+
+DeviceRegistry::DeviceRegistry(QObject *parent)
+    : QObject(parent)
+{
+    load();
+
+    // 시그널에 연결하는 것만으로 MessageIngest가 와일드카드 토픽을 구독
+    MessageIngest *ingest = MessageIngest::instance();
+    connect(ingest, &MessageIngest::logEvent, this, &DeviceRegistry::onLogEvent);
+    connect(ingest, &MessageIngest::deviceStatus, this, &DeviceRegistry::onDeviceStatus);
+    connect(ingest, &MessageIngest::speedStats, this, &DeviceRegistry::onSpeedStats);
+
+    // 마지막 수신 시각은 메시지마다 저장하지 않고 끝날 때 한 번
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &DeviceRegistry::save);
+}
+
+/* ---------- 기기 ID 해석 ---------- */
+
+QString DeviceRegistry::kindOf(const QString &deviceId)
+{
+    // feeder_02 → feeder, robot_arm_01 → robot_arm (끝의 _숫자 제거)
+    static const QRegularExpression suffix("_\\d+$");
+    QString kind = deviceId;
+    kind.remove(suffix);
+    return kind;
+}
+
+int DeviceRegistry::numberOf(const QString &deviceId)
+{
+    static const QRegularExpression suffix("_(\\d+)$");
+    const QRegularExpressionMatch match = suffix.match(deviceId);
+    return match.hasMatch() ? match.captured(1).toInt() : 0;
+}
+
+bool DeviceRegistry::isDeviceId(const QString &deviceId)
+{
+    static const QRegularExpression pattern("^[A-Za-z][A-Za-z0-9]*(?:_[A-Za-z0-9]+)*_\\d+$");
+    return pattern.match(deviceId).hasMatch();
+}
+
+QString DeviceRegistry::kindDisplayName(const QString &kind)
+{
+    for (const KindAlias &alias : kKinds) {
+        if (kind == QLatin1String(alias.kind)) return QString::fromUtf8(alias.display);
+    }
+    return kind;
+}
+
+QString DeviceRegistry::displayName(const QString &deviceId) const
+{
+    const QString kind = kindOf(deviceId);
+    const int number = numberOf(deviceId);
+    const QString kindName = kindDisplayName(kind);
+    if (number == 0 || kindName == kind) return deviceId;
+    return QString("%1 %2번").arg(kindName).arg(number);
+}
+
+QString DeviceRegistry::commandTopic(int index) const
+{
+    const QString topic = m_commandTopics.value(index);
+    return topic.isEmpty() ? m_ids.value(index) + "/cmd" : topic;
+}
+
+QVector<int> DeviceRegistry::indicesWithRole(Role role) const
+{
+    QVector<int> indices;
+    for (int i = 0; i < m_roles.size(); ++i) {
+        if (m_roles[i] == role) indices.append(i);
+    }
+    return indices;
+}
+
+QString DeviceRegistry::firstOf(const QString &kind, Role role) const
+{
+    int best = -1;
+    for (int i = 0; i < m_ids.size(); ++i) {
+        if (m_roles[i] != role || m_kinds[i] != kind) continue;
+        if (best < 0 || numberOf(m_ids[i]) < numberOf(m_ids[best])) best = i;
+    }
+    return best >= 0 ? m_ids[best] : QString();
+}
+
+QString DeviceRegistry::resolve(const QString &text) const
+{
+    const QString input = text.trimmed().toLower();
+    if (m_index.contains(input)) return input;
+
+    static const QStringList ordinals = {"첫", "두", "세", "네", "다섯", "여섯", "일곱", "여덟", "아홉", "열"};
+
+    for (const KindAlias &alias : kKinds) {
+        const QString kindPattern = QString::fromUtf8(alias.pattern);
+
+        // 피더2, 피더 2번, 피더02, feeder_2, feeder2
+        const QRegularExpression numbered(QString("(?:%1)\\s*_?\\s*0*(\\d+)").arg(kindPattern));
+        QRegularExpressionMatch match = numbered.match(input);
+        int number = match.hasMatch() ? match.captured(1).toInt() : 0;
+
+        // 두 번째 피더
+        if (number == 0) {
+            const QRegularExpression ordinal(QString("(%1)\\s*번째\\s*(?:%2)").arg(ordinals.join('|'), kindPattern));
+            match = ordinal.match(input);
+            if (match.hasMatch()) number = ordinals.indexOf(match.captured(1)) + 1;
+        }
+        if (number == 0) continue;
+
+        const QString deviceId = QString("%1_%2").arg(QLatin1String(alias.kind)).arg(number, 2, 10, QChar('0'));
+        if (m_index.contains(deviceId)) return deviceId;
+    }
+    return QString();
+}
+
+/* ---------- 등록 ---------- */
+
+int DeviceRegistry::add(const QString &deviceId, Role role, const QString &commandTopic)
+{
+    const int index = m_ids.size();
+    m_index.insert(deviceId, index);
+    m_ids.append(deviceId);
+    m_kinds.append(kindOf(deviceId));
+    m_roles.append(role);
+    m_commandTopics.append(commandTopic);
+    m_lastStatus.append(QString());
+    m_lastSeen.append(0);
+    m_confirmed.append(false);
+    m_errorCount.append(0);
+    m_infoCount.append(0);
+    m_statusCount.append(0);
+    return index;
+}
+
+int DeviceRegistry::ensure(const QString &deviceId)
+{
+    const int existing = indexOf(deviceId);
+    if (existing >= 0 || deviceId.isEmpty()) return existing;
+    if (!isDeviceId(deviceId)) {
+        if (!m_ignored.contains(deviceId)) {
+            m_ignored.insert(deviceId);
+            qDebug() << "[DeviceRegistry] 기기 ID 모양이 아니라 무시:" << deviceId;
+        }
+        return -1;
+    }
+
+    // 저장은 로그 밖의 트래픽/명령으로 확인될 때 (confirm)
+    const int index = add(deviceId, Unknown, QString());
+    qDebug() << "[DeviceRegistry] 새 기기 발견:" << deviceId << "(" << displayName(deviceId) << ") 인덱스" << index;
+    qDebug().noquote() << report();
+    emit deviceDiscovered(index);
+    return index;
+}
+
+void DeviceRegistry::setRole(int index, Role role)
+{
+    if (index < 0 || m_roles[index] == role) return;
+    // 제어 대상으로 확인된 기기는 다른 상태가 와도 그대로
+    if (m_roles[index] == Actuator && role != Actuator) return;
+
+    m_roles[index] = role;
+    qDebug() << "[DeviceRegistry]" << m_ids[index] << "역할:" << (role == Actuator ? "제어 대상" : "라인 기기");
+    if (m_confirmed[index]) save();
+    emit roleChanged(index);
+}
+
+void DeviceRegistry::confirm(int index)
+{
+    if (index < 0 || m_confirmed[index]) return;
+    m_confirmed[index] = true;
+    save();
+}
+
+void DeviceRegistry::noteCommandTopic(const QString &deviceId, const QString &topic)
+{
+    const int index = ensure(deviceId);
+    if (index < 0) return;
+
+    const QString custom = (topic == deviceId + "/cmd") ? QString() : topic;
+    const bool changed = m_commandTopics[index] != custom;
+    m_commandTopics[index] = custom;
+    setRole(index, Actuator);
+    if (!m_confirmed[index]) confirm(index);
+    else if (changed) save();
+}
+
+/* ---------- 발견 ---------- */
+
+void DeviceRegistry::onLogEvent(const LogEventPtr &event)
+{
+    const int index = ensure(event->deviceId);
+    if (index < 0) return;
+
+    m_lastSeen[index] = QDateTime::currentMSecsSinceEpoch();
+    if (event->logLevel == "error") m_errorCount[index]++;
+    else m_infoCount[index]++;
+
+    if (m_roles[index] == Unknown) setRole(index, Sensor);   // 로그를 올리는 건 라인 기기 (저장은 안 함)
+}
+
+void DeviceRegistry::onDeviceStatus(const DeviceStatusPtr &status)
+{
+    const int index = ensure(status->deviceId);
+    if (index < 0) return;
+
+    m_lastSeen[index] = status->receivedAt;
+    m_lastStatus[index] = status->status;
+    m_statusCount[index]++;
+
+    const bool onOff = (status->status == "on" || status->status == "off");
+    setRole(index, onOff ? Actuator : Sensor);
+    confirm(index);
+}
+
+void DeviceRegistry::onSpeedStats(const SpeedStatsPtr &stats)
+{
+    const int index = ensure(stats->deviceId);
+    if (index < 0) return;
+
+    m_lastSeen[index] = stats->receivedAt;
+    if (m_roles[index] == Unknown) setRole(index, Sensor);
+    confirm(index);
+}
+
+QString DeviceRegistry::report() const
+{
+    QStringList lines;
+    lines << QString("[DeviceRegistry] 기기 %1대 (제어 대상 %2, 라인 %3)")
+                 .arg(count()).arg(indicesWithRole(Actuator).size()).arg(indicesWithRole(Sensor).size());
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int i = 0; i < m_ids.size(); ++i) {
+        lines << QString("  #%1 %2 (%3) 상태=%4 오류 %5 정보 %6 상태 %7, 마지막 수신 %8")
+                     .arg(i).arg(m_ids[i], displayName(m_ids[i]), m_lastStatus[i].isEmpty() ? "-" : m_lastStatus[i])
+                     .arg(m_errorCount[i]).arg(m_infoCount[i]).arg(m_statusCount[i])
+                     .arg(m_lastSeen[i] ? QString("%1초 전").arg((now - m_lastSeen[i]) / 1000) : QString("-"));
+    }
+    return lines.join('\n');
+}
+
+/* ---------- 저장 ---------- */
+
+void DeviceRegistry::save() const
+{
+    QSettings settings("VisionCraft", "client_qt");
+    settings.remove(kSettingsGroup);    // 뺀 기기/로그로만 본 기기가 남지 않게 새로 씀
+    settings.beginWriteArray(kSettingsGroup);
+    int written = 0;
+    for (int i = 0; i < m_ids.size(); ++i) {
+        if (!m_confirmed[i]) continue;
+        settings.setArrayIndex(written++);
+        settings.setValue("id", m_ids[i]);
+        settings.setValue("role", static_cast<int>(m_roles[i]));
+        settings.setValue("command_topic", m_commandTopics[i]);
+        settings.setValue("last_seen", m_lastSeen[i]);
+    }
+    settings.endArray();
+}
+
+void DeviceRegistry::load()
+{
+    QSettings settings("VisionCraft", "client_qt");
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QStringList expired;
+    const int size = settings.beginReadArray(kSettingsGroup);
+    for (int i = 0; i < size; ++i) {
+        settings.setArrayIndex(i);
+        const QString deviceId = settings.value("id").toString();
+        if (!isDeviceId(deviceId) || m_index.contains(deviceId)) continue;
+        // 0 = 아직 한 번도 못 받음 (기본 목록) → 빼지 않음
+        const qint64 lastSeen = settings.value("last_seen", 0).toLongLong();
+        if (lastSeen > 0 && now - lastSeen > kExpiryMs) {
+            expired << deviceId;
+            continue;
+        }
+        const int index = add(deviceId, static_cast<Role>(settings.value("role").toInt()),
+                              settings.value("command_topic").toString());
+        m_lastSeen[index] = lastSeen;
+        m_confirmed[index] = true;
+    }
+    settings.endArray();
+
+    if (m_ids.isEmpty()) {
+        for (const SeedDevice &seed : kSeedDevices) {
+            const int index = add(QString::fromLatin1(seed.id), seed.role, QString::fromLatin1(seed.commandTopic));
+            m_confirmed[index] = true;
+        }
+        save();
+        qDebug() << "[DeviceRegistry] 저장된 기기 없음 - 기본 목록으로 시작:" << m_ids;
+    } else {
+        if (m_ids.size() != size) save();
+        qDebug() << "[DeviceRegistry] 저장된 기기" << m_ids.size() << "대 복구";
+        if (!expired.isEmpty()) qDebug() << "[DeviceRegistry] 30일 넘게 수신 없어 뺀 기기:" << expired;
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef DEVICE_REGISTRY_H
+#define DEVICE_REGISTRY_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include "message_types.h"
+
+// 기기 목록 - 코드에 기기 ID를 박아두지 않고 와일드카드 구독(+/status, factory/+/log/...)으로 발견
+// - 기기마다 0부터 차례로 인덱스를 주고, 상태는 인덱스로 접근하는 배열에 보관 (문자열 키 맵 대신)
+//   다른 모듈도 기기별 상태를 같은 인덱스의 배열로 들고 있으면 됨 (ensure → 필요할 때 크기 늘림)
+// - 역할: <device>/status 로 on/off를 보고하면 제어 대상(Actuator), 그 밖의 상태/로그만 오면 라인 기기(Sensor)
+// - 제어 토픽은 기본 <device>/cmd, 다른 토픽으로 명령을 보낸 적이 있으면 그 토픽 (CommandQueue가 알려줌)
+// - 발견한 기기는 QSettings에 저장 → 다음 실행부터 바로 알고 시작
+//   로그로만 본 기기는 이번 실행 동안만 (상태/통계를 보내거나 명령을 받은 기기만 저장)
+//   30일 넘게 수신이 없던 기기는 시작할 때 목록에서 뺌 (실행 중에는 인덱스가 바뀌지 않게 빼지 않음)
+// - "factory"처럼 <종류>_<번호> 모양이 아닌 ID는 기기로 보지 않음
+class DeviceRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Role : quint8 {
+        Unknown = 0,
+        Sensor,         // 라인 기기 (로그, 오류 상태, 통계)
+        Actuator        // 제어 대상 (on/off 명령 응답)
+    };
+
+    static DeviceRegistry* instance();
+
+    // deviceId → 인덱스 (없으면 -1), ensure는 없으면 등록하고 deviceDiscovered (기기 ID 모양이 아니면 -1)
+    int indexOf(const QString &deviceId) const { return m_index.value(deviceId, -1); }
+    int ensure(const QString &deviceId);
+    int count() const { return m_ids.size(); }
+
+    QString idAt(int index) const { return m_ids.value(index); }
+    QString kindAt(int index) const { return m_kinds.value(index); }
+    Role roleAt(int index) const { return static_cast<Role>(m_roles.value(index, Unknown)); }
+    QString commandTopic(int index) const;
+    QString lastStatus(int index) const { return m_lastStatus.value(index); }
+    qint64 lastSeen(int index) const { return m_lastSeen.value(index); }
+    quint32 errorCount(int index) const { return m_errorCount.value(index); }
+    quint32 infoCount(int index) const { return m_infoCount.value(index); }
+    quint32 statusCount(int index) const { return m_statusCount.value(index); }
+
+    bool isActuator(const QString &deviceId) const { return roleAt(indexOf(deviceId)) == Actuator; }
+    QVector<int> indicesWithRole(Role role) const;
+    // kind 기기 중 role인 것의 가장 작은 번호 ID (창마다 보여줄 라인 기기/제어 대상), 없으면 빈 문자열
+    QString firstOf(const QString &kind, Role role) const;
+    QString displayName(const QString &deviceId) const;     // "피더 2번", 모르는 종류면 ID 그대로
+
+    // 제어 명령을 보낼 때 (CommandQueue) - 역할을 Actuator로, 토픽 기억
+    void noteCommandTopic(const QString &deviceId, const QString &topic);
+
+    // "피더2", "피더 2번", "두 번째 피더", "feeder2", "conveyor_03" → 알려진 기기 ID (모르면 빈 문자열)
+    QString resolve(const QString &text) const;
+
+    // "feeder_02" → "feeder", 2 (발견 전에도 쓸 수 있게 static)
+    static QString kindOf(const QString &deviceId);
+    static int numberOf(const QString &deviceId);
+    static bool isDeviceId(const QString &deviceId);    // <종류>_<번호> (feeder_01, robot_arm_02)
+    static QString kindDisplayName(const QString &kind);
+
+    QString report() const;
+
+signals:
+    void deviceDiscovered(int index);
+    void roleChanged(int index);
+
+private slots:
+    void onLogEvent(const LogEventPtr &event);
+    void onDeviceStatus(const DeviceStatusPtr &status);
+    void onSpeedStats(const SpeedStatsPtr &stats);
+
+private:
+    explicit DeviceRegistry(QObject *parent = nullptr);
+
+    int add(const QString &deviceId, Role role, const QString &commandTopic);
+    void setRole(int index, Role role);
+    void confirm(int index);    // 로그 밖의 트래픽/명령으로 확인된 기기 → 저장 대상
+
+    void save() const;
+    void load();
+
+    QHash<QString, int> m_index;        // 수신 시 ID → 인덱스 조회용 (한 번)
+
+    // 인덱스로 접근하는 기기별 상태
+    QVector<QString> m_ids;
+    QVector<QString> m_kinds;
+    QVector<quint8>  m_roles;
+    QVector<QString> m_commandTopics;   // 비어있으면 <device>/cmd
+    QVector<QString> m_lastStatus;
+    QVector<qint64>  m_lastSeen;        // 저장된 기기는 지난 실행의 마지막 수신부터
+    QVector<bool>    m_confirmed;       // 저장 대상 (로그로만 본 기기는 false)
+    QVector<quint32> m_errorCount;
+    QVector<quint32> m_infoCount;
+    QVector<quint32> m_statusCount;
+
+    QSet<QString> m_ignored;            // 기기 ID 모양이 아니라 무시한 ID (한 번만 로그)
+};
+
+#endif // DEVICE_REGISTRY_H
@@ -0,0 +1,94 @@
+#include "error_burst_coalescer.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+namespace {
+const int kFrameMs = 16;
+const int kMaxAggregatesPerFrame = 16;
+const qint64 kFrameBudgetMs = 8;        // 프레임의 절반은 나머지 화면 갱신 몫
+const quint64 kReportEvery = 200;
+}
+
+ErrorBurstCoalescer::ErrorBurstCoalescer(QObject *parent)
+    : QObject(parent)
+{
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setInterval(kFrameMs);
+    connect(&m_frameTimer, &QTimer::timeout, this, &ErrorBurstCoalescer::flush);
+}
+
+QString ErrorBurstCoalescer::keyOf(const LogEventPtr &event)
+{
+    return event->deviceId + '|' + event->logCode;
+}
+
+void ErrorBurstCoalescer::push(const LogEventPtr &event)
+{
+    if (!event) return;
+    m_stats.events++;
+
+    const QString key = keyOf(event);
+    auto it = m_queueIndex.constFind(key);
+    if (it != m_queueIndex.cend()) {
+        ErrorAggregate &aggregate = m_queue[it.value()];
+        aggregate.latest = event;
+        aggregate.count++;
+    } else {
+        ErrorAggregate aggregate;
+        aggregate.latest = event;
+        aggregate.firstTimestamp = event->timestamp;
+        m_queueIndex.insert(key, m_queue.size());
+        m_queue.append(aggregate);
+        m_stats.maxQueue = qMax(m_stats.maxQueue, m_queue.size());
+    }
+
+    if (!m_frameTimer.isActive()) m_frameTimer.start();
+}
+
+void ErrorBurstCoalescer::clear()
+{
+    m_frameTimer.stop();
+    m_queue.clear();
+    m_queueIndex.clear();
+}
+
+void ErrorBurstCoalescer::flush()
+{
+    QElapsedTimer frame;
+    frame.start();
+    m_stats.frames++;
+
+    int handled = 0;
+    while (handled < m_queue.size() && handled < kMaxAggregatesPerFrame) {
+        // 최소 한 건은 처리 (하나가 예산보다 오래 걸려도 멈추지 않게)
+        if (handled > 0 && frame.elapsed() >= kFrameBudgetMs) break;
+        emit aggregateReady(m_queue.at(handled));
+        handled++;
+    }
+    m_stats.aggregates += handled;
+    m_stats.maxFrameMs = qMax(m_stats.maxFrameMs, frame.elapsed());
+
+    // 처리한 만큼 앞에서 빼고 색인 다시 만들기 (남은 것은 많아야 기기×코드 수)
+    m_queue.remove(0, handled);
+    m_queueIndex.clear();
+    for (int i = 0; i < m_queue.size(); ++i) {
+        m_queueIndex.insert(keyOf(m_queue.at(i).latest), i);
+    }
+
+    if (!m_queue.isEmpty()) {
+        m_stats.deferredFrames++;
+        m_frameTimer.start();
+    }
+
+    if (m_stats.frames % kReportEvery == 0) {
+        qDebug().noquote() << report();
+    }
+}
+
+QString ErrorBurstCoalescer::report() const
+{
+    return QString("[ErrorBurst] 오류 로그 %1건 → 묶음 %2개 (%3프레임, 넘김 %4), 최대 대기 %5묶음, 최대 프레임 %6ms")
+        .arg(m_stats.events).arg(m_stats.aggregates).arg(m_stats.frames).arg(m_stats.deferredFrames)
+        .arg(m_stats.maxQueue).arg(m_stats.maxFrameMs);
+}
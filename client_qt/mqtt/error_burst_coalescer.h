@@ -0,0 +1,60 @@
+#ifndef ERROR_BURST_COALESCER_H
+#define ERROR_BURST_COALESCER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <QVector>
+#include "message_types.h"
+
+// 같은 기기에서 같은 코드로 몰려온 오류 로그 묶음 ("SPD ×12")
+struct ErrorAggregate {
+    LogEventPtr latest;             // 화면에는 마지막 것을 보여줌
+    qint64 firstTimestamp = 0;
+    int count = 1;
+};
+
+// 오류 로그를 화면 한 프레임(16ms) 단위로 모아서 넘김 (기기가 깜빡이며 초당 수십 건을 보낼 때 대시보드가 멈추지 않게)
+// - 프레임 안에서 (기기, 코드)가 같은 로그는 하나로 합치고 건수만 셈
+// - 한 프레임에 넘기는 묶음 수와 처리 시간(8ms)에 상한 → 남은 것은 다음 프레임으로 (그 사이 더 들어오면 거기 합쳐짐)
+// - 로그가 없으면 타이머도 돌지 않음
+class ErrorBurstCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 events = 0;
+        quint64 aggregates = 0;     // 화면으로 넘긴 묶음 수
+        quint64 frames = 0;
+        quint64 deferredFrames = 0; // 상한에 걸려 다음 프레임으로 넘긴 적
+        int     maxQueue = 0;
+        qint64  maxFrameMs = 0;
+    };
+
+    explicit ErrorBurstCoalescer(QObject *parent = nullptr);
+
+    void push(const LogEventPtr &event);
+    // 아직 넘기지 않은 묶음 버림 (화면을 통째로 다시 그릴 때)
+    void clear();
+
+    Stats stats() const { return m_stats; }
+    QString report() const;
+
+signals:
+    // 받는 쪽은 묶음 하나당 카드/이력/차트/브로드캐스트를 한 번씩만
+    void aggregateReady(const ErrorAggregate &aggregate);
+
+private slots:
+    void flush();
+
+private:
+    static QString keyOf(const LogEventPtr &event);
+
+    QTimer m_frameTimer;
+    QVector<ErrorAggregate> m_queue;        // 도착 순서
+    QHash<QString, int> m_queueIndex;       // 기기|코드 → m_queue 위치
+    Stats m_stats;
+};
+
+#endif // ERROR_BURST_COALESCER_H
@@ -0,0 +1,249 @@
+#include "journal_format.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+const char kMagic[4] = {'V', 'C', 'J', '1'};
+
+template <typename T>
+void put(uchar *dst, T value)
+{
+    qToLittleEndian<T>(value, dst);
+}
+
+template <typename T>
+T get(const uchar *src)
+{
+    return qFromLittleEndian<T>(src);
+}
+}
+
+namespace Journal {
+
+QByteArray encode(const Record &record)
+{
+    const int topicSize = qMin(record.topic.size(), 0xFFFF);
+    const quint32 total = kRecordHeaderSize + topicSize + record.payload.size();
+
+    QByteArray bytes(static_cast<int>(total), Qt::Uninitialized);
+    uchar *p = reinterpret_cast<uchar *>(bytes.data());
+    put<quint32>(p, total);
+    put<qint64>(p + 4, record.receivedAtMs);
+    p[12] = record.qos;
+    p[13] = record.retain ? 1 : 0;
+    put<quint16>(p + 14, static_cast<quint16>(topicSize));
+    put<quint32>(p + 16, static_cast<quint32>(record.payload.size()));
+    std::memcpy(p + kRecordHeaderSize, record.topic.constData(), topicSize);
+    std::memcpy(p + kRecordHeaderSize + topicSize, record.payload.constData(), record.payload.size());
+    return bytes;
+}
+
+QStringList segmentFiles(const QString &path, const QString &prefix)
+{
+    const QFileInfo info(path);
+    if (info.isFile()) return {info.absoluteFilePath()};
+
+    QStringList files;
+    const QDir dir(path);
+    for (const QString &name : dir.entryList({prefix + "_*.vcj"}, QDir::Files, QDir::Name)) {
+        files << dir.absoluteFilePath(name);
+    }
+    return files;
+}
+
+QString segmentFileName(qint64 createdAtMs, int sequence, const QString &prefix)
+{
+    // 이름순 = 시간순이 되도록 자릿수 고정
+    return QString("%1_%2_%3.vcj").arg(prefix).arg(createdAtMs, 13, 10, QChar('0')).arg(sequence, 5, 10, QChar('0'));
+}
+
+}
+
+/* ---------- 쓰기 ---------- */
+
+JournalSegmentWriter::~JournalSegmentWriter()
+{
+    close();
+}
+
+bool JournalSegmentWriter::open(const QString &path, qint64 capacity, qint64 createdAtMs)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite) || !m_file.resize(capacity)) {
+        qDebug() << "[Journal] 세그먼트 생성 실패:" << path << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    m_map = m_file.map(0, capacity);
+    if (!m_map) {
+        qDebug() << "[Journal] mmap 실패:" << path << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    std::memset(m_map, 0, Journal::kFileHeaderSize);
+    std::memcpy(m_map, kMagic, sizeof(kMagic));
+    put<quint32>(m_map + 4, Journal::kVersion);
+    put<qint64>(m_map + 8, createdAtMs);
+
+    m_capacity = capacity;
+    m_used = Journal::kFileHeaderSize;
+    return true;
+}
+
+bool JournalSegmentWriter::append(const QByteArray &encoded)
+{
+    // 끝 표시(크기 0) 4바이트는 항상 남겨둠
+    if (!m_map || m_used + encoded.size() + 4 > m_capacity) return false;
+
+    uchar *dst = m_map + m_used;
+    // 본문 먼저, 크기는 마지막 → 읽는 쪽은 크기가 써진 레코드만 봄
+    std::memcpy(dst + 4, encoded.constData() + 4, encoded.size() - 4);
+    std::memcpy(dst, encoded.constData(), 4);
+    m_used += encoded.size();
+    return true;
+}
+
+void JournalSegmentWriter::close()
+{
+    if (!m_map) return;
+
+    m_file.unmap(m_map);
+    m_map = nullptr;
+    // 미리 잡아둔 빈 공간은 돌려줌 (끝 표시 4바이트 포함)
+    m_file.resize(m_used + 4);
+    m_file.close();
+    m_capacity = 0;
+}
+
+/* ---------- 읽기 ---------- */
+
+JournalReader::JournalReader(const QString &path)
+{
+    if (!path.isEmpty()) open(path);
+}
+
+JournalReader::~JournalReader()
+{
+    unmap();
+}
+
+bool JournalReader::open(const QString &path, const QString &prefix)
+{
+    unmap();
+    m_segments = Journal::segmentFiles(path, prefix);
+    m_segmentIndex = -1;
+    if (m_segments.isEmpty()) {
+        qDebug() << "[Journal] 세그먼트 없음:" << path;
+        return false;
+    }
+    return mapSegment(0);
+}
+
+void JournalReader::unmap()
+{
+    if (m_map) m_file.unmap(m_map);
+    m_map = nullptr;
+    m_size = 0;
+    if (m_file.isOpen()) m_file.close();
+}
+
+bool JournalReader::mapSegment(int index)
+{
+    unmap();
+    m_segmentIndex = index;
+    m_offset = Journal::kFileHeaderSize;
+    if (index < 0 || index >= m_segments.size()) return false;
+
+    m_file.setFileName(m_segments.at(index));
+    if (!m_file.open(QIODevice::ReadOnly) || m_file.size() < Journal::kFileHeaderSize) {
+        qDebug() << "[Journal] 세그먼트 열기 실패:" << m_segments.at(index);
+        return false;
+    }
+    m_size = m_file.size();
+    m_map = m_file.map(0, m_size);
+    if (!m_map || std::memcmp(m_map, kMagic, sizeof(kMagic)) != 0) {
+        qDebug() << "[Journal] 저널 파일이 아님:" << m_segments.at(index);
+        unmap();
+        return false;
+    }
+    return true;
+}
+
+bool JournalReader::next(Journal::Record &record)
+{
+    while (m_segmentIndex < m_segments.size()) {
+        if (m_map && m_offset + Journal::kRecordHeaderSize <= m_size) {
+            const uchar *p = m_map + m_offset;
+            const quint32 total = get<quint32>(p);
+            if (total >= Journal::kRecordHeaderSize && m_offset + total <= m_size) {
+                const quint16 topicSize = get<quint16>(p + 14);
+                const quint32 payloadSize = get<quint32>(p + 16);
+                if (Journal::kRecordHeaderSize + topicSize + payloadSize == total) {
+                    record.receivedAtMs = get<qint64>(p + 4);
+                    record.qos = p[12];
+                    record.retain = (p[13] & 1) != 0;
+                    const char *data = reinterpret_cast<const char *>(p + Journal::kRecordHeaderSize);
+                    record.topic = QByteArray(data, topicSize);
+                    record.payload = QByteArray(data + topicSize, static_cast<int>(payloadSize));
+                    m_offset += total;
+                    return true;
+                }
+            }
+            // 크기 0(끝) 또는 망가진 레코드 → 이 세그먼트는 여기까지
+        }
+        if (m_segmentIndex + 1 >= m_segments.size()) {
+            m_segmentIndex = m_segments.size();
+            unmap();
+            return false;
+        }
+        mapSegment(m_segmentIndex + 1);
+    }
+    return false;
+}
+
+void JournalReader::rewind()
+{
+    if (!m_segments.isEmpty()) mapSegment(0);
+}
+
+qint64 JournalReader::segmentCreatedAt(const QString &path)
+{
+    // <prefix>_<ms>_<번호>.vcj
+    const QStringList parts = QFileInfo(path).completeBaseName().split('_');
+    return parts.size() >= 2 ? parts.at(1).toLongLong() : 0;
+}
+
+void JournalReader::seek(qint64 timestampMs)
+{
+    // 생성 시각이 목표 이하인 마지막 세그먼트부터 순차 탐색
+    int start = 0;
+    for (int i = 0; i < m_segments.size(); ++i) {
+        if (segmentCreatedAt(m_segments.at(i)) <= timestampMs) start = i;
+        else break;
+    }
+    mapSegment(start);
+
+    Journal::Record record;
+    Position before = position();
+    while (next(record)) {
+        if (record.receivedAtMs >= timestampMs) {
+            setPosition(before);
+            return;
+        }
+        before = position();
+    }
+}
+
+void JournalReader::setPosition(const Position &position)
+{
+    if (position.segment != m_segmentIndex || !m_map) mapSegment(position.segment);
+    m_offset = position.offset;
+}
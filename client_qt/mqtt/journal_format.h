@@ -0,0 +1,103 @@
+#ifndef JOURNAL_FORMAT_H
+#define JOURNAL_FORMAT_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+// MQTT 수신 기록(캡처 저널) 파일 형식 - 클라이언트(CaptureJournal), 재생 도구, 타임 트래블이 같이 씀
+//
+// 세그먼트 파일 <prefix>_<생성 ms>_<번호>.vcj, 미리 정해진 크기로 만들어 mmap 후 앞에서부터 채움
+//   헤더 32바이트: "VCJ1" | u32 버전 | i64 생성 시각(ms) | 예약
+//   레코드 (리틀 엔디언): u32 레코드 크기 | i64 수신 시각(ms) | u8 QoS | u8 플래그(1 = retain) | u16 토픽 길이
+//                         | u32 페이로드 길이 | 토픽(UTF-8) | 페이로드
+//   레코드 크기가 0이면 끝 - 본문을 먼저 쓰고 크기를 마지막에 쓰므로 도중에 죽어도 반쯤 쓴 레코드는 안 읽힘
+namespace Journal {
+
+constexpr int kFileHeaderSize = 32;
+constexpr int kRecordHeaderSize = 20;
+constexpr quint32 kVersion = 1;
+
+struct Record {
+    qint64     receivedAtMs = 0;
+    quint8     qos = 0;
+    bool       retain = false;
+    QByteArray topic;       // UTF-8 그대로 (재생할 때 필요한 것만 QString으로)
+    QByteArray payload;
+};
+
+// 레코드 하나를 파일에 쓰는 바이트열로
+QByteArray encode(const Record &record);
+
+// 폴더 안의 세그먼트 파일 (이름 = 생성 순서), 파일을 주면 그 파일 하나
+// prefix: 캡처 저널은 capture, 로컬 이력(LocalHistory)은 history - '_' 없이
+QStringList segmentFiles(const QString &path, const QString &prefix = QStringLiteral("capture"));
+
+QString segmentFileName(qint64 createdAtMs, int sequence, const QString &prefix = QStringLiteral("capture"));
+
+}
+
+// 세그먼트 하나를 mmap 해서 앞에서부터 채움 (한 스레드에서만 사용)
+class JournalSegmentWriter
+{
+public:
+    ~JournalSegmentWriter();
+
+    bool open(const QString &path, qint64 capacity, qint64 createdAtMs);
+    // 자리가 모자라면 false (호출한 쪽이 새 세그먼트로 넘김)
+    bool append(const QByteArray &encoded);
+    // 쓴 만큼만 남기고 파일 크기를 줄임
+    void close();
+
+    bool isOpen() const { return m_map != nullptr; }
+    qint64 used() const { return m_used; }
+    QString path() const { return m_file.fileName(); }
+
+private:
+    QFile m_file;
+    uchar *m_map = nullptr;
+    qint64 m_capacity = 0;
+    qint64 m_used = 0;
+};
+
+// 세그먼트들을 순서대로 읽음 (mmap, 읽기 전용)
+class JournalReader
+{
+public:
+    explicit JournalReader(const QString &path = QString());
+    ~JournalReader();
+
+    bool open(const QString &path, const QString &prefix = QStringLiteral("capture"));
+    bool isValid() const { return !m_segments.isEmpty(); }
+    QStringList segments() const { return m_segments; }
+
+    // 다음 레코드 (세그먼트 경계는 알아서 넘어감), 끝이면 false
+    bool next(Journal::Record &record);
+    // 처음부터 다시
+    void rewind();
+    // receivedAtMs >= timestampMs 인 첫 레코드 앞으로 (세그먼트 생성 시각으로 건너뛰고 그 안에서 순차 탐색)
+    void seek(qint64 timestampMs);
+
+    // 현재 읽는 위치 (세그먼트 번호, 바이트 오프셋) - 체크포인트에서 되돌아올 때
+    struct Position {
+        int segment = 0;
+        qint64 offset = Journal::kFileHeaderSize;
+    };
+    Position position() const { return {m_segmentIndex, m_offset}; }
+    void setPosition(const Position &position);
+
+private:
+    bool mapSegment(int index);
+    void unmap();
+    static qint64 segmentCreatedAt(const QString &path);
+
+    QStringList m_segments;
+    int m_segmentIndex = -1;
+    QFile m_file;
+    uchar *m_map = nullptr;
+    qint64 m_size = 0;
+    qint64 m_offset = 0;
+};
+
+#endif // JOURNAL_FORMAT_H
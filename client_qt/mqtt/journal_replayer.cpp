@@ -0,0 +1,105 @@
+#include "journal_replayer.h"
+#include "mqtt_hub.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <limits>
+
+namespace {
+const int kTickMs = 10;
+const int kMaxPerTick = 2000;      // 한 번에 이만큼만 넣고 이벤트 루프로 (화면이 멈추지 않게)
+const quint64 kReportEvery = 50000;
+}
+
+JournalReplayer::JournalReplayer(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setInterval(kTickMs);
+    connect(&m_timer, &QTimer::timeout, this, &JournalReplayer::onTick);
+}
+
+bool JournalReplayer::startFromEnvironment()
+{
+    const QString path = qEnvironmentVariable("VISIONCRAFT_REPLAY").trimmed();
+    if (path.isEmpty()) return false;
+
+    bool ok = false;
+    double speed = qEnvironmentVariable("VISIONCRAFT_REPLAY_SPEED").toDouble(&ok);
+    if (!ok || speed < 0) speed = 1.0;
+
+    MqttHub::instance()->setReplayMode(true);
+    auto *replayer = new JournalReplayer(QCoreApplication::instance());
+    connect(replayer, &JournalReplayer::finished, replayer, [replayer]() {
+        qDebug().noquote() << replayer->report();
+    });
+    // 창들이 구독을 다 등록한 뒤에 시작
+    QTimer::singleShot(1000, replayer, [replayer, path, speed]() { replayer->start(path, speed); });
+    qDebug() << "[JournalReplayer] 재생 모드 - 브로커 대신 저널:" << path << "배속" << speed;
+    return true;
+}
+
+bool JournalReplayer::start(const QString &path, double speed, qint64 fromMs)
+{
+    stop();
+    if (!m_reader.open(path)) return false;
+    if (fromMs > 0) m_reader.seek(fromMs);
+
+    m_speed = speed;
+    m_stats = Stats();
+    m_hasNext = m_reader.next(m_next);
+    m_firstAt = m_hasNext ? m_next.receivedAtMs : -1;
+    if (!m_hasNext) {
+        qDebug() << "[JournalReplayer] 재생할 메시지 없음:" << path;
+        emit finished();
+        return false;
+    }
+
+    qDebug() << "[JournalReplayer] 재생 시작: 세그먼트" << m_reader.segments().size() << "개, 배속" << speed;
+    m_wall.start();
+    m_timer.start();
+    return true;
+}
+
+void JournalReplayer::stop()
+{
+    m_timer.stop();
+    m_hasNext = false;
+}
+
+void JournalReplayer::onTick()
+{
+    MqttHub *hub = MqttHub::instance();
+    // 지금까지 재생됐어야 하는 기록 시각 (0배속이면 제한 없음)
+    const qint64 due = m_speed > 0 ? m_firstAt + static_cast<qint64>(m_wall.elapsed() * m_speed)
+                                   : std::numeric_limits<qint64>::max();
+
+    int injected = 0;
+    while (m_hasNext && m_next.receivedAtMs <= due && injected < kMaxPerTick) {
+        hub->inject(QString::fromUtf8(m_next.topic), m_next.payload, m_next.receivedAtMs);
+        m_stats.messages++;
+        m_stats.bytes += m_next.payload.size();
+        m_stats.recordedSpanMs = m_next.receivedAtMs - m_firstAt;
+        injected++;
+
+        if (m_stats.messages % kReportEvery == 0) {
+            qDebug().noquote() << report();
+        }
+        m_hasNext = m_reader.next(m_next);
+    }
+
+    if (!m_hasNext) {
+        m_timer.stop();
+        m_stats.wallMs = m_wall.elapsed();
+        emit finished();
+    }
+}
+
+QString JournalReplayer::report() const
+{
+    const qint64 wallMs = m_timer.isActive() ? m_wall.elapsed() : m_stats.wallMs;
+    const double seconds = qMax<qint64>(1, wallMs) / 1000.0;
+    return QString("[JournalReplayer] %1건 (%2 MB) 재생, 기록 구간 %3초를 %4초에 - %5건/s")
+        .arg(m_stats.messages).arg(m_stats.bytes / 1048576.0, 0, 'f', 1)
+        .arg(m_stats.recordedSpanMs / 1000.0, 0, 'f', 1).arg(seconds, 0, 'f', 1)
+        .arg(m_stats.messages / seconds, 0, 'f', 0);
+}
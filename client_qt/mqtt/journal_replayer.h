@@ -0,0 +1,54 @@
+#ifndef JOURNAL_REPLAYER_H
+#define JOURNAL_REPLAYER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "journal_format.h"
+
+// 캡처 저널을 클라이언트 안에서 재생 - 브로커 없이 MqttHub::inject 로 수신 경로에 그대로 흘림
+// - 속도 1이면 기록된 간격 그대로, N이면 N배, 0이면 최대 속도 (수신 처리 성능 측정)
+// - 켜기: VISIONCRAFT_REPLAY=<저널 폴더|세그먼트 파일>, VISIONCRAFT_REPLAY_SPEED=<배속>
+//   재생 중에는 MqttHub가 브로커에 붙지 않음 (명령 발행은 실패로 처리됨)
+class JournalReplayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 messages = 0;
+        quint64 bytes = 0;
+        qint64  wallMs = 0;         // 재생에 걸린 실제 시간
+        qint64  recordedSpanMs = 0; // 기록된 구간 길이
+    };
+
+    explicit JournalReplayer(QObject *parent = nullptr);
+
+    // 환경 변수가 있으면 재생 모드로 시작하고 true
+    static bool startFromEnvironment();
+
+    bool start(const QString &path, double speed, qint64 fromMs = 0);
+    void stop();
+    bool isRunning() const { return m_timer.isActive(); }
+
+    Stats stats() const { return m_stats; }
+    QString report() const;
+
+signals:
+    void finished();
+
+private slots:
+    void onTick();
+
+private:
+    JournalReader m_reader;
+    QTimer m_timer;
+    QElapsedTimer m_wall;
+    double m_speed = 1.0;
+    qint64 m_firstAt = -1;          // 첫 레코드 수신 시각
+    Journal::Record m_next;
+    bool m_hasNext = false;
+    Stats m_stats;
+};
+
+#endif // JOURNAL_REPLAYER_H
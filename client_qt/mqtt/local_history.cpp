@@ -0,0 +1,431 @@
+#include "local_history.h"
+#include "log_categories.h"
+#include "mqtt_hub.h"
+#include "response_pipeline.h"
+
+#include <QCoreApplication>
+#include <QDate>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <QDebug>
+#include <algorithm>
+#include <deque>
+#include <cstring>
+#include <limits>
+
+namespace {
+const qint64 kMegabyte = 1024 * 1024;
+const quint64 kReportEvery = 1000;
+const int kMaxSpeedPoints = 10;         // DeviceChart 점 수와 같게 (타임 트래블과 같은 기준)
+const int kLogHeaderSize = 1 + 4 + 2;   // u8 레벨 | u32 반복 건수 | u16 코드 길이
+const int kApplyChunkRows = 20000;      // 이벤트 루프 한 번에 LogStore에 넣는 복원 로그 수
+
+const char *kStatisticsFilter = "factory/+/msg/statistics";
+const char *kInfoLogFilter    = "factory/+/log/info";
+const QByteArray kLogTopicPrefix = QByteArrayLiteral("log/");
+
+// 오류 로그 한 건 → 레코드 (토픽 log/<device_id>, 수신 시각 자리에 로그 timestamp)
+Journal::Record encodeLog(const LogSnapshot::Row &row)
+{
+    const QByteArray code = row.logCode.toUtf8().left(0xFFFF);
+    const QByteArray message = row.message.toUtf8();
+
+    Journal::Record record;
+    record.receivedAtMs = row.timestamp;
+    record.topic = kLogTopicPrefix + row.deviceId.toUtf8();
+    record.payload = QByteArray(kLogHeaderSize + code.size() + message.size(), Qt::Uninitialized);
+
+    uchar *p = reinterpret_cast<uchar *>(record.payload.data());
+    p[0] = static_cast<quint8>(row.level);
+    qToLittleEndian<quint32>(static_cast<quint32>(qMax(1, row.repeatCount)), p + 1);
+    qToLittleEndian<quint16>(static_cast<quint16>(code.size()), p + 5);
+    std::memcpy(p + kLogHeaderSize, code.constData(), code.size());
+    std::memcpy(p + kLogHeaderSize + code.size(), message.constData(), message.size());
+    return record;
+}
+
+bool decodeLog(const Journal::Record &record, LogSnapshot::Row &row)
+{
+    const QByteArray &payload = record.payload;
+    if (payload.size() < kLogHeaderSize) return false;
+    const uchar *p = reinterpret_cast<const uchar *>(payload.constData());
+    const int codeSize = qFromLittleEndian<quint16>(p + 5);
+    if (payload.size() < kLogHeaderSize + codeSize) return false;
+
+    row.timestamp = record.receivedAtMs;
+    row.deviceId = QString::fromUtf8(record.topic.mid(kLogTopicPrefix.size()));
+    row.level = static_cast<LogLevel>(p[0]);
+    row.repeatCount = static_cast<int>(qFromLittleEndian<quint32>(p + 1));
+    row.logCode = QString::fromUtf8(payload.constData() + kLogHeaderSize, codeSize);
+    row.message = QString::fromUtf8(payload.constData() + kLogHeaderSize + codeSize,
+                                    payload.size() - kLogHeaderSize - codeSize);
+    return true;
+}
+}
+
+LocalHistory* LocalHistory::instance()
+{
+    static QPointer<LocalHistory> history;
+    if (!history) {
+        history = new LocalHistory(QCoreApplication::instance());
+    }
+    return history;
+}
+
+bool LocalHistory::isEnabled()
+{
+    return QSettings("VisionCraft", "client_qt").value("history/enabled", true).toBool();
+}
+
+LocalHistory::LocalHistory(QObject *parent)
+    : QObject(parent)
+{
+    QSettings settings("VisionCraft", "client_qt");
+    m_segmentBytes = qMax<qint64>(1, settings.value("history/segment_mb", 16).toLongLong()) * kMegabyte;
+    m_maxBytes = qMax<qint64>(m_segmentBytes, settings.value("history/max_mb", 512).toLongLong() * kMegabyte);
+
+    m_directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/history";
+    QDir().mkpath(m_directory);
+}
+
+LocalHistory::~LocalHistory()
+{
+    // 쓴 만큼만 남기고 세그먼트 크기를 줄임
+    m_writer.close();
+    if (m_active) qDebug().noquote() << report();
+}
+
+/* ---------- 같은 로그 판정 ---------- */
+
+bool LocalHistory::LogKeys::find(const QString &deviceId, const QString &logCode, qint64 timestamp, Key &key) const
+{
+    key.timestamp = timestamp;
+    key.device = m_devices.value(deviceId);
+    key.code = m_codes.value(logCode);
+    return key.device != 0 && key.code != 0;
+}
+
+bool LocalHistory::LogKeys::insert(const QString &deviceId, const QString &logCode, qint64 timestamp)
+{
+    Key key;
+    key.timestamp = timestamp;
+    key.device = m_devices.value(deviceId);
+    if (key.device == 0) key.device = *m_devices.insert(deviceId, static_cast<quint32>(m_devices.size() + 1));
+    key.code = m_codes.value(logCode);
+    if (key.code == 0) key.code = *m_codes.insert(logCode, static_cast<quint32>(m_codes.size() + 1));
+
+    const int before = m_keys.size();
+    m_keys.insert(key);
+    return m_keys.size() != before;
+}
+
+bool LocalHistory::LogKeys::contains(const QString &deviceId, const QString &logCode, qint64 timestamp) const
+{
+    Key key;
+    return find(deviceId, logCode, timestamp, key) && m_keys.contains(key);
+}
+
+void LocalHistory::LogKeys::remove(const QString &deviceId, const QString &logCode, qint64 timestamp)
+{
+    Key key;
+    if (find(deviceId, logCode, timestamp, key)) m_keys.remove(key);
+}
+
+void LocalHistory::LogKeys::clear()
+{
+    m_keys.clear();
+    m_devices.clear();
+    m_codes.clear();
+}
+
+/* ---------- 시작할 때 복원 ---------- */
+
+void LocalHistory::restore()
+{
+    if (m_active || m_restoring) return;
+    if (!isEnabled()) {
+        qDebug() << "[LocalHistory] 꺼져 있음 (history/enabled) - 서버에서 전부 받음";
+        emit restored(0, 0);
+        return;
+    }
+
+    m_restoring = true;
+    const QString directory = m_directory;
+    const int maxRows = LogStore::instance()->maxRows();
+    // 세그먼트를 훑는 건 워커에서, LogStore/화면 반영은 GUI 스레드에서
+    ResponsePipeline::instance()->run<Restored>(this,
+        [directory, maxRows]() { return scan(directory, maxRows); },
+        [this](const Restored &result) { apply(result); });
+}
+
+LocalHistory::Restored LocalHistory::scan(const QString &directory, int maxRows)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Restored result;
+    JournalReader reader;
+    if (!reader.open(directory, QStringLiteral("history"))) return result;
+
+    std::deque<LogSnapshot::Row> logs;
+    QHash<QByteArray, std::deque<Journal::Record>> speed;   // 토픽마다 최근 kMaxSpeedPoints개
+    QHash<QByteArray, Journal::Record> info;                // 토픽마다 마지막 하나
+
+    Journal::Record record;
+    while (reader.next(record)) {
+        result.scanned++;
+        if (record.topic.startsWith(kLogTopicPrefix)) {
+            LogSnapshot::Row row;
+            if (!decodeLog(record, row)) continue;
+            result.keys.insert(row.deviceId, row.logCode, row.timestamp);
+            result.lastLogAt = qMax(result.lastLogAt, row.timestamp);
+            logs.push_back(std::move(row));
+        } else if (record.topic.endsWith("/msg/statistics")) {
+            std::deque<Journal::Record> &points = speed[record.topic];
+            points.push_back(record);
+            if (static_cast<int>(points.size()) > kMaxSpeedPoints) points.pop_front();
+        } else {
+            info.insert(record.topic, record);
+        }
+    }
+
+    // 세그먼트 안에서는 받은 순서 (백필/차트 조회분은 과거 시각) → timestamp 순으로
+    std::stable_sort(logs.begin(), logs.end(),
+                     [](const LogSnapshot::Row &a, const LogSnapshot::Row &b) { return a.timestamp < b.timestamp; });
+    const int skip = qMax(0, static_cast<int>(logs.size()) - maxRows);
+    if (skip > 0) {
+        result.skippedFrom = logs.front().timestamp;
+        result.skippedTo = logs[skip - 1].timestamp;
+    }
+    result.logs.reserve(static_cast<int>(logs.size()) - skip);
+    for (auto it = logs.begin() + skip; it != logs.end(); ++it) result.logs.append(std::move(*it));
+
+    for (const auto &points : std::as_const(speed)) {
+        for (const Journal::Record &point : points) result.messages.append(point);
+    }
+    for (const Journal::Record &message : std::as_const(info)) result.messages.append(message);
+    std::stable_sort(result.messages.begin(), result.messages.end(),
+                     [](const Journal::Record &a, const Journal::Record &b) { return a.receivedAtMs < b.receivedAtMs; });
+
+    result.scanMs = timer.elapsed();
+    return result;
+}
+
+void LocalHistory::apply(const Restored &result)
+{
+    m_applyTimer.start();
+    m_keys = result.keys;
+
+    MqttHub *hub = MqttHub::instance();
+    m_injecting = true;
+    for (const Journal::Record &message : result.messages) {
+        hub->inject(QString::fromUtf8(message.topic), message.payload, message.receivedAtMs);
+    }
+    m_injecting = false;
+
+    m_stats.restoredLogs = result.logs.size();
+    m_stats.restoredStats = result.messages.size();
+    m_stats.scannedRecords = result.scanned;
+
+    // 여기부터 기록 (주입한 통계는 이미 로컬에 있음) - 로그를 LogStore에 넣는 동안 들어오는 것도 빠짐없이
+    m_active = true;
+    hub->subscribe(kStatisticsFilter, this, &LocalHistory::onMessage);
+    hub->subscribe(kInfoLogFilter, this, &LocalHistory::onMessage);
+
+    qDebug() << "[LocalHistory] 이력 읽음: 로그" << result.logs.size() << "건, 통계" << result.messages.size()
+             << "건 (레코드" << result.scanned << "건, 읽기" << result.scanMs << "ms), 마지막 로그"
+             << QDateTime::fromMSecsSinceEpoch(result.lastLogAt) << "- 로그는 나눠서 넣음";
+    emit scanned(static_cast<int>(result.logs.size()), result.lastLogAt);
+
+    // 로그 100만 건을 한 번에 넣으면 GUI 스레드가 수 초 멈춤 → 이벤트 루프를 돌려가며 조금씩
+    m_pending = std::make_shared<const Restored>(result);
+    m_pendingNext = 0;
+    applyLogs();
+}
+
+void LocalHistory::applyLogs()
+{
+    if (!m_pending) return;
+    const Restored &result = *m_pending;
+
+    LogStore *store = LogStore::instance();
+    const int end = qMin(m_pendingNext + kApplyChunkRows, static_cast<int>(result.logs.size()));
+    for (; m_pendingNext < end; ++m_pendingNext) {
+        const LogSnapshot::Row &row = result.logs[m_pendingNext];
+        if (m_storedWhileRestoring.contains(row.deviceId, row.logCode, row.timestamp)) continue;
+        store->append(row);
+    }
+    if (m_pendingNext < result.logs.size()) {
+        QMetaObject::invokeMethod(this, &LocalHistory::applyLogs, Qt::QueuedConnection);
+        return;
+    }
+
+    const std::shared_ptr<const Restored> done = std::move(m_pending);
+    m_pending.reset();
+    m_storedWhileRestoring.clear();
+    m_restoring = false;
+    m_stats.restoreMs = done->scanMs + m_applyTimer.elapsed();
+
+    qDebug() << "[LocalHistory] 복원: 로그" << done->logs.size() << "건 LogStore에 넣음 (읽기" << done->scanMs
+             << "ms, 읽기부터 끝까지" << m_stats.restoreMs << "ms)";
+    emit restored(static_cast<int>(done->logs.size()), done->lastLogAt);
+    if (done->skippedTo > 0) {
+        qDebug() << "[LocalHistory] LogStore 상한 - 오래된 로그를" << QDateTime::fromMSecsSinceEpoch(done->skippedTo)
+                 << "까지 건너뜀";
+        emit logsDropped(done->skippedFrom, done->skippedTo);
+    }
+}
+
+/* ---------- 기록 ---------- */
+
+void LocalHistory::recordLog(const QJsonObject &log)
+{
+    if (!m_active) return;
+
+    LogSnapshot::Row row;
+    row.timestamp = log.value("timestamp").toVariant().toLongLong();
+    row.deviceId = log.value("device_id").toString();
+    row.logCode = log.value("log_code").toString();
+    row.level = LogStore::levelFromString(log.value("log_level").toString());
+    row.repeatCount = qMax(1, log.value("repeat_count").toInt(1));
+    row.message = log.value("message").toString();
+    recordRow(row);
+}
+
+void LocalHistory::recordLogs(const QVector<LogRecord> &records)
+{
+    if (!m_active) return;
+
+    const quint64 before = m_stats.recordedLogs;
+    for (const LogRecord &record : records) {
+        LogSnapshot::Row row;
+        row.timestamp = record.timestamp;
+        row.deviceId = record.deviceId;
+        row.logCode = record.logCode;
+        row.level = LogStore::levelFromString(record.logLevel);
+        row.message = record.message;
+        recordRow(row);
+    }
+    qCDebug(lcQuery) << "[LocalHistory] 조회 결과" << records.size() << "건 중" << (m_stats.recordedLogs - before) << "건 새로 기록";
+}
+
+void LocalHistory::recordRow(const LogSnapshot::Row &row)
+{
+    // 시각 없는 로그는 다음 실행에서 구분할 수 없어서 남기지 않음
+    if (row.timestamp <= 0 || row.deviceId.isEmpty()) return;
+
+    if (!m_keys.insert(row.deviceId, row.logCode, row.timestamp)) {
+        m_stats.duplicates++;
+        // 복원 중이면 부른 쪽이 이미 LogStore에 넣음 → 복원 로그 중 같은 것은 건너뜀
+        if (m_pending) m_storedWhileRestoring.insert(row.deviceId, row.logCode, row.timestamp);
+        return;
+    }
+    write(encodeLog(row));
+
+    if (++m_stats.recordedLogs % kReportEvery == 0) {
+        qDebug().noquote() << report();
+    }
+}
+
+void LocalHistory::onMessage(const QByteArray &payload, const QMqttTopicName &topic)
+{
+    MqttHub *hub = MqttHub::instance();
+    if (m_injecting || hub->isReplayMode()) return;
+
+    Journal::Record record;
+    record.receivedAtMs = hub->messageTime();
+    record.topic = topic.name().toUtf8();
+    record.payload = payload;
+    write(record);
+    m_stats.recordedStats++;
+}
+
+void LocalHistory::write(const Journal::Record &record)
+{
+    const QByteArray encoded = Journal::encode(record);
+    if (!m_writer.isOpen() && !rotate()) return;
+    if (m_writer.append(encoded)) return;
+    // 세그먼트가 참
+    if (!rotate() || !m_writer.append(encoded)) {
+        qDebug() << "[LocalHistory] 기록 실패 (세그먼트보다 큰 레코드?):" << record.topic << encoded.size() << "bytes";
+    }
+}
+
+bool LocalHistory::rotate()
+{
+    m_writer.close();
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const QString path = m_directory + "/" + Journal::segmentFileName(now, m_sequence++, QStringLiteral("history"));
+    if (!m_writer.open(path, m_segmentBytes, now)) return false;
+
+    m_stats.segments++;
+    enforceCap();
+    return true;
+}
+
+void LocalHistory::enforceCap()
+{
+    QStringList files = Journal::segmentFiles(m_directory, QStringLiteral("history"));
+    qint64 total = 0;
+    for (const QString &file : std::as_const(files)) total += QFileInfo(file).size();
+
+    while (total > m_maxBytes && files.size() > 1) {
+        const QString oldest = files.takeFirst();
+        total -= QFileInfo(oldest).size();
+
+        // 지우기 전에 그 세그먼트의 로그 시각 범위 - 같은 로그를 다시 받으면 다시 기록되도록 키도 뺌
+        qint64 fromMs = std::numeric_limits<qint64>::max();
+        qint64 toMs = std::numeric_limits<qint64>::min();
+        {
+            // 지우기 전에 mmap을 닫아야 함 (Windows)
+            JournalReader reader;
+            Journal::Record record;
+            LogSnapshot::Row row;
+            if (reader.open(oldest, QStringLiteral("history"))) {
+                while (reader.next(record)) {
+                    if (!record.topic.startsWith(kLogTopicPrefix) || !decodeLog(record, row)) continue;
+                    m_keys.remove(row.deviceId, row.logCode, row.timestamp);
+                    fromMs = qMin(fromMs, row.timestamp);
+                    toMs = qMax(toMs, row.timestamp);
+                }
+            }
+        }
+
+        if (QFile::remove(oldest)) {
+            m_stats.deletedSegments++;
+            qDebug() << "[LocalHistory] 용량 상한 - 오래된 세그먼트 삭제:" << QFileInfo(oldest).fileName();
+            if (fromMs <= toMs) emit logsDropped(fromMs, toMs);
+        }
+    }
+}
+
+/* ---------- 차트 동기화 ---------- */
+
+void LocalHistory::markChartSynced()
+{
+    if (!m_active) return;
+    QSettings("VisionCraft", "client_qt").setValue("history/chart_synced_year", QDate::currentDate().year());
+}
+
+bool LocalHistory::isChartSynced() const
+{
+    // 로컬 이력이 비어 있으면 (지웠거나 처음) 설정이 남아 있어도 다시 받음
+    if (!m_active || m_stats.restoredLogs == 0) return false;
+    return QSettings("VisionCraft", "client_qt").value("history/chart_synced_year", 0).toInt() == QDate::currentDate().year();
+}
+
+QString LocalHistory::report() const
+{
+    return QString("[LocalHistory] 복원 로그 %1건/통계 %2건 (%3 ms), 기록 로그 %4건/통계 %5건, 중복 %6건, "
+                   "세그먼트 %7개 (삭제 %8) - %9")
+        .arg(m_stats.restoredLogs).arg(m_stats.restoredStats).arg(m_stats.restoreMs)
+        .arg(m_stats.recordedLogs).arg(m_stats.recordedStats).arg(m_stats.duplicates)
+        .arg(m_stats.segments).arg(m_stats.deletedSegments).arg(m_directory);
+}
@@ -0,0 +1,150 @@
+#ifndef LOCAL_HISTORY_H
+#define LOCAL_HISTORY_H
+
+#include <QObject>
+#include <QSet>
+#include <QHash>
+#include <QVector>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QtMqtt/QMqttTopicName>
+#include <memory>
+#include "journal_format.h"
+#include "log_store.h"
+#include "query_response_decoder.h"
+
+// 로그/통계 로컬 이력 - 재시작해도 화면을 로컬 데이터로 먼저 그리고 서버에서는 빠진 구간만 받음
+// - 캡처 저널과 같은 세그먼트 형식(history_*.vcj), 실행할 때마다 새 세그먼트를 mmap 해서 이어 씀
+//   * 오류 로그: 토픽 log/<device_id>, 수신 시각 = 로그 timestamp, 페이로드는 열 값 이진 인코딩
+//   * 속도 통계/정보 로그(불량률): 받은 MQTT 메시지 그대로 (factory/+/msg/statistics, factory/+/log/info)
+// - 시작할 때 restore(): 워커에서 세그먼트를 mmap 으로 훑고, 통계는 토픽마다 최근 것만 MqttHub::inject
+//   → 화면은 실시간 때와 같은 경로로 그려짐, 여기서 scanned() (브로커 연결은 이때부터 가능)
+//   로그는 GUI 스레드를 오래 막지 않도록 이벤트 루프를 돌려가며 조금씩 LogStore에 넣고 다 넣으면 restored()
+// - 같은 로그(기기, 코드, timestamp)는 한 번만 기록 (백필/차트 조회로 다시 받아도)
+// - 설정: history/enabled(기본 켜짐), history/segment_mb(16), history/max_mb(512, 넘으면 오래된 세그먼트 삭제)
+//   재생/타임 트래블 모드에서는 쓰지 않음
+// - 로그가 로컬에서 빠지면 (오래된 세그먼트 삭제, 복원 때 LogStore 상한으로 건너뜀) logsDropped()로 그 시간대를 알림
+class LocalHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 restoredLogs = 0;
+        quint64 restoredStats = 0;
+        quint64 scannedRecords = 0;
+        qint64  restoreMs = 0;
+        quint64 recordedLogs = 0;
+        quint64 recordedStats = 0;
+        quint64 duplicates = 0;     // 이미 있는 로그라 건너뜀
+        quint64 segments = 0;
+        quint64 deletedSegments = 0;
+    };
+
+    static LocalHistory* instance();
+    static bool isEnabled();
+    ~LocalHistory() override;
+
+    // 로컬 이력을 읽어 LogStore/화면에 반영한 뒤 restored() - 끝난 뒤부터 기록 시작
+    void restore();
+    bool isActive() const { return m_active; }
+    bool isRestoring() const { return m_restoring; }
+
+    // 로그 한 건 (Home::addErrorLog), 차트 조회 결과 (Home::processChartDataResponse)
+    void recordLog(const QJsonObject &log);
+    void recordLogs(const QVector<LogRecord> &records);
+
+    // 올해 차트 데이터를 서버에서 한 번 받아 로컬에 다 있음 → 다음 실행부터 차트 전체 조회 생략
+    void markChartSynced();
+    bool isChartSynced() const;
+
+    QString directory() const { return m_directory; }
+    Stats stats() const { return m_stats; }
+    QString report() const;
+
+signals:
+    // 이력을 다 읽고 통계를 주입함, 기록 시작 - 로그는 아직 LogStore에 넣는 중 (logCount: 넣을 로그 수)
+    // lastLogAt: 로컬에 있는 가장 최근 로그 시각, 없으면 0
+    void scanned(int logCount, qint64 lastLogAt);
+    // 복원한 로그를 LogStore에 다 넣음
+    void restored(int logCount, qint64 lastLogAt);
+    // 이 시간대의 로그 일부가 더 이상 LogStore/로컬 이력에 없음 (복원 직후에는 restored() 다음에)
+    void logsDropped(qint64 fromMs, qint64 toMs);
+
+private:
+    explicit LocalHistory(QObject *parent = nullptr);
+
+    // 같은 로그 판정 - 기기/코드를 문자열 번호로 바꿔 (기기, 코드, timestamp) 전체를 비교
+    // (해시 값만 비교하면 충돌한 다른 로그를 중복으로 보고 버림)
+    class LogKeys
+    {
+    public:
+        bool insert(const QString &deviceId, const QString &logCode, qint64 timestamp);    // 새 로그면 true
+        bool contains(const QString &deviceId, const QString &logCode, qint64 timestamp) const;
+        void remove(const QString &deviceId, const QString &logCode, qint64 timestamp);
+        void clear();
+        int size() const { return m_keys.size(); }
+
+    private:
+        struct Key {
+            qint64  timestamp = 0;
+            quint32 device = 0;
+            quint32 code = 0;
+
+            bool operator==(const Key &other) const
+            {
+                return timestamp == other.timestamp && device == other.device && code == other.code;
+            }
+            friend size_t qHash(const Key &key, size_t seed = 0)
+            {
+                return qHashMulti(seed, key.timestamp, key.device, key.code);
+            }
+        };
+
+        bool find(const QString &deviceId, const QString &logCode, qint64 timestamp, Key &key) const;
+
+        QHash<QString, quint32> m_devices;      // 0번은 쓰지 않음
+        QHash<QString, quint32> m_codes;
+        QSet<Key> m_keys;
+    };
+
+    struct Restored {
+        QVector<LogSnapshot::Row> logs;         // 오래된 것부터
+        QVector<Journal::Record> messages;      // 통계 메시지, 오래된 것부터
+        LogKeys keys;
+        qint64 lastLogAt = 0;
+        qint64 skippedFrom = 0;                 // LogStore 상한으로 건너뛴 오래된 로그의 시각 범위 (없으면 0)
+        qint64 skippedTo = 0;
+        quint64 scanned = 0;
+        qint64 scanMs = 0;
+    };
+
+    static Restored scan(const QString &directory, int maxRows);
+
+    void apply(const Restored &result);
+    void applyLogs();
+    void recordRow(const LogSnapshot::Row &row);
+    void onMessage(const QByteArray &payload, const QMqttTopicName &topic);
+    void write(const Journal::Record &record);
+    bool rotate();
+    void enforceCap();
+
+    QString m_directory;
+    qint64 m_segmentBytes = 0;
+    qint64 m_maxBytes = 0;
+    int m_sequence = 0;
+
+    JournalSegmentWriter m_writer;      // GUI 스레드에서만 (로그/통계는 초당 몇 건이라 mmap 복사로 충분)
+    LogKeys m_keys;
+    std::shared_ptr<const Restored> m_pending;  // LogStore에 넣는 중인 복원 결과
+    int m_pendingNext = 0;
+    LogKeys m_storedWhileRestoring;     // 복원 중 실시간/조회로 이미 LogStore에 들어간 복원 대상 로그 (다시 넣지 않음)
+    QElapsedTimer m_applyTimer;
+    bool m_active = false;
+    bool m_restoring = false;
+    bool m_injecting = false;           // 복원한 통계를 주입하는 중 (다시 기록하지 않음)
+
+    Stats m_stats;
+};
+
+#endif // LOCAL_HISTORY_H
@@ -0,0 +1,5 @@
+#include "log_categories.h"
+
+// debug는 꺼진 채로 시작 (info 이상만)
+Q_LOGGING_CATEGORY(lcLive, "visioncraft.live", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcQuery, "visioncraft.query", QtInfoMsg)
@@ -0,0 +1,12 @@
+#ifndef LOG_CATEGORIES_H
+#define LOG_CATEGORIES_H
+
+#include <QLoggingCategory>
+
+// 메시지/쿼리 한 건마다 찍는 로그 - GUI 스레드에서 초당 수십~수백 번 불리므로 기본은 꺼둠
+// 필요할 때만: QT_LOGGING_RULES="visioncraft.live.debug=true;visioncraft.query.debug=true"
+// 주기 보고(report)와 실패/경고는 그대로 qDebug/qWarning
+Q_DECLARE_LOGGING_CATEGORY(lcLive)      // 실시간 로그 수신, 상태 변경, 중복, 오류 묶음
+Q_DECLARE_LOGGING_CATEGORY(lcQuery)     // 검색, 페이지, 쿼리 전송/취소
+
+#endif // LOG_CATEGORIES_H
@@ -0,0 +1,270 @@
+#include "log_pager.h"
+#include "log_categories.h"
+#include "mqtt_hub.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const int kPageTimeoutMs = 15000;
+}
+
+LogPager::LogPager(const QString &deviceId, QObject *parent)
+    : QObject(parent)
+    , m_deviceId(deviceId)
+    , m_supersedeKey(QString("pager/%1/%2").arg(deviceId.isEmpty() ? "all" : deviceId)
+                         .arg(reinterpret_cast<quintptr>(this), 0, 16))
+{
+}
+
+void LogPager::setEnabled(bool enabled)
+{
+    // 목록 내용이 바뀜 → 진행 중/미리 받은 페이지는 더 이상 맞지 않음
+    m_generation++;
+    m_inFlight.cancel();
+    m_inFlight = QueryHandle();
+    m_inFlightBefore = -1;
+    m_wanted = false;
+    if (m_prefetched.valid) m_stats.discarded++;
+    m_prefetched = Page();
+    m_exhaustedBefore = -1;
+    m_byOffset = false;
+    m_offsetNext = Cursor();
+
+    if (m_enabled != enabled) {
+        m_enabled = enabled;
+        qDebug() << "[LogPager]" << (m_deviceId.isEmpty() ? "all" : m_deviceId) << (enabled ? "켜짐" : "꺼짐");
+    }
+}
+
+QStringList LogPager::keysOf(const QJsonObject &row)
+{
+    QStringList keys;
+    const QString id = row["_id"].toString();
+    if (!id.isEmpty()) keys << id;
+    keys << QString("%1|%2|%3").arg(row["device_id"].toString(), row["log_code"].toString())
+                               .arg(row["timestamp"].toVariant().toLongLong());
+    return keys;
+}
+
+void LogPager::sortNewestFirst(QList<QJsonObject> &rows)
+{
+    std::stable_sort(rows.begin(), rows.end(), [](const QJsonObject &a, const QJsonObject &b) {
+        const qint64 ta = a["timestamp"].toVariant().toLongLong();
+        const qint64 tb = b["timestamp"].toVariant().toLongLong();
+        if (ta != tb) return ta > tb;
+        return a["_id"].toString() > b["_id"].toString();
+    });
+}
+
+bool LogPager::isNewestFirst(const QList<QJsonObject> &rows)
+{
+    for (int i = 1; i < rows.size(); ++i) {
+        if (rows[i]["timestamp"].toVariant().toLongLong() > rows[i - 1]["timestamp"].toVariant().toLongLong()) return false;
+    }
+    return true;
+}
+
+void LogPager::fetchOlder(const QList<QJsonObject> &boundaryRows)
+{
+    if (!m_enabled) return;
+
+    Cursor cursor;
+    if (m_byOffset) {
+        // offset 페이지는 목록 끝이 아니라 받은 만큼을 기준으로
+        cursor = m_offsetNext;
+    } else {
+        cursor.before = boundaryRows.isEmpty() ? QDateTime::currentMSecsSinceEpoch()
+                                               : boundaryRows.first()["timestamp"].toVariant().toLongLong();
+        for (const QJsonObject &row : boundaryRows) {
+            for (const QString &key : keysOf(row)) cursor.seen.insert(key);
+        }
+    }
+    if (cursor.before <= 0 || cursor.before == m_exhaustedBefore) return;
+
+    // 미리 받아 둔 페이지가 지금 목록 끝에 이어지면 바로 넘김
+    if (m_prefetched.valid && m_prefetched.cursor.before == cursor.before
+        && (!cursor.byOffset || m_prefetched.cursor.offset == cursor.offset)) {
+        Page page = m_prefetched;
+        m_prefetched = Page();
+        // 그 사이 실시간/백필로 같은 timestamp 행이 목록에 더 들어왔을 수 있어 목록 기준으로 다시 거름
+        QList<QJsonObject> rows;
+        rows.reserve(page.rows.size());
+        for (const QJsonObject &row : page.rows) {
+            bool seen = false;
+            if (row["timestamp"].toVariant().toLongLong() == cursor.before) {
+                for (const QString &key : keysOf(row)) seen = seen || cursor.seen.contains(key);
+            }
+            if (!seen) rows.append(row);
+        }
+        page.rows = rows;
+        m_stats.prefetchHits++;
+        deliver(page);
+        return;
+    }
+
+    if (m_prefetched.valid) {
+        qCDebug(lcQuery) << "[LogPager] 기준점이 바뀌어 미리 받은 페이지 버림:" << m_prefetched.cursor.before << "→" << cursor.before;
+        m_stats.discarded++;
+        m_prefetched = Page();
+    }
+
+    // 같은 기준점으로 받는 중 (미리 받기 포함) → 도착하면 바로 넘기도록만
+    if (m_inFlight.isPending() && m_inFlightBefore == cursor.before) {
+        m_wanted = true;
+        return;
+    }
+
+    m_generation++;
+    request(cursor, true);
+}
+
+void LogPager::request(const Cursor &cursor, bool wanted)
+{
+    if (!MqttHub::instance()->isConnected()) {
+        qDebug() << "[LogPager] MQTT 연결 안 됨 - 이전 로그 요청 건너뜀";
+        return;
+    }
+
+    QJsonObject filters;
+    filters["log_level"] = "error";
+    if (!m_deviceId.isEmpty()) filters["device_id"] = m_deviceId;
+    QJsonObject timeRange;
+    timeRange["start"] = 0;
+    timeRange["end"] = cursor.before;
+    filters["time_range"] = timeRange;
+    filters["limit"] = kPageSize;
+    filters["offset"] = cursor.offset;
+
+    LogShape shape;
+    shape.deviceId = m_deviceId;
+    shape.logLevel = "error";
+    shape.endMs = cursor.before;
+
+    QueryEngine::Request query;
+    query.queryType = "logs";
+    query.tag = "pager";
+    query.supersedeKey = m_supersedeKey;
+    query.filters = filters;
+    query.timeoutMs = kPageTimeoutMs;
+    query.prepare = [shape](const QString &queryId) {
+        ResponsePipeline::instance()->expectLogQuery(queryId, shape);
+    };
+
+    const int generation = m_generation;
+    m_inFlight = QueryEngine::instance()->send(query, this,
+        [this, generation, cursor](const QueryResult &result) {
+            if (generation != m_generation) return;
+            LogBatch batch;
+            if (result.outcome == QueryResult::TimedOut) {
+                batch.status = result.status;
+                batch.error = result.error;
+            } else {
+                batch = result.value<LogBatch>();
+            }
+            onPage(cursor, batch);
+        });
+    m_inFlightBefore = cursor.before;
+    m_wanted = wanted;
+
+    qCDebug(lcQuery) << "[LogPager]" << (wanted ? "이전 페이지 요청" : "다음 페이지 미리 받기")
+                     << "before:" << cursor.before << "offset:" << cursor.offset << "query:" << m_inFlight.id();
+}
+
+void LogPager::onPage(const Cursor &cursor, const LogBatch &batch)
+{
+    const bool wanted = m_wanted;
+    m_inFlight = QueryHandle();
+    m_inFlightBefore = -1;
+    m_wanted = false;
+
+    if (!batch.isSuccess()) {
+        // 다음 스크롤 때 다시 요청됨
+        qWarning() << "[LogPager] 이전 로그 페이지 실패:" << batch.status << batch.error;
+        return;
+    }
+    if (batch.receivedRows > 0 && batch.rows.isEmpty()) {
+        // 서버가 보낸 행이 조건(기기/레벨/기준 시각)에 하나도 안 맞음 - 요청과 다른 응답이라 건너뛰면 행을 잃음
+        qWarning() << "[LogPager] 이전 로그 페이지 오류: 받은" << batch.receivedRows << "행이 모두 조건 밖 - before:"
+                   << cursor.before << "offset:" << cursor.offset;
+        return;
+    }
+
+    Page page;
+    page.valid = true;
+    page.cursor = cursor;
+    if (!cursor.byOffset && batch.receivedRows >= kPageSize && !isNewestFirst(batch.rows)) {
+        // 꽉 찬 페이지가 최신순이 아님 → 이 페이지가 기준점 아래 최신 500행이라는 보장이 없음
+        // 같은 기준점의 offset 페이지로 보면 이 페이지도 그대로 쓸 수 있음
+        page.cursor.byOffset = true;
+        m_byOffset = true;
+        qWarning() << "[LogPager] 서버 응답이 최신순이 아님 - before" << cursor.before << "에 고정하고 offset 페이지로 바꿈";
+    }
+    page.last = batch.receivedRows < kPageSize;
+    page.rows.reserve(batch.rows.size());
+    for (const QJsonObject &row : batch.rows) {
+        const qint64 ts = row["timestamp"].toVariant().toLongLong();
+        if (ts <= 0 || ts > cursor.before) continue;
+        if (ts == cursor.before) {
+            bool seen = false;
+            for (const QString &key : keysOf(row)) seen = seen || cursor.seen.contains(key);
+            if (seen) continue;
+        }
+        page.rows.append(row);
+    }
+    sortNewestFirst(page.rows);
+    m_stats.pages++;
+
+    if (wanted) {
+        deliver(page);
+    } else {
+        m_prefetched = page;
+        qCDebug(lcQuery) << "[LogPager] 미리 받음:" << page.rows.size() << "행" << (page.last ? "(마지막)" : "");
+    }
+}
+
+void LogPager::deliver(const Page &page)
+{
+    if (!page.rows.isEmpty()) {
+        m_stats.rows += page.rows.size();
+        emit pageReady(page.rows);
+    }
+
+    if (page.last) {
+        m_exhaustedBefore = page.rows.isEmpty() || page.cursor.byOffset
+                                ? page.cursor.before
+                                : page.rows.last()["timestamp"].toVariant().toLongLong();
+        qDebug() << "[LogPager] 더 이전 로그 없음 - 페이지" << m_stats.pages << "개,"
+                 << m_stats.rows << "행, 미리 받기 적중" << m_stats.prefetchHits << "/ 버림" << m_stats.discarded;
+        emit exhausted();
+        return;
+    }
+
+    // 넘긴 게 없으면 (같은 ms에 몰려 전부 이미 보인 행) 목록 끝이 그대로라 바로 이어서 받음
+    const Cursor next = nextCursor(page);
+    if (next.byOffset) m_offsetNext = next;
+    request(next, page.rows.isEmpty());
+}
+
+LogPager::Cursor LogPager::nextCursor(const Page &page)
+{
+    Cursor next;
+    if (page.rows.isEmpty() || page.cursor.byOffset) {
+        next = page.cursor;
+        next.offset += kPageSize;
+        return next;
+    }
+
+    next.before = page.rows.last()["timestamp"].toVariant().toLongLong();
+    if (next.before == page.cursor.before) {
+        // 페이지 전체가 기준 timestamp 한 ms 안 → 그 안에서 offset으로 넘김
+        next.seen = page.cursor.seen;
+        next.offset = page.cursor.offset + kPageSize;
+    }
+    for (auto it = page.rows.crbegin(); it != page.rows.crend(); ++it) {
+        if ((*it)["timestamp"].toVariant().toLongLong() != next.before) break;
+        for (const QString &key : keysOf(*it)) next.seen.insert(key);
+    }
+    return next;
+}
@@ -0,0 +1,94 @@
+#ifndef LOG_PAGER_H
+#define LOG_PAGER_H
+
+#include <QObject>
+#include <QSet>
+#include <QList>
+#include <QJsonObject>
+#include "query_engine.h"
+#include "response_pipeline.h"
+
+// 오류 로그 목록 무한 스크롤 - 목록 맨 아래(가장 오래된 로그)보다 이전 페이지를 받음
+// - 키셋 페이지: (timestamp, _id) 기준점보다 오래된 것 - offset으로 건너뛰지 않아 깊이 내려가도 응답 크기가 같음
+//   서버는 time_range만 알아서 end = 기준 timestamp 로 보내고, 같은 timestamp에서 이미 보인 행(_id 또는 기기·코드)은 여기서 거름
+//   같은 ms에 한 페이지보다 많이 몰린 경우만 그 timestamp 안에서 offset
+// - 서버가 최신순으로 주지 않으면(꽉 찬 페이지 안 순서가 뒤섞임) 키셋이 행을 건너뛰므로
+//   그 기준점에 고정하고 offset 페이지로 바꿈 - 이때 페이지끼리는 시각 순서가 보장되지 않아 받는 쪽이 끼워 넣음
+// - 한 페이지를 넘겨주면 바로 다음 페이지를 뒤에서 미리 받아 둠 → 다음 스크롤은 기다리지 않음
+// - 목록이 바뀌어(검색/다시 불러오기) 기준점이 달라지면 미리 받은 페이지는 버림
+class LogPager : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 pages = 0;
+        quint64 rows = 0;
+        quint64 prefetchHits = 0;   // 미리 받아 둔 페이지로 바로 넘김
+        quint64 discarded = 0;      // 기준점이 바뀌어 버린 미리 받은 페이지
+    };
+
+    // deviceId가 비어있으면 모든 기기
+    explicit LogPager(const QString &deviceId, QObject *parent = nullptr);
+
+    // 목록이 검색 결과 등 다른 내용일 때는 끔 (미리 받은 페이지도 버림)
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // 목록 맨 아래 timestamp의 행들 (ErrorLogModel::oldestRows) 보다 이전 페이지 → pageReady
+    void fetchOlder(const QList<QJsonObject> &boundaryRows);
+
+    Stats stats() const { return m_stats; }
+
+    struct Cursor {
+        qint64 before = 0;          // 이 timestamp 이하
+        QSet<QString> seen;         // before와 같은 timestamp에서 이미 보인 행
+        int offset = 0;             // before 안에서 건너뛸 행 (같은 ms에 한 페이지보다 많을 때, offset 페이지일 때)
+        bool byOffset = false;      // before에 고정하고 offset으로 넘기는 페이지 (서버 응답이 정렬되지 않음)
+    };
+
+    struct Page {
+        bool valid = false;
+        bool last = false;          // 서버가 페이지보다 적게 줌
+        Cursor cursor;              // 이 페이지를 요청한 기준점
+        QList<QJsonObject> rows;    // (timestamp, _id) 내림차순
+    };
+
+    static constexpr int kPageSize = 500;
+
+    // 서버가 정렬을 보장하지 않음 → (timestamp, _id) 내림차순으로 맞춤
+    static void sortNewestFirst(QList<QJsonObject> &rows);
+    // 정렬된 페이지의 가장 오래된 timestamp 다음 기준점
+    static Cursor nextCursor(const Page &page);
+    static QStringList keysOf(const QJsonObject &row);
+    // 서버가 보낸 순서가 timestamp 내림차순인지
+    static bool isNewestFirst(const QList<QJsonObject> &rows);
+
+signals:
+    // 최신순 - 보통은 목록 맨 아래에 그대로 이어지지만 offset 페이지면 목록 중간에 들어갈 행도 있음 (ErrorLogModel::mergeLogs)
+    void pageReady(const QList<QJsonObject> &rows);
+    // 더 이전 로그가 없음
+    void exhausted();
+
+private:
+    void request(const Cursor &cursor, bool wanted);
+    void onPage(const Cursor &cursor, const LogBatch &batch);
+    void deliver(const Page &page);
+
+    QString m_deviceId;
+    QString m_supersedeKey;
+    bool m_enabled = true;
+    qint64 m_exhaustedBefore = -1;  // 이 기준점에서 더 없음을 확인함
+    int m_generation = 0;           // setEnabled/기준점 변경 때 늘려 늦은 응답을 버림
+
+    QueryHandle m_inFlight;
+    qint64 m_inFlightBefore = -1;
+    bool m_wanted = false;          // 받는 중인 페이지를 도착하자마자 넘길지 (미리 받기면 false)
+    Page m_prefetched;
+    bool m_byOffset = false;        // 정렬되지 않은 응답을 봐서 offset 페이지로 바꿈 (setEnabled 때 되돌림)
+    Cursor m_offsetNext;            // offset 페이지일 때 다음 요청 기준점
+
+    Stats m_stats;
+};
+
+#endif // LOG_PAGER_H
@@ -0,0 +1,511 @@
+#include "log_query_planner.h"
+#include "log_categories.h"
+#include "mqtt_hub.h"
+#include "local_history.h"
+#include "log_store.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QSaveFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const int kPageSize = 500;
+const int kMaxPagesPerSlice = 40;           // 하루 20,000행까지
+const int kMaxInFlight = 4;                 // 한 검색에서 동시에 받는 구간 수
+const qint64 kSliceMs = 24LL * 60 * 60 * 1000;
+const qint64 kLiveMarginMs = 60 * 1000;     // 이보다 최근은 로그가 더 올 수 있어 덮인 것으로 치지 않음
+const int kFlushIntervalMs = 100;
+const int kReportEvery = 20;                // 검색 20건마다 누적 보고
+const int kPageTimeoutMs = 15000;
+const int kMaxResultRows = 100000;          // ErrorLogModel 기본 보관 수와 같게
+const char *kAllDevicesScope = "*";         // coverage.json에서 모든 기기 범위("")의 키
+
+quint64 logKey(const QString &deviceId, const QString &logCode, qint64 timestamp)
+{
+    return static_cast<quint64>(qHashMulti(0, deviceId, logCode, timestamp));
+}
+
+LogQuery storeQuery(const QString &deviceId, qint64 startMs, qint64 endMs)
+{
+    LogQuery query;
+    if (!deviceId.isEmpty()) query.deviceIds = {deviceId};
+    query.level = LogLevel::Error;
+    query.startMs = startMs;
+    query.endMs = endMs;
+    return query;
+}
+
+QString coveragePath()
+{
+    return LocalHistory::instance()->directory() + "/coverage.json";
+}
+}
+
+LogQueryPlanner* LogQueryPlanner::instance()
+{
+    static QPointer<LogQueryPlanner> planner;
+    if (!planner) {
+        planner = new LogQueryPlanner(QCoreApplication::instance());
+    }
+    return planner;
+}
+
+LogQueryPlanner::LogQueryPlanner(QObject *parent)
+    : QObject(parent)
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogQueryPlanner::flush);
+
+    // 덮인 구간은 LogStore에 로그가 있다는 뜻 - 로컬에서 빠지는 시간대는 다시 서버에서
+    LocalHistory *history = LocalHistory::instance();
+    connect(history, &LocalHistory::restored, this, &LogQueryPlanner::loadCoverage);
+    connect(history, &LocalHistory::logsDropped, this, &LogQueryPlanner::onLogsDropped);
+    connect(LogStore::instance(), &LogStore::evicted, this, &LogQueryPlanner::onLogsDropped);
+    if (history->isActive() && !history->isRestoring()) loadCoverage();
+}
+
+/* ---------- 검색 ---------- */
+
+int LogQueryPlanner::search(const LogSearchRequest &request, QObject *context, UpdateCallback onUpdate)
+{
+    cancel(request.owner);
+
+    auto search = std::make_shared<Search>();
+    search->id = m_nextId++;
+    search->request = request;
+    search->context = context;
+    search->onUpdate = std::move(onUpdate);
+    search->progress.searchId = search->id;
+    search->timer.start();
+    m_stats.searches++;
+
+    const Interval wanted{request.startMs, request.endMs};
+    const QVector<Interval> missing = gaps(request.deviceId, wanted);
+    qint64 missingMs = 0;
+    for (const Interval &gap : missing) {
+        missingMs += gap.end - gap.start + 1;
+        // 하루 단위로 잘라서 여러 구간을 동시에
+        for (qint64 start = gap.start; start <= gap.end; start += kSliceMs) {
+            search->waiting.append({start, qMin(gap.end, start + kSliceMs - 1)});
+        }
+    }
+    search->progress.cachedMs = (wanted.end - wanted.start + 1) - missingMs;
+    search->progress.fetchSlices = search->waiting.size();
+
+    const int id = search->id;
+    m_searches.insert(id, search);
+    if (!request.owner.isEmpty()) m_ownerSearch.insert(request.owner, id);
+
+    qCDebug(lcQuery) << "[LogQueryPlanner] 검색 #" << id << request.owner << request.deviceId << request.logCode
+                     << QDateTime::fromMSecsSinceEpoch(request.startMs).toString("yyyy-MM-dd hh:mm") << "~"
+                     << QDateTime::fromMSecsSinceEpoch(request.endMs).toString("yyyy-MM-dd hh:mm")
+                     << "- 로컬" << search->progress.cachedMs / 1000 << "초 분량, 서버 구간" << search->waiting.size() << "개";
+
+    if (search->waiting.isEmpty()) {
+        m_stats.localOnly++;
+        finish(id);
+        return id;
+    }
+    if (!MqttHub::instance()->isConnected()) {
+        // 연결이 없으면 로컬에 있는 만큼만
+        search->progress.failedSlices = search->waiting.size();
+        m_stats.failedSlices += search->waiting.size();
+        search->waiting.clear();
+        finish(id);
+        return id;
+    }
+
+    // 로컬에 있는 부분은 서버 응답을 기다리지 않고 먼저 (덮인 구간이 없어도 실시간으로 받은 로그가 있을 수 있음)
+    deliver(*search);
+    pump(*search);
+    return id;
+}
+
+void LogQueryPlanner::cancel(const QString &owner)
+{
+    if (owner.isEmpty() || !m_ownerSearch.contains(owner)) return;
+
+    std::shared_ptr<Search> search = m_searches.take(m_ownerSearch.take(owner));
+    if (!search) return;
+    for (const QueryHandle &handle : std::as_const(search->inFlight)) handle.cancel();
+    m_stats.cancelled++;
+    qCDebug(lcQuery) << "[LogQueryPlanner] 검색 #" << search->id << "취소 (같은 창에서 새 검색)";
+}
+
+void LogQueryPlanner::pump(Search &search)
+{
+    const int id = search.id;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    // 목록 위(최신)부터 채워지도록 최근 구간부터
+    while (search.inFlight.size() < kMaxInFlight && !search.waiting.isEmpty()) {
+        fetchPage(id, search.waiting.takeLast(), 0, now);
+    }
+    if (search.inFlight.isEmpty() && search.waiting.isEmpty()) finish(id);
+}
+
+void LogQueryPlanner::fetchPage(int searchId, const Interval &slice, int page, qint64 startedAt)
+{
+    std::shared_ptr<Search> search = m_searches.value(searchId);
+    if (!search) return;
+    const LogSearchRequest &request = search->request;
+
+    QJsonObject filters;
+    filters["log_level"] = "error";
+    if (!request.deviceId.isEmpty()) filters["device_id"] = request.deviceId;
+    QJsonObject timeRange;
+    timeRange["start"] = slice.start;
+    timeRange["end"] = slice.end;
+    filters["time_range"] = timeRange;
+    filters["limit"] = kPageSize;
+    filters["offset"] = page * kPageSize;
+
+    LogShape shape;
+    shape.deviceId = request.deviceId;
+    shape.logLevel = "error";
+    shape.startMs = slice.start;
+    shape.endMs = slice.end;
+    shape.asRecords = true;
+
+    QueryEngine::Request query;
+    query.queryType = "logs";
+    query.tag = "planner";
+    query.filters = filters;
+    query.timeoutMs = kPageTimeoutMs;
+    query.prepare = [shape](const QString &queryId) {
+        ResponsePipeline::instance()->expectLogQuery(queryId, shape);
+    };
+
+    auto queryId = std::make_shared<QString>();
+    QueryHandle handle = QueryEngine::instance()->send(query, this,
+        [this, searchId, queryId, slice, page, startedAt](const QueryResult &result) {
+            LogBatch batch;
+            if (result.outcome == QueryResult::TimedOut) {
+                batch.status = result.status;
+                batch.error = result.error;
+            } else {
+                batch = result.value<LogBatch>();
+            }
+            onPage(searchId, *queryId, slice, page, startedAt, batch);
+        });
+    *queryId = handle.id();
+    search->inFlight.insert(handle.id(), handle);
+}
+
+void LogQueryPlanner::onPage(int searchId, const QString &queryId, const Interval &slice, int page,
+                             qint64 startedAt, const LogBatch &batch)
+{
+    std::shared_ptr<Search> search = m_searches.value(searchId);
+    if (!search) return;
+    search->inFlight.remove(queryId);
+
+    if (!batch.isSuccess()) {
+        search->sliceKeys.remove(slice.start);
+        search->progress.failedSlices++;
+        m_stats.failedSlices++;
+        qDebug() << "[LogQueryPlanner] 검색 #" << searchId << "구간 실패:"
+                 << QDateTime::fromMSecsSinceEpoch(slice.start).toString("MM-dd") << batch.status << batch.error;
+        pump(*search);
+        return;
+    }
+
+    m_stats.pages++;
+    m_stats.rowsFetched += batch.records.size();
+    const int stored = store(*search, slice, batch.records);
+    LocalHistory::instance()->recordLogs(batch.records);
+
+    search->dirty = true;
+    if (!m_flushTimer.isActive()) m_flushTimer.start();
+
+    // 등록된 쿼리의 응답이고 서버가 보낸 행이 모두 LogStore까지 갔을 때만 구간을 믿음
+    // (조건 밖/시각 없는 행이 섞였으면 서버가 조건을 다르게 적용한 것 - 덮인 것으로 치면 다음 검색이 틀림)
+    if (!batch.known || batch.receivedRows != batch.records.size() || stored != batch.records.size()) {
+        search->sliceKeys.remove(slice.start);
+        search->progress.failedSlices++;
+        m_stats.failedSlices++;
+        qDebug() << "[LogQueryPlanner] 검색 #" << searchId << "구간 불완전:"
+                 << QDateTime::fromMSecsSinceEpoch(slice.start).toString("MM-dd") << "받은" << batch.receivedRows
+                 << "행, 조건 통과" << batch.records.size() << "행, 저장" << stored << "행"
+                 << (batch.known ? "" : "(등록 안 된 응답)");
+        pump(*search);
+        return;
+    }
+
+    if (batch.receivedRows >= kPageSize) {
+        if (page + 1 < kMaxPagesPerSlice) {
+            fetchPage(searchId, slice, page + 1, startedAt);
+            return;
+        }
+        search->sliceKeys.remove(slice.start);
+        // 앞부분만 받았으므로 덮인 것으로 치지 않음
+        search->progress.truncatedSlices++;
+    } else {
+        search->sliceKeys.remove(slice.start);
+        // 요청을 시작한 시점 직전까지만 완전함
+        const Interval done{slice.start, qMin(slice.end, startedAt - kLiveMarginMs)};
+        if (done.end >= done.start) cover(search->request.deviceId, done);
+        m_stats.slicesFetched++;
+    }
+    pump(*search);
+}
+
+void LogQueryPlanner::flush()
+{
+    // 콜백에서 새 검색을 시작할 수 있으므로 id로 다시 찾음
+    const QList<int> ids = m_searches.keys();
+    for (int id : ids) {
+        std::shared_ptr<Search> search = m_searches.value(id);
+        if (!search || !search->dirty) continue;
+        search->dirty = false;
+        deliver(*search);
+    }
+}
+
+void LogQueryPlanner::deliver(Search &search)
+{
+    if (!search.context || !search.onUpdate) return;
+
+    LogSearchUpdate &progress = search.progress;
+    progress.reset = !search.delivered;
+    if (!search.delivered) {
+        // 로컬 부분은 한 번만 훑음 - 이후 페이지에서 같은 로그를 다시 보내지 않도록 키를 기억
+        search.delivered = true;
+        progress.rows = collect(search.request);
+        if (!progress.complete) {
+            for (const QJsonObject &log : std::as_const(progress.rows)) {
+                search.shownKeys.insert(logKey(log.value("device_id").toString(), log.value("log_code").toString(),
+                                               log.value("timestamp").toVariant().toLongLong()));
+            }
+        }
+    } else {
+        // 여러 구간이 동시에 들어오므로 이번 몫만 최신순으로
+        progress.rows.swap(search.pending);
+        search.pending.clear();
+        std::stable_sort(progress.rows.begin(), progress.rows.end(), [](const QJsonObject &a, const QJsonObject &b) {
+            return a.value("timestamp").toVariant().toLongLong() > b.value("timestamp").toVariant().toLongLong();
+        });
+    }
+    progress.totalRows += progress.rows.size();
+    search.onUpdate(progress);
+    progress.rows.clear();
+}
+
+void LogQueryPlanner::finish(int searchId)
+{
+    std::shared_ptr<Search> search = m_searches.take(searchId);
+    if (!search) return;
+    if (m_ownerSearch.value(search->request.owner) == searchId) m_ownerSearch.remove(search->request.owner);
+
+    search->progress.complete = true;
+    deliver(*search);
+
+    const LogSearchUpdate &progress = search->progress;
+    qCDebug(lcQuery) << "[LogQueryPlanner] 검색 #" << searchId << "완료:" << progress.totalRows << "건,"
+                     << search->timer.elapsed() << "ms - 로컬" << progress.cachedMs / 1000 << "초 분량, 서버 구간"
+                     << progress.fetchSlices << "개 (실패" << progress.failedSlices << ", 잘림" << progress.truncatedSlices << ")";
+    if (m_stats.searches % kReportEvery == 0) qDebug().noquote() << report();
+}
+
+/* ---------- 로컬 (LogStore) ---------- */
+
+QList<QJsonObject> LogQueryPlanner::collect(const LogSearchRequest &request) const
+{
+    LogQuery query = storeQuery(request.deviceId, request.startMs, request.endMs);
+    query.logCode = request.logCode;
+    // LogStore 검색은 timestamp 최신순 (백필/복원분도 제 시각 자리에) → 상한까지만 받음
+    return LogStore::instance()->search(query, kMaxResultRows);
+}
+
+int LogQueryPlanner::store(Search &search, const Interval &slice, const QVector<LogRecord> &records)
+{
+    // 실시간으로 받았거나 복원한 로그와 겹치지 않게 - 구간마다 LogStore에 있는 키를 한 번만 모음
+    auto keys = search.sliceKeys.find(slice.start);
+    if (keys == search.sliceKeys.end()) {
+        keys = search.sliceKeys.insert(slice.start, {});
+        const QList<QJsonObject> existing = LogStore::instance()->search(
+            storeQuery(search.request.deviceId, slice.start, slice.end), 0);
+        for (const QJsonObject &log : existing) {
+            keys->insert(logKey(log.value("device_id").toString(), log.value("log_code").toString(),
+                                log.value("timestamp").toVariant().toLongLong()));
+        }
+    }
+
+    LogStore *store = LogStore::instance();
+    const QString &logCode = search.request.logCode;
+    int reached = 0;
+    for (const LogRecord &record : records) {
+        if (!record.hasValidTimestamp()) continue;
+        reached++;
+        const quint64 key = logKey(record.deviceId, record.logCode, record.timestamp);
+        const bool stored = keys->contains(key);
+
+        LogSnapshot::Row row;
+        row.timestamp = record.timestamp;
+        row.deviceId = record.deviceId;
+        row.logCode = record.logCode;
+        row.level = LogStore::levelFromString(record.logLevel);
+        row.message = record.message;
+        if (!stored) {
+            keys->insert(key);
+            store->append(row);
+        }
+
+        // 다음 결과에는 아직 보내지 않은 행만 (검색 시작 뒤 실시간으로 들어와 LogStore에만 있던 것도 포함)
+        if (!logCode.isEmpty() && record.logCode != logCode) continue;
+        if (search.shownKeys.contains(key)) continue;
+        search.shownKeys.insert(key);
+        search.pending.append(row.toJson());
+    }
+    return reached;
+}
+
+/* ---------- 덮인 구간 ---------- */
+
+QVector<LogQueryPlanner::Interval> LogQueryPlanner::subtract(const QVector<Interval> &wanted,
+                                                            const QVector<Interval> &covered)
+{
+    QVector<Interval> remaining;
+    for (const Interval &gap : wanted) {
+        qint64 cursor = gap.start;
+        for (const Interval &interval : covered) {
+            if (interval.end < cursor) continue;
+            if (interval.start > gap.end) break;
+            if (interval.start > cursor) remaining.append({cursor, interval.start - 1});
+            cursor = interval.end + 1;
+            if (cursor > gap.end) break;
+        }
+        if (cursor <= gap.end) remaining.append({cursor, gap.end});
+    }
+    return remaining;
+}
+
+void LogQueryPlanner::merge(QVector<Interval> &intervals, const Interval &interval)
+{
+    intervals.append(interval);
+    std::sort(intervals.begin(), intervals.end(), [](const Interval &a, const Interval &b) { return a.start < b.start; });
+
+    // 겹치거나 붙은 구간 합치기
+    QVector<Interval> merged;
+    for (const Interval &next : std::as_const(intervals)) {
+        if (!merged.isEmpty() && next.start <= merged.last().end + 1) {
+            merged.last().end = qMax(merged.last().end, next.end);
+        } else {
+            merged.append(next);
+        }
+    }
+    intervals = merged;
+}
+
+void LogQueryPlanner::remove(QVector<Interval> &intervals, qint64 fromMs, qint64 toMs)
+{
+    QVector<Interval> kept;
+    for (const Interval &interval : std::as_const(intervals)) {
+        if (interval.end < fromMs || interval.start > toMs) {
+            kept.append(interval);
+            continue;
+        }
+        if (interval.start < fromMs) kept.append({interval.start, fromMs - 1});
+        if (interval.end > toMs) kept.append({toMs + 1, interval.end});
+    }
+    intervals = kept;
+}
+
+QVector<LogQueryPlanner::Interval> LogQueryPlanner::gaps(const QString &deviceId, const Interval &wanted) const
+{
+    QVector<Interval> result = subtract({wanted}, m_coverage.value(deviceId));
+    // 모든 기기로 받은 구간은 기기별 검색에도 유효
+    if (!deviceId.isEmpty()) result = subtract(result, m_coverage.value(QString()));
+    return result;
+}
+
+void LogQueryPlanner::cover(const QString &deviceId, const Interval &interval)
+{
+    merge(m_coverage[deviceId], interval);
+    saveCoverage();
+}
+
+void LogQueryPlanner::onLogsDropped(qint64 fromMs, qint64 toMs)
+{
+    bool changed = false;
+    for (QVector<Interval> &intervals : m_coverage) {
+        const bool overlaps = std::any_of(intervals.cbegin(), intervals.cend(), [fromMs, toMs](const Interval &interval) {
+            return interval.end >= fromMs && interval.start <= toMs;
+        });
+        if (!overlaps) continue;
+        remove(intervals, fromMs, toMs);
+        changed = true;
+    }
+    if (!changed) return;
+
+    m_stats.droppedRanges++;
+    qDebug() << "[LogQueryPlanner] 로컬에서 빠진 로그" << QDateTime::fromMSecsSinceEpoch(fromMs) << "~"
+             << QDateTime::fromMSecsSinceEpoch(toMs) << "- 덮인 구간에서 뺌";
+    saveCoverage();
+}
+
+void LogQueryPlanner::loadCoverage()
+{
+    LocalHistory *history = LocalHistory::instance();
+    if (!history->isActive()) return;
+
+    // 복원 전 세션 메모리에만 있던 구간은 로컬 이력에 기록되지 않았으므로 파일 것으로 바꿈
+    // 이력이 비었으면 (지웠거나 처음) 저장된 구간도 의미 없음
+    m_coverage.clear();
+    if (history->stats().restoredLogs == 0) return;
+    QFile file(coveragePath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    int count = 0;
+    for (auto it = root.constBegin(); it != root.constEnd(); ++it) {
+        const QString deviceId = it.key() == kAllDevicesScope ? QString() : it.key();
+        QVector<Interval> &intervals = m_coverage[deviceId];
+        for (const QJsonValue &value : it.value().toArray()) {
+            const QJsonArray pair = value.toArray();
+            if (pair.size() != 2) continue;
+            const Interval interval{pair.at(0).toVariant().toLongLong(), pair.at(1).toVariant().toLongLong()};
+            if (interval.start <= 0 || interval.end < interval.start) continue;
+            merge(intervals, interval);
+            count++;
+        }
+    }
+    qDebug() << "[LogQueryPlanner] 덮인 구간" << count << "개 불러옴 (" << m_coverage.size() << "범위)";
+}
+
+void LogQueryPlanner::saveCoverage() const
+{
+    // 로컬 이력에 기록되는 동안만 - 아니면 다음 실행에 로그 없이 구간만 남음
+    if (!LocalHistory::instance()->isActive()) return;
+
+    QJsonObject root;
+    for (auto it = m_coverage.constBegin(); it != m_coverage.constEnd(); ++it) {
+        if (it.value().isEmpty()) continue;
+        QJsonArray intervals;
+        for (const Interval &interval : it.value()) intervals.append(QJsonArray{interval.start, interval.end});
+        root[it.key().isEmpty() ? QString(kAllDevicesScope) : it.key()] = intervals;
+    }
+
+    QSaveFile file(coveragePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "[LogQueryPlanner] 덮인 구간 저장 실패:" << coveragePath();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+QString LogQueryPlanner::report() const
+{
+    int intervals = 0;
+    for (const QVector<Interval> &covered : m_coverage) intervals += covered.size();
+    return QString("[LogQueryPlanner] 검색 %1회 (로컬만 %2, 취소 %3), 서버 구간 %4개/페이지 %5개/%6행 (실패 %7), "
+                   "덮인 구간 %8개 (로컬에서 빠져 줄인 %9회)")
+        .arg(m_stats.searches).arg(m_stats.localOnly).arg(m_stats.cancelled)
+        .arg(m_stats.slicesFetched).arg(m_stats.pages).arg(m_stats.rowsFetched).arg(m_stats.failedSlices)
+        .arg(intervals).arg(m_stats.droppedRanges);
+}
@@ -0,0 +1,134 @@
+#ifndef LOG_QUERY_PLANNER_H
+#define LOG_QUERY_PLANNER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <functional>
+#include <memory>
+#include "query_engine.h"
+#include "response_pipeline.h"
+
+// 날짜 범위 오류 로그 검색 (Home/피더/컨베이어 검색창)
+struct LogSearchRequest {
+    QString owner;              // 같은 owner의 이전 검색은 취소 ("home", "feeder", "conveyor")
+    QString deviceId;           // 서버에 보내는 기기 조건 (비어있으면 모든 기기) - 캐시 범위의 단위
+    QString logCode;            // 로컬에서 거름 (서버에는 보내지 않아 같은 구간을 코드만 바꿔 다시 찾아도 캐시로)
+    qint64  startMs = 0;
+    qint64  endMs = 0;          // 포함
+};
+
+// 검색 중간/최종 결과
+// 첫 결과(reset)는 로컬에 있던 것 전체, 그 뒤로는 지난 결과 이후 새로 받은 행만 - 받는 쪽이 시각 순으로 끼워 넣음
+struct LogSearchUpdate {
+    int  searchId = 0;
+    QList<QJsonObject> rows;    // 최신순
+    bool reset = false;         // true면 목록을 rows로 바꿈, false면 rows를 더함
+    int  totalRows = 0;         // 지금까지 보낸 행 수
+    bool complete = false;
+    qint64 cachedMs = 0;        // 검색 구간 중 로컬 캐시로 답한 길이
+    int  fetchSlices = 0;       // 서버에서 받은 (받는 중인) 구간 수
+    int  failedSlices = 0;      // 실패/시간 초과/연결 안 됨 - 그 구간은 빠진 결과
+    int  truncatedSlices = 0;   // 페이지 상한에 걸린 구간 (앞부분만)
+};
+
+// 로컬 우선 검색 계획기
+// - 서버에서 끝까지 받은 시간 구간을 범위(기기 조건)별로 기억 → 검색 구간 중 덮인 부분은 LogStore에서 바로
+// - 덮인 구간은 로컬 이력 옆(history/coverage.json)에 저장 → 재시작해도 복원한 로그로 답하고 서버에는 빠진 구간만
+// - 빠진 구간만 하루 단위로 잘라 서버에 페이지 단위(500행)로 요청, 최대 4개 구간을 동시에
+// - 로컬 부분은 검색 시작 때 한 번만 모아 보내고, 받은 로그는 LogStore(없는 것만)와 LocalHistory에 넣은 뒤
+//   100ms마다 새로 받은 행만 콜백으로 흘려줌 (마지막은 complete)
+// - 모든 기기 범위("")로 받은 구간은 기기별 검색에도 그대로 쓰임
+// - 지금에 가까운 구간(1분 이내)은 아직 로그가 더 올 수 있어 덮인 것으로 치지 않음
+// - LogStore 상한으로 밀려나거나 로컬 이력에서 지워진 시간대는 덮인 구간에서 뺌
+class LogQueryPlanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    using UpdateCallback = std::function<void(const LogSearchUpdate &update)>;
+
+    struct Stats {
+        quint64 searches = 0;
+        quint64 localOnly = 0;          // 서버 요청 없이 끝난 검색
+        quint64 slicesFetched = 0;
+        quint64 pages = 0;
+        quint64 rowsFetched = 0;
+        quint64 failedSlices = 0;
+        quint64 cancelled = 0;
+        quint64 droppedRanges = 0;      // LogStore/로컬 이력에서 빠져 덮인 구간에서 뺀 횟수
+    };
+
+    struct Interval {
+        qint64 start = 0;
+        qint64 end = 0;             // 포함
+    };
+
+    static LogQueryPlanner* instance();
+
+    // context가 파괴되면 콜백은 호출되지 않음
+    int search(const LogSearchRequest &request, QObject *context, UpdateCallback onUpdate);
+    void cancel(const QString &owner);
+
+    Stats stats() const { return m_stats; }
+    QString report() const;
+
+    // 구간 계산 (정렬·병합된 목록 기준)
+    // wanted 중 covered에 없는 부분
+    static QVector<Interval> subtract(const QVector<Interval> &wanted, const QVector<Interval> &covered);
+    // 구간을 더하고 겹치거나 붙은 것을 합침
+    static void merge(QVector<Interval> &intervals, const Interval &interval);
+    // [fromMs, toMs]와 겹치는 부분을 뺌
+    static void remove(QVector<Interval> &intervals, qint64 fromMs, qint64 toMs);
+
+private:
+    explicit LogQueryPlanner(QObject *parent = nullptr);
+
+    struct Search {
+        int id = 0;
+        LogSearchRequest request;
+        QPointer<QObject> context;
+        UpdateCallback onUpdate;
+        QVector<Interval> waiting;      // 아직 요청하지 않은 구간
+        QHash<QString, QueryHandle> inFlight;
+        LogSearchUpdate progress;
+        bool dirty = false;
+        QElapsedTimer timer;
+        QHash<qint64, QSet<quint64>> sliceKeys;    // 구간 시작 → LogStore에 이미 있는 로그 키 (첫 페이지 때 채움)
+        bool delivered = false;                     // 로컬 부분(reset)을 보냈는지
+        QSet<quint64> shownKeys;                    // 이미 보낸 로그 키
+        QList<QJsonObject> pending;                 // 아직 보내지 않은 새 행
+    };
+
+    void pump(Search &search);
+    void fetchPage(int searchId, const Interval &slice, int page, qint64 startedAt);
+    void onPage(int searchId, const QString &queryId, const Interval &slice, int page, qint64 startedAt,
+                const LogBatch &batch);
+    void flush();
+    void deliver(Search &search);
+    void finish(int searchId);
+
+    QList<QJsonObject> collect(const LogSearchRequest &request) const;
+    QVector<Interval> gaps(const QString &deviceId, const Interval &wanted) const;
+    void cover(const QString &deviceId, const Interval &interval);
+    // LogStore에 들어갔거나 이미 있던 행 수 (시각 없는 행은 빠짐)
+    int store(Search &search, const Interval &slice, const QVector<LogRecord> &records);
+    void onLogsDropped(qint64 fromMs, qint64 toMs);
+    void loadCoverage();
+    void saveCoverage() const;
+
+    QHash<QString, QVector<Interval>> m_coverage;   // 범위(기기 조건)별 덮인 구간, 정렬·병합 상태
+
+    QHash<int, std::shared_ptr<Search>> m_searches;
+    QHash<QString, int> m_ownerSearch;
+    int m_nextId = 1;
+    QTimer m_flushTimer;
+
+    Stats m_stats;
+};
+
+#endif // LOG_QUERY_PLANNER_H
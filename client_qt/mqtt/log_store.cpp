@@ -0,0 +1,723 @@
+#include "log_store.h"
+#include "log_categories.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QSettings>
+#include <QDebug>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+using namespace LogColumns;
+
+namespace {
+const quint16 kNoEntry = 0;     // 사전 0번 = 빈 문자열 (넘치거나 값이 없을 때)
+const int kMaxVocabulary = 200000;  // 메시지 단어 목록 상한 (숫자 값이 섞인 메시지로 끝없이 늘지 않게)
+const int kMaxTermExpansion = 256;  // 검색어 한 단어가 펼쳐지는 메시지 단어 수 상한 (넘으면 그 단어만 후보를 훑어 확인)
+
+// 청크 행 하나 - 여러 청크에서 모은 결과를 timestamp 순으로 합칠 때
+struct Hit {
+    qint64  timestamp = 0;
+    int     chunk = 0;          // 스냅샷 청크 순서 (들어온 순서)
+    quint16 row = 0;
+};
+
+// timestamp 최신순, 같은 시각이면 나중에 들어온 것 먼저
+bool newerHit(const Hit &a, const Hit &b)
+{
+    if (a.timestamp != b.timestamp) return a.timestamp > b.timestamp;
+    if (a.chunk != b.chunk) return a.chunk > b.chunk;
+    return a.row > b.row;
+}
+
+// 청크 안 행들을 같은 기준(최신순)으로
+void sortNewestFirst(const Chunk &chunk, std::vector<quint16> &rows)
+{
+    std::sort(rows.begin(), rows.end(), [&chunk](quint16 a, quint16 b) {
+        const qint64 ta = chunk.timestamps[a];
+        const qint64 tb = chunk.timestamps[b];
+        return ta != tb ? ta > tb : a > b;
+    });
+}
+
+// 청크 전체를 최신순으로 (시간 색인을 거꾸로)
+void newestRows(const Chunk &chunk, std::vector<quint16> &rows)
+{
+    if (static_cast<int>(chunk.byTime.size()) == chunk.size()) {
+        rows.assign(chunk.byTime.crbegin(), chunk.byTime.crend());
+        return;
+    }
+    rows.resize(chunk.size());
+    std::iota(rows.begin(), rows.end(), quint16(0));
+    sortNewestFirst(chunk, rows);
+}
+
+// 전체에서 최신 wanted건
+// rowsOf(chunk, rows)는 그 청크에서 조건에 맞는 행을 최신순으로 많아야 wanted건 채움
+// 청크를 최대 timestamp가 큰 것부터 돌고, 모은 wanted번째보다 최대 timestamp가 작은 청크부터는 보지 않음
+// (들어온 순서가 아니라 timestamp 순 - 백필/복원으로 과거 로그가 뒤 청크에 있어도 맞게)
+template <typename RowsOf>
+std::vector<Hit> newestHits(const std::vector<std::shared_ptr<const Chunk>> &chunks, int wanted, RowsOf rowsOf)
+{
+    std::vector<int> order(chunks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&chunks](int a, int b) {
+        const qint64 ma = chunks[a]->maxTimestamp;
+        const qint64 mb = chunks[b]->maxTimestamp;
+        return ma != mb ? ma > mb : a > b;
+    });
+
+    std::vector<Hit> hits;
+    std::vector<quint16> rows;
+    for (int index : order) {
+        const Chunk &chunk = *chunks[index];
+        if (chunk.size() == 0) continue;
+        if (static_cast<int>(hits.size()) >= wanted && hits[wanted - 1].timestamp > chunk.maxTimestamp) break;
+
+        rows.clear();
+        rowsOf(chunk, rows);
+        for (quint16 row : rows) hits.push_back({chunk.timestamps[row], index, row});
+
+        // 앞 wanted건만 남김 - wanted번째가 다음 청크를 볼지 정하는 기준
+        if (static_cast<int>(hits.size()) >= wanted) {
+            std::nth_element(hits.begin(), hits.begin() + (wanted - 1), hits.end(), newerHit);
+            hits.resize(wanted);
+        }
+    }
+    std::sort(hits.begin(), hits.end(), newerHit);
+    return hits;
+}
+}
+
+/* ---------- 사전 ---------- */
+
+Dictionary::Dictionary()
+{
+    append(QString());      // 0번 = 빈 문자열
+}
+
+quint16 Dictionary::append(const QString &value)
+{
+    if (m_size >= kBlocks * kBlockSize) return 0;
+    std::unique_ptr<QString[]> &block = m_blocks[m_size >> kBlockBits];
+    if (!block) block.reset(new QString[kBlockSize]);
+    block[m_size & (kBlockSize - 1)] = value;
+    return static_cast<quint16>(m_size++);
+}
+
+/* ---------- 단어 ---------- */
+
+QStringList LogColumns::tokenize(const QString &text)
+{
+    QStringList tokens;
+    QString current;
+    for (const QChar c : text) {
+        if (c.isLetterOrNumber()) {
+            current.append(c.toLower());
+        } else if (!current.isEmpty()) {
+            tokens.append(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty()) tokens.append(current);
+    return tokens;
+}
+
+quint32 LogColumns::tokenHash(const QString &token)
+{
+    return static_cast<quint32>(qHash(token, 0));
+}
+
+/* ---------- 검색 조건 ---------- */
+
+QStringList LogQuery::terms() const
+{
+    return text.toLower().simplified().split(' ', Qt::SkipEmptyParts);
+}
+
+bool LogQuery::matches(const LogSnapshot::Row &row) const
+{
+    return matches(row, terms());
+}
+
+bool LogQuery::matches(const LogSnapshot::Row &row, const QStringList &words) const
+{
+    if (!deviceIds.isEmpty() && !deviceIds.contains(row.deviceId)) return false;
+    if (!logCode.isEmpty() && row.logCode != logCode) return false;
+    if (level != LogLevel::Unknown && row.level != level) return false;
+    if (startMs > 0 && row.timestamp < startMs) return false;
+    if (endMs > 0 && row.timestamp > endMs) return false;
+
+    if (words.isEmpty()) return true;
+    const QStringList tokens = tokenize(row.message);
+    for (const QString &word : words) {
+        if (row.deviceId.contains(word, Qt::CaseInsensitive)) continue;
+        if (row.logCode.contains(word, Qt::CaseInsensitive)) continue;
+        const bool inMessage = std::any_of(tokens.cbegin(), tokens.cend(),
+                                           [&word](const QString &token) { return token.startsWith(word); });
+        if (!inMessage) return false;
+    }
+    return true;
+}
+
+bool LogQuery::matches(const QJsonObject &log) const
+{
+    return matches(LogStore::rowFromJson(log));
+}
+
+/* ---------- 행 ---------- */
+
+QJsonObject LogSnapshot::Row::toJson() const
+{
+    QJsonObject object;
+    object["device_id"] = deviceId;
+    object["log_code"] = logCode;
+    const QString levelText = LogStore::levelToString(level);
+    if (!levelText.isEmpty()) object["log_level"] = levelText;
+    if (!message.isEmpty()) object["message"] = message;
+    object["timestamp"] = timestamp;
+    if (repeatCount > 1) object["repeat_count"] = repeatCount;
+    return object;
+}
+
+/* ---------- 스냅샷 ---------- */
+
+LogSnapshot::Row LogSnapshot::rowAt(const Chunk &chunk, int row) const
+{
+    Row result;
+    result.timestamp = chunk.timestamps[row];
+    result.deviceId = m_devices->at(chunk.devices[row]);
+    result.logCode = m_codes->at(chunk.codes[row]);
+    result.level = static_cast<LogLevel>(chunk.levels[row]);
+    result.repeatCount = static_cast<int>(chunk.repeats[row]);
+
+    const quint32 begin = row > 0 ? chunk.messageEnds[row - 1] : 0;
+    const quint32 end = chunk.messageEnds[row];
+    if (end > begin) result.message = QString::fromUtf8(chunk.arena.constData() + begin, end - begin);
+    return result;
+}
+
+int LogSnapshot::lookup(const Dictionary *dictionary, int count, const QString &value) const
+{
+    if (!dictionary || value.isEmpty()) return -1;
+    // 사전은 기기/코드 종류 수만큼이라 작음
+    for (int id = 1; id < count; ++id) {
+        if (dictionary->at(id) == value) return id;
+    }
+    return -1;
+}
+
+QList<QJsonObject> LogSnapshot::newest(int limit) const
+{
+    const int wanted = limit > 0 ? qMin(limit, m_rows) : m_rows;
+    if (wanted <= 0) return {};
+
+    const std::vector<Hit> hits = newestHits(m_chunks, wanted, [wanted](const Chunk &chunk, std::vector<quint16> &rows) {
+        newestRows(chunk, rows);
+        if (static_cast<int>(rows.size()) > wanted) rows.resize(wanted);
+    });
+
+    QList<QJsonObject> logs;
+    logs.reserve(static_cast<int>(hits.size()));
+    for (const Hit &hit : hits) logs.append(rowAt(*m_chunks[hit.chunk], hit.row).toJson());
+    return logs;
+}
+
+QList<QJsonObject> LogSnapshot::newestForDevice(const QString &deviceId, int limit) const
+{
+    return newestForDevices(QStringList{deviceId}, limit);
+}
+
+QList<QJsonObject> LogSnapshot::newestForDevices(const QStringList &deviceIds, int limit) const
+{
+    QVector<quint16> ids;
+    for (const QString &deviceId : deviceIds) {
+        const int id = lookup(m_devices.get(), m_deviceCount, deviceId);
+        if (id > 0) ids.append(static_cast<quint16>(id));
+    }
+    if (ids.isEmpty()) return {};
+    return newestForIds(ids, limit);
+}
+
+QList<QJsonObject> LogSnapshot::newestForIds(const QVector<quint16> &deviceIds, int limit) const
+{
+    const int wanted = limit > 0 ? limit : std::numeric_limits<int>::max();
+
+    const std::vector<Hit> hits = newestHits(m_chunks, wanted, [&deviceIds, wanted](const Chunk &chunk, std::vector<quint16> &rows) {
+        // 청크의 기기별 행 목록만 모아서 최신순
+        for (quint16 id : deviceIds) {
+            auto it = chunk.byDevice.constFind(id);
+            if (it != chunk.byDevice.constEnd()) rows.insert(rows.end(), it->begin(), it->end());
+        }
+        if (static_cast<int>(rows.size()) > wanted) {
+            std::partial_sort(rows.begin(), rows.begin() + wanted, rows.end(), [&chunk](quint16 a, quint16 b) {
+                const qint64 ta = chunk.timestamps[a];
+                const qint64 tb = chunk.timestamps[b];
+                return ta != tb ? ta > tb : a > b;
+            });
+            rows.resize(wanted);
+        } else {
+            sortNewestFirst(chunk, rows);
+        }
+    });
+
+    QList<QJsonObject> logs;
+    logs.reserve(static_cast<int>(hits.size()));
+    for (const Hit &hit : hits) logs.append(rowAt(*m_chunks[hit.chunk], hit.row).toJson());
+    return logs;
+}
+
+int LogSnapshot::countForDevice(const QString &deviceId) const
+{
+    const int id = lookup(m_devices.get(), m_deviceCount, deviceId);
+    if (id <= 0) return 0;
+
+    int count = 0;
+    for (const auto &chunk : m_chunks) {
+        auto it = chunk->byDevice.constFind(static_cast<quint16>(id));
+        if (it != chunk->byDevice.constEnd()) count += static_cast<int>(it->size());
+    }
+    return count;
+}
+
+int LogSnapshot::countForCode(const QString &logCode) const
+{
+    const int id = lookup(m_codes.get(), m_codeCount, logCode);
+    if (id <= 0) return 0;
+
+    int count = 0;
+    for (const auto &chunk : m_chunks) {
+        auto it = chunk->byCode.constFind(static_cast<quint16>(id));
+        if (it != chunk->byCode.constEnd()) count += static_cast<int>(it->size());
+    }
+    return count;
+}
+
+QStringList LogSnapshot::deviceIds() const
+{
+    if (!m_devices) return {};
+    QStringList ids;
+    for (int i = 1; i < m_deviceCount; ++i) ids.append(m_devices->at(i));
+    return ids;
+}
+
+void LogSnapshot::forEach(const std::function<void(const Row &)> &visit) const
+{
+    for (const auto &chunk : m_chunks) {
+        for (int row = 0; row < chunk->size(); ++row) visit(rowAt(*chunk, row));
+    }
+}
+
+/* ---------- 스토어 ---------- */
+
+LogStore* LogStore::instance()
+{
+    static QPointer<LogStore> store;
+    if (!store) {
+        store = new LogStore(QCoreApplication::instance());
+    }
+    return store;
+}
+
+LogStore::LogStore(QObject *parent)
+    : QObject(parent)
+    , m_devices(std::make_shared<Dictionary>())
+    , m_codes(std::make_shared<Dictionary>())
+{
+    qRegisterMetaType<LogSnapshot>("LogSnapshot");
+
+    QSettings settings("VisionCraft", "client_qt");
+    m_maxRows = qMax(kChunkRows, settings.value("logstore/max_rows", 1000000).toInt());
+    qDebug() << "[LogStore] 로그 이력 최대" << m_maxRows << "행";
+}
+
+LogLevel LogStore::levelFromString(const QString &level)
+{
+    if (level.compare("error", Qt::CaseInsensitive) == 0) return LogLevel::Error;
+    if (level.compare("info", Qt::CaseInsensitive) == 0) return LogLevel::Info;
+    if (level.compare("warning", Qt::CaseInsensitive) == 0
+        || level.compare("warn", Qt::CaseInsensitive) == 0) return LogLevel::Warning;
+    return LogLevel::Unknown;
+}
+
+QString LogStore::levelToString(LogLevel level)
+{
+    switch (level) {
+    case LogLevel::Error:   return "error";
+    case LogLevel::Info:    return "info";
+    case LogLevel::Warning: return "warning";
+    default:                return QString();
+    }
+}
+
+quint16 LogStore::intern(Dictionary &dictionary, QHash<QString, quint16> &lookup, const QString &value)
+{
+    if (value.isEmpty()) return kNoEntry;
+    auto it = lookup.constFind(value);
+    if (it != lookup.constEnd()) return it.value();
+
+    // 제자리에 덧붙임 - 스냅샷은 자기 개수까지만 읽으므로 복사하지 않음
+    const quint16 id = dictionary.append(value);
+    if (id == kNoEntry) return kNoEntry;
+    lookup.insert(value, id);
+    return id;
+}
+
+LogSnapshot::Row LogStore::rowFromJson(const QJsonObject &log)
+{
+    LogSnapshot::Row row;
+    row.timestamp = log.value("timestamp").toVariant().toLongLong();
+    row.deviceId = log.value("device_id").toString();
+    row.logCode = log.value("log_code").toString();
+    row.level = levelFromString(log.value("log_level").toString());
+    row.repeatCount = qMax(1, log.value("repeat_count").toInt(1));
+    row.message = log.value("message").toString();
+    return row;
+}
+
+void LogStore::append(const QJsonObject &log)
+{
+    append(rowFromJson(log));
+}
+
+void LogStore::append(const LogSnapshot::Row &log)
+{
+    if (!m_open) {
+        m_open = std::make_shared<Chunk>();
+        m_open->timestamps.reserve(kChunkRows);
+        m_open->devices.reserve(kChunkRows);
+        m_open->codes.reserve(kChunkRows);
+        m_open->levels.reserve(kChunkRows);
+        m_open->repeats.reserve(kChunkRows);
+        m_open->messageEnds.reserve(kChunkRows);
+    }
+
+    Chunk &chunk = *m_open;
+    const quint16 row = static_cast<quint16>(chunk.size());
+    const quint16 device = intern(*m_devices, m_deviceLookup, log.deviceId);
+    const quint16 code = intern(*m_codes, m_codeLookup, log.logCode);
+
+    chunk.timestamps.push_back(log.timestamp);
+    chunk.devices.push_back(device);
+    chunk.codes.push_back(code);
+    chunk.levels.push_back(static_cast<quint8>(log.level));
+    chunk.repeats.push_back(static_cast<quint32>(qMax(1, log.repeatCount)));
+    chunk.arena.append(log.message.toUtf8());
+    chunk.messageEnds.push_back(static_cast<quint32>(chunk.arena.size()));
+    chunk.byDevice[device].push_back(row);
+    chunk.byCode[code].push_back(row);
+    indexTokens(chunk, row, log.message);
+    chunk.minTimestamp = qMin(chunk.minTimestamp, log.timestamp);
+    chunk.maxTimestamp = qMax(chunk.maxTimestamp, log.timestamp);
+
+    m_openSnapshot.reset();
+    m_rows++;
+    m_appended++;
+
+    if (chunk.size() >= kChunkRows) seal();
+    evict();
+    if (m_appended % 10000 == 0) qDebug().noquote() << report();
+}
+
+void LogStore::indexTokens(Chunk &chunk, quint16 row, const QString &message)
+{
+    if (message.isEmpty()) return;
+    QStringList tokens = tokenize(message);
+    tokens.removeDuplicates();
+    for (const QString &token : tokens) {
+        const quint32 hash = tokenHash(token);
+        chunk.byToken[hash].push_back(row);
+
+        if (m_openWords.contains(token)) continue;
+        auto it = m_vocabulary.find(token);
+        if (it == m_vocabulary.end()) {
+            if (m_vocabulary.size() >= kMaxVocabulary) {
+                if (!chunk.untrackedTokens) {
+                    chunk.untrackedTokens = true;
+                    if (m_untrackedChunks++ == 0) {
+                        qDebug() << "[LogStore] 메시지 단어 목록 상한" << kMaxVocabulary
+                                 << "- 목록에 없는 단어가 있는 청크는 검색 때 훑어 확인";
+                    }
+                }
+                continue;
+            }
+            it = m_vocabulary.insert(token, Word{hash, 0});
+        }
+        it->chunks++;
+        m_openWords.insert(token);
+    }
+}
+
+namespace {
+void buildTimeIndex(Chunk &chunk)
+{
+    chunk.byTime.resize(chunk.timestamps.size());
+    for (size_t row = 0; row < chunk.byTime.size(); ++row) chunk.byTime[row] = static_cast<quint16>(row);
+    // 대부분 이미 시간순이라 stable_sort가 거의 훑기만 함
+    std::stable_sort(chunk.byTime.begin(), chunk.byTime.end(), [&chunk](quint16 a, quint16 b) {
+        return chunk.timestamps[a] < chunk.timestamps[b];
+    });
+}
+}
+
+void LogStore::seal()
+{
+    if (!m_open || m_open->size() == 0) return;
+    m_open->arena.squeeze();
+    buildTimeIndex(*m_open);
+    m_sealed.push_back(std::move(m_open));
+    m_sealedWords.push_back(m_openWords.values());
+    m_open.reset();
+    m_openSnapshot.reset();
+    m_openWords.clear();
+}
+
+void LogStore::evict()
+{
+    // 오래된 청크 단위로 버림 - 들고 있는 스냅샷은 계속 유효
+    qint64 fromMs = std::numeric_limits<qint64>::max();
+    qint64 toMs = std::numeric_limits<qint64>::min();
+    while (m_rows > m_maxRows && !m_sealed.empty()) {
+        const LogColumns::Chunk &oldest = *m_sealed.front();
+        const int rows = oldest.size();
+        fromMs = qMin(fromMs, oldest.minTimestamp);
+        toMs = qMax(toMs, oldest.maxTimestamp);
+        if (oldest.untrackedTokens) m_untrackedChunks--;
+        // 이 청크에만 있던 단어는 목록에서 뺌 → 상한 아래로 내려가면 새 단어를 다시 받음
+        for (const QString &word : std::as_const(m_sealedWords.front())) {
+            auto it = m_vocabulary.find(word);
+            if (it != m_vocabulary.end() && --it->chunks <= 0) m_vocabulary.erase(it);
+        }
+        m_sealedWords.pop_front();
+        m_sealed.pop_front();
+        m_rows -= rows;
+        m_evicted += rows;
+    }
+    if (fromMs <= toMs) emit evicted(fromMs, toMs);
+}
+
+void LogStore::clear()
+{
+    m_sealed.clear();
+    m_open.reset();
+    m_openSnapshot.reset();
+    m_vocabulary.clear();
+    m_openWords.clear();
+    m_sealedWords.clear();
+    m_untrackedChunks = 0;
+    m_rows = 0;
+    qDebug() << "[LogStore] 로그 이력 비움";
+}
+
+LogSnapshot LogStore::snapshot() const
+{
+    LogSnapshot snapshot;
+    snapshot.m_chunks.reserve(m_sealed.size() + 1);
+    snapshot.m_chunks.assign(m_sealed.cbegin(), m_sealed.cend());
+
+    if (m_open && m_open->size() > 0) {
+        // 쓰는 중인 청크만 복사 (최대 kChunkRows행), 다음 append 전까지는 같은 복사본
+        if (!m_openSnapshot) {
+            auto copy = std::make_shared<Chunk>(*m_open);
+            buildTimeIndex(*copy);
+            m_openSnapshot = std::move(copy);
+        }
+        snapshot.m_chunks.push_back(m_openSnapshot);
+    }
+    snapshot.m_devices = m_devices;
+    snapshot.m_codes = m_codes;
+    snapshot.m_deviceCount = m_devices->size();
+    snapshot.m_codeCount = m_codes->size();
+    snapshot.m_rows = m_rows;
+    m_snapshots++;
+    return snapshot;
+}
+
+QList<QJsonObject> LogStore::search(const LogQuery &query, int limit) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const LogSnapshot snapshot = this->snapshot();
+    const QStringList words = query.terms();
+    const int wanted = limit > 0 ? limit : std::numeric_limits<int>::max();
+
+    // 검색어 단어마다 기기/코드 사전 번호와 메시지 단어 해시로 펼침 (사전은 작아서 포함 검사로)
+    struct Term {
+        QVector<quint16> devices;
+        QVector<quint16> codes;
+        QVector<quint32> tokens;
+        bool scan = false;      // 색인으로 못 좁힘 → 다른 조건으로 고른 행을 하나씩 확인
+    };
+    QVector<Term> expanded;
+    for (const QString &word : words) {
+        Term term;
+        for (int id = 1; id < m_devices->size(); ++id) {
+            if (m_devices->at(id).contains(word, Qt::CaseInsensitive)) term.devices.append(static_cast<quint16>(id));
+        }
+        for (int id = 1; id < m_codes->size(); ++id) {
+            if (m_codes->at(id).contains(word, Qt::CaseInsensitive)) term.codes.append(static_cast<quint16>(id));
+        }
+        for (auto it = m_vocabulary.lowerBound(word); it != m_vocabulary.cend() && it.key().startsWith(word); ++it) {
+            if (term.tokens.size() >= kMaxTermExpansion) {
+                term.scan = true;
+                break;
+            }
+            term.tokens.append(it->hash);
+        }
+        // 기기/코드/메시지 어디에도 없는 단어 → 결과 없음 (목록에 못 넣은 단어가 있는 청크가 없을 때만)
+        if (!term.scan && m_untrackedChunks == 0 && term.devices.isEmpty() && term.codes.isEmpty()
+            && term.tokens.isEmpty()) {
+            m_searches++;
+            m_searchUs += timer.nsecsElapsed() / 1000;
+            return {};
+        }
+        expanded.append(term);
+    }
+
+    QVector<quint16> deviceFilter;
+    for (const QString &deviceId : query.deviceIds) {
+        auto it = m_deviceLookup.constFind(deviceId);
+        if (it != m_deviceLookup.constEnd()) deviceFilter.append(it.value());
+    }
+    if (!query.deviceIds.isEmpty() && deviceFilter.isEmpty()) return {};
+    quint16 codeFilter = 0;
+    if (!query.logCode.isEmpty()) {
+        codeFilter = m_codeLookup.value(query.logCode, 0);
+        if (codeFilter == 0) return {};
+    }
+
+    std::vector<quint16> rows;
+    std::vector<quint16> candidates;
+    std::vector<quint16> merged;
+    int examined = 0;
+
+    auto collect = [](std::vector<quint16> &out, const std::vector<quint16> &list) {
+        out.insert(out.end(), list.begin(), list.end());
+    };
+
+    // 청크마다 조건에 맞는 행을 최신순으로 wanted건까지 → newestHits가 청크 사이를 timestamp 순으로 합침
+    auto matchChunk = [&](const Chunk &chunk, std::vector<quint16> &out) {
+        if (query.startMs > 0 && chunk.maxTimestamp < query.startMs) return;
+        if (query.endMs > 0 && chunk.minTimestamp > query.endMs) return;
+
+        // 1) 후보 행 - 단어별 색인(기기 ∪ 코드 ∪ 메시지 단어)의 교집합
+        bool narrowed = false;
+        for (const Term &term : expanded) {
+            // 펼치지 못한 단어, 또는 목록에 없는 단어가 있는 청크 → 이 단어는 3)에서 행마다 확인
+            if (term.scan || chunk.untrackedTokens) continue;
+            candidates.clear();
+            for (quint16 id : term.devices) {
+                auto found = chunk.byDevice.constFind(id);
+                if (found != chunk.byDevice.constEnd()) collect(candidates, *found);
+            }
+            for (quint16 id : term.codes) {
+                auto found = chunk.byCode.constFind(id);
+                if (found != chunk.byCode.constEnd()) collect(candidates, *found);
+            }
+            for (quint32 hash : term.tokens) {
+                auto found = chunk.byToken.constFind(hash);
+                if (found != chunk.byToken.constEnd()) collect(candidates, *found);
+            }
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+            if (!narrowed) {
+                rows.swap(candidates);
+                narrowed = true;
+            } else {
+                merged.clear();
+                std::set_intersection(rows.begin(), rows.end(), candidates.begin(), candidates.end(),
+                                      std::back_inserter(merged));
+                rows.swap(merged);
+            }
+            if (rows.empty()) return;
+        }
+
+        // 2) 검색어로 못 좁혔으면 코드/기기 색인, 날짜가 청크에 걸쳐 있으면 시간 색인, 아니면 청크 전체
+        //    시간 색인/청크 전체는 이미 최신순, 나머지는 행 번호순이라 최신순으로 정렬
+        bool newestFirst = false;
+        if (!narrowed) {
+            rows.clear();
+            const bool partial = (query.startMs > 0 && chunk.minTimestamp < query.startMs)
+                                 || (query.endMs > 0 && chunk.maxTimestamp > query.endMs);
+            if (codeFilter != 0) {
+                auto found = chunk.byCode.constFind(codeFilter);
+                if (found != chunk.byCode.constEnd()) rows = *found;
+            } else if (!deviceFilter.isEmpty()) {
+                for (quint16 id : deviceFilter) {
+                    auto found = chunk.byDevice.constFind(id);
+                    if (found != chunk.byDevice.constEnd()) collect(rows, *found);
+                }
+            } else if (partial && static_cast<int>(chunk.byTime.size()) == chunk.size()) {
+                auto begin = chunk.byTime.begin();
+                auto end = chunk.byTime.end();
+                if (query.startMs > 0) {
+                    begin = std::lower_bound(begin, end, query.startMs, [&chunk](quint16 row, qint64 ms) {
+                        return chunk.timestamps[row] < ms;
+                    });
+                }
+                if (query.endMs > 0) {
+                    end = std::upper_bound(begin, end, query.endMs, [&chunk](qint64 ms, quint16 row) {
+                        return ms < chunk.timestamps[row];
+                    });
+                }
+                rows.assign(std::make_reverse_iterator(end), std::make_reverse_iterator(begin));
+                newestFirst = true;
+            } else {
+                newestRows(chunk, rows);
+                newestFirst = true;
+            }
+        }
+        if (!newestFirst) sortNewestFirst(chunk, rows);
+
+        // 3) 최신순으로 열 값 확인 - 싼 열 비교 먼저, 문자열은 해시 충돌/펼치지 못한 단어 확인용으로 마지막에
+        for (quint16 row : rows) {
+            if (static_cast<int>(out.size()) >= wanted) break;
+            examined++;
+            const qint64 ts = chunk.timestamps[row];
+            if (query.startMs > 0 && ts < query.startMs) continue;
+            if (query.endMs > 0 && ts > query.endMs) continue;
+            if (query.level != LogLevel::Unknown && chunk.levels[row] != static_cast<quint8>(query.level)) continue;
+            if (!deviceFilter.isEmpty() && !deviceFilter.contains(chunk.devices[row])) continue;
+            if (codeFilter != 0 && chunk.codes[row] != codeFilter) continue;
+
+            if (!words.isEmpty() && !query.matches(snapshot.rowAt(chunk, row), words)) continue;
+            out.push_back(row);
+        }
+    };
+
+    const std::vector<Hit> hits = newestHits(snapshot.m_chunks, wanted, matchChunk);
+    QList<QJsonObject> results;
+    results.reserve(static_cast<int>(hits.size()));
+    for (const Hit &hit : hits) results.append(snapshot.rowAt(*snapshot.m_chunks[hit.chunk], hit.row).toJson());
+
+    const qint64 us = timer.nsecsElapsed() / 1000;
+    m_searches++;
+    m_searchUs += us;
+    qCDebug(lcQuery) << "[LogStore] 검색" << query.text << "→" << results.size() << "건 (확인" << examined << "행 /"
+                     << m_rows << "행," << us << "us)";
+    return results;
+}
+
+QString LogStore::report() const
+{
+    qint64 bytes = 0;
+    auto chunkBytes = [](const Chunk &chunk) {
+        qint64 postings = 0;
+        for (const std::vector<quint16> &rows : chunk.byToken) postings += static_cast<qint64>(rows.size());
+        return static_cast<qint64>(chunk.size()) * (8 + 2 + 2 + 1 + 4 + 4 + 2 * 2 + 2) + postings * 2 + chunk.arena.size();
+    };
+    for (const auto &chunk : m_sealed) bytes += chunkBytes(*chunk);
+    if (m_open) bytes += chunkBytes(*m_open);
+
+    return QString("[LogStore] %1행 (청크 %2개, 약 %3 KB), 기기 %4종, 코드 %5종, 메시지 단어 %6종, "
+                   "누적 %7건 추가/%8건 밀려남, 스냅샷 %9회, 검색 %10회 (평균 %11us)")
+        .arg(m_rows).arg(m_sealed.size() + (m_open ? 1 : 0)).arg(bytes / 1024)
+        .arg(m_devices->size() - 1).arg(m_codes->size() - 1).arg(m_vocabulary.size())
+        .arg(m_appended).arg(m_evicted).arg(m_snapshots)
+        .arg(m_searches).arg(m_searches > 0 ? m_searchUs / static_cast<qint64>(m_searches) : 0);
+}
@@ -0,0 +1,218 @@
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QJsonObject>
+#include <QMetaType>
+#include <QMap>
+#include <QSet>
+#include <array>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// 메모리 안 로그 이력 (열 단위)
+// - 행마다 QJsonObject를 들고 있지 않고 열로 나눠 저장:
+//   timestamp(int64), 기기/코드(사전 번호), 레벨(enum), 반복 건수, 메시지(문자열 arena 오프셋)
+// - 4096행 단위 청크, 꽉 차면 봉인(불변) → 스냅샷은 청크 포인터만 복사 (행 복사 없음)
+//   스냅샷은 불변이라 창끼리 나눠 쓰고 워커 스레드로 넘겨도 됨
+// - 청크마다 기기별/코드별/메시지 단어별 행 목록 → 기기 하나 조회하거나 검색할 때 전체를 훑지 않음
+//   청크의 timestamp 최소/최대 + 시간순 행 번호 → 날짜 범위 밖 청크는 건너뛰고 걸친 청크는 이분 탐색
+// - 최대 행 수(logstore/max_rows, 기본 1,000,000)를 넘으면 오래된 청크부터 버림
+
+enum class LogLevel : quint8 {
+    Unknown = 0,
+    Info,
+    Warning,
+    Error
+};
+
+namespace LogColumns {
+const int kChunkRows = 4096;
+
+struct Chunk {
+    std::vector<qint64>  timestamps;
+    std::vector<quint16> devices;           // Dictionary 번호
+    std::vector<quint16> codes;
+    std::vector<quint8>  levels;            // LogLevel
+    std::vector<quint32> repeats;           // 묶인 건수 (repeat_count, 보통 1)
+    std::vector<quint32> messageEnds;       // arena 안 메시지 끝 오프셋 (시작 = 앞 행의 끝)
+    QByteArray arena;                       // 메시지 UTF-8 이어붙임
+
+    // 청크 안 행 번호 (오래된 것부터)
+    QHash<quint16, std::vector<quint16>> byDevice;
+    QHash<quint16, std::vector<quint16>> byCode;
+    QHash<quint32, std::vector<quint16>> byToken;   // 메시지 단어(소문자) 해시 → 행
+    std::vector<quint16> byTime;                    // timestamp 순 행 번호 (봉인/스냅샷 때 채움)
+    qint64 minTimestamp = std::numeric_limits<qint64>::max();
+    qint64 maxTimestamp = std::numeric_limits<qint64>::min();
+    bool untrackedTokens = false;   // 단어 목록 상한으로 목록에 못 넣은 단어가 있음 → 검색어는 이 청크를 훑어 확인
+
+    int size() const { return static_cast<int>(timestamps.size()); }
+};
+
+// 번호 → 문자열 (0번은 빈 문자열), 새 값은 제자리에 덧붙임
+// 256개짜리 블록으로 잡아 덧붙여도 이미 있는 값은 옮겨지지 않음 → 스냅샷은 만들 때의 개수까지만 읽으므로
+// 스토어가 덧붙이는 동안 다른 스레드에서 읽어도 됨 (size()는 스토어 쪽에서만)
+class Dictionary
+{
+public:
+    Dictionary();
+
+    // 새 번호, 꽉 차면 0
+    quint16 append(const QString &value);
+    int size() const { return m_size; }
+    const QString &at(int id) const { return m_blocks[id >> kBlockBits][id & (kBlockSize - 1)]; }
+
+private:
+    static const int kBlockBits = 8;
+    static const int kBlockSize = 1 << kBlockBits;
+    static const int kBlocks = 65536 / kBlockSize;
+
+    std::array<std::unique_ptr<QString[]>, kBlocks> m_blocks;
+    int m_size = 0;
+};
+
+// 메시지를 단어로 (글자/숫자가 이어진 부분, 소문자)
+QStringList tokenize(const QString &text);
+quint32 tokenHash(const QString &token);
+}
+
+class LogSnapshot
+{
+public:
+    struct Row {
+        qint64  timestamp = 0;
+        QString deviceId;
+        QString logCode;
+        LogLevel level = LogLevel::Unknown;
+        int     repeatCount = 1;
+        QString message;
+
+        QJsonObject toJson() const;
+    };
+
+    LogSnapshot() = default;
+
+    int size() const { return m_rows; }
+    bool isEmpty() const { return m_rows == 0; }
+
+    // timestamp 최신순 (같은 시각이면 나중에 들어온 것 먼저), limit <= 0 이면 전부
+    // 백필/복원으로 과거 로그가 나중에 들어와도 청크의 timestamp 최소/최대로 최신 청크부터 고름
+    QList<QJsonObject> newest(int limit) const;
+    QList<QJsonObject> newestForDevice(const QString &deviceId, int limit) const;
+    QList<QJsonObject> newestForDevices(const QStringList &deviceIds, int limit) const;
+    int countForDevice(const QString &deviceId) const;
+    int countForCode(const QString &logCode) const;
+
+    // 이 스냅샷에 나오는 기기 ID (prefix로 거르기용)
+    QStringList deviceIds() const;
+
+    // 오래된 것부터 전부 방문 (차트 집계 같은 일괄 처리용)
+    void forEach(const std::function<void(const Row &)> &visit) const;
+
+private:
+    friend class LogStore;
+
+    Row rowAt(const LogColumns::Chunk &chunk, int row) const;
+    int lookup(const LogColumns::Dictionary *dictionary, int count, const QString &value) const;
+    QList<QJsonObject> newestForIds(const QVector<quint16> &deviceIds, int limit) const;
+
+    std::vector<std::shared_ptr<const LogColumns::Chunk>> m_chunks;     // 오래된 것부터
+    std::shared_ptr<const LogColumns::Dictionary> m_devices;
+    std::shared_ptr<const LogColumns::Dictionary> m_codes;
+    int m_deviceCount = 0;      // 스냅샷을 만들 때의 사전 크기 (그 뒤에 덧붙은 것은 읽지 않음)
+    int m_codeCount = 0;
+    int m_rows = 0;
+};
+
+Q_DECLARE_METATYPE(LogSnapshot)
+
+// 로컬 로그 검색 조건 (LogStore::search, 입력하는 대로 목록 거르기)
+// text는 공백으로 나눈 단어가 모두 맞아야 함 - 단어마다 기기 ID/코드에 들어있거나 메시지에 그 단어로 시작하는 말이 있으면
+struct LogQuery {
+    QString text;
+    QStringList deviceIds;                  // 비어있으면 모든 기기
+    QString logCode;                        // 정확히 같은 코드만, 비어있으면 모든 코드
+    LogLevel level = LogLevel::Unknown;     // Unknown이면 모든 레벨
+    qint64  startMs = 0;                    // 0이면 제한 없음
+    qint64  endMs = 0;                      // 포함, 0이면 제한 없음
+
+    QStringList terms() const;
+    bool matches(const LogSnapshot::Row &row) const;
+    bool matches(const LogSnapshot::Row &row, const QStringList &words) const;     // words = terms() 미리 나눈 것
+    bool matches(const QJsonObject &log) const;
+};
+
+class LogStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static LogStore* instance();
+
+    // 로그 한 건 (device_id, log_code, log_level, message, timestamp, repeat_count)
+    void append(const QJsonObject &log);
+    void append(const LogSnapshot::Row &row);
+    void clear();
+
+    LogSnapshot snapshot() const;
+
+    // 색인으로 찾은 timestamp 최신순 limit건 (limit <= 0 이면 전부) - GUI 스레드에서 입력마다 불러도 한 프레임 안
+    QList<QJsonObject> search(const LogQuery &query, int limit) const;
+
+    int size() const { return m_rows; }
+    int maxRows() const { return m_maxRows; }
+    QString report() const;
+
+    static LogLevel levelFromString(const QString &level);
+    static QString levelToString(LogLevel level);
+    static LogSnapshot::Row rowFromJson(const QJsonObject &log);
+
+signals:
+    // 상한을 넘어 오래된 청크를 버림 - 버린 행들의 timestamp 범위 (날짜 검색 계획기가 덮인 구간에서 뺌)
+    void evicted(qint64 fromMs, qint64 toMs);
+
+private:
+    explicit LogStore(QObject *parent = nullptr);
+
+    quint16 intern(LogColumns::Dictionary &dictionary, QHash<QString, quint16> &lookup, const QString &value);
+    void indexTokens(LogColumns::Chunk &chunk, quint16 row, const QString &message);
+    void seal();
+    void evict();
+
+    std::deque<std::shared_ptr<const LogColumns::Chunk>> m_sealed;
+    std::shared_ptr<LogColumns::Chunk> m_open;                          // 쓰는 중인 청크 (스토어만 가짐)
+    mutable std::shared_ptr<const LogColumns::Chunk> m_openSnapshot;    // m_open 복사본, 다음 append까지 재사용
+
+    std::shared_ptr<LogColumns::Dictionary> m_devices;
+    std::shared_ptr<LogColumns::Dictionary> m_codes;
+    QHash<QString, quint16> m_deviceLookup;
+    QHash<QString, quint16> m_codeLookup;
+
+    // 메시지 단어 목록 (소문자 → 해시), 앞부분으로 찾기용
+    // 단어마다 그 단어가 있는 청크 수 - 청크가 밀려나 0이 되면 뺌
+    // 상한에 걸려 못 넣은 단어가 있는 청크만 검색 때 훑어 확인 (Chunk::untrackedTokens)
+    struct Word {
+        quint32 hash = 0;
+        int chunks = 0;
+    };
+    QMap<QString, Word> m_vocabulary;
+    QSet<QString> m_openWords;                  // 쓰는 중인 청크에서 센 단어
+    std::deque<QStringList> m_sealedWords;      // m_sealed와 같은 순서, 청크마다 센 단어
+    int m_untrackedChunks = 0;
+
+    int m_rows = 0;
+    int m_maxRows = 1000000;
+    quint64 m_appended = 0;
+    quint64 m_evicted = 0;
+    mutable quint64 m_snapshots = 0;
+    mutable quint64 m_searches = 0;
+    mutable qint64  m_searchUs = 0;         // 누적 검색 시간
+};
+
+#endif // LOG_STORE_H
@@ -0,0 +1,241 @@
+#include "message_ingest.h"
+#include "mqtt_hub.h"
+#include "stats_rollup.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const char *kErrorLogFilter   = "factory/+/log/error";
+const char *kInfoLogFilter    = "factory/+/log/info";
+const char *kStatisticsFilter = "factory/+/msg/statistics";
+const char *kLogResponseFilter = "factory/+/log/response";
+const char *kStatusFilter     = "+/status";
+
+// 서버가 숫자를 문자열로 보내는 경우가 있어서 ("0.0123") 둘 다 처리
+double toNumber(const QJsonValue &value)
+{
+    return value.isString() ? value.toString().toDouble() : value.toDouble();
+}
+}
+
+MessageIngest* MessageIngest::instance()
+{
+    static QPointer<MessageIngest> ingest;
+    if (!ingest) {
+        qRegisterMetaType<LogEventPtr>("LogEventPtr");
+        qRegisterMetaType<SpeedStatsPtr>("SpeedStatsPtr");
+        qRegisterMetaType<FailureStatsPtr>("FailureStatsPtr");
+        qRegisterMetaType<DeviceStatusPtr>("DeviceStatusPtr");
+        ingest = new MessageIngest(QCoreApplication::instance());
+    }
+    return ingest;
+}
+
+MessageIngest::MessageIngest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void MessageIngest::connectNotify(const QMetaMethod &signal)
+{
+    if (signal == QMetaMethod::fromSignal(&MessageIngest::logEvent)) {
+        ensureSubscribed(kErrorLogFilter);
+        ensureSubscribed(kInfoLogFilter);
+    } else if (signal == QMetaMethod::fromSignal(&MessageIngest::speedStats)) {
+        ensureSubscribed(kStatisticsFilter);
+    } else if (signal == QMetaMethod::fromSignal(&MessageIngest::failureStats)) {
+        ensureSubscribed(kInfoLogFilter);
+        ensureSubscribed(kLogResponseFilter);
+    } else if (signal == QMetaMethod::fromSignal(&MessageIngest::deviceStatus)) {
+        ensureSubscribed(kStatusFilter);
+    }
+}
+
+void MessageIngest::ensureSubscribed(const QString &filter)
+{
+    if (m_subscribed.contains(filter)) return;
+    m_subscribed.insert(filter);
+
+    MqttHub *hub = MqttHub::instance();
+    if (filter == kErrorLogFilter) {
+        // 오류 로그는 QoS 1 - 지속 세션에서 오프라인 동안 브로커가 보관 (QoS 1로 발행된 것만)
+        hub->subscribe(filter, this, &MessageIngest::onLogMessage, 1);
+    } else if (filter == kInfoLogFilter) {
+        hub->subscribe(filter, this, &MessageIngest::onLogMessage);
+    } else if (filter == kStatisticsFilter) {
+        hub->subscribe(filter, this, &MessageIngest::onStatisticsMessage);
+    } else if (filter == kLogResponseFilter) {
+        hub->subscribe(filter, this, &MessageIngest::onLogResponseMessage);
+    } else if (filter == kStatusFilter) {
+        hub->subscribe(filter, this, &MessageIngest::onStatusMessage);
+    }
+    qDebug() << "[Ingest] 구독 등록:" << filter;
+}
+
+/* ---------- 기기별 구독 ---------- */
+
+void MessageIngest::addDeviceRoute(const QString &deviceId, QObject *receiver, DeviceRoute route)
+{
+    if (deviceId.isEmpty() || !receiver) return;
+
+    // 와일드카드 구독은 그대로 하나 (기기마다 브로커 구독을 늘리지 않음), 분배만 기기별로
+    if (route.onLog) {
+        ensureSubscribed(kErrorLogFilter);
+        ensureSubscribed(kInfoLogFilter);
+    } else if (route.onSpeed) {
+        ensureSubscribed(kStatisticsFilter);
+    } else if (route.onFailure) {
+        ensureSubscribed(kInfoLogFilter);
+        ensureSubscribed(kLogResponseFilter);
+    } else if (route.onStatus) {
+        ensureSubscribed(kStatusFilter);
+    }
+
+    route.receiver = receiver;
+    m_deviceRoutes[deviceId].append(route);
+    connect(receiver, &QObject::destroyed, this, &MessageIngest::onDeviceReceiverDestroyed, Qt::UniqueConnection);
+}
+
+void MessageIngest::unsubscribeDevice(const QString &deviceId, QObject *receiver)
+{
+    auto it = m_deviceRoutes.find(deviceId);
+    if (it == m_deviceRoutes.end()) return;
+
+    it->erase(std::remove_if(it->begin(), it->end(), [receiver](const DeviceRoute &route) {
+                  return route.receiver.isNull() || route.receiver == receiver;
+              }), it->end());
+    if (it->isEmpty()) m_deviceRoutes.erase(it);
+}
+
+void MessageIngest::onDeviceReceiverDestroyed(QObject *receiver)
+{
+    const QStringList devices = m_deviceRoutes.keys();
+    for (const QString &deviceId : devices) unsubscribeDevice(deviceId, receiver);
+}
+
+template <typename Ptr>
+void MessageIngest::deliverToDevice(const QString &deviceId, std::function<void(const Ptr &)> DeviceRoute::*handler, const Ptr &value)
+{
+    if (!value) return;
+    auto it = m_deviceRoutes.constFind(deviceId);
+    if (it == m_deviceRoutes.constEnd()) return;
+
+    // 핸들러 안에서 구독을 바꿀 수 있으니 복사본으로
+    const QList<DeviceRoute> routes = it.value();
+    for (const DeviceRoute &route : routes) {
+        if (route.receiver && route.*handler) (route.*handler)(value);
+    }
+}
+
+/* ---------- 디코더 ---------- */
+
+LogEventPtr MessageIngest::decodeLog(const QString &deviceId, const QString &logLevel, const QByteArray &payload)
+{
+    return decodeLog(deviceId, logLevel, QJsonDocument::fromJson(payload).object());
+}
+
+LogEventPtr MessageIngest::decodeLog(const QString &deviceId, const QString &logLevel, const QJsonObject &object)
+{
+    auto event = std::make_shared<LogEvent>();
+    event->json = object;
+    event->json["device_id"] = deviceId;
+    event->json["log_level"] = logLevel;
+
+    event->deviceId = deviceId;
+    event->logLevel = logLevel;
+    event->logCode = object.value("log_code").toString();
+    if (object.value("message").isString()) {
+        event->message = object.value("message").toString();
+    }
+    event->timestamp = object.value("timestamp").toVariant().toLongLong();
+    return event;
+}
+
+SpeedStatsPtr MessageIngest::decodeSpeedStats(const QString &deviceId, const QByteArray &payload)
+{
+    const QJsonObject object = QJsonDocument::fromJson(payload).object();
+
+    auto stats = std::make_shared<SpeedStats>();
+    stats->json = object;
+    stats->deviceId = object.value("device_id").toString(deviceId);
+    stats->currentSpeed = toNumber(object.value("current_speed"));
+    stats->average = toNumber(object.value("average"));
+    stats->receivedAt = MqttHub::instance()->messageTime();
+    return stats;
+}
+
+FailureStatsPtr MessageIngest::decodeFailure(const QString &deviceId, const QJsonObject &failureObject, FailureStats::Source source)
+{
+    if (!failureObject.contains("failure")) return nullptr;
+
+    auto stats = std::make_shared<FailureStats>();
+    stats->deviceId = deviceId;
+    stats->failureRate = toNumber(failureObject.value("failure")) * 100;  // 1.0000 → 100%
+    stats->total = static_cast<int>(toNumber(failureObject.value("total")));
+    stats->pass = static_cast<int>(toNumber(failureObject.value("pass")));
+    stats->fail = static_cast<int>(toNumber(failureObject.value("fail")));
+    stats->source = source;
+    stats->receivedAt = MqttHub::instance()->messageTime();
+    return stats;
+}
+
+/* ---------- 토픽 핸들러 ---------- */
+
+void MessageIngest::onLogMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic)
+{
+    const QString deviceId = captures.value(0);
+    const QString logLevel = topic.name().section('/', -1);   // error | info
+    const QJsonObject object = QJsonDocument::fromJson(payload).object();
+
+    // info 로그의 message가 객체이면 불량률 통계
+    if (logLevel == "info") {
+        const QJsonValue message = object.value("message");
+        if (message.isObject()) {
+            if (FailureStatsPtr failure = decodeFailure(deviceId, message.toObject(), FailureStats::InfoLog)) {
+                emit failureStats(failure);
+                deliverToDevice(deviceId, &DeviceRoute::onFailure, failure);
+            }
+        }
+    }
+
+    const LogEventPtr event = decodeLog(deviceId, logLevel, object);
+    emit logEvent(event);
+    deliverToDevice(deviceId, &DeviceRoute::onLog, event);
+}
+
+void MessageIngest::onStatisticsMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic)
+{
+    Q_UNUSED(topic);
+    // 오늘 통계 증분 요청의 응답이면 누적에 합친 값(하루 평균)으로 바뀜
+    const SpeedStatsPtr stats = StatsRollup::instance()->absorb(decodeSpeedStats(captures.value(0), payload));
+    emit speedStats(stats);
+    deliverToDevice(stats->deviceId, &DeviceRoute::onSpeed, stats);
+}
+
+void MessageIngest::onLogResponseMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic)
+{
+    Q_UNUSED(topic);
+    const QJsonObject response = QJsonDocument::fromJson(payload).object();
+    const QJsonObject message = response.value("data").toObject().value("message").toObject();
+
+    if (FailureStatsPtr failure = decodeFailure(captures.value(0), message, FailureStats::LogResponse)) {
+        emit failureStats(failure);
+        deliverToDevice(failure->deviceId, &DeviceRoute::onFailure, failure);
+    }
+}
+
+void MessageIngest::onStatusMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic)
+{
+    Q_UNUSED(topic);
+    auto status = std::make_shared<DeviceStatus>();
+    status->deviceId = captures.value(0);
+    status->status = QString::fromUtf8(payload);
+    status->receivedAt = MqttHub::instance()->messageTime();
+    emit deviceStatus(status);
+    deliverToDevice(status->deviceId, &DeviceRoute::onStatus, status);
+}
@@ -0,0 +1,105 @@
+#ifndef MESSAGE_INGEST_H
+#define MESSAGE_INGEST_H
+
+#include <QObject>
+#include <QSet>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QMetaMethod>
+#include <QtMqtt/QMqttTopicName>
+#include <functional>
+#include "message_types.h"
+
+// 수신 계층: 로그/통계/상태 메시지를 메시지당 한 번만 디코딩해서 타입별 시그널로 뿌린다
+// - 창 개수만큼 QJsonDocument::fromJson 하던 것을 여기 한 곳으로 모음
+// - 시그널에 처음 연결될 때 해당 토픽만 MqttHub에 구독 (아무도 안 듣는 토픽은 구독하지 않음)
+// - 한 기기만 보는 창은 subscribeDevice로 - 트라이가 잡은 기기 id(캡처)로 그 기기 소비자에게만 전달
+class MessageIngest : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MessageIngest* instance();
+
+    // 디코더 (재생/시뮬레이터 등에서도 재사용)
+    static LogEventPtr decodeLog(const QString &deviceId, const QString &logLevel, const QByteArray &payload);
+    static LogEventPtr decodeLog(const QString &deviceId, const QString &logLevel, const QJsonObject &object);
+    static SpeedStatsPtr decodeSpeedStats(const QString &deviceId, const QByteArray &payload);
+    static FailureStatsPtr decodeFailure(const QString &deviceId, const QJsonObject &failureObject, FailureStats::Source source);
+
+    // deviceId 것만 받음 (전체 시그널을 받아 deviceId를 비교해 버리지 않아도 됨), receiver가 파괴되면 자동 해제
+    template <typename Receiver>
+    void subscribeDevice(const QString &deviceId, Receiver *receiver, void (Receiver::*slot)(const LogEventPtr &))
+    {
+        DeviceRoute route;
+        route.onLog = [receiver, slot](const LogEventPtr &event) { (receiver->*slot)(event); };
+        addDeviceRoute(deviceId, receiver, route);
+    }
+
+    template <typename Receiver>
+    void subscribeDevice(const QString &deviceId, Receiver *receiver, void (Receiver::*slot)(const SpeedStatsPtr &))
+    {
+        DeviceRoute route;
+        route.onSpeed = [receiver, slot](const SpeedStatsPtr &stats) { (receiver->*slot)(stats); };
+        addDeviceRoute(deviceId, receiver, route);
+    }
+
+    template <typename Receiver>
+    void subscribeDevice(const QString &deviceId, Receiver *receiver, void (Receiver::*slot)(const FailureStatsPtr &))
+    {
+        DeviceRoute route;
+        route.onFailure = [receiver, slot](const FailureStatsPtr &stats) { (receiver->*slot)(stats); };
+        addDeviceRoute(deviceId, receiver, route);
+    }
+
+    template <typename Receiver>
+    void subscribeDevice(const QString &deviceId, Receiver *receiver, void (Receiver::*slot)(const DeviceStatusPtr &))
+    {
+        DeviceRoute route;
+        route.onStatus = [receiver, slot](const DeviceStatusPtr &status) { (receiver->*slot)(status); };
+        addDeviceRoute(deviceId, receiver, route);
+    }
+
+    void unsubscribeDevice(const QString &deviceId, QObject *receiver);
+
+signals:
+    void logEvent(const LogEventPtr &event);
+    void speedStats(const SpeedStatsPtr &stats);
+    void failureStats(const FailureStatsPtr &stats);
+    void deviceStatus(const DeviceStatusPtr &status);
+
+protected:
+    void connectNotify(const QMetaMethod &signal) override;
+
+private slots:
+    void onDeviceReceiverDestroyed(QObject *receiver);
+
+private:
+    explicit MessageIngest(QObject *parent = nullptr);
+
+    // 기기별 소비자 - 한 번 등록에 핸들러 하나만 채워짐
+    struct DeviceRoute {
+        QPointer<QObject> receiver;
+        std::function<void(const LogEventPtr &)> onLog;
+        std::function<void(const SpeedStatsPtr &)> onSpeed;
+        std::function<void(const FailureStatsPtr &)> onFailure;
+        std::function<void(const DeviceStatusPtr &)> onStatus;
+    };
+
+    void addDeviceRoute(const QString &deviceId, QObject *receiver, DeviceRoute route);
+    template <typename Ptr>
+    void deliverToDevice(const QString &deviceId, std::function<void(const Ptr &)> DeviceRoute::*handler, const Ptr &value);
+
+    void ensureSubscribed(const QString &filter);
+
+    void onLogMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic);
+    void onStatisticsMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic);
+    void onLogResponseMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic);
+    void onStatusMessage(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic);
+
+    QSet<QString> m_subscribed;
+    QHash<QString, QList<DeviceRoute>> m_deviceRoutes;     // deviceId → 그 기기만 받는 소비자
+};
+
+#endif // MESSAGE_INGEST_H
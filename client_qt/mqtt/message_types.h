@@ -0,0 +1,61 @@
+#ifndef MESSAGE_TYPES_H
+#define MESSAGE_TYPES_H
+
+#include <QString>
+#include <QJsonObject>
+#include <QMetaType>
+#include <memory>
+
+// 수신 메시지를 한 번만 파싱해서 만드는 불변 공유 구조체들
+// 소비자(Home, 피더/컨베이어 창, 챗봇)는 같은 인스턴스를 공유 포인터로 받는다
+
+// factory/<device>/log/error, factory/<device>/log/info
+struct LogEvent {
+    QString deviceId;
+    QString logLevel;       // "error" | "info"
+    QString logCode;        // SPD, INF ...
+    QString message;        // message가 문자열일 때만
+    qint64  timestamp = 0;
+    QJsonObject json;       // device_id, log_level 이 채워진 원본 (기존 QJsonObject API용, 암시적 공유)
+};
+
+// factory/<device>/msg/statistics
+struct SpeedStats {
+    QString deviceId;
+    double  currentSpeed = 0.0;
+    double  average = 0.0;
+    qint64  receivedAt = 0;
+    QJsonObject json;       // 원본 (onDeviceStatsReceived 호환)
+};
+
+// factory/<device>/log/info 의 message.failure, factory/<device>/log/response 의 data.message.failure
+struct FailureStats {
+    enum Source { InfoLog, LogResponse };
+
+    QString deviceId;
+    double  failureRate = 0.0;   // 백분율 (0~100)
+    int     total = 0;
+    int     pass = 0;
+    int     fail = 0;
+    Source  source = InfoLog;
+    qint64  receivedAt = 0;
+};
+
+// <device>/status (on, off, reverse, SPEED_xx ...)
+struct DeviceStatus {
+    QString deviceId;
+    QString status;
+    qint64  receivedAt = 0;
+};
+
+using LogEventPtr     = std::shared_ptr<const LogEvent>;
+using SpeedStatsPtr   = std::shared_ptr<const SpeedStats>;
+using FailureStatsPtr = std::shared_ptr<const FailureStats>;
+using DeviceStatusPtr = std::shared_ptr<const DeviceStatus>;
+
+Q_DECLARE_METATYPE(LogEventPtr)
+Q_DECLARE_METATYPE(SpeedStatsPtr)
+Q_DECLARE_METATYPE(FailureStatsPtr)
+Q_DECLARE_METATYPE(DeviceStatusPtr)
+
+#endif // MESSAGE_TYPES_H
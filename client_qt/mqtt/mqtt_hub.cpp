@@ -0,0 +1,462 @@
+#include "mqtt_hub.h"
+#include "capture_journal.h"
+#include "log_categories.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QRandomGenerator>
+#include <QUuid>
+#include <QDebug>
+#include <algorithm>
+#include <utility>
+
+namespace {
+const int kReconnectBaseMs = 1000;
+const int kReconnectMaxMs = 30000;
+const int kClientIdSlots = 4;       // 같은 PC에서 동시에 띄울 수 있는 인스턴스 수 (넘으면 일회용 clientId)
+}
+
+MqttHub* MqttHub::instance()
+{
+    static QPointer<MqttHub> hub;
+    if (!hub) {
+        hub = new MqttHub(QCoreApplication::instance());
+    }
+    return hub;
+}
+
+MqttHub::MqttHub(QObject *parent)
+    : QObject(parent)
+{
+    // 부하 테스트 때 로컬 브로커(fleet_simulator)로 돌릴 수 있게 환경 변수로 덮어씀
+    if (qEnvironmentVariableIsSet("VISIONCRAFT_MQTT_HOST")) {
+        m_broker = qEnvironmentVariable("VISIONCRAFT_MQTT_HOST");
+    }
+    if (qEnvironmentVariableIsSet("VISIONCRAFT_MQTT_PORT")) {
+        m_port = qEnvironmentVariableIntValue("VISIONCRAFT_MQTT_PORT");
+    }
+    qDebug() << "[MqttHub] 브로커:" << m_broker << m_port;
+
+    m_client = new QMqttClient(this);
+    m_client->setHostname(m_broker);
+    m_client->setPort(m_port);
+    // 재시작해도 같은 clientId + clean session 끔 → 브로커가 세션(구독, QoS 1 메시지)을 보관
+    m_client->setClientId(persistentClientId());
+    m_client->setCleanSession(false);
+
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setSingleShot(true);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &MqttHub::connectToBroker);
+
+    connect(m_client, &QMqttClient::connected, this, &MqttHub::onClientConnected);
+    connect(m_client, &QMqttClient::disconnected, this, &MqttHub::onClientDisconnected);
+    connect(m_client, &QMqttClient::stateChanged, this, &MqttHub::onClientStateChanged);
+    connect(m_client, &QMqttClient::brokerSessionRestored, this, &MqttHub::onBrokerSessionRestored);
+
+    // 연결 단위 시그널은 PUBLISH 패킷 하나당 한 번만 발생 → 구독이 겹쳐도 중복 처리 없음
+    connect(m_client, &QMqttClient::messageReceived, this, &MqttHub::dispatch);
+}
+
+bool MqttHub::isConnected() const
+{
+    return m_client && m_client->state() == QMqttClient::Connected;
+}
+
+QString MqttHub::clientId() const
+{
+    return m_client ? m_client->clientId() : QString();
+}
+
+QString MqttHub::persistentClientId()
+{
+    QSettings settings("VisionCraft", "client_qt");
+    const QString lockDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+
+    // 같은 clientId로 두 인스턴스가 붙으면 브로커가 서로를 끊어버리므로 슬롯마다 잠금
+    for (int slot = 0; slot < kClientIdSlots; ++slot) {
+        auto lock = std::make_unique<QLockFile>(lockDir + QString("/visioncraft_mqtt_%1.lock").arg(slot));
+        if (!lock->tryLock(0)) continue;
+
+        const QString key = QString("mqtt/client_id_%1").arg(slot);
+        QString id = settings.value(key).toString();
+        if (id.isEmpty()) {
+            id = "VisionCraft_" + QUuid::createUuid().toString(QUuid::Id128).left(12);
+            settings.setValue(key, id);
+        }
+        m_clientIdLock = std::move(lock);
+        qDebug() << "[MqttHub] 지속 세션 clientId:" << id << "(슬롯" << slot << ")";
+        return id;
+    }
+
+    qDebug() << "[MqttHub] clientId 슬롯이 모두 사용 중 → 일회용 clientId";
+    return "VisionCraft_" + QString::number(QDateTime::currentMSecsSinceEpoch());
+}
+
+void MqttHub::connectToBroker()
+{
+    if (m_replayMode) return;
+    if (m_connectHolds > 0) {
+        if (!m_connectDeferred) qDebug() << "[MqttHub] 연결 보류 중 - 풀리면 연결";
+        m_connectDeferred = true;
+        return;
+    }
+    if (m_client->state() == QMqttClient::Disconnected) {
+        qDebug() << "[MqttHub] 브로커 연결 시도:" << m_broker << m_port;
+        m_client->connectToHost();
+    }
+}
+
+void MqttHub::holdConnect()
+{
+    m_connectHolds++;
+}
+
+void MqttHub::releaseConnect()
+{
+    if (m_connectHolds == 0) return;
+    if (--m_connectHolds > 0 || !m_connectDeferred) return;
+
+    m_connectDeferred = false;
+    connectToBroker();
+}
+
+void MqttHub::subscribe(const QString &filter, QObject *receiver, Handler handler, quint8 qos)
+{
+    if (!handler) return;
+    subscribe(filter, receiver, RouteHandler([handler](const QStringList &, const QByteArray &payload, const QMqttTopicName &topic) {
+                  handler(payload, topic);
+              }), qos);
+}
+
+void MqttHub::subscribe(const QString &filter, QObject *receiver, RouteHandler handler, quint8 qos)
+{
+    if (!receiver || !handler) return;
+    if (!TopicRouter::isValidFilter(filter)) {
+        qDebug() << "[MqttHub] 잘못된 토픽 필터:" << filter;
+        return;
+    }
+
+    Consumer consumer;
+    consumer.filter = filter;
+    consumer.receiver = receiver;
+    consumer.handler = std::move(handler);
+    consumer.qos = qos;
+
+    const int routeId = m_nextRouteId++;
+    m_consumers.insert(routeId, consumer);
+    m_router.insert(filter, routeId);
+
+    connect(receiver, &QObject::destroyed, this, &MqttHub::onReceiverDestroyed, Qt::UniqueConnection);
+
+    syncSubscriptions();
+}
+
+void MqttHub::unsubscribe(const QString &filter, QObject *receiver)
+{
+    removeConsumers(receiver, filter);
+}
+
+void MqttHub::unsubscribeAll(QObject *receiver)
+{
+    removeConsumers(receiver);
+}
+
+bool MqttHub::publish(const QString &topic, const QByteArray &payload, quint8 qos, bool retain)
+{
+    if (!isConnected()) {
+        qDebug() << "[MqttHub] 연결 안됨, 발행 실패:" << topic;
+        return false;
+    }
+    return m_client->publish(QMqttTopicName(topic), payload, qos, retain) != -1;
+}
+
+void MqttHub::onClientConnected()
+{
+    qDebug() << "[MqttHub] 브로커 연결됨, clientId:" << m_client->clientId()
+             << "(재시도" << m_reconnectAttempt << "회 후)";
+    m_reconnectAttempt = 0;
+    m_reconnectTimer->stop();
+
+    m_brokerFilters.clear();
+    m_brokerQos.clear();
+    if (m_sessionRestored) {
+        // 브로커에 지난 구독이 남아 있음 → 걸려 있는 것으로 두고 syncSubscriptions가 차이만 해제/추가
+        // (세션이 없으면 전부 새로 구독)
+        const QHash<QString, quint8> persisted = loadSessionFilters();
+        for (auto it = persisted.cbegin(); it != persisted.cend(); ++it) {
+            m_brokerFilters.insert(it.key(), nullptr);
+            m_brokerQos.insert(it.key(), it.value());
+        }
+        qDebug() << "[MqttHub] 브로커 세션 이어받음 - 지난 구독" << persisted.size() << "개";
+    }
+    m_sessionRestored = false;
+    syncSubscriptions();
+    emit connected();
+
+    if (m_everConnected) {
+        const qint64 offlineMs = m_lastDisconnectedAt ? QDateTime::currentMSecsSinceEpoch() - m_lastDisconnectedAt : 0;
+        qDebug() << "[MqttHub] 재연결, 끊겨 있던 시간:" << offlineMs << "ms";
+        emit reconnected(offlineMs);
+    }
+    m_everConnected = true;
+}
+
+void MqttHub::onClientDisconnected()
+{
+    qDebug() << "[MqttHub] 브로커 연결 끊김";
+    m_lastDisconnectedAt = QDateTime::currentMSecsSinceEpoch();
+    m_brokerFilters.clear();
+    m_brokerQos.clear();
+    emit disconnected();
+}
+
+void MqttHub::onBrokerSessionRestored()
+{
+    m_sessionRestored = true;
+}
+
+void MqttHub::onClientStateChanged(QMqttClient::ClientState state)
+{
+    // 연결 중 실패(Connecting → Disconnected)도 여기로 오므로 재연결은 상태 변화 기준
+    if (state == QMqttClient::Disconnected) scheduleReconnect();
+}
+
+void MqttHub::scheduleReconnect()
+{
+    if (m_reconnectTimer->isActive()) return;
+
+    // 1s, 2s, 4s ... 최대 30s, 각 구간의 절반~전체 사이에서 무작위
+    const int shift = qMin(m_reconnectAttempt, 5);
+    const int ceiling = qMin(kReconnectMaxMs, kReconnectBaseMs << shift);
+    const int delay = ceiling / 2 + QRandomGenerator::global()->bounded(ceiling / 2 + 1);
+    m_reconnectAttempt++;
+
+    qDebug() << "[MqttHub]" << delay << "ms 후 재연결 (시도" << m_reconnectAttempt << ")";
+    m_reconnectTimer->start(delay);
+}
+
+void MqttHub::onReceiverDestroyed()
+{
+    // QPointer는 이미 비어있으므로 죽은 등록만 정리
+    removeConsumers(nullptr);
+}
+
+void MqttHub::dispatch(const QByteArray &payload, const QMqttTopicName &topic)
+{
+    m_messageTime = QDateTime::currentMSecsSinceEpoch();
+    if (CaptureJournal::isEnabled()) {
+        const bool known = (m_lastMessage.topic == topic.name());
+        CaptureJournal::instance()->record(topic.name(), payload, known ? m_lastMessage.qos : 0,
+                                           known && m_lastMessage.retain, m_messageTime);
+        m_lastMessage.topic.clear();
+    }
+    route(payload, topic);
+}
+
+void MqttHub::inject(const QString &topic, const QByteArray &payload, qint64 receivedAtMs)
+{
+    // 재생 메시지는 다시 기록하지 않음
+    m_messageTime = receivedAtMs > 0 ? receivedAtMs : QDateTime::currentMSecsSinceEpoch();
+    route(payload, QMqttTopicName(topic));
+}
+
+void MqttHub::route(const QByteArray &payload, const QMqttTopicName &topic)
+{
+    QElapsedTimer routeTimer;
+    routeTimer.start();
+
+    QVector<TopicRouter::Match> routes = m_router.match(topic.name());
+
+    // 맞는 등록 모두에 등록 순서대로 - 같은 수신자가 같은 필터를 두 번 등록한 것만 한 번
+    std::sort(routes.begin(), routes.end(), [](const TopicRouter::Match &a, const TopicRouter::Match &b) {
+        return a.routeId < b.routeId;
+    });
+
+    // 핸들러 안에서 구독을 추가/삭제할 수 있으므로 호출 대상을 먼저 확정
+    QVector<QPair<Consumer, QStringList>> targets;
+    QSet<QPair<QObject*, QString>> delivered;
+    for (const TopicRouter::Match &match : routes) {
+        auto it = m_consumers.constFind(match.routeId);
+        if (it == m_consumers.cend()) continue;
+        QObject *receiver = it->receiver.data();
+        if (!receiver) continue;
+        const QPair<QObject*, QString> key(receiver, it->filter);
+        if (delivered.contains(key)) continue;
+        delivered.insert(key);
+        targets.append(qMakePair(*it, match.captures));
+    }
+
+    const quint64 routeNs = static_cast<quint64>(routeTimer.nsecsElapsed());
+    m_stats.messages++;
+    m_stats.totalRouteNs += routeNs;
+    m_stats.maxRouteNs = qMax(m_stats.maxRouteNs, routeNs);
+    if (m_stats.messages % 1000 == 0) {
+        qCDebug(lcLive) << "[MqttHub] 라우팅 통계 - 메시지:" << m_stats.messages
+                 << "평균(ns):" << (m_stats.totalRouteNs / m_stats.messages)
+                 << "최대(ns):" << m_stats.maxRouteNs
+                 << "등록 필터:" << m_consumers.size();
+    }
+
+    for (const auto &target : targets) {
+        if (target.first.receiver.isNull()) continue;
+        target.first.handler(target.second, payload, topic);
+    }
+}
+
+void MqttHub::removeConsumers(QObject *receiver, const QString &filter)
+{
+    for (auto it = m_consumers.begin(); it != m_consumers.end(); ) {
+        const bool dead = it->receiver.isNull();
+        const bool target = receiver && it->receiver == receiver
+                            && (filter.isEmpty() || it->filter == filter);
+        if (dead || target) {
+            m_router.remove(it->filter, it.key());
+            it = m_consumers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    syncSubscriptions();
+}
+
+QHash<QString, quint8> MqttHub::minimalFilterSet() const
+{
+    // 1. 중복 필터 제거 (QoS는 가장 높은 값)
+    QHash<QString, quint8> unique;
+    for (const Consumer &consumer : std::as_const(m_consumers)) {
+        if (consumer.receiver.isNull()) continue;
+        unique[consumer.filter] = qMax(unique.value(consumer.filter, 0), consumer.qos);
+    }
+
+    // 2. 다른 필터에 완전히 포함되는 필터 제거 (예: factory/feeder_01/log/info ⊂ factory/+/log/info)
+    QHash<QString, quint8> minimal;
+    for (auto it = unique.cbegin(); it != unique.cend(); ++it) {
+        QString coveringFilter = it.key();
+        for (auto other = unique.cbegin(); other != unique.cend(); ++other) {
+            if (other.key() != it.key() && covers(other.key(), it.key())) {
+                coveringFilter = other.key();
+                break;
+            }
+        }
+        if (coveringFilter == it.key()) {
+            minimal[it.key()] = qMax(minimal.value(it.key(), 0), it.value());
+        }
+    }
+
+    // 3. 포함된 필터의 QoS를 덮는 필터에 반영
+    for (auto it = unique.cbegin(); it != unique.cend(); ++it) {
+        if (minimal.contains(it.key())) continue;
+        for (auto cover = minimal.begin(); cover != minimal.end(); ++cover) {
+            if (covers(cover.key(), it.key())) {
+                cover.value() = qMax(cover.value(), it.value());
+            }
+        }
+    }
+
+    return minimal;
+}
+
+void MqttHub::syncSubscriptions()
+{
+    if (!isConnected()) return;
+
+    const QHash<QString, quint8> wanted = minimalFilterSet();
+    bool changed = false;
+
+    // 더 이상 필요없는 구독 해제
+    const QStringList current = m_brokerFilters.keys();
+    for (const QString &filter : current) {
+        if (!wanted.contains(filter) || wanted.value(filter) != m_brokerQos.value(filter)) {
+            unsubscribeBroker(filter);
+            m_brokerFilters.remove(filter);
+            m_brokerQos.remove(filter);
+            changed = true;
+            qDebug() << "[MqttHub] 구독 해제:" << filter;
+        }
+    }
+
+    // 새로 필요한 구독 추가
+    for (auto it = wanted.cbegin(); it != wanted.cend(); ++it) {
+        if (m_brokerFilters.contains(it.key())) continue;
+
+        QMqttSubscription *sub = m_client->subscribe(QMqttTopicFilter(it.key()), it.value());
+        if (!sub) {
+            qDebug() << "[MqttHub] 구독 실패:" << it.key();
+            continue;
+        }
+        if (CaptureJournal::isEnabled()) {
+            connect(sub, &QMqttSubscription::messageReceived, this, [this](const QMqttMessage &message) {
+                m_lastMessage.topic = message.topic().name();
+                m_lastMessage.qos = message.qos();
+                m_lastMessage.retain = message.retain();
+            });
+        }
+        m_brokerFilters.insert(it.key(), sub);
+        m_brokerQos.insert(it.key(), it.value());
+        changed = true;
+        qDebug() << "[MqttHub] 구독:" << it.key() << "QoS" << it.value();
+    }
+
+    if (changed) saveSessionFilters();
+}
+
+void MqttHub::unsubscribeBroker(const QString &filter)
+{
+    // 세션으로 이어받은 필터는 이 연결에서 만든 구독 객체가 없어 QMqttClient가 해제 요청을 보내지 않음
+    // → 같은 필터로 구독 객체를 만든 뒤 해제 (브로커에 이미 있는 구독이라 SUBSCRIBE는 덮어쓰기일 뿐)
+    if (!m_brokerFilters.value(filter)) m_client->subscribe(QMqttTopicFilter(filter), m_brokerQos.value(filter));
+    m_client->unsubscribe(QMqttTopicFilter(filter));
+}
+
+QHash<QString, quint8> MqttHub::loadSessionFilters() const
+{
+    QSettings settings("VisionCraft", "client_qt");
+    const QVariantMap stored = settings.value("mqtt/session_filters/" + m_client->clientId()).toMap();
+    QHash<QString, quint8> filters;
+    for (auto it = stored.cbegin(); it != stored.cend(); ++it) {
+        if (TopicRouter::isValidFilter(it.key())) filters.insert(it.key(), static_cast<quint8>(it.value().toInt()));
+    }
+    return filters;
+}
+
+void MqttHub::saveSessionFilters() const
+{
+    // 세션으로 이어받은 것 포함 지금 브로커에 걸린 필터 (다음 접속 때 세션이 있으면 이것과 비교)
+    QVariantMap stored;
+    for (auto it = m_brokerQos.cbegin(); it != m_brokerQos.cend(); ++it) stored.insert(it.key(), it.value());
+    QSettings settings("VisionCraft", "client_qt");
+    settings.setValue("mqtt/session_filters/" + m_client->clientId(), stored);
+}
+
+bool MqttHub::matches(const QString &filter, const QString &topic)
+{
+    const QStringList f = filter.split('/');
+    const QStringList t = topic.split('/');
+
+    for (int i = 0; i < f.size(); ++i) {
+        if (f[i] == "#") return true;
+        if (i >= t.size()) return false;
+        if (f[i] != "+" && f[i] != t[i]) return false;
+    }
+    return f.size() == t.size();
+}
+
+bool MqttHub::covers(const QString &wider, const QString &narrower)
+{
+    // wider가 받는 토픽 집합이 narrower의 토픽 집합을 모두 포함하는지
+    const QStringList w = wider.split('/');
+    const QStringList n = narrower.split('/');
+
+    for (int i = 0; i < w.size(); ++i) {
+        if (w[i] == "#") return true;
+        if (i >= n.size()) return false;
+        if (n[i] == "#") return false;
+        if (w[i] == "+") continue;
+        if (n[i] == "+" || w[i] != n[i]) return false;
+    }
+    return w.size() == n.size();
+}
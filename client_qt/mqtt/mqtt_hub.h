@@ -0,0 +1,173 @@
+#ifndef MQTT_HUB_H
+#define MQTT_HUB_H
+
+#include <QObject>
+#include <QPointer>
+#include <QList>
+#include <QHash>
+#include <QStringList>
+#include <QTimer>
+#include <QLockFile>
+#include <QtMqtt/QMqttClient>
+#include <QtMqtt/QMqttMessage>
+#include <QtMqtt/QMqttSubscription>
+#include <functional>
+#include <memory>
+#include "topic_router.h"
+
+// 클라이언트 전체가 공유하는 단일 MQTT 연결
+// - 브로커 연결은 허브 하나만 가진다 (창마다 QMqttClient를 만들지 않음)
+// - 컴포넌트들이 등록한 필터를 모아서 겹치지 않는 최소 구독 집합만 브로커에 요청
+// - 수신 메시지는 토픽 트라이로 라우팅, 맞는 등록마다 한 번씩 전달 (등록 순서대로)
+//   한 컴포넌트가 겹치는 필터를 여러 개 등록했다면 각 핸들러가 모두 불림, 같은 필터를 두 번 등록한 것만 한 번으로
+// - clientId를 설정에 저장해 두고 clean session 없이 접속 → 브로커가 구독/QoS 1 메시지를 보관
+//   브로커가 세션을 이어받았다고 알리면(brokerSessionRestored) 지난 구독 중 그대로인 것은 다시 보내지 않고
+//   빠진 것만 해제/추가 (브로커에 걸린 필터 목록은 clientId별로 설정에 저장)
+// - 재연결은 지수 백오프 + 지터 (여러 운영 PC가 브로커 재시작 직후 한꺼번에 붙지 않도록)
+class MqttHub : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Handler = std::function<void(const QByteArray &payload, const QMqttTopicName &topic)>;
+    // captures: 필터의 '+' / '#' 자리에 걸린 세그먼트 (예: factory/+/log/error → {device_id})
+    using RouteHandler = std::function<void(const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic)>;
+
+    static MqttHub* instance();
+
+    QMqttClient* client() const { return m_client; }
+    bool isConnected() const;
+    QString clientId() const;
+
+    // 마지막으로 연결이 끊긴 시각 (epoch ms, 한 번도 안 끊겼으면 0)
+    qint64 lastDisconnectedAt() const { return m_lastDisconnectedAt; }
+    int reconnectAttempts() const { return m_reconnectAttempt; }
+
+    void connectToBroker();
+
+    // 연결 전에 끝나야 하는 일(시작 시 로컬 이력 복원 등)이 있으면 잡아 둠
+    // 잡혀 있는 동안 어디서 connectToBroker를 불러도 미뤄졌다가, 마지막 releaseConnect 때 한 번 연결
+    void holdConnect();
+    void releaseConnect();
+    bool isConnectHeld() const { return m_connectHolds > 0; }
+
+    // 저널 재생 (JournalReplayer): 브로커에 붙지 않고 기록된 메시지를 수신한 것처럼 흘려보냄
+    void setReplayMode(bool replay) { m_replayMode = replay; }
+    bool isReplayMode() const { return m_replayMode; }
+    void inject(const QString &topic, const QByteArray &payload, qint64 receivedAtMs = 0);
+
+    // 지금 라우팅 중인 메시지의 수신 시각 (실시간이면 지금, 재생이면 기록된 시각) - 핸들러 안에서만 의미 있음
+    qint64 messageTime() const { return m_messageTime; }
+
+    // receiver가 파괴되면 등록도 자동으로 정리된다
+    void subscribe(const QString &filter, QObject *receiver, RouteHandler handler, quint8 qos = 0);
+    void subscribe(const QString &filter, QObject *receiver, Handler handler, quint8 qos = 0);
+
+    template <typename Receiver>
+    void subscribe(const QString &filter, Receiver *receiver,
+                   void (Receiver::*slot)(const QByteArray &, const QMqttTopicName &),
+                   quint8 qos = 0)
+    {
+        subscribe(filter, receiver, Handler([receiver, slot](const QByteArray &payload, const QMqttTopicName &topic) {
+                      (receiver->*slot)(payload, topic);
+                  }), qos);
+    }
+
+    template <typename Receiver>
+    void subscribe(const QString &filter, Receiver *receiver,
+                   void (Receiver::*slot)(const QStringList &, const QByteArray &, const QMqttTopicName &),
+                   quint8 qos = 0)
+    {
+        subscribe(filter, receiver, RouteHandler([receiver, slot](const QStringList &captures, const QByteArray &payload, const QMqttTopicName &topic) {
+                      (receiver->*slot)(captures, payload, topic);
+                  }), qos);
+    }
+
+    void unsubscribe(const QString &filter, QObject *receiver);
+    void unsubscribeAll(QObject *receiver);
+
+    bool publish(const QString &topic, const QByteArray &payload, quint8 qos = 0, bool retain = false);
+
+    // 현재 브로커에 실제로 걸려있는 구독 필터 목록 (디버그용)
+    QStringList activeFilters() const { return m_brokerFilters.keys(); }
+
+    // 디스패치 비용 통계 (라우팅만, 핸들러 실행 시간 제외)
+    struct DispatchStats {
+        quint64 messages = 0;
+        quint64 totalRouteNs = 0;
+        quint64 maxRouteNs = 0;
+    };
+    DispatchStats dispatchStats() const { return m_stats; }
+
+    // 토픽 필터 유틸
+    static bool matches(const QString &filter, const QString &topic);
+    static bool covers(const QString &wider, const QString &narrower);
+
+signals:
+    void connected();
+    void disconnected();
+    // 끊겼다가 다시 연결됨 (connected 직후). offlineMs: 끊겨 있던 시간
+    void reconnected(qint64 offlineMs);
+
+private slots:
+    void onClientConnected();
+    void onClientDisconnected();
+    void onClientStateChanged(QMqttClient::ClientState state);
+    void onBrokerSessionRestored();
+    void onReceiverDestroyed();
+
+private:
+    explicit MqttHub(QObject *parent = nullptr);
+
+    QString persistentClientId();
+    void scheduleReconnect();
+
+    struct Consumer {
+        QString filter;
+        QPointer<QObject> receiver;
+        RouteHandler handler;
+        quint8 qos = 0;
+    };
+
+    void dispatch(const QByteArray &payload, const QMqttTopicName &topic);
+    void route(const QByteArray &payload, const QMqttTopicName &topic);
+    void syncSubscriptions();
+    void unsubscribeBroker(const QString &filter);
+    QHash<QString, quint8> loadSessionFilters() const;
+    void saveSessionFilters() const;
+    QHash<QString, quint8> minimalFilterSet() const;
+    void removeConsumers(QObject *receiver, const QString &filter = QString());
+
+    QMqttClient *m_client = nullptr;
+    QTimer *m_reconnectTimer = nullptr;
+    int m_reconnectAttempt = 0;
+    int m_connectHolds = 0;
+    bool m_connectDeferred = false;     // 잡혀 있는 동안 연결 요청이 있었음
+    bool m_everConnected = false;
+    bool m_sessionRestored = false;     // 이번 CONNACK이 세션 있음 (connected보다 먼저 옴)
+    qint64 m_lastDisconnectedAt = 0;
+    std::unique_ptr<QLockFile> m_clientIdLock;          // 같은 PC에서 두 번 실행하면 다른 clientId 슬롯 사용
+
+    QString m_broker = "mqtt.kwon.pics";
+    int m_port = 1883;
+
+    int m_nextRouteId = 1;
+    QHash<int, Consumer> m_consumers;                     // routeId -> 소비자
+    TopicRouter m_router;                                 // 필터 트라이 (routeId 저장)
+    QHash<QString, QMqttSubscription*> m_brokerFilters;   // 필터 -> 브로커 구독 (세션으로 이어받은 필터는 nullptr)
+    QHash<QString, quint8> m_brokerQos;
+
+    DispatchStats m_stats;
+    bool m_replayMode = false;
+    qint64 m_messageTime = 0;
+
+    // 구독 시그널(QoS/retain 포함)이 클라이언트 시그널보다 먼저 오므로 여기 잠깐 보관 → 저널에 기록
+    struct LastMessage {
+        QString topic;
+        quint8 qos = 0;
+        bool retain = false;
+    };
+    LastMessage m_lastMessage;
+};
+
+#endif // MQTT_HUB_H
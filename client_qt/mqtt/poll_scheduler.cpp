@@ -0,0 +1,281 @@
+#include "poll_scheduler.h"
+#include "mqtt_hub.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QWidget>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace {
+const int kCoalesceMs = 2000;           // 이 안에 같은 요청이 또 오면 합침
+const int kPausedRecheckMs = 2000;      // 멈춘 폴링이 다시 보이는지 확인하는 간격
+const int kConnectSpreadMinMs = 500;    // 연결 직후 첫 발행을 흩어 놓는 구간
+const int kConnectSpreadMaxMs = 3000;
+const qint64 kRateWindowMs = 10 * 60 * 1000;
+const int kReportEvery = 100;
+const qint64 kNever = std::numeric_limits<qint64>::max();
+}
+
+int PollScheduler::Poll::intervalMs() const
+{
+    int interval = 0;
+    for (const Consumer &consumer : consumers) {
+        if (!consumer.object || consumer.intervalMs <= 0) continue;
+        interval = interval == 0 ? consumer.intervalMs : qMin(interval, consumer.intervalMs);
+    }
+    return interval;
+}
+
+PollScheduler* PollScheduler::instance()
+{
+    static QPointer<PollScheduler> scheduler;
+    if (!scheduler) {
+        scheduler = new PollScheduler(QCoreApplication::instance());
+    }
+    return scheduler;
+}
+
+PollScheduler::PollScheduler(QObject *parent)
+    : QObject(parent)
+{
+    m_tickTimer = new QTimer(this);
+    m_tickTimer->setSingleShot(true);
+    connect(m_tickTimer, &QTimer::timeout, this, &PollScheduler::onTick);
+
+    connect(MqttHub::instance(), &MqttHub::connected, this, &PollScheduler::onConnected);
+}
+
+void PollScheduler::registerPoll(const QString &key, const QString &topic, int intervalMs,
+                                 PayloadBuilder build, QObject *consumer)
+{
+    if (!consumer || !build || intervalMs < 0) return;
+
+    auto it = m_polls.find(key);
+    if (it == m_polls.end()) {
+        Poll poll;
+        poll.key = key;
+        poll.topic = topic;
+        poll.build = std::move(build);
+        it = m_polls.insert(key, poll);
+        qDebug() << "[PollScheduler] 폴링 등록:" << key << topic << intervalMs << "ms";
+    } else {
+        // 같은 요청을 다른 창도 원함 → 발행은 하나로, 주기만 짧은 쪽으로
+        qDebug() << "[PollScheduler] 기존 폴링에 소비자 추가:" << key;
+    }
+
+    bool found = false;
+    for (Consumer &existing : it->consumers) {
+        if (existing.object == consumer) {
+            existing.intervalMs = intervalMs;
+            found = true;
+        }
+    }
+    if (!found) {
+        Consumer entry;
+        entry.object = consumer;
+        entry.intervalMs = intervalMs;
+        it->consumers.append(entry);
+        connect(consumer, &QObject::destroyed, this, &PollScheduler::onConsumerDestroyed, Qt::UniqueConnection);
+    }
+
+    // 처음 주기가 생기면 바로가 아니라 흩어서, 주기가 짧아졌으면 당겨서
+    const int interval = it->intervalMs();
+    if (interval > 0 && it->nextDue == kNever) {
+        it->nextDue = QDateTime::currentMSecsSinceEpoch()
+                      + QRandomGenerator::global()->bounded(kConnectSpreadMinMs, kConnectSpreadMaxMs + 1);
+    } else if (interval > 0 && it->lastPublished) {
+        it->nextDue = qMin(it->nextDue, it->lastPublished + interval);
+    }
+    scheduleTick();
+}
+
+void PollScheduler::unregisterPoll(const QString &key, QObject *consumer)
+{
+    auto it = m_polls.find(key);
+    if (it == m_polls.end()) return;
+
+    it->consumers.erase(std::remove_if(it->consumers.begin(), it->consumers.end(), [consumer](const Consumer &entry) {
+        return entry.object.isNull() || entry.object == consumer;
+    }), it->consumers.end());
+
+    if (it->consumers.isEmpty()) {
+        qDebug() << "[PollScheduler] 폴링 해제:" << key;
+        m_polls.erase(it);
+    } else if (it->intervalMs() == 0) {
+        it->nextDue = kNever;
+    }
+    scheduleTick();
+}
+
+void PollScheduler::onConsumerDestroyed(QObject *)
+{
+    // QPointer는 이미 비어있으므로 죽은 소비자만 정리
+    for (auto it = m_polls.begin(); it != m_polls.end(); ) {
+        it->consumers.erase(std::remove_if(it->consumers.begin(), it->consumers.end(), [](const Consumer &entry) {
+            return entry.object.isNull();
+        }), it->consumers.end());
+
+        if (it->consumers.isEmpty()) it = m_polls.erase(it);
+        else ++it;
+    }
+    scheduleTick();
+}
+
+bool PollScheduler::requestNow(const QString &key)
+{
+    auto it = m_polls.find(key);
+    if (it == m_polls.end()) return false;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (it->lastPublished && now - it->lastPublished < kCoalesceMs) {
+        m_rates[it->topic].coalesced++;
+        qDebug() << "[PollScheduler] 최근에 보낸 요청과 합침:" << key;
+        return true;
+    }
+
+    if (!publish(it.value())) return false;
+
+    it->nextDue = nextDueAfter(it.value(), now);
+    scheduleTick();
+    return true;
+}
+
+bool PollScheduler::isActive(const Poll &poll) const
+{
+    for (const Consumer &consumer : poll.consumers) {
+        if (!consumer.object) continue;
+        const QWidget *widget = qobject_cast<const QWidget *>(consumer.object.data());
+        if (!widget) return true;   // 화면 없는 소비자는 항상
+        if (widget->isVisible() && !widget->window()->isMinimized()) return true;
+    }
+    return false;
+}
+
+bool PollScheduler::publish(Poll &poll)
+{
+    if (!MqttHub::instance()->publish(poll.topic, poll.build())) return false;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QList<qint64> &history = m_history[poll.topic];
+    history.append(now);
+    pruneRate(poll.topic, now);
+
+    poll.lastPublished = now;
+    poll.paused = false;
+    m_rates[poll.topic].published++;
+
+    if (++m_publishedTotal % kReportEvery == 0) {
+        qDebug().noquote() << rateReport();
+    }
+    return true;
+}
+
+qint64 PollScheduler::nextDueAfter(const Poll &poll, qint64 now) const
+{
+    const int interval = poll.intervalMs();
+    if (interval == 0) return kNever;   // 수동 전용
+
+    const int spread = qMax(1, interval / 10);
+    return now + interval - spread + QRandomGenerator::global()->bounded(2 * spread + 1);
+}
+
+void PollScheduler::onConnected()
+{
+    // 재연결 직후 모든 폴링이 동시에 나가지 않도록 흩어서
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (Poll &poll : m_polls) {
+        if (poll.intervalMs() == 0) continue;
+        poll.nextDue = now + QRandomGenerator::global()->bounded(kConnectSpreadMinMs, kConnectSpreadMaxMs + 1);
+    }
+    scheduleTick();
+}
+
+void PollScheduler::onTick()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const bool connected = MqttHub::instance()->isConnected();
+
+    for (Poll &poll : m_polls) {
+        if (poll.nextDue > now) continue;
+
+        if (!connected) {
+            // 연결되면 onConnected에서 다시 잡힘
+            poll.nextDue = now + kPausedRecheckMs;
+            continue;
+        }
+        if (!isActive(poll)) {
+            if (!poll.paused) qDebug() << "[PollScheduler] 소비자가 안 보여서 멈춤:" << poll.key;
+            poll.paused = true;
+            m_rates[poll.topic].pausedTicks++;
+            poll.nextDue = now + kPausedRecheckMs;
+            continue;
+        }
+
+        // 수동 요청(requestNow)으로 최근에 나갔으면 이번 주기는 합침
+        if (poll.lastPublished && now - poll.lastPublished < kCoalesceMs) {
+            m_rates[poll.topic].coalesced++;
+        } else {
+            if (poll.paused) qDebug() << "[PollScheduler] 재개:" << poll.key;
+            if (!publish(poll)) {
+                poll.nextDue = now + kPausedRecheckMs;
+                continue;
+            }
+        }
+        poll.nextDue = nextDueAfter(poll, now);
+    }
+    scheduleTick();
+}
+
+void PollScheduler::scheduleTick()
+{
+    qint64 nearest = kNever;
+    for (const Poll &poll : std::as_const(m_polls)) {
+        nearest = qMin(nearest, poll.nextDue);
+    }
+
+    if (nearest == kNever) {
+        m_tickTimer->stop();
+        return;
+    }
+    const qint64 wait = qMax<qint64>(0, nearest - QDateTime::currentMSecsSinceEpoch());
+    m_tickTimer->start(static_cast<int>(qMin<qint64>(wait, std::numeric_limits<int>::max())));
+}
+
+void PollScheduler::pruneRate(const QString &topic, qint64 now) const
+{
+    QList<qint64> &history = m_history[topic];
+    while (!history.isEmpty() && history.first() < now - kRateWindowMs) history.removeFirst();
+}
+
+QHash<QString, PollScheduler::TopicRate> PollScheduler::topicRates() const
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QHash<QString, TopicRate> rates = m_rates;
+    for (auto it = rates.begin(); it != rates.end(); ++it) {
+        pruneRate(it.key(), now);
+        it->perMinute = m_history.value(it.key()).size() * 60000.0 / kRateWindowMs;
+    }
+    return rates;
+}
+
+QString PollScheduler::rateReport() const
+{
+    const QHash<QString, TopicRate> rates = topicRates();
+
+    QStringList lines;
+    lines << QString("[PollScheduler] 폴링 %1개, 발행 %2건").arg(m_polls.size()).arg(m_publishedTotal);
+
+    QStringList topics = rates.keys();
+    std::sort(topics.begin(), topics.end());
+    for (const QString &topic : topics) {
+        const TopicRate &rate = rates[topic];
+        lines << QString("  %1: 분당 %2회 (발행 %3, 합침 %4, 숨김으로 건너뜀 %5)")
+                     .arg(topic).arg(rate.perMinute, 0, 'f', 2)
+                     .arg(rate.published).arg(rate.coalesced).arg(rate.pausedTicks);
+    }
+    return lines.join('\n');
+}
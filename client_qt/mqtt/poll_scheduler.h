@@ -0,0 +1,85 @@
+#ifndef POLL_SCHEDULER_H
+#define POLL_SCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <functional>
+#include <limits>
+
+// 주기적 요청(통계, 불량률 등) 스케줄러
+// - 같은 key의 폴링은 여러 창이 등록해도 한 번만 발행 (주기는 가장 짧은 것)
+// - 매 주기에 ±10% 지터, 연결 직후에는 몇 초에 걸쳐 흩어서 발행 (한꺼번에 몰리지 않게)
+// - 소비자 창이 모두 숨겨져/최소화돼 있으면 그 폴링은 멈춤 (다시 보이면 바로 재개)
+// - requestNow: 수동 새로고침도 직전 발행과 가까우면 합침
+// - 토픽별 실제 발행 빈도(분당) 통계
+class PollScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    using PayloadBuilder = std::function<QByteArray()>;     // 발행할 때마다 호출 (time_range 등 갱신)
+
+    struct TopicRate {
+        quint64 published = 0;
+        quint64 coalesced = 0;      // 중복/근접 요청으로 합쳐져 발행 안 한 횟수
+        quint64 pausedTicks = 0;    // 소비자가 안 보여서 건너뛴 횟수
+        double perMinute = 0.0;     // 최근 10분 기준 실제 발행 빈도
+    };
+
+    static PollScheduler* instance();
+
+    // consumer가 QWidget이면 보일 때만 폴링, 파괴되면 등록 해제
+    // intervalMs가 0이면 주기 없이 requestNow로만 (수동 새로고침을 같은 key로 합치기 위해)
+    void registerPoll(const QString &key, const QString &topic, int intervalMs,
+                      PayloadBuilder build, QObject *consumer);
+    void unregisterPoll(const QString &key, QObject *consumer);
+
+    // 지금 한 번 (최근에 같은 key를 발행했으면 합침). 등록 안 된 key거나 연결이 안 돼 있으면 false
+    bool requestNow(const QString &key);
+
+    QHash<QString, TopicRate> topicRates() const;
+    QString rateReport() const;
+
+private slots:
+    void onConnected();
+    void onTick();
+    void onConsumerDestroyed(QObject *consumer);
+
+private:
+    explicit PollScheduler(QObject *parent = nullptr);
+
+    struct Consumer {
+        QPointer<QObject> object;
+        int intervalMs = 0;
+    };
+
+    struct Poll {
+        QString key;
+        QString topic;
+        PayloadBuilder build;
+        QList<Consumer> consumers;
+        qint64 nextDue = std::numeric_limits<qint64>::max();   // epoch ms, 수동 전용이면 max
+        qint64 lastPublished = 0;
+        bool paused = false;
+
+        int intervalMs() const;     // 소비자 중 가장 짧은 주기, 모두 수동이면 0
+    };
+
+    bool isActive(const Poll &poll) const;
+    bool publish(Poll &poll);
+    qint64 nextDueAfter(const Poll &poll, qint64 now) const;   // 주기 ±10% 지터
+    void scheduleTick();
+    void pruneRate(const QString &topic, qint64 now) const;
+
+    QHash<QString, Poll> m_polls;                       // key → 폴링
+    mutable QHash<QString, QList<qint64>> m_history;    // topic → 최근 발행 시각 (빈도 계산용)
+    QHash<QString, TopicRate> m_rates;                  // topic → 누적 통계
+    quint64 m_publishedTotal = 0;
+
+    QTimer *m_tickTimer = nullptr;
+};
+
+#endif // POLL_SCHEDULER_H
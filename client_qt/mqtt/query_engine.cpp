@@ -0,0 +1,382 @@
+#include "query_engine.h"
+#include "log_categories.h"
+#include "mqtt_hub.h"
+#include "response_channel.h"
+#include "response_pipeline.h"
+#include "wire_codec.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QUuid>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace {
+const int kRecentFinishedLimit = 256;
+const int kReportEvery = 50;
+}
+
+/* ---------- QueryHandle ---------- */
+
+bool QueryHandle::isPending() const
+{
+    return isValid() && QueryEngine::instance()->isPending(m_id);
+}
+
+void QueryHandle::cancel() const
+{
+    if (isValid()) QueryEngine::instance()->cancel(m_id);
+}
+
+/* ---------- LatencyHistogram ---------- */
+
+const QVector<int> &QueryEngine::LatencyHistogram::bounds()
+{
+    static const QVector<int> limits = {50, 100, 250, 500, 1000, 2500, 5000, 10000};
+    return limits;
+}
+
+void QueryEngine::LatencyHistogram::add(qint64 ms)
+{
+    const QVector<int> &limits = bounds();
+    if (buckets.isEmpty()) buckets.fill(0, limits.size() + 1);
+
+    int bucket = limits.size();
+    for (int i = 0; i < limits.size(); ++i) {
+        if (ms <= limits[i]) { bucket = i; break; }
+    }
+    buckets[bucket]++;
+    count++;
+    totalMs += ms;
+    maxMs = qMax(maxMs, ms);
+}
+
+qint64 QueryEngine::LatencyHistogram::percentile(double p) const
+{
+    if (count == 0) return 0;
+    const quint64 target = static_cast<quint64>(qMax(1.0, p * count));
+    quint64 seen = 0;
+    for (int i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= target) return i < bounds().size() ? bounds()[i] : maxMs;
+    }
+    return maxMs;
+}
+
+/* ---------- QueryEngine ---------- */
+
+QueryEngine* QueryEngine::instance()
+{
+    static QPointer<QueryEngine> engine;
+    if (!engine) {
+        qRegisterMetaType<QueryReply>("QueryReply");
+        engine = new QueryEngine(QCoreApplication::instance());
+    }
+    return engine;
+}
+
+QueryEngine::QueryEngine(QObject *parent)
+    : QObject(parent)
+{
+    m_deadlineTimer = new QTimer(this);
+    m_deadlineTimer->setSingleShot(true);
+    connect(m_deadlineTimer, &QTimer::timeout, this, &QueryEngine::onDeadlineTimer);
+
+    connect(MqttHub::instance(), &MqttHub::connected, this, &QueryEngine::onConnected);
+
+    // 로그 조회는 기본 엔드포인트 (디코딩/필터링은 응답 파이프라인이 담당)
+    ResponsePipeline *pipeline = ResponsePipeline::instance();
+    registerEndpoint("logs", "factory/query/logs/request", "factory/query/logs/response",
+                     [pipeline](const QByteArray &payload) {
+                         const LogBatch batch = pipeline->decodeLogBatch(payload);
+                         QueryReply reply;
+                         reply.queryId = batch.queryId;
+                         reply.status = batch.status;
+                         reply.error = batch.error;
+                         reply.body = QVariant::fromValue(batch);
+                         // 등록된 조건을 다른 워커가 먼저 가져갔으면 (두 토픽으로 같은 응답) 행이 비어 있음 - 쿼리를 끝내면 안 됨
+                         reply.matched = batch.known;
+                         return reply;
+                     },
+                     [pipeline](const QString &queryId) { pipeline->forgetLogQuery(queryId); });
+}
+
+void QueryEngine::registerEndpoint(const QString &queryType, const QString &requestTopic,
+                                   const QString &responseTopic, ReplyDecoder decoder,
+                                   ReleaseHook release, quint8 qos)
+{
+    if (m_endpoints.contains(queryType)) return;
+
+    Endpoint endpoint;
+    endpoint.queryType = queryType;
+    endpoint.requestTopic = requestTopic;
+    endpoint.decoder = std::move(decoder);
+    endpoint.release = std::move(release);
+    endpoint.qos = qos;
+    endpoint.channel = new ResponseChannel(responseTopic, [this, queryType](const QByteArray &payload, const QMqttTopicName &) {
+        onResponse(queryType, payload);
+    }, qos, this);
+
+    m_endpoints.insert(queryType, endpoint);
+    qDebug() << "[QueryEngine] 엔드포인트 등록:" << queryType << requestTopic << "→" << endpoint.channel->privateTopic();
+}
+
+QueryHandle QueryEngine::send(const Request &request, QObject *context, Callback callback)
+{
+    auto endpoint = m_endpoints.constFind(request.queryType);
+    if (endpoint == m_endpoints.constEnd()) {
+        qDebug() << "[QueryEngine] 등록되지 않은 쿼리 종류:" << request.queryType;
+        return QueryHandle();
+    }
+
+    // 같은 키로 진행 중인 쿼리는 대체
+    if (!request.supersedeKey.isEmpty()) {
+        const QString previous = m_supersede.value(request.supersedeKey);
+        if (!previous.isEmpty() && m_pending.contains(previous)) {
+            finish(previous, EndReason::Superseded);
+        }
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    Pending pending;
+    pending.queryId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    pending.queryType = request.queryType;
+    pending.histogramKey = request.tag.isEmpty() ? request.queryType : request.queryType + "/" + request.tag;
+    pending.supersedeKey = request.supersedeKey;
+    pending.context = context;
+    pending.callback = std::move(callback);
+    pending.qos = qMax(request.qos, endpoint->qos);
+    pending.createdAt = now;
+    pending.deadline = now + request.timeoutMs;
+
+    QJsonObject query;
+    query["query_id"] = pending.queryId;
+    query["query_type"] = request.queryType;
+    query["client_id"] = MqttHub::instance()->clientId();
+    endpoint->channel->stamp(query);
+    query["accept_encoding"] = WireCodec::acceptedEncodings();   // 모르는 서버는 무시하고 JSON으로 응답
+    query["filters"] = request.filters;
+    pending.payload = QJsonDocument(query).toJson(QJsonDocument::Compact);
+
+    const QString queryId = pending.queryId;
+    if (request.prepare) request.prepare(queryId);
+    m_pending.insert(queryId, pending);
+    if (!request.supersedeKey.isEmpty()) m_supersede.insert(request.supersedeKey, queryId);
+
+    if (!publish(m_pending[queryId])) {
+        // 연결되면 onConnected에서 보낸다
+        m_queueOrder.append(queryId);
+        m_counters.queued++;
+        qCDebug(lcQuery) << "[QueryEngine] 연결 대기열에 추가:" << pending.histogramKey << queryId;
+    }
+
+    scheduleDeadline();
+    return QueryHandle(queryId, pending.deadline);
+}
+
+bool QueryEngine::publish(Pending &pending)
+{
+    MqttHub *hub = MqttHub::instance();
+    if (!hub->isConnected()) return false;
+
+    const Endpoint &endpoint = m_endpoints[pending.queryType];
+    if (!hub->publish(endpoint.requestTopic, pending.payload, pending.qos)) return false;
+
+    pending.sentAt = QDateTime::currentMSecsSinceEpoch();
+    m_counters.sent++;
+    qCDebug(lcQuery) << "[QueryEngine] 쿼리 전송:" << pending.histogramKey << pending.queryId
+                     << pending.payload.size() << "bytes";
+    return true;
+}
+
+void QueryEngine::onConnected()
+{
+    const QList<QString> queued = m_queueOrder;
+    m_queueOrder.clear();
+
+    for (const QString &queryId : queued) {
+        auto it = m_pending.find(queryId);
+        if (it == m_pending.end()) continue;    // 그 사이 취소/시간 초과
+        if (!publish(it.value())) m_queueOrder.append(queryId);
+    }
+    if (!queued.isEmpty()) {
+        qCDebug(lcQuery) << "[QueryEngine] 대기열 전송:" << (queued.size() - m_queueOrder.size()) << "/" << queued.size();
+    }
+}
+
+void QueryEngine::onResponse(const QString &queryType, const QByteArray &payload)
+{
+    const Endpoint &endpoint = m_endpoints[queryType];
+
+    // 디코딩은 워커에서, 상관관계/콜백은 여기(GUI 스레드)에서
+    ResponsePipeline::instance()->run<QueryReply>(this, [decoder = endpoint.decoder, payload]() {
+        return decoder(payload);
+    }, [this](const QueryReply &reply) {
+        onReply(reply);
+    });
+}
+
+void QueryEngine::onReply(const QueryReply &reply)
+{
+    auto it = m_pending.find(reply.queryId);
+    if (it == m_pending.end()) {
+        if (m_recentFinished.contains(reply.queryId)) {
+            m_counters.lateDropped++;
+            qCDebug(lcQuery) << "[QueryEngine] 이미 끝난 쿼리의 늦은 응답 버림:" << reply.queryId;
+        } else {
+            m_counters.foreignDropped++;
+        }
+        return;
+    }
+    if (!reply.matched) {
+        // 같은 응답의 다른 사본이 쿼리를 끝냄 (또는 이미 끝냄)
+        m_counters.unmatchedDropped++;
+        qCDebug(lcQuery) << "[QueryEngine] 확인 못 한 응답은 쿼리를 끝내지 않음:" << reply.queryId << reply.status;
+        return;
+    }
+
+    Pending pending = it.value();
+    m_pending.erase(it);
+    m_queueOrder.removeAll(pending.queryId);
+    if (m_supersede.value(pending.supersedeKey) == pending.queryId) m_supersede.remove(pending.supersedeKey);
+    rememberFinished(pending.queryId);
+    scheduleDeadline();
+
+    QueryResult result;
+    result.queryId = pending.queryId;
+    result.status = reply.status;
+    result.error = reply.error;
+    result.body = reply.body;
+    result.outcome = (reply.status == "success") ? QueryResult::Success : QueryResult::ServerError;
+    result.latencyMs = QDateTime::currentMSecsSinceEpoch() - (pending.sentAt ? pending.sentAt : pending.createdAt);
+
+    m_histograms[pending.histogramKey].add(result.latencyMs);
+    m_counters.completed++;
+    if (m_counters.completed % kReportEvery == 0) {
+        qDebug().noquote() << latencyReport();
+    }
+
+    if (pending.context && pending.callback) {
+        pending.callback(result);
+    }
+}
+
+void QueryEngine::cancel(const QString &queryId)
+{
+    if (m_pending.contains(queryId)) finish(queryId, EndReason::Cancelled);
+}
+
+void QueryEngine::cancelAll(QObject *context)
+{
+    QStringList ids;
+    for (auto it = m_pending.cbegin(); it != m_pending.cend(); ++it) {
+        if (it->context == context) ids.append(it.key());
+    }
+    for (const QString &queryId : ids) finish(queryId, EndReason::Cancelled);
+}
+
+void QueryEngine::finish(const QString &queryId, EndReason reason)
+{
+    auto it = m_pending.find(queryId);
+    if (it == m_pending.end()) return;
+
+    Pending pending = it.value();
+    m_pending.erase(it);
+    m_queueOrder.removeAll(queryId);
+    if (m_supersede.value(pending.supersedeKey) == queryId) m_supersede.remove(pending.supersedeKey);
+    rememberFinished(queryId);
+
+    const Endpoint &endpoint = m_endpoints[pending.queryType];
+    if (endpoint.release) endpoint.release(queryId);
+
+    switch (reason) {
+    case EndReason::Cancelled:
+        m_counters.cancelled++;
+        qCDebug(lcQuery) << "[QueryEngine] 쿼리 취소:" << pending.histogramKey << queryId;
+        break;
+    case EndReason::Superseded:
+        m_counters.superseded++;
+        qCDebug(lcQuery) << "[QueryEngine] 새 쿼리로 대체:" << pending.histogramKey << queryId;
+        break;
+    case EndReason::TimedOut: {
+        m_counters.timedOut++;
+        m_histograms[pending.histogramKey].timeouts++;
+        qDebug() << "[QueryEngine] 쿼리 시간 초과:" << pending.histogramKey << queryId
+                 << (pending.sentAt ? "(전송됨)" : "(연결 대기 중)");
+        // 공용 응답 토픽을 끊은 뒤라면 다시 구독 (전용 토픽 응답이 끊겼을 수 있음)
+        if (pending.sentAt && endpoint.channel) endpoint.channel->noteTimeout();
+
+        // 시간 초과만 호출자에게 알린다 (취소/대체는 호출자가 한 일)
+        if (pending.context && pending.callback) {
+            QueryResult result;
+            result.outcome = QueryResult::TimedOut;
+            result.queryId = queryId;
+            result.status = "timeout";
+            result.error = "응답 시간 초과";
+            result.latencyMs = QDateTime::currentMSecsSinceEpoch() - pending.createdAt;
+            pending.callback(result);
+        }
+        break;
+    }
+    }
+    scheduleDeadline();
+}
+
+void QueryEngine::rememberFinished(const QString &queryId)
+{
+    m_recentFinished.append(queryId);
+    while (m_recentFinished.size() > kRecentFinishedLimit) m_recentFinished.removeFirst();
+}
+
+void QueryEngine::scheduleDeadline()
+{
+    qint64 nearest = std::numeric_limits<qint64>::max();
+    for (const Pending &pending : std::as_const(m_pending)) {
+        nearest = qMin(nearest, pending.deadline);
+    }
+
+    if (nearest == std::numeric_limits<qint64>::max()) {
+        m_deadlineTimer->stop();
+        return;
+    }
+    const qint64 wait = qMax<qint64>(0, nearest - QDateTime::currentMSecsSinceEpoch());
+    m_deadlineTimer->start(static_cast<int>(qMin<qint64>(wait, std::numeric_limits<int>::max())));
+}
+
+void QueryEngine::onDeadlineTimer()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QStringList expired;
+    for (auto it = m_pending.cbegin(); it != m_pending.cend(); ++it) {
+        if (it->deadline <= now) expired.append(it.key());
+    }
+    for (const QString &queryId : expired) finish(queryId, EndReason::TimedOut);
+    scheduleDeadline();
+}
+
+QString QueryEngine::latencyReport() const
+{
+    QStringList lines;
+    lines << QString("[QueryEngine] 전송 %1, 완료 %2, 시간 초과 %3, 취소 %4, 대체 %5, 늦은 응답 %6")
+                 .arg(m_counters.sent).arg(m_counters.completed).arg(m_counters.timedOut)
+                 .arg(m_counters.cancelled).arg(m_counters.superseded).arg(m_counters.lateDropped);
+
+    const WireCodec::Stats wire = WireCodec::stats();
+    lines << QString("  응답 형식: json %1, cbor %2, cbor+zlib %3, json+zlib %4 / 수신 %5KB → 해제 후 %6KB, 압축 해제 %7ms")
+                 .arg(wire.json).arg(wire.cbor).arg(wire.cborZlib).arg(wire.jsonZlib)
+                 .arg(wire.wireBytes / 1024).arg(wire.plainBytes / 1024).arg(wire.inflateNs / 1000000);
+
+    QStringList keys = m_histograms.keys();
+    std::sort(keys.begin(), keys.end());
+    for (const QString &key : keys) {
+        const LatencyHistogram &h = m_histograms[key];
+        lines << QString("  %1: %2건, 평균 %3ms, p50 ≤%4ms, p95 ≤%5ms, 최대 %6ms, 시간 초과 %7")
+                     .arg(key).arg(h.count)
+                     .arg(h.count ? h.totalMs / static_cast<qint64>(h.count) : 0)
+                     .arg(h.percentile(0.5)).arg(h.percentile(0.95)).arg(h.maxMs).arg(h.timeouts);
+    }
+    return lines.join('\n');
+}
@@ -0,0 +1,186 @@
+#ifndef QUERY_ENGINE_H
+#define QUERY_ENGINE_H
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QVariant>
+#include <QJsonObject>
+#include <QTimer>
+#include <functional>
+
+class ResponseChannel;
+
+// 쿼리 응답 한 건의 결과 (콜백으로 전달)
+struct QueryResult {
+    enum Outcome {
+        Success,        // status == "success"
+        ServerError,    // 응답은 왔지만 status != "success"
+        TimedOut        // 마감 시간까지 응답 없음
+    };
+
+    Outcome outcome = Success;
+    QString queryId;
+    QString status;
+    QString error;
+    QVariant body;          // 엔드포인트 디코더가 만든 결과 (LogBatch, VideoQueryResult ...)
+    qint64  latencyMs = 0;
+
+    bool ok() const { return outcome == Success; }
+    template <typename T> T value() const { return body.value<T>(); }
+};
+
+// 엔드포인트 디코더가 워커에서 만들어 주는 것
+struct QueryReply {
+    QString queryId;
+    QString status;
+    QString error;
+    QVariant body;
+    bool    matched = true;     // false면 디코더가 이 쿼리 응답으로 확인하지 못함 (쿼리를 끝내지 않고 버림)
+};
+
+// send()가 돌려주는 핸들
+class QueryHandle
+{
+public:
+    QueryHandle() = default;
+
+    QString id() const { return m_id; }
+    bool isValid() const { return !m_id.isEmpty(); }
+    qint64 deadline() const { return m_deadline; }   // epoch ms
+
+    bool isPending() const;
+    void cancel() const;
+
+private:
+    friend class QueryEngine;
+    QueryHandle(const QString &id, qint64 deadline) : m_id(id), m_deadline(deadline) {}
+
+    QString m_id;
+    qint64 m_deadline = 0;
+};
+
+// 모든 MQTT 쿼리(요청/응답)의 상관관계 엔진
+// - query_id는 UUID, 요청마다 마감 시간(deadline), 취소/대체(supersede) 지원
+// - 취소/대체/시간 초과된 쿼리의 늦은 응답은 버림
+// - 연결이 끊겨 있으면 대기열에 넣었다가 연결되면 보냄
+// - 쿼리 종류별 지연 시간 히스토그램
+class QueryEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    using ReplyDecoder = std::function<QueryReply(const QByteArray &payload)>;   // 워커 스레드에서 실행
+    using ReleaseHook = std::function<void(const QString &queryId)>;            // 응답 없이 끝난 쿼리 정리
+    using Callback = std::function<void(const QueryResult &result)>;
+
+    struct Request {
+        QString queryType;          // 등록된 엔드포인트 ("logs", "videos" ...)
+        QJsonObject filters;
+        QString tag;                // 히스토그램 분류 (예: "chart", "search")
+        QString supersedeKey;       // 같은 키로 진행 중인 이전 쿼리는 대체(취소)
+        int timeoutMs = 15000;
+        quint8 qos = 0;
+        std::function<void(const QString &queryId)> prepare;   // 전송 전에 query_id로 할 일 (응답 정리 조건 등록 등)
+    };
+
+    // 지연 시간 히스토그램 (ms 상한 기준 버킷)
+    struct LatencyHistogram {
+        static const QVector<int> &bounds();    // 50, 100, 250, 500, 1000, 2500, 5000, 10000, 그 이상
+        QVector<quint64> buckets;
+        quint64 count = 0;
+        qint64 totalMs = 0;
+        qint64 maxMs = 0;
+        quint64 timeouts = 0;
+
+        void add(qint64 ms);
+        qint64 percentile(double p) const;     // 버킷 상한으로 근사
+    };
+
+    static QueryEngine* instance();
+
+    // 같은 queryType으로 다시 호출하면 무시 (여러 모듈이 각자 등록해도 됨)
+    void registerEndpoint(const QString &queryType, const QString &requestTopic,
+                          const QString &responseTopic, ReplyDecoder decoder,
+                          ReleaseHook release = nullptr, quint8 qos = 0);
+    bool hasEndpoint(const QString &queryType) const { return m_endpoints.contains(queryType); }
+
+    // context가 파괴되면 콜백은 호출되지 않는다
+    QueryHandle send(const Request &request, QObject *context, Callback callback);
+
+    void cancel(const QString &queryId);
+    void cancelAll(QObject *context);
+    bool isPending(const QString &queryId) const { return m_pending.contains(queryId); }
+
+    QHash<QString, LatencyHistogram> latencyHistograms() const { return m_histograms; }
+    QString latencyReport() const;
+
+    struct Counters {
+        quint64 sent = 0;
+        quint64 queued = 0;
+        quint64 completed = 0;
+        quint64 timedOut = 0;
+        quint64 cancelled = 0;
+        quint64 superseded = 0;
+        quint64 lateDropped = 0;    // 끝난 쿼리의 늦은 응답
+        quint64 foreignDropped = 0; // 이 클라이언트가 보낸 적 없는 query_id
+        quint64 unmatchedDropped = 0; // 진행 중 query_id지만 디코더가 확인 못 한 응답 (두 토픽으로 온 같은 응답 등)
+    };
+    Counters counters() const { return m_counters; }
+
+private slots:
+    void onConnected();
+    void onDeadlineTimer();
+
+private:
+    explicit QueryEngine(QObject *parent = nullptr);
+
+    struct Endpoint {
+        QString queryType;
+        QString requestTopic;
+        ResponseChannel *channel = nullptr;
+        ReplyDecoder decoder;
+        ReleaseHook release;
+        quint8 qos = 0;
+    };
+
+    struct Pending {
+        QString queryId;
+        QString queryType;
+        QString histogramKey;
+        QString supersedeKey;
+        QPointer<QObject> context;
+        Callback callback;
+        QByteArray payload;
+        quint8 qos = 0;
+        qint64 createdAt = 0;
+        qint64 sentAt = 0;          // 0이면 아직 대기열
+        qint64 deadline = 0;
+    };
+
+    enum class EndReason { Cancelled, Superseded, TimedOut };
+
+    void onResponse(const QString &queryType, const QByteArray &payload);
+    void onReply(const QueryReply &reply);
+    bool publish(Pending &pending);
+    void finish(const QString &queryId, EndReason reason);
+    void rememberFinished(const QString &queryId);
+    void scheduleDeadline();
+
+    QHash<QString, Endpoint> m_endpoints;
+    QHash<QString, Pending> m_pending;          // query_id → 진행 중 쿼리
+    QList<QString> m_queueOrder;                // 연결 대기 중인 query_id (보낸 순서)
+    QHash<QString, QString> m_supersede;        // supersedeKey → query_id
+
+    QList<QString> m_recentFinished;            // 늦은 응답 판별용 (최근 것만)
+    QHash<QString, LatencyHistogram> m_histograms;
+    Counters m_counters;
+
+    QTimer *m_deadlineTimer = nullptr;
+};
+
+Q_DECLARE_METATYPE(QueryReply)
+
+#endif // QUERY_ENGINE_H
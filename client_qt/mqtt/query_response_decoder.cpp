@@ -0,0 +1,642 @@
+#include "query_response_decoder.h"
+#include "wire_codec.h"
+#include "log_categories.h"
+
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QDebug>
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+struct Span {
+    const char *p = nullptr;
+    int n = 0;
+    bool escaped = false;   // 문자열 안에 '\' 이스케이프가 있었는지
+};
+
+bool keyIs(const Span &key, const char *literal)
+{
+    const int len = static_cast<int>(std::strlen(literal));
+    return key.n == len && std::memcmp(key.p, literal, len) == 0;
+}
+
+// 응답 스키마 전용 단일 패스 스캐너
+// 범용 파서가 아니라 "필요한 값만 꺼내고 나머지는 건너뛰기"에 맞춰져 있다
+class Scanner
+{
+public:
+    Scanner(const char *begin, const char *end) : m_p(begin), m_end(end) {}
+
+    void skipWs()
+    {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\n' || *m_p == '\r' || *m_p == '\t'))
+            ++m_p;
+    }
+
+    bool peek(char c)
+    {
+        skipWs();
+        return m_p < m_end && *m_p == c;
+    }
+
+    bool consume(char c)
+    {
+        if (!peek(c)) return false;
+        ++m_p;
+        return true;
+    }
+
+    bool atEnd()
+    {
+        skipWs();
+        return m_p >= m_end;
+    }
+
+    const char *pos() const { return m_p; }
+
+    // 따옴표 안쪽 범위만 잡는다 (디코딩은 필요할 때만)
+    bool rawString(Span &out)
+    {
+        if (!consume('"')) return false;
+        out.p = m_p;
+        out.escaped = false;
+        while (m_p < m_end) {
+            const char c = *m_p;
+            if (c == '"') {
+                out.n = static_cast<int>(m_p - out.p);
+                ++m_p;
+                return true;
+            }
+            if (c == '\\') {
+                out.escaped = true;
+                m_p += 2;
+                continue;
+            }
+            ++m_p;
+        }
+        return false;
+    }
+
+    bool readString(QString &out)
+    {
+        Span span;
+        if (!rawString(span)) return false;
+        out = decodeString(span);
+        return true;
+    }
+
+    // 문자열이면 읽고, null 등 다른 값이면 건너뛰고 빈 문자열
+    bool readStringOrSkip(QString &out)
+    {
+        if (peek('"')) return readString(out);
+        out.clear();
+        return skipValue();
+    }
+
+    bool readNumber(qint64 &out)
+    {
+        skipWs();
+        const char *start = m_p;
+        bool negative = false;
+        if (m_p < m_end && *m_p == '-') { negative = true; ++m_p; }
+
+        qint64 value = 0;
+        const char *digits = m_p;
+        while (m_p < m_end && *m_p >= '0' && *m_p <= '9') {
+            value = value * 10 + (*m_p - '0');
+            ++m_p;
+        }
+        if (m_p == digits) return false;
+
+        // 소수점/지수가 있으면 double로 다시 해석 (드문 경우)
+        if (m_p < m_end && (*m_p == '.' || *m_p == 'e' || *m_p == 'E')) {
+            while (m_p < m_end && (std::strchr("0123456789.eE+-", *m_p) != nullptr))
+                ++m_p;
+            bool ok = false;
+            const double d = QByteArray::fromRawData(start, static_cast<int>(m_p - start)).toDouble(&ok);
+            if (!ok) return false;
+            out = static_cast<qint64>(d);
+            return true;
+        }
+
+        out = negative ? -value : value;
+        return true;
+    }
+
+    // 값 하나를 통째로 건너뛴다 (중첩 객체/배열 포함)
+    bool skipValue()
+    {
+        skipWs();
+        if (m_p >= m_end) return false;
+
+        const char c = *m_p;
+        if (c == '"') {
+            Span ignored;
+            return rawString(ignored);
+        }
+        if (c == '{' || c == '[') {
+            int depth = 0;
+            while (m_p < m_end) {
+                const char ch = *m_p;
+                if (ch == '"') {
+                    Span ignored;
+                    if (!rawString(ignored)) return false;
+                    continue;
+                }
+                if (ch == '{' || ch == '[') {
+                    ++depth;
+                } else if (ch == '}' || ch == ']') {
+                    if (--depth == 0) { ++m_p; return true; }
+                }
+                ++m_p;
+            }
+            return false;
+        }
+
+        // 숫자, true/false/null
+        const char *start = m_p;
+        while (m_p < m_end && *m_p != ',' && *m_p != '}' && *m_p != ']'
+               && *m_p != ' ' && *m_p != '\n' && *m_p != '\r' && *m_p != '\t')
+            ++m_p;
+        return m_p > start;
+    }
+
+    // 값 하나의 원문 범위
+    bool rawValue(QByteArray &out)
+    {
+        skipWs();
+        const char *start = m_p;
+        if (!skipValue()) return false;
+        out = QByteArray(start, static_cast<int>(m_p - start));
+        return true;
+    }
+
+    static QString decodeString(const Span &span)
+    {
+        if (!span.escaped) return QString::fromUtf8(span.p, span.n);
+
+        QString out;
+        out.reserve(span.n);
+        const char *p = span.p;
+        const char *end = span.p + span.n;
+        const char *run = p;
+        while (p < end) {
+            if (*p != '\\') { ++p; continue; }
+
+            out += QString::fromUtf8(run, static_cast<int>(p - run));
+            ++p;
+            if (p >= end) break;
+            switch (*p) {
+            case 'n': out += QChar('\n'); break;
+            case 't': out += QChar('\t'); break;
+            case 'r': out += QChar('\r'); break;
+            case 'b': out += QChar('\b'); break;
+            case 'f': out += QChar('\f'); break;
+            case 'u':
+                // 서로게이트 쌍은 QString(UTF-16)에 코드 유닛 두 개로 이어 붙이면 그대로 맞춰진다
+                if (end - p >= 5) {
+                    bool ok = false;
+                    const ushort unit = QByteArray::fromRawData(p + 1, 4).toUShort(&ok, 16);
+                    if (ok) out += QChar(unit);
+                    p += 4;
+                }
+                break;
+            default:        // \" \\ \/
+                out += QChar(*p);
+                break;
+            }
+            ++p;
+            run = p;
+        }
+        out += QString::fromUtf8(run, static_cast<int>(end - run));
+        return out;
+    }
+
+private:
+    const char *m_p;
+    const char *m_end;
+};
+
+bool parseRow(Scanner &s, LogRecord &row)
+{
+    if (!s.consume('{')) return false;
+    if (s.consume('}')) return true;
+
+    for (;;) {
+        Span key;
+        if (!s.rawString(key) || !s.consume(':')) return false;
+
+        bool ok = true;
+        if (keyIs(key, "device_id")) {
+            ok = s.readStringOrSkip(row.deviceId);
+        } else if (keyIs(key, "log_level")) {
+            ok = s.readStringOrSkip(row.logLevel);
+        } else if (keyIs(key, "log_code")) {
+            ok = s.readStringOrSkip(row.logCode);
+        } else if (keyIs(key, "message")) {
+            if (s.peek('"')) ok = s.readString(row.message);
+            else ok = s.rawValue(row.rawMessage);
+        } else if (keyIs(key, "timestamp")) {
+            if (s.peek('"')) {
+                QString text;
+                ok = s.readString(text);
+                row.timestamp = QueryResponseDecoder::timestampFromText(text);
+            } else if (s.peek('n')) {
+                ok = s.skipValue();                     // null
+            } else {
+                ok = s.readNumber(row.timestamp);
+            }
+        } else if (keyIs(key, "_id") && s.peek('"')) {
+            ok = s.readString(row.id);
+        } else {
+            // 모르는 필드는 원문만 보관 (toJson에서 필요할 때 해석)
+            QByteArray value;
+            ok = s.rawValue(value);
+            if (!row.extraFields.isEmpty()) row.extraFields += ',';
+            row.extraFields += '"';
+            row.extraFields.append(key.p, key.n);
+            row.extraFields += "\":";
+            row.extraFields += value;
+        }
+        if (!ok) return false;
+
+        if (s.consume(',')) continue;
+        return s.consume('}');
+    }
+}
+
+bool parseRows(Scanner &s, QVector<LogRecord> &rows)
+{
+    if (!s.consume('[')) return false;
+    if (s.consume(']')) return true;
+
+    for (;;) {
+        LogRecord row;
+        if (!parseRow(s, row)) return false;
+        rows.append(std::move(row));
+
+        if (s.consume(',')) continue;
+        return s.consume(']');
+    }
+}
+
+bool parseResponse(Scanner &s, LogQueryResponse &out)
+{
+    if (!s.consume('{')) return false;
+    if (s.consume('}')) return s.atEnd();
+
+    for (;;) {
+        Span key;
+        if (!s.rawString(key) || !s.consume(':')) return false;
+
+        bool ok = true;
+        if (keyIs(key, "query_id")) {
+            ok = s.readStringOrSkip(out.queryId);
+        } else if (keyIs(key, "status")) {
+            ok = s.readStringOrSkip(out.status);
+        } else if (keyIs(key, "error")) {
+            ok = s.readStringOrSkip(out.error);
+        } else if (keyIs(key, "data") && s.peek('[')) {
+            ok = parseRows(s, out.rows);
+        } else {
+            ok = s.skipValue();
+        }
+        if (!ok) return false;
+
+        if (s.consume(',')) continue;
+        return s.consume('}') && s.atEnd();
+    }
+}
+
+// 최상위 키만 훑으며 query_id를 꺼냄 - data가 앞에 있어도 행은 만들지 않고 바이트만 건너뜀
+bool peekQueryId(Scanner &s, QString &queryId)
+{
+    if (!s.consume('{')) return false;
+    for (;;) {
+        Span key;
+        if (!s.rawString(key) || !s.consume(':')) return false;
+        if (keyIs(key, "query_id")) return s.peek('"') && s.readString(queryId);
+        if (!s.skipValue() || !s.consume(',')) return false;
+    }
+}
+
+/* ---------- CBOR (협상된 경우) ---------- */
+
+// 단일 JSON 값 조각 ("abc", 12, {...}) - extraFields/rawMessage를 JSON 경로와 같은 모양으로
+QByteArray jsonFragment(const QJsonValue &value)
+{
+    const QByteArray wrapped = QJsonDocument(QJsonArray{ value }).toJson(QJsonDocument::Compact);
+    return wrapped.mid(1, wrapped.size() - 2);
+}
+
+// 문자열이면 읽고, null 등 다른 값이면 건너뛰고 빈 문자열
+bool cborString(QCborStreamReader &r, QString &out)
+{
+    out.clear();
+    if (!r.isString()) return r.next();
+
+    auto chunk = r.readString();
+    while (chunk.status == QCborStreamReader::Ok) {
+        out += chunk.data;
+        chunk = r.readString();
+    }
+    return chunk.status == QCborStreamReader::EndOfString;
+}
+
+bool cborTimestamp(QCborStreamReader &r, qint64 &out)
+{
+    if (r.isInteger()) {
+        out = r.toInteger();
+        return r.next();
+    }
+    if (r.isDouble()) {
+        out = static_cast<qint64>(r.toDouble());
+        return r.next();
+    }
+    if (r.isString()) {
+        QString text;
+        if (!cborString(r, text)) return false;
+        out = QueryResponseDecoder::timestampFromText(text);
+        return true;
+    }
+    return r.next();
+}
+
+bool parseCborRow(QCborStreamReader &r, LogRecord &row)
+{
+    if (!r.isMap() || !r.enterContainer()) return false;
+
+    QString key;
+    while (r.hasNext()) {
+        if (!cborString(r, key)) return false;
+
+        bool ok = true;
+        if (key == QLatin1String("device_id")) {
+            ok = cborString(r, row.deviceId);
+        } else if (key == QLatin1String("log_level")) {
+            ok = cborString(r, row.logLevel);
+        } else if (key == QLatin1String("log_code")) {
+            ok = cborString(r, row.logCode);
+        } else if (key == QLatin1String("timestamp")) {
+            ok = cborTimestamp(r, row.timestamp);
+        } else if (key == QLatin1String("_id")) {
+            ok = cborString(r, row.id);
+        } else if (key == QLatin1String("message") && r.isString()) {
+            ok = cborString(r, row.message);
+        } else {
+            // 객체 message / 모르는 필드는 JSON 원문으로 (JSON 경로와 같은 보관 방식)
+            const QCborValue value = QCborValue::fromCbor(r);
+            if (key == QLatin1String("message")) {
+                if (value.isMap() || value.isArray()) row.rawMessage = jsonFragment(value.toJsonValue());
+            } else {
+                if (!row.extraFields.isEmpty()) row.extraFields += ',';
+                row.extraFields += jsonFragment(key);
+                row.extraFields += ':';
+                row.extraFields += jsonFragment(value.toJsonValue());
+            }
+            ok = r.lastError() == QCborError::NoError;
+        }
+        if (!ok) return false;
+    }
+    return r.leaveContainer();
+}
+
+bool parseCborResponse(QCborStreamReader &r, LogQueryResponse &out)
+{
+    while (r.isTag()) r.next();     // self-describe 태그 등
+    if (!r.isMap() || !r.enterContainer()) return false;
+
+    QString key;
+    while (r.hasNext()) {
+        if (!cborString(r, key)) return false;
+
+        bool ok = true;
+        if (key == QLatin1String("query_id")) {
+            ok = cborString(r, out.queryId);
+        } else if (key == QLatin1String("status")) {
+            ok = cborString(r, out.status);
+        } else if (key == QLatin1String("error")) {
+            ok = cborString(r, out.error);
+        } else if (key == QLatin1String("data") && r.isArray()) {
+            if (r.isLengthKnown()) out.rows.reserve(static_cast<int>(r.length()));
+            ok = r.enterContainer();
+            while (ok && r.hasNext()) {
+                LogRecord row;
+                ok = parseCborRow(r, row);
+                if (ok) out.rows.append(std::move(row));
+            }
+            ok = ok && r.leaveContainer();
+        } else {
+            ok = r.next();
+        }
+        if (!ok) return false;
+    }
+    return r.leaveContainer() && r.lastError() == QCborError::NoError;
+}
+
+bool peekCborQueryId(QCborStreamReader &r, QString &queryId)
+{
+    while (r.isTag()) r.next();
+    if (!r.isMap() || !r.enterContainer()) return false;
+
+    QString key;
+    while (r.hasNext()) {
+        if (!r.isString() || !cborString(r, key)) return false;
+        if (key == QLatin1String("query_id")) return r.isString() && cborString(r, queryId);
+        if (!r.next()) return false;
+    }
+    return false;
+}
+
+std::atomic<quint64> g_responses{0};
+std::atomic<quint64> g_rows{0};
+std::atomic<quint64> g_bytes{0};
+std::atomic<quint64> g_totalNs{0};
+std::atomic<quint64> g_maxNs{0};
+std::atomic<quint64> g_fallbacks{0};
+std::atomic<quint64> g_cborResponses{0};
+std::atomic<quint64> g_skipped{0};
+
+void record(quint64 rows, quint64 bytes, quint64 ns)
+{
+    g_responses++;
+    g_rows += rows;
+    g_bytes += bytes;
+    g_totalNs += ns;
+    quint64 prev = g_maxNs.load();
+    while (ns > prev && !g_maxNs.compare_exchange_weak(prev, ns)) {}
+}
+
+} // namespace
+
+/* ---------- LogRecord ---------- */
+
+QJsonObject LogRecord::toJson() const
+{
+    QJsonObject object;
+    if (!extraFields.isEmpty()) {
+        object = QJsonDocument::fromJson("{" + extraFields + "}").object();
+    }
+    if (!id.isEmpty()) object["_id"] = id;
+    object["device_id"] = deviceId;
+    object["log_level"] = logLevel;
+    object["log_code"] = logCode;
+    if (!rawMessage.isEmpty()) {
+        const QJsonDocument doc = QJsonDocument::fromJson(rawMessage);
+        object["message"] = doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+    } else {
+        object["message"] = message;
+    }
+    // 해석 못 한 시각은 0이나 현재 시각으로 채우지 않음
+    if (hasValidTimestamp()) object["timestamp"] = static_cast<double>(timestamp);
+    return object;
+}
+
+/* ---------- QueryResponseDecoder ---------- */
+
+bool QueryResponseDecoder::decodeLogs(const QByteArray &payload, LogQueryResponse &out,
+                                      const std::function<bool(const QString &queryId)> &wanted)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    out = LogQueryResponse();
+
+    // 협상된 형식(압축/CBOR)이면 먼저 풀기 - 구 서버의 JSON은 그대로 통과
+    QByteArray body;
+    const WireCodec::Encoding encoding = WireCodec::unwrap(payload, body);
+    if (encoding == WireCodec::Encoding::Unknown) return false;
+
+    // 내 쿼리가 아니면 행은 읽지 않음 - 공용 토픽에는 다른 운영 PC의 대량 응답도 섞여 옴
+    if (wanted) {
+        QString queryId;
+        bool peeked = false;
+        if (encoding == WireCodec::Encoding::Cbor) {
+            QCborStreamReader reader(body);
+            peeked = peekCborQueryId(reader, queryId);
+        } else {
+            Scanner scanner(body.constData(), body.constData() + body.size());
+            peeked = peekQueryId(scanner, queryId);
+        }
+        if (peeked && !wanted(queryId)) {
+            out.queryId = queryId;
+            out.skipped = true;
+            g_skipped++;
+            qCDebug(lcQuery) << "[Decoder] 다른 쿼리의 응답 건너뜀:" << queryId << payload.size() << "바이트";
+            return true;
+        }
+    }
+
+    if (encoding == WireCodec::Encoding::Cbor) {
+        g_cborResponses++;
+        QCborStreamReader reader(body);
+        if (!parseCborResponse(reader, out)) {
+            // 스트림 리더가 못 읽으면 QCborValue 전체 파싱으로
+            g_fallbacks++;
+            QCborParserError error;
+            const QCborValue value = QCborValue::fromCbor(body, &error);
+            if (error.error != QCborError::NoError || !value.isMap()) {
+                out = LogQueryResponse();
+                return false;
+            }
+            out = fromJson(value.toMap().toJsonObject());
+            qDebug() << "[Decoder] CBOR 스트림 실패 → QCborValue 폴백, 행:" << out.rows.size();
+        }
+    } else {
+        Scanner scanner(body.constData(), body.constData() + body.size());
+        if (!parseResponse(scanner, out)) {
+            // 스캐너가 못 읽는 응답이면 기존 QJsonDocument 경로로
+            g_fallbacks++;
+            const QJsonDocument doc = QJsonDocument::fromJson(body);
+            if (!doc.isObject()) {
+                out = LogQueryResponse();
+                return false;
+            }
+            out = fromJson(doc.object());
+            qDebug() << "[Decoder] 스캐너 실패 → QJsonDocument 폴백, 행:" << out.rows.size();
+        }
+    }
+
+    const quint64 ns = static_cast<quint64>(timer.nsecsElapsed());
+    record(out.rows.size(), payload.size(), ns);
+    qCDebug(lcQuery) << "[Decoder] 로그 응답 디코딩:" << out.rows.size() << "행,"
+             << payload.size() << "바이트(" << WireCodec::name(WireCodec::sniff(payload)) << "),"
+             << (ns / 1000) << "us";
+    return true;
+}
+
+LogQueryResponse QueryResponseDecoder::fromJson(const QJsonObject &response)
+{
+    LogQueryResponse out;
+    out.queryId = response.value("query_id").toString();
+    out.status = response.value("status").toString();
+    out.error = response.value("error").toString();
+
+    const QJsonArray data = response.value("data").toArray();
+    out.rows.reserve(data.size());
+    for (const QJsonValue &value : data) {
+        out.rows.append(recordFromJson(value.toObject()));
+    }
+    return out;
+}
+
+LogRecord QueryResponseDecoder::recordFromJson(const QJsonObject &row)
+{
+    LogRecord record;
+    QJsonObject extra = row;
+
+    record.id = extra.take("_id").toString();
+    record.deviceId = extra.take("device_id").toString();
+    record.logLevel = extra.take("log_level").toString();
+    record.logCode = extra.take("log_code").toString();
+
+    const QJsonValue message = extra.take("message");
+    if (message.isObject()) {
+        record.rawMessage = QJsonDocument(message.toObject()).toJson(QJsonDocument::Compact);
+    } else if (message.isArray()) {
+        record.rawMessage = QJsonDocument(message.toArray()).toJson(QJsonDocument::Compact);
+    } else {
+        record.message = message.toString();
+    }
+
+    const QJsonValue timestamp = extra.take("timestamp");
+    if (timestamp.isString()) record.timestamp = timestampFromText(timestamp.toString());
+    else if (timestamp.isDouble()) record.timestamp = static_cast<qint64>(timestamp.toDouble());
+
+    if (!extra.isEmpty()) {
+        const QByteArray compact = QJsonDocument(extra).toJson(QJsonDocument::Compact);
+        record.extraFields = compact.mid(1, compact.size() - 2);   // 바깥 {} 제거
+    }
+    return record;
+}
+
+qint64 QueryResponseDecoder::timestampFromText(const QString &text)
+{
+    bool ok = false;
+    const qint64 ms = text.toLongLong(&ok);
+    if (ok) return ms;
+
+    const QDateTime parsed = QDateTime::fromString(text, Qt::ISODateWithMs);
+    return parsed.isValid() ? parsed.toMSecsSinceEpoch() : LogRecord::kInvalidTimestamp;
+}
+
+QueryResponseDecoder::Stats QueryResponseDecoder::stats()
+{
+    Stats stats;
+    stats.responses = g_responses.load();
+    stats.rows = g_rows.load();
+    stats.bytes = g_bytes.load();
+    stats.totalNs = g_totalNs.load();
+    stats.maxNs = g_maxNs.load();
+    stats.fallbacks = g_fallbacks.load();
+    stats.cborResponses = g_cborResponses.load();
+    stats.skipped = g_skipped.load();
+    return stats;
+}
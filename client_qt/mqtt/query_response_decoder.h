@@ -0,0 +1,75 @@
+#ifndef QUERY_RESPONSE_DECODER_H
+#define QUERY_RESPONSE_DECODER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QJsonObject>
+#include <functional>
+
+// factory/query/logs/response 의 data[] 한 행
+struct LogRecord {
+    QString id;             // _id
+    QString deviceId;
+    QString logLevel;
+    QString logCode;
+    QString message;        // message가 문자열일 때
+    qint64  timestamp = 0;  // 숫자/문자열(ms 숫자 또는 ISO 8601) 어느 쪽으로 와도 ms로 변환
+                            // 없으면 0, 해석 실패 시 kInvalidTimestamp - 둘 다 시각을 지어내지 않고 버릴 것
+    QByteArray rawMessage;  // message가 객체/배열이면 원문 JSON 그대로
+    QByteArray extraFields; // 모르는 필드들 원문 ("key":value,...) - toJson()에서만 해석
+
+    static constexpr qint64 kInvalidTimestamp = -1;
+    bool hasValidTimestamp() const { return timestamp > 0; }
+
+    // 기존 QJsonObject API (addErrorLogUI, onSearchResultsReceived 등)용
+    // 화면에 실제로 올라가는 행에만 호출할 것
+    QJsonObject toJson() const;
+};
+
+// factory/query/logs/response 전체
+struct LogQueryResponse {
+    QString queryId;
+    QString status;
+    QString error;
+    QVector<LogRecord> rows;
+    bool skipped = false;   // query_id만 보고 건너뜀 (rows/status 없음)
+
+    bool isSuccess() const { return status == "success"; }
+};
+
+// 대량 로그 쿼리 응답 전용 디코더
+// - 응답 스키마를 알고 있으니 바이트를 한 번만 훑으면서 바로 LogRecord를 채운다
+//   (QJsonDocument → QJsonArray → QJsonObject → QVariant 중간 DOM 없음)
+// - 서버가 CBOR(+zlib)로 응답하면 QCborStreamReader로 같은 방식으로 읽는다 (WireCodec 참고)
+// - 모르는 값은 건너뛰거나 원문 범위만 보관, 문법이 깨진 응답은 QJsonDocument 경로로 폴백
+class QueryResponseDecoder
+{
+public:
+    struct Stats {
+        quint64 responses = 0;
+        quint64 rows = 0;
+        quint64 bytes = 0;          // 받은 그대로 (압축이면 압축된 크기)
+        quint64 totalNs = 0;
+        quint64 maxNs = 0;
+        quint64 fallbacks = 0;
+        quint64 cborResponses = 0;
+        quint64 skipped = 0;        // query_id만 보고 버린 응답 (공용 토픽의 다른 클라이언트 응답 등)
+    };
+
+    // 실패하면 false (out은 비워짐)
+    // wanted가 있으면 행을 읽기 전에 query_id부터 꺼내 물어보고, 거절하면 queryId만 채우고 skipped로 끝냄
+    // (query_id를 못 꺼내면 그냥 전부 디코딩)
+    static bool decodeLogs(const QByteArray &payload, LogQueryResponse &out,
+                           const std::function<bool(const QString &queryId)> &wanted = {});
+
+    // 스캐너 실패 시 폴백 / 이미 QJsonObject가 있는 경우
+    static LogQueryResponse fromJson(const QJsonObject &response);
+    static LogRecord recordFromJson(const QJsonObject &row);
+    // 문자열 timestamp → ms (실패하면 LogRecord::kInvalidTimestamp)
+    static qint64 timestampFromText(const QString &text);
+
+    static Stats stats();
+};
+
+#endif // QUERY_RESPONSE_DECODER_H
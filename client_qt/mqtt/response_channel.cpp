@@ -0,0 +1,79 @@
+#include "response_channel.h"
+
+#include <QSettings>
+#include <QDebug>
+
+namespace {
+const int kDefaultLegacyGraceMs = 5 * 60 * 1000;
+}
+
+ResponseChannel::ResponseChannel(const QString &legacyTopic, MqttHub::Handler handler,
+                                 quint8 qos, QObject *parent)
+    : QObject(parent)
+    , m_legacyTopic(legacyTopic)
+    , m_privateTopic(legacyTopic + "/" + MqttHub::instance()->clientId())
+    , m_handler(std::move(handler))
+    , m_qos(qos)
+{
+    QSettings settings("VisionCraft", "client_qt");
+    m_graceTimer = new QTimer(this);
+    m_graceTimer->setSingleShot(true);
+    m_graceTimer->setInterval(qMax(0, settings.value("mqtt/legacy_response_grace_ms", kDefaultLegacyGraceMs).toInt()));
+    connect(m_graceTimer, &QTimer::timeout, this, &ResponseChannel::dropLegacy);
+
+    MqttHub::instance()->subscribe(m_privateTopic, this, &ResponseChannel::onPrivateMessage, m_qos);
+    subscribeLegacy();
+}
+
+void ResponseChannel::stamp(QJsonObject &request) const
+{
+    request["response_topic"] = m_privateTopic;
+}
+
+void ResponseChannel::subscribeLegacy()
+{
+    if (m_legacySubscribed) return;
+    m_legacySubscribed = true;
+    MqttHub::instance()->subscribe(m_legacyTopic, this, &ResponseChannel::onLegacyMessage, m_qos);
+}
+
+void ResponseChannel::dropLegacy()
+{
+    if (!m_legacySubscribed) return;
+    m_legacySubscribed = false;
+    MqttHub::instance()->unsubscribe(m_legacyTopic, this);
+    qDebug() << "[ResponseChannel] 전용 응답 토픽만 사용:" << m_privateTopic << "(공용 토픽 구독 해제)";
+}
+
+void ResponseChannel::onPrivateMessage(const QByteArray &payload, const QMqttTopicName &topic)
+{
+    if (!m_private) {
+        // 서버가 response_topic을 지원함 → 유예 시간 뒤 공용 토픽은 끊음
+        m_private = true;
+        if (m_legacySubscribed && !m_graceTimer->isActive()) {
+            qDebug() << "[ResponseChannel] 전용 응답 토픽 확인:" << m_privateTopic
+                     << "- 공용 토픽은" << m_graceTimer->interval() / 1000 << "초 뒤 해제";
+            m_graceTimer->start();
+        }
+    }
+    m_handler(payload, topic);
+}
+
+void ResponseChannel::onLegacyMessage(const QByteArray &payload, const QMqttTopicName &topic)
+{
+    // 구 서버 폴백 (다른 클라이언트 응답도 섞여 옴 - query_id 매칭은 받는 쪽에서)
+    // 등록 안 된 query_id의 응답은 디코더가 query_id만 보고 행은 읽지 않음
+    // 두 토픽으로 같은 응답이 오면 쿼리 조건을 먼저 가져간 사본만 디코딩되고 나머지는 같은 식으로 건너뜀
+    if (!m_legacySubscribed) return;
+    m_handler(payload, topic);
+}
+
+void ResponseChannel::noteTimeout()
+{
+    if (m_legacySubscribed) return;
+
+    // 응답을 전용 토픽으로 주던 서버가 바뀌었을 수 있음 → 다시 두 토픽 모두, 다음 전용 응답부터 유예 시간을 다시 셈
+    m_private = false;
+    subscribeLegacy();
+    qDebug() << "[ResponseChannel] 전용 토픽 응답 없이 시간 초과 - 공용 토픽 다시 구독:" << m_legacyTopic;
+}
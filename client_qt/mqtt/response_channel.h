@@ -0,0 +1,50 @@
+#ifndef RESPONSE_CHANNEL_H
+#define RESPONSE_CHANNEL_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QTimer>
+#include "mqtt_hub.h"
+
+// 쿼리 응답 수신 채널
+// - 요청에 response_topic(<공용 응답 토픽>/<client_id>)을 실어 보내고 그 토픽을 구독
+//   → 다른 운영 PC의 대량 응답을 받아서 query_id 비교 후 버리는 일이 없어짐
+// - 구 서버는 response_topic을 모르고 공용 토픽으로만 보내므로 공용 토픽도 같이 구독
+//   전용 토픽으로 응답이 오면 유예 시간(mqtt/legacy_response_grace_ms, 기본 5분) 뒤에 공용 토픽 구독을 끊음
+//   (서버 여러 대 중 일부만 업데이트된 경우 그 사이 공용 토픽으로 오는 응답도 받음)
+// - 공용 토픽을 끊은 뒤 보낸 쿼리가 응답 없이 시간 초과되면 공용 토픽을 다시 구독
+class ResponseChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+    ResponseChannel(const QString &legacyTopic, MqttHub::Handler handler,
+                    quint8 qos = 0, QObject *parent = nullptr);
+
+    QString legacyTopic() const { return m_legacyTopic; }
+    QString privateTopic() const { return m_privateTopic; }
+    bool isPrivate() const { return m_private; }
+    bool isLegacySubscribed() const { return m_legacySubscribed; }
+
+    // 요청 JSON에 response_topic 추가
+    void stamp(QJsonObject &request) const;
+
+    // 보낸 쿼리가 응답 없이 시간 초과됨 (QueryEngine)
+    void noteTimeout();
+
+private:
+    void onPrivateMessage(const QByteArray &payload, const QMqttTopicName &topic);
+    void onLegacyMessage(const QByteArray &payload, const QMqttTopicName &topic);
+    void subscribeLegacy();
+    void dropLegacy();
+
+    QString m_legacyTopic;
+    QString m_privateTopic;
+    MqttHub::Handler m_handler;
+    quint8 m_qos = 0;
+    bool m_private = false;             // 전용 토픽으로 응답이 온 적 있음 (공용 토픽을 다시 구독하면 초기화)
+    bool m_legacySubscribed = false;
+    QTimer *m_graceTimer = nullptr;
+};
+
+#endif // RESPONSE_CHANNEL_H
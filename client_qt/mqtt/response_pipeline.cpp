@@ -0,0 +1,146 @@
+#include "response_pipeline.h"
+
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+void storeMax(std::atomic<quint64> &target, quint64 value)
+{
+    quint64 prev = target.load();
+    while (value > prev && !target.compare_exchange_weak(prev, value)) {}
+}
+}
+
+ResponsePipeline* ResponsePipeline::instance()
+{
+    static QPointer<ResponsePipeline> pipeline;
+    if (!pipeline) {
+        qRegisterMetaType<LogBatch>("LogBatch");
+        pipeline = new ResponsePipeline(QCoreApplication::instance());
+    }
+    return pipeline;
+}
+
+ResponsePipeline::ResponsePipeline(QObject *parent)
+    : QObject(parent)
+{
+    // GUI 스레드 몫은 남겨두고, 응답 처리는 많아야 4개까지
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 4));
+    m_pool.setExpiryTimeout(30000);
+    m_pool.setObjectName("ResponsePipeline");
+}
+
+ResponsePipeline::~ResponsePipeline()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void ResponsePipeline::expectLogQuery(const QString &queryId, const LogShape &shape)
+{
+    QMutexLocker locker(&m_shapeMutex);
+    m_logShapes.insert(queryId, shape);
+}
+
+void ResponsePipeline::forgetLogQuery(const QString &queryId)
+{
+    QMutexLocker locker(&m_shapeMutex);
+    m_logShapes.remove(queryId);
+}
+
+LogBatch ResponsePipeline::decodeLogBatch(const QByteArray &payload)
+{
+    // 등록되지 않은 query_id면 행을 읽지 않음 (다른 클라이언트 응답, 다른 토픽으로 온 사본이 이미 조건을 가져간 응답)
+    LogQueryResponse response;
+    const bool decoded = QueryResponseDecoder::decodeLogs(payload, response, [this](const QString &queryId) {
+        QMutexLocker locker(&m_shapeMutex);
+        return m_logShapes.contains(queryId);
+    });
+    if (!decoded) {
+        LogBatch batch;
+        batch.status = "error";
+        batch.error = "invalid json";
+        return batch;
+    }
+
+    LogShape shape;
+    bool known = false;
+    {
+        QMutexLocker locker(&m_shapeMutex);
+        auto it = m_logShapes.find(response.queryId);
+        if (it != m_logShapes.end()) {
+            shape = it.value();
+            m_logShapes.erase(it);
+            known = true;
+        }
+    }
+    return shapeLogs(response, known ? &shape : nullptr);
+}
+
+LogBatch ResponsePipeline::shapeLogs(const LogQueryResponse &response, const LogShape *shape)
+{
+    LogBatch batch;
+    batch.queryId = response.queryId;
+    batch.status = response.status;
+    batch.error = response.error;
+    batch.receivedRows = response.rows.size();
+    batch.known = (shape != nullptr);
+
+    // 내가 보낸 쿼리가 아니면 행은 만들지 않는다
+    if (!shape || !response.isSuccess()) return batch;
+
+    const int count = response.rows.size();
+    if (shape->asRecords) batch.records.reserve(count);
+    else batch.rows.reserve(count);
+
+    for (int n = 0; n < count; ++n) {
+        const LogRecord &record = response.rows[shape->reversed ? count - 1 - n : n];
+
+        // 시각을 알 수 없는 행은 목록/차트/기록 어디에도 넣지 않음 (현재 시각으로 지어내지 않음)
+        if (!record.hasValidTimestamp()) {
+            batch.invalidTimestamps++;
+            continue;
+        }
+        if (!shape->deviceId.isEmpty() && record.deviceId != shape->deviceId) continue;
+        if (!shape->logLevel.isEmpty() && record.logLevel != shape->logLevel) continue;
+        if (shape->startMs > 0 && record.timestamp < shape->startMs) continue;
+        if (shape->endMs > 0 && record.timestamp > shape->endMs) continue;
+
+        if (shape->asRecords) {
+            batch.records.append(record);
+        } else {
+            batch.rows.append(record.toJson());
+        }
+    }
+    if (batch.invalidTimestamps > 0) {
+        qWarning() << "[Pipeline] timestamp 해석 실패로 버린 행:" << batch.invalidTimestamps << "/" << count
+                   << "query:" << batch.queryId;
+    }
+    return batch;
+}
+
+void ResponsePipeline::recordJob(quint64 queueNs, quint64 workNs)
+{
+    const quint64 jobs = ++m_jobs;
+    m_totalWorkNs += workNs;
+    storeMax(m_maxWorkNs, workNs);
+    storeMax(m_maxQueueNs, queueNs);
+
+    if (jobs % 100 == 0) {
+        qDebug() << "[Pipeline] 처리" << jobs << "건, 평균" << (m_totalWorkNs.load() / jobs / 1000)
+                 << "us, 최대" << (m_maxWorkNs.load() / 1000) << "us, 최대 대기" << (m_maxQueueNs.load() / 1000) << "us";
+    }
+}
+
+ResponsePipeline::Stats ResponsePipeline::stats() const
+{
+    Stats stats;
+    stats.jobs = m_jobs.load();
+    stats.totalWorkNs = m_totalWorkNs.load();
+    stats.maxWorkNs = m_maxWorkNs.load();
+    stats.maxQueueNs = m_maxQueueNs.load();
+    return stats;
+}
@@ -0,0 +1,110 @@
+#ifndef RESPONSE_PIPELINE_H
+#define RESPONSE_PIPELINE_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "query_response_decoder.h"
+
+// 로그 쿼리 응답을 화면용으로 다듬는 조건 (쿼리를 보낼 때 등록)
+struct LogShape {
+    QString deviceId;           // 비어있으면 모든 기기
+    QString logLevel;           // 비어있으면 모든 레벨
+    qint64  startMs = 0;        // 0이면 시작 제한 없음
+    qint64  endMs = 0;          // 0이면 끝 제한 없음
+    bool    reversed = false;   // data[] 역순으로 (목록 위로 쌓는 화면용)
+    bool    asRecords = false;  // QJsonObject 대신 LogRecord로 (Home 차트, 검색 계획기의 LogStore 적재용)
+};
+
+// 워커에서 완성된, 바로 화면에 붙일 수 있는 결과
+struct LogBatch {
+    QString queryId;
+    QString status;
+    QString error;
+    bool    known = false;          // 등록된 쿼리의 응답인지 (다른 클라이언트 응답이면 false)
+    int     receivedRows = 0;       // 서버가 보낸 행 수
+    int     invalidTimestamps = 0;  // timestamp가 없거나 해석 못 해 버린 행
+    QList<QJsonObject> rows;        // 필터 통과 행 (asRecords == false)
+    QVector<LogRecord> records;     // 필터 통과 행 (asRecords == true)
+
+    bool isSuccess() const { return status == "success"; }
+};
+
+Q_DECLARE_METATYPE(LogBatch)
+
+// 응답 처리 파이프라인: 디코딩 → 필터(기기/레벨/날짜) → 정렬/변환을 워커 풀에서 하고
+// GUI 스레드에는 완성된 배치만 넘긴다 (쿼리 상관관계는 QueryEngine이 이걸 통해 처리)
+class ResponsePipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 jobs = 0;
+        quint64 totalWorkNs = 0;
+        quint64 maxWorkNs = 0;
+        quint64 maxQueueNs = 0;   // 제출 → 워커 시작까지 대기
+    };
+
+    static ResponsePipeline* instance();
+    ~ResponsePipeline() override;
+
+    void expectLogQuery(const QString &queryId, const LogShape &shape);
+    void forgetLogQuery(const QString &queryId);
+
+    // 로그 쿼리 응답 한 건 디코딩 + 등록된 조건으로 정리 (워커에서 호출, 스레드 안전)
+    LogBatch decodeLogBatch(const QByteArray &payload);
+
+    // 임의 작업: work는 워커에서, deliver는 context 스레드에서
+    template <typename Result>
+    void run(QObject *context, std::function<Result()> work, std::function<void(const Result &)> deliver)
+    {
+        QPointer<QObject> guard(context);
+        QElapsedTimer queued;
+        queued.start();
+
+        m_pool.start(QRunnable::create([this, guard, queued, work = std::move(work), deliver = std::move(deliver)]() {
+            const quint64 queueNs = static_cast<quint64>(queued.nsecsElapsed());
+            QElapsedTimer timer;
+            timer.start();
+            auto result = std::make_shared<Result>(work());
+            recordJob(queueNs, static_cast<quint64>(timer.nsecsElapsed()));
+
+            // 파이프라인(앱 수명)을 통해 넘기고, 도착 시점에 context가 살아있는지 확인
+            QMetaObject::invokeMethod(this, [guard, deliver, result]() {
+                if (guard) deliver(*result);
+            }, Qt::QueuedConnection);
+        }));
+    }
+
+    // 순수 함수 (워커에서 호출)
+    static LogBatch shapeLogs(const LogQueryResponse &response, const LogShape *shape);
+
+    Stats stats() const;
+
+private:
+    explicit ResponsePipeline(QObject *parent = nullptr);
+
+    void recordJob(quint64 queueNs, quint64 workNs);
+
+    QThreadPool m_pool;
+
+    mutable QMutex m_shapeMutex;
+    QHash<QString, LogShape> m_logShapes;   // query_id → 조건 (워커가 응답 도착 시 꺼내감)
+
+    std::atomic<quint64> m_jobs{0};
+    std::atomic<quint64> m_totalWorkNs{0};
+    std::atomic<quint64> m_maxWorkNs{0};
+    std::atomic<quint64> m_maxQueueNs{0};
+};
+
+#endif // RESPONSE_PIPELINE_H
@@ -0,0 +1,335 @@
+#include "stats_rollup.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QUuid>
+#include <QDebug>
+
+namespace {
+const qint64 kResponseTimeoutMs = 15000;    // 이 안에 응답이 없으면 그 구간은 다음 요청에 다시 포함
+const int kShiftStartHour = 10;             // 오늘 통계 시작 시각 (기존 요청과 동일)
+const int kSaveDelayMs = 5000;              // 합칠 때마다 쓰지 않고 모아서 저장
+const int kReportEvery = 30;
+
+double toNumber(const QJsonValue &value)
+{
+    return value.isString() ? value.toString().toDouble() : value.toDouble();
+}
+}
+
+StatsRollup* StatsRollup::instance()
+{
+    static QPointer<StatsRollup> rollup;
+    if (!rollup) {
+        rollup = new StatsRollup(QCoreApplication::instance());
+    }
+    return rollup;
+}
+
+StatsRollup::StatsRollup(QObject *parent)
+    : QObject(parent)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(kSaveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, &StatsRollup::save);
+    // 끝날 때 모아둔 것 저장
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+        if (m_saveTimer.isActive()) {
+            m_saveTimer.stop();
+            save();
+        }
+    });
+
+    load();
+}
+
+qint64 StatsRollup::windowStart(qint64 now)
+{
+    // 10:00 전에는 시작 시각이 미래라 구간이 거꾸로 → 자정부터
+    const QDateTime at = QDateTime::fromMSecsSinceEpoch(now);
+    const qint64 shift = QDateTime(at.date(), QTime(kShiftStartHour, 0, 0)).toMSecsSinceEpoch();
+    return now >= shift ? shift : at.date().startOfDay().toMSecsSinceEpoch();
+}
+
+void StatsRollup::resetIfNewWindow(const QString &deviceId, qint64 now)
+{
+    const qint64 start = windowStart(now);
+    auto it = m_aggregates.find(deviceId);
+    if (it != m_aggregates.end() && it->windowStart == start) return;
+
+    if (it != m_aggregates.end()) {
+        qDebug() << "[StatsRollup] 구간 변경 - 누적 초기화:" << deviceId
+                 << QDateTime::fromMSecsSinceEpoch(it->windowStart) << "→" << QDateTime::fromMSecsSinceEpoch(start);
+    }
+    Aggregate aggregate;
+    aggregate.day = QDateTime::fromMSecsSinceEpoch(now).date();
+    aggregate.windowStart = start;
+    aggregate.coveredUntil = start;
+    m_aggregates.insert(deviceId, aggregate);
+    m_pending.remove(deviceId);
+}
+
+QByteArray StatsRollup::nextRequest(const QString &deviceId)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    resetIfNewWindow(deviceId, now);
+
+    auto pending = m_pending.find(deviceId);
+    if (pending != m_pending.end() && pending->sentAt + kResponseTimeoutMs < now) {
+        // 응답 유실 - coveredUntil은 그대로라 다음 구간이 이 구간까지 덮음
+        m_counters.lost++;
+        qDebug() << "[StatsRollup] 응답 없음, 다음 요청에 포함:" << deviceId;
+        m_pending.erase(pending);
+    }
+
+    const Aggregate &aggregate = m_aggregates[deviceId];
+    const qint64 dayStart = aggregate.windowStart;
+
+    Pending request;
+    request.requestId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    request.full = !aggregate.exact || aggregate.coveredUntil <= dayStart;
+    // 구간은 (coveredUntil, now] - 경계 샘플이 두 번 세지지 않게 +1
+    request.start = request.full ? dayStart : aggregate.coveredUntil + 1;
+    request.end = now;
+    request.sentAt = now;
+    m_pending.insert(deviceId, request);
+
+    if (request.full) m_counters.fullRequests++;
+    else m_counters.deltaRequests++;
+    m_counters.requestedWindowMs += qMax<qint64>(0, request.end - request.start);
+
+    QJsonObject timeRange;
+    timeRange["start"] = request.start;
+    timeRange["end"] = request.end;
+
+    QJsonObject payload;
+    payload["device_id"] = deviceId;
+    payload["time_range"] = timeRange;
+    payload["request_id"] = request.requestId;     // 서버가 돌려주면 응답을 정확히 짝지음
+
+    qDebug() << "[StatsRollup]" << deviceId << (request.full ? "하루치 요청" : "증분 요청")
+             << (request.end - request.start) / 1000 << "초 구간";
+    return QJsonDocument(payload).toJson(QJsonDocument::Compact);
+}
+
+SpeedStatsPtr StatsRollup::absorb(const SpeedStatsPtr &stats)
+{
+    if (!stats) return stats;
+
+    auto pending = m_pending.find(stats->deviceId);
+    if (pending == m_pending.end()) return stats;
+
+    // factory/statistics는 다른 창의 통계 요청(최근 1분 등)도 같이 씀 → 짝이 확인된 응답만 합침
+    // 다른 요청의 응답은 그대로 넘기고 기다리는 요청도 건드리지 않음
+    switch (matchReply(pending.value(), stats->json)) {
+    case Reply::Ours:
+        break;
+    case Reply::Foreign:
+        m_counters.foreign++;
+        return stats;
+    case Reply::Unknown: {
+        // request_id도 time_range도 돌려주지 않는 서버 → 짝을 지을 수 없으니 그날은 하루치 전체 요청으로
+        // (하루치 응답은 누가 받아도 그 자체로 오늘 평균이라 합치지 않고 그대로 씀)
+        Aggregate &aggregate = m_aggregates[stats->deviceId];
+        if (aggregate.exact) {
+            qDebug() << "[StatsRollup] 응답에 request_id/time_range 없음 - 오늘은 하루치 전체 요청으로 전환:" << stats->deviceId;
+            aggregate.exact = false;
+            scheduleSave();
+        }
+        m_counters.foreign++;
+        return stats;
+    }
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (pending->sentAt + kResponseTimeoutMs < now) {
+        m_counters.lost++;
+        m_pending.erase(pending);
+        return stats;
+    }
+
+    const Pending request = pending.value();
+    m_pending.erase(pending);
+
+    Aggregate &aggregate = m_aggregates[stats->deviceId];
+    aggregate.last = stats->currentSpeed;
+    aggregate.lastAt = now;
+
+    const QJsonValue countValue = stats->json.contains("count") ? stats->json.value("count")
+                                                                : stats->json.value("sample_count");
+    if (countValue.isUndefined() || countValue.isNull()) {
+        // count가 없으면 구간 평균을 합칠 수 없음 → 그날은 하루치 전체 요청으로 (서버 평균을 그대로 사용)
+        if (aggregate.exact) {
+            qDebug() << "[StatsRollup] 응답에 count 없음 - 오늘은 하루치 전체 요청으로 전환:" << stats->deviceId;
+        }
+        aggregate.exact = false;
+        aggregate.coveredUntil = request.end;
+        scheduleSave();
+        emit rollupUpdated(stats->deviceId);
+        return stats;
+    }
+
+    const quint64 windowCount = static_cast<quint64>(qMax(0.0, toNumber(countValue)));
+    const double windowSum = stats->json.contains("sum") ? toNumber(stats->json.value("sum"))
+                                                         : stats->average * windowCount;
+    // min/max를 안 주는 서버면 받은 평균/현재값으로 근사 (실제 최소/최대보다 안쪽) → 근사로 표시
+    const bool windowMinMax = stats->json.contains("min") && stats->json.contains("max");
+    const double windowMin = windowMinMax ? toNumber(stats->json.value("min"))
+                                          : qMin(stats->average, stats->currentSpeed);
+    const double windowMax = windowMinMax ? toNumber(stats->json.value("max"))
+                                          : qMax(stats->average, stats->currentSpeed);
+
+    if (request.full) {
+        // 하루치 응답이면 누적을 통째로 교체
+        aggregate.count = 0;
+        aggregate.sum = 0.0;
+        aggregate.exact = true;
+        aggregate.minMaxApproximate = false;
+    }
+    if (windowCount > 0) {
+        if (!windowMinMax) aggregate.minMaxApproximate = true;
+        aggregate.min = aggregate.count ? qMin(aggregate.min, windowMin) : windowMin;
+        aggregate.max = aggregate.count ? qMax(aggregate.max, windowMax) : windowMax;
+        aggregate.count += windowCount;
+        aggregate.sum += windowSum;
+    }
+    aggregate.coveredUntil = request.end;
+
+    m_counters.merged++;
+    scheduleSave();
+    emit rollupUpdated(stats->deviceId);
+
+    if (m_counters.merged % kReportEvery == 0) {
+        qDebug().noquote() << report();
+    }
+
+    // 소비자(차트, 챗봇)는 지금처럼 "average = 오늘 평균"을 받음
+    auto merged = std::make_shared<SpeedStats>(*stats);
+    merged->average = aggregate.mean();
+    merged->json["window_average"] = stats->average;
+    merged->json["average"] = aggregate.mean();
+    merged->json["count"] = static_cast<double>(aggregate.count);
+    merged->json["min"] = aggregate.min;
+    merged->json["max"] = aggregate.max;
+    merged->json["min_max_approximate"] = aggregate.minMaxApproximate;
+    return merged;
+}
+
+StatsRollup::Reply StatsRollup::matchReply(const Pending &pending, const QJsonObject &reply)
+{
+    const QString requestId = reply.value("request_id").toString();
+    if (!requestId.isEmpty()) return requestId == pending.requestId ? Reply::Ours : Reply::Foreign;
+
+    const QJsonObject range = reply.value("time_range").toObject();
+    if (range.contains("start") && range.contains("end")) {
+        const bool same = static_cast<qint64>(toNumber(range.value("start"))) == pending.start
+                       && static_cast<qint64>(toNumber(range.value("end"))) == pending.end;
+        return same ? Reply::Ours : Reply::Foreign;
+    }
+    return Reply::Unknown;
+}
+
+QString StatsRollup::report() const
+{
+    QStringList lines;
+    const quint64 requests = m_counters.deltaRequests + m_counters.fullRequests;
+    lines << QString("[StatsRollup] 요청 %1건 (증분 %2, 하루치 %3), 합침 %4, 유실 %5, 다른 요청 응답 %6, 평균 요청 구간 %7초")
+                 .arg(requests).arg(m_counters.deltaRequests).arg(m_counters.fullRequests)
+                 .arg(m_counters.merged).arg(m_counters.lost).arg(m_counters.foreign)
+                 .arg(requests ? m_counters.requestedWindowMs / 1000.0 / requests : 0.0, 0, 'f', 1);
+
+    for (auto it = m_aggregates.constBegin(); it != m_aggregates.constEnd(); ++it) {
+        const Aggregate &aggregate = it.value();
+        lines << QString("  %1 (%2): n=%3 평균 %4 최소 %5 최대 %6%7 마지막 %8%9")
+                     .arg(it.key(), QDateTime::fromMSecsSinceEpoch(aggregate.windowStart).toString("yyyy-MM-dd hh:mm~"))
+                     .arg(aggregate.count).arg(aggregate.mean(), 0, 'f', 2)
+                     .arg(aggregate.min, 0, 'f', 1).arg(aggregate.max, 0, 'f', 1)
+                     .arg(aggregate.minMaxApproximate ? " (근사)" : "")
+                     .arg(aggregate.last, 0, 'f', 1)
+                     .arg(aggregate.exact ? "" : " (서버 count 미지원)");
+    }
+    return lines.join('\n');
+}
+
+/* ---------- 저장 ---------- */
+
+void StatsRollup::scheduleSave()
+{
+    if (!m_saveTimer.isActive()) m_saveTimer.start();
+}
+
+QString StatsRollup::storePath() const
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(dir);
+    return dir + "/stats_rollup.json";
+}
+
+void StatsRollup::save() const
+{
+    QJsonObject root;
+    for (auto it = m_aggregates.constBegin(); it != m_aggregates.constEnd(); ++it) {
+        const Aggregate &aggregate = it.value();
+        QJsonObject entry;
+        entry["day"] = aggregate.day.toString(Qt::ISODate);
+        entry["window_start"] = static_cast<double>(aggregate.windowStart);
+        entry["covered_until"] = static_cast<double>(aggregate.coveredUntil);
+        entry["count"] = static_cast<double>(aggregate.count);
+        entry["sum"] = aggregate.sum;
+        entry["min"] = aggregate.min;
+        entry["max"] = aggregate.max;
+        entry["last"] = aggregate.last;
+        entry["last_at"] = static_cast<double>(aggregate.lastAt);
+        entry["exact"] = aggregate.exact;
+        entry["min_max_approximate"] = aggregate.minMaxApproximate;
+        root[it.key()] = entry;
+    }
+
+    QSaveFile file(storePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "[StatsRollup] 저장 실패:" << storePath();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+void StatsRollup::load()
+{
+    QFile file(storePath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    const qint64 start = windowStart(QDateTime::currentMSecsSinceEpoch());
+
+    for (auto it = root.constBegin(); it != root.constEnd(); ++it) {
+        const QJsonObject entry = it.value().toObject();
+
+        Aggregate aggregate;
+        aggregate.day = QDate::fromString(entry.value("day").toString(), Qt::ISODate);
+        aggregate.windowStart = static_cast<qint64>(entry.value("window_start").toDouble());
+        if (aggregate.windowStart != start) continue;   // 지난 날짜/10:00 전 구간은 버림
+
+        aggregate.coveredUntil = static_cast<qint64>(entry.value("covered_until").toDouble());
+        aggregate.count = static_cast<quint64>(entry.value("count").toDouble());
+        aggregate.sum = entry.value("sum").toDouble();
+        aggregate.min = entry.value("min").toDouble();
+        aggregate.max = entry.value("max").toDouble();
+        aggregate.last = entry.value("last").toDouble();
+        aggregate.lastAt = static_cast<qint64>(entry.value("last_at").toDouble());
+        aggregate.exact = entry.value("exact").toBool(true);
+        aggregate.minMaxApproximate = entry.value("min_max_approximate").toBool(false);
+        m_aggregates.insert(it.key(), aggregate);
+    }
+
+    if (!m_aggregates.isEmpty()) {
+        qDebug() << "[StatsRollup] 오늘 누적 복구:" << m_aggregates.keys();
+    }
+}
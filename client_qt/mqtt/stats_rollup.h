@@ -0,0 +1,97 @@
+#ifndef STATS_ROLLUP_H
+#define STATS_ROLLUP_H
+
+#include <QObject>
+#include <QHash>
+#include <QDate>
+#include <QTimer>
+#include "message_types.h"
+
+// "오늘(10:00~지금)" 속도 통계를 클라이언트에서 누적 (10:00 전에는 자정~지금, 10:00이 되면 새로 시작)
+// - 매 주기마다 하루치를 다시 계산시키지 않고, 마지막으로 성공한 구간 끝 ~ 지금 만 요청해서 합침
+// - 응답의 count(+ sum/min/max)로 합치므로 하루 평균은 전체 재요청과 같은 값
+// - 서버가 count를 안 주면 합칠 수 없으니 그날은 예전처럼 하루치 전체 요청으로 되돌림
+//   응답에 request_id/time_range가 없어 내 요청의 응답인지 알 수 없을 때도 마찬가지
+// - min/max는 서버가 주면 그 값, 안 주면 구간 평균/현재값으로 근사 (minMaxApproximate로 표시)
+// - 누적값은 파일(stats_rollup.json)에 저장 → 근무 중간에 재시작해도 이어서 (합칠 때마다가 아니라 몇 초 모아서)
+class StatsRollup : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Aggregate {
+        QDate   day;                // 근무일
+        qint64  windowStart = 0;    // 오늘 구간 시작 (10:00, 10:00 전이면 자정)
+        qint64  coveredUntil = 0;   // 여기까지 합쳐짐 (epoch ms), 다음 요청 구간의 시작
+        quint64 count = 0;
+        double  sum = 0.0;
+        double  min = 0.0;
+        double  max = 0.0;
+        double  last = 0.0;         // 마지막 current_speed
+        qint64  lastAt = 0;
+        bool    exact = true;       // false면 서버가 count를 안 줘서 그날은 하루치 전체 요청
+        bool    minMaxApproximate = false;  // min/max를 안 준 응답이 섞임 → 구간 평균/현재값으로 근사한 값
+
+        double mean() const { return count ? sum / count : 0.0; }
+    };
+
+    struct Counters {
+        quint64 deltaRequests = 0;
+        quint64 fullRequests = 0;       // 하루치 전체 (첫 요청, 서버가 count 미지원)
+        quint64 merged = 0;
+        quint64 lost = 0;               // 응답 없이 만료된 요청 (다음 구간에 포함돼서 다시 요청됨)
+        quint64 foreign = 0;            // 같은 토픽으로 온 다른 요청의 응답 (합치지 않고 그대로 넘김)
+        qint64  requestedWindowMs = 0;  // 요청한 구간 길이 합 (서버가 계산한 양)
+    };
+
+    static StatsRollup* instance();
+
+    // PollScheduler가 발행할 때마다 호출 - factory/statistics 요청 페이로드
+    QByteArray nextRequest(const QString &deviceId);
+
+    // MessageIngest가 factory/<device>/msg/statistics 를 받으면 호출
+    // 이 누적기가 보낸 요청의 응답이면 합친 뒤 하루 기준 값으로 바꾼 통계를, 아니면 그대로 돌려줌
+    // 짝은 돌려받은 request_id로, 없으면 돌려받은 time_range가 기다리는 구간과 같은지로 확인
+    SpeedStatsPtr absorb(const SpeedStatsPtr &stats);
+
+    bool hasAggregate(const QString &deviceId) const { return m_aggregates.contains(deviceId); }
+    Aggregate aggregate(const QString &deviceId) const { return m_aggregates.value(deviceId); }
+    Counters counters() const { return m_counters; }
+    QString report() const;
+
+signals:
+    void rollupUpdated(const QString &deviceId);
+
+private:
+    explicit StatsRollup(QObject *parent = nullptr);
+
+    struct Pending {
+        QString requestId;
+        qint64 start = 0;
+        qint64 end = 0;
+        qint64 sentAt = 0;
+        bool full = false;
+    };
+
+    enum class Reply {
+        Ours,
+        Foreign,
+        Unknown     // request_id도 time_range도 없음
+    };
+
+    static Reply matchReply(const Pending &pending, const QJsonObject &reply);
+    static qint64 windowStart(qint64 now);
+    void resetIfNewWindow(const QString &deviceId, qint64 now);
+
+    void scheduleSave();
+    void save() const;
+    void load();
+    QString storePath() const;
+
+    QHash<QString, Aggregate> m_aggregates;     // deviceId → 오늘 누적
+    QHash<QString, Pending> m_pending;          // deviceId → 응답 기다리는 요청 (기기당 하나)
+    Counters m_counters;
+    QTimer m_saveTimer;
+};
+
+#endif // STATS_ROLLUP_H
@@ -0,0 +1,273 @@
+#include "time_travel.h"
+#include "mqtt_hub.h"
+#include "response_pipeline.h"
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QSettings>
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace {
+const int kMaxErrorMessages = 100;      // 되감을 때 다시 흘려줄 최근 오류 수 (예전 Home 오류 이력 크기)
+const int kMaxSpeedPoints = 10;         // DeviceChart 점 수와 같게
+const int kSeekCoalesceMs = 30;
+const int kPlayTickMs = 50;
+const int kMaxInjectPerTick = 2000;
+
+bool endsWith(const QByteArray &topic, const char *suffix)
+{
+    return topic.endsWith(suffix);
+}
+
+QString environmentPath()
+{
+    return qEnvironmentVariable("VISIONCRAFT_TIME_TRAVEL").trimmed();
+}
+}
+
+/* ---------- 상태 ---------- */
+
+void DashboardState::apply(const Journal::Record &record)
+{
+    at = record.receivedAtMs;
+    if (record.topic.startsWith("factory/query/")) return;
+
+    Message message;
+    message.at = record.receivedAtMs;
+    message.topic = record.topic;
+    message.payload = record.payload;
+
+    if (endsWith(record.topic, "/log/error")) {
+        errors.push_back(std::move(message));
+        if (static_cast<int>(errors.size()) > kMaxErrorMessages) errors.pop_front();
+    } else if (endsWith(record.topic, "/msg/statistics")) {
+        std::deque<Message> &points = speed[record.topic];
+        points.push_back(std::move(message));
+        if (static_cast<int>(points.size()) > kMaxSpeedPoints) points.pop_front();
+    } else {
+        latest.insert(record.topic, std::move(message));
+    }
+}
+
+QVector<DashboardState::Message> DashboardState::messages() const
+{
+    QVector<Message> all;
+    all.reserve(latest.size() + static_cast<int>(errors.size()) + speed.size() * kMaxSpeedPoints);
+    for (const Message &message : latest) all.append(message);
+    for (const auto &points : speed) all.append(QVector<Message>(points.begin(), points.end()));
+    all.append(QVector<Message>(errors.begin(), errors.end()));
+
+    std::stable_sort(all.begin(), all.end(), [](const Message &a, const Message &b) { return a.at < b.at; });
+    return all;
+}
+
+/* ---------- 타임 트래블 ---------- */
+
+bool TimeTravel::isEnabled()
+{
+    return !environmentPath().isEmpty();
+}
+
+TimeTravel* TimeTravel::instance()
+{
+    static QPointer<TimeTravel> timeTravel;
+    if (!timeTravel) {
+        timeTravel = new TimeTravel(QCoreApplication::instance());
+    }
+    return timeTravel;
+}
+
+bool TimeTravel::startFromEnvironment()
+{
+    if (!isEnabled()) return false;
+
+    const QString path = environmentPath();
+    MqttHub::instance()->setReplayMode(true);
+    TimeTravel *timeTravel = instance();
+    // 창들이 구독을 다 등록한 뒤에 색인 시작
+    QTimer::singleShot(1000, timeTravel, [timeTravel, path]() { timeTravel->open(path); });
+    qDebug() << "[TimeTravel] 타임 트래블 모드 - 브로커 대신 저널:" << path;
+    return true;
+}
+
+TimeTravel::TimeTravel(QObject *parent)
+    : QObject(parent)
+{
+    QSettings settings("VisionCraft", "client_qt");
+    m_intervalMs = qMax(10, settings.value("timetravel/checkpoint_sec", 300).toInt()) * 1000LL;
+
+    m_seekTimer.setSingleShot(true);
+    m_seekTimer.setInterval(kSeekCoalesceMs);
+    connect(&m_seekTimer, &QTimer::timeout, this, &TimeTravel::applySeek);
+
+    m_playTimer.setInterval(kPlayTickMs);
+    connect(&m_playTimer, &QTimer::timeout, this, &TimeTravel::onPlayTick);
+}
+
+void TimeTravel::open(const QString &path)
+{
+    m_path = path;
+    if (!m_reader.open(path)) return;
+
+    const qint64 intervalMs = m_intervalMs;
+    // 저널 전체를 한 번 훑는 건 워커에서
+    ResponsePipeline::instance()->run<Index>(this,
+        [path, intervalMs]() { return buildIndex(path, intervalMs); },
+        [this](const Index &index) {
+            m_checkpoints = index.checkpoints;
+            m_firstAt = index.firstAt;
+            m_lastAt = index.lastAt;
+            m_stats.checkpoints = m_checkpoints.size();
+            m_stats.indexedMessages = index.messages;
+            qDebug().noquote() << report();
+            if (m_checkpoints.isEmpty()) return;
+
+            emit ready(m_firstAt, m_lastAt);
+            // 처음에는 기록의 마지막 시점 (녹화가 끝났을 때 화면)
+            m_seekTarget = m_lastAt;
+            applySeek();
+        });
+}
+
+TimeTravel::Index TimeTravel::buildIndex(const QString &path, qint64 intervalMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Index index;
+    JournalReader reader(path);
+    DashboardState state;
+    Journal::Record record;
+    qint64 nextCheckpointAt = std::numeric_limits<qint64>::min();
+    JournalReader::Position before = reader.position();
+
+    while (reader.next(record)) {
+        if (index.messages == 0) index.firstAt = record.receivedAtMs;
+        if (record.receivedAtMs >= nextCheckpointAt) {
+            // 이 레코드 직전까지의 상태
+            Checkpoint checkpoint;
+            checkpoint.at = record.receivedAtMs;
+            checkpoint.position = before;
+            checkpoint.state = state;
+            index.checkpoints.append(std::move(checkpoint));
+            nextCheckpointAt = record.receivedAtMs + intervalMs;
+        }
+        state.apply(record);
+        index.lastAt = record.receivedAtMs;
+        index.messages++;
+        before = reader.position();
+    }
+
+    qDebug() << "[TimeTravel] 색인 완료:" << index.messages << "건, 체크포인트" << index.checkpoints.size()
+             << "개," << timer.elapsed() << "ms";
+    return index;
+}
+
+void TimeTravel::seek(qint64 timestampMs)
+{
+    m_seekTarget = qBound(m_firstAt, timestampMs, m_lastAt);
+    m_seekTimer.start();
+}
+
+void TimeTravel::applySeek()
+{
+    if (m_checkpoints.isEmpty()) return;
+
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 target = m_seekTarget;
+
+    // target 이하인 마지막 체크포인트
+    auto it = std::upper_bound(m_checkpoints.cbegin(), m_checkpoints.cend(), target,
+                               [](qint64 value, const Checkpoint &checkpoint) { return value < checkpoint.at; });
+    const Checkpoint &checkpoint = (it == m_checkpoints.cbegin()) ? m_checkpoints.first() : *(it - 1);
+
+    m_state = checkpoint.state;
+    m_reader.setPosition(checkpoint.position);
+    m_hasPending = false;
+
+    quint64 delta = 0;
+    Journal::Record record;
+    while (m_reader.next(record)) {
+        if (record.receivedAtMs > target) {
+            m_pending = record;
+            m_hasPending = true;
+            break;
+        }
+        m_state.apply(record);
+        delta++;
+    }
+    m_state.at = target;
+
+    emit rewound(target);
+    MqttHub *hub = MqttHub::instance();
+    const QVector<DashboardState::Message> messages = m_state.messages();
+    for (const DashboardState::Message &message : messages) {
+        hub->inject(QString::fromUtf8(message.topic), message.payload, message.at);
+    }
+
+    m_stats.seeks++;
+    m_stats.deltaMessages += delta;
+    m_stats.maxDelta = qMax(m_stats.maxDelta, delta);
+    m_stats.lastSeekMs = timer.elapsed();
+    qDebug() << "[TimeTravel] 이동:" << QDateTime::fromMSecsSinceEpoch(target).toString("MM-dd HH:mm:ss")
+             << "체크포인트 뒤" << delta << "건 반영, 화면에" << messages.size() << "건 전달,"
+             << m_stats.lastSeekMs << "ms";
+
+    if (isPlaying()) {
+        m_playFrom = target;
+        m_playClock.restart();
+    }
+    emit positionChanged(target);
+}
+
+void TimeTravel::play(double speed)
+{
+    m_playSpeed = speed;
+    if (speed <= 0 || m_checkpoints.isEmpty()) {
+        m_playTimer.stop();
+        return;
+    }
+    m_playFrom = m_state.at;
+    m_playClock.start();
+    m_playTimer.start();
+}
+
+void TimeTravel::onPlayTick()
+{
+    const qint64 due = qMin(m_lastAt, m_playFrom + static_cast<qint64>(m_playClock.elapsed() * m_playSpeed));
+
+    // 이동 이후로는 새로 들어오는 메시지만 흘리면 됨 (실시간 수신과 같음)
+    MqttHub *hub = MqttHub::instance();
+    int injected = 0;
+    while (injected < kMaxInjectPerTick) {
+        if (!m_hasPending) {
+            m_hasPending = m_reader.next(m_pending);
+            if (!m_hasPending) break;
+        }
+        if (m_pending.receivedAtMs > due) break;
+
+        m_state.apply(m_pending);
+        hub->inject(QString::fromUtf8(m_pending.topic), m_pending.payload, m_pending.receivedAtMs);
+        m_hasPending = false;
+        injected++;
+    }
+    m_state.at = due;
+    emit positionChanged(due);
+
+    if (!m_hasPending && due >= m_lastAt) {
+        m_playTimer.stop();
+        qDebug() << "[TimeTravel] 기록 끝까지 재생";
+    }
+}
+
+QString TimeTravel::report() const
+{
+    return QString("[TimeTravel] 메시지 %1건, 체크포인트 %2개 (%3초 간격), 이동 %4회 - 평균 %5건/최대 %6건 반영, 마지막 %7ms")
+        .arg(m_stats.indexedMessages).arg(m_stats.checkpoints).arg(m_intervalMs / 1000)
+        .arg(m_stats.seeks).arg(m_stats.seeks ? m_stats.deltaMessages / m_stats.seeks : 0)
+        .arg(m_stats.maxDelta).arg(m_stats.lastSeekMs);
+}
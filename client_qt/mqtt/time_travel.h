@@ -0,0 +1,123 @@
+#ifndef TIME_TRAVEL_H
+#define TIME_TRAVEL_H
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <deque>
+#include "journal_format.h"
+
+// 화면 상태를 되짚는 데 필요한 만큼만 줄인 수신 내역
+// - 상태/불량률 등: 토픽마다 마지막 메시지
+// - 속도 통계: 토픽마다 최근 차트 점 수만큼
+// - 오류 로그: 최근 오류 카드 수만큼
+// - 쿼리 응답(factory/query/...)은 그때의 요청에 대한 답이라 제외
+struct DashboardState
+{
+    struct Message {
+        qint64     at = 0;
+        QByteArray topic;
+        QByteArray payload;
+    };
+
+    QHash<QByteArray, Message> latest;
+    QHash<QByteArray, std::deque<Message>> speed;
+    std::deque<Message> errors;
+    qint64 at = 0;                      // 마지막으로 반영한 메시지 시각
+
+    void apply(const Journal::Record &record);
+    // 시간순으로 다시 흘려보낼 메시지
+    QVector<Message> messages() const;
+};
+
+// 캡처 저널로 지난 시점의 대시보드를 재구성 (타임 트래블)
+// - 저널을 한 번 훑으면서 일정 간격(기록 시각 기준 5분)마다 DashboardState 체크포인트를 남김
+// - 임의 시각 T로 이동: T 이전 마지막 체크포인트 + 그 뒤 T까지의 메시지만 반영 → 이력 전체가 아니라 체크포인트 간격만큼
+// - 재구성한 상태는 rewound() 후 MqttHub::inject 로 흘려서 화면이 실시간 때와 같은 경로로 그리게 함
+// - 켜기: VISIONCRAFT_TIME_TRAVEL=<저널 폴더> (브로커에 붙지 않음), 체크포인트 간격 timetravel/checkpoint_sec
+class TimeTravel : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        int     checkpoints = 0;
+        quint64 indexedMessages = 0;
+        qint64  indexMs = 0;
+        quint64 seeks = 0;
+        quint64 deltaMessages = 0;      // 이동할 때 체크포인트 뒤에 반영한 메시지 (합)
+        quint64 maxDelta = 0;
+        qint64  lastSeekMs = 0;
+    };
+
+    static bool isEnabled();
+    static TimeTravel* instance();
+    // 환경 변수가 있으면 재생 모드로 색인을 시작하고 true
+    static bool startFromEnvironment();
+
+    bool isReady() const { return !m_checkpoints.isEmpty(); }
+    qint64 firstTime() const { return m_firstAt; }
+    qint64 lastTime() const { return m_lastAt; }
+    qint64 currentTime() const { return m_state.at; }
+
+    // T 시점의 화면으로 (연속으로 불러도 마지막 것만 실제로 처리)
+    void seek(qint64 timestampMs);
+    // 현재 시점부터 기록된 속도 × speed 로 진행 (0이면 멈춤)
+    void play(double speed);
+    bool isPlaying() const { return m_playTimer.isActive(); }
+
+    Stats stats() const { return m_stats; }
+    QString report() const;
+
+signals:
+    void ready(qint64 firstMs, qint64 lastMs);
+    // 화면이 쌓아둔 상태(오류 카드, 차트)를 비워야 할 때 - 직후에 재구성한 메시지가 들어옴
+    void rewound(qint64 timestampMs);
+    void positionChanged(qint64 timestampMs);
+
+private:
+    explicit TimeTravel(QObject *parent = nullptr);
+
+    struct Checkpoint {
+        qint64 at = 0;
+        JournalReader::Position position;   // 체크포인트 직후 레코드 위치
+        DashboardState state;
+    };
+
+    struct Index {
+        QVector<Checkpoint> checkpoints;
+        qint64 firstAt = 0;
+        qint64 lastAt = 0;
+        quint64 messages = 0;
+    };
+
+    void open(const QString &path);
+    static Index buildIndex(const QString &path, qint64 intervalMs);
+    void applySeek();
+    void onPlayTick();
+
+    QString m_path;
+    qint64 m_intervalMs = 0;
+    QVector<Checkpoint> m_checkpoints;
+    qint64 m_firstAt = 0;
+    qint64 m_lastAt = 0;
+
+    JournalReader m_reader;             // 현재 시점 직후를 가리킴
+    DashboardState m_state;
+    Journal::Record m_pending;          // 읽었지만 아직 시각이 안 된 레코드 (재생 중)
+    bool m_hasPending = false;
+
+    QTimer m_seekTimer;                 // 슬라이더를 끌 때 합치기
+    qint64 m_seekTarget = 0;
+
+    QTimer m_playTimer;
+    QElapsedTimer m_playClock;
+    qint64 m_playFrom = 0;
+    double m_playSpeed = 0.0;
+
+    Stats m_stats;
+};
+
+#endif // TIME_TRAVEL_H
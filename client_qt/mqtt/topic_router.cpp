@@ -0,0 +1,106 @@
+#include "topic_router.h"
+
+TopicRouter::TopicRouter()
+    : m_root(new Node)
+{
+}
+
+TopicRouter::~TopicRouter() = default;
+
+void TopicRouter::insert(const QString &filter, int routeId)
+{
+    const QStringList segments = filter.split('/');
+    Node *node = m_root.get();
+
+    for (int i = 0; i < segments.size(); ++i) {
+        const QString &seg = segments.at(i);
+        if (seg == "#") {
+            node->hashRoutes.append(routeId);
+            return;
+        }
+        if (seg == "+") {
+            if (!node->plus) node->plus.reset(new Node);
+            node = node->plus.get();
+        } else {
+            Node *&child = node->children[seg];
+            if (!child) child = new Node;
+            node = child;
+        }
+    }
+    node->routes.append(routeId);
+}
+
+void TopicRouter::remove(const QString &filter, int routeId)
+{
+    // 빈 노드는 남겨둠 (필터 종류가 몇 개 안돼서 정리 비용이 더 큼)
+    const QStringList segments = filter.split('/');
+    Node *node = m_root.get();
+
+    for (int i = 0; i < segments.size() && node; ++i) {
+        const QString &seg = segments.at(i);
+        if (seg == "#") {
+            node->hashRoutes.removeAll(routeId);
+            return;
+        }
+        node = (seg == "+") ? node->plus.get() : node->children.value(seg, nullptr);
+    }
+    if (node) node->routes.removeAll(routeId);
+}
+
+void TopicRouter::clear()
+{
+    m_root.reset(new Node);
+}
+
+QVector<TopicRouter::Match> TopicRouter::match(const QString &topic) const
+{
+    QVector<Match> out;
+    const QStringList segments = topic.split('/');
+    QStringList captures;
+    collect(m_root.get(), segments, 0, captures, 0, out);
+    return out;
+}
+
+void TopicRouter::collect(const Node *node, const QStringList &segments, int depth,
+                          QStringList &captures, int literals, QVector<Match> &out) const
+{
+    // '#'는 현재 레벨 포함 나머지 전부 (a/# 는 a 자체도 매칭)
+    if (!node->hashRoutes.isEmpty()) {
+        QStringList withRest = captures;
+        withRest.append(segments.mid(depth).join('/'));
+        for (int id : node->hashRoutes) {
+            out.append({id, withRest, literals});
+        }
+    }
+
+    if (depth == segments.size()) {
+        for (int id : node->routes) {
+            out.append({id, captures, literals});
+        }
+        return;
+    }
+
+    const QString &seg = segments.at(depth);
+
+    if (const Node *child = node->children.value(seg, nullptr)) {
+        collect(child, segments, depth + 1, captures, literals + 1, out);
+    }
+
+    if (node->plus) {
+        captures.append(seg);
+        collect(node->plus.get(), segments, depth + 1, captures, literals, out);
+        captures.removeLast();
+    }
+}
+
+bool TopicRouter::isValidFilter(const QString &filter)
+{
+    if (filter.isEmpty()) return false;
+    const QStringList segments = filter.split('/');
+    for (int i = 0; i < segments.size(); ++i) {
+        const QString &seg = segments.at(i);
+        if (seg == "#" && i != segments.size() - 1) return false;
+        if (seg != "#" && seg != "+" && (seg.contains('#') || seg.contains('+'))) return false;
+    }
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef TOPIC_ROUTER_H
+#define TOPIC_ROUTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <QtAlgorithms>
+#include <memory>
+
+// MQTT 토픽 필터 트라이
+// - 필터를 '/' 단위로 미리 쪼개서 트리로 보관 (등록 시 한 번만)
+// - 조회 비용은 토픽 깊이에만 비례, 등록된 기기/토픽 수와 무관 (리터럴 세그먼트는 해시 조회)
+// - '+' 와 '#' 와일드카드 지원, 와일드카드에 걸린 세그먼트를 captures로 돌려줌
+class TopicRouter
+{
+public:
+    struct Match {
+        int routeId = -1;
+        QStringList captures;   // '+' 순서대로, '#'이면 나머지 경로 한 덩어리
+        int specificity = 0;    // 리터럴 세그먼트 수 (클수록 구체적)
+    };
+
+    TopicRouter();
+    ~TopicRouter();
+
+    void insert(const QString &filter, int routeId);
+    void remove(const QString &filter, int routeId);
+    void clear();
+
+    QVector<Match> match(const QString &topic) const;
+
+    static bool isValidFilter(const QString &filter);
+
+private:
+    struct Node {
+        QHash<QString, Node*> children;   // 리터럴 세그먼트
+        std::unique_ptr<Node> plus;       // '+'
+        QVector<int> routes;              // 여기서 끝나는 필터
+        QVector<int> hashRoutes;          // 여기서 '#'으로 끝나는 필터
+        ~Node() { qDeleteAll(children); }
+    };
+
+    void collect(const Node *node, const QStringList &segments, int depth,
+                 QStringList &captures, int literals, QVector<Match> &out) const;
+
+    std::unique_ptr<Node> m_root;
+};
+
+#endif // TOPIC_ROUTER_H
@@ -0,0 +1,182 @@
+#include "wire_codec.h"
+
+#include <QCborValue>
+#include <QCborMap>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <atomic>
+
+namespace {
+
+const char kMagic[] = "VCZ";        // 뒤에 'C'(cbor) 또는 'J'(json)
+const int kHeaderSize = 4;
+const int kCompressLevel = 6;
+
+std::atomic<quint64> g_json{0};
+std::atomic<quint64> g_cbor{0};
+std::atomic<quint64> g_cborZlib{0};
+std::atomic<quint64> g_jsonZlib{0};
+std::atomic<quint64> g_wireBytes{0};
+std::atomic<quint64> g_plainBytes{0};
+std::atomic<quint64> g_inflateNs{0};
+std::atomic<quint64> g_errors{0};
+
+bool hasMagic(const QByteArray &payload)
+{
+    return payload.size() > kHeaderSize && payload.startsWith(kMagic);
+}
+
+} // namespace
+
+QJsonArray WireCodec::acceptedEncodings()
+{
+    return QJsonArray{ "cbor+zlib", "cbor", "json+zlib", "json" };
+}
+
+WireCodec::Encoding WireCodec::sniff(const QByteArray &payload)
+{
+    if (payload.isEmpty()) return Encoding::Unknown;
+
+    if (hasMagic(payload)) {
+        switch (payload.at(3)) {
+        case 'C': return Encoding::CborZlib;
+        case 'J': return Encoding::JsonZlib;
+        default:  return Encoding::Unknown;
+        }
+    }
+
+    const uchar first = static_cast<uchar>(payload.at(0));
+
+    // CBOR: self-describe 태그(D9 D9 F7) 또는 맵(major type 5)으로 시작
+    if (first == 0xD9 && payload.size() >= 3
+        && static_cast<uchar>(payload.at(1)) == 0xD9 && static_cast<uchar>(payload.at(2)) == 0xF7)
+        return Encoding::Cbor;
+    if ((first & 0xE0) == 0xA0) return Encoding::Cbor;
+
+    // JSON: 공백 뒤 '{' (pretty-print 응답은 줄바꿈/들여쓰기로 시작할 수 있음)
+    for (char c : payload) {
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+        return c == '{' ? Encoding::Json : Encoding::Unknown;
+    }
+    return Encoding::Unknown;
+}
+
+QString WireCodec::name(Encoding encoding)
+{
+    switch (encoding) {
+    case Encoding::Json:     return "json";
+    case Encoding::Cbor:     return "cbor";
+    case Encoding::CborZlib: return "cbor+zlib";
+    case Encoding::JsonZlib: return "json+zlib";
+    default:                 return "unknown";
+    }
+}
+
+WireCodec::Encoding WireCodec::fromName(const QString &name)
+{
+    const QString key = name.trimmed().toLower();
+    if (key == "json") return Encoding::Json;
+    if (key == "cbor") return Encoding::Cbor;
+    if (key == "cbor+zlib") return Encoding::CborZlib;
+    if (key == "json+zlib") return Encoding::JsonZlib;
+    return Encoding::Unknown;
+}
+
+WireCodec::Encoding WireCodec::unwrap(const QByteArray &payload, QByteArray &body)
+{
+    const Encoding encoding = sniff(payload);
+    g_wireBytes += payload.size();
+
+    switch (encoding) {
+    case Encoding::Json:
+        g_json++;
+        body = payload;
+        g_plainBytes += body.size();
+        return Encoding::Json;
+    case Encoding::Cbor:
+        g_cbor++;
+        body = payload;
+        g_plainBytes += body.size();
+        return Encoding::Cbor;
+    case Encoding::CborZlib:
+    case Encoding::JsonZlib: {
+        QElapsedTimer timer;
+        timer.start();
+        // 헤더 뒤는 qCompress 형식 그대로 (4바이트 원본 크기 + zlib 스트림)
+        body = qUncompress(reinterpret_cast<const uchar *>(payload.constData()) + kHeaderSize,
+                           payload.size() - kHeaderSize);
+        g_inflateNs += static_cast<quint64>(timer.nsecsElapsed());
+        if (body.isEmpty()) {
+            g_errors++;
+            qDebug() << "[WireCodec] 압축 해제 실패:" << payload.size() << "bytes";
+            return Encoding::Unknown;
+        }
+        g_plainBytes += body.size();
+        if (encoding == Encoding::CborZlib) {
+            g_cborZlib++;
+            return Encoding::Cbor;
+        }
+        g_jsonZlib++;
+        return Encoding::Json;
+    }
+    default:
+        g_errors++;
+        body.clear();
+        return Encoding::Unknown;
+    }
+}
+
+bool WireCodec::toJsonObject(const QByteArray &payload, QJsonObject &out)
+{
+    QByteArray body;
+    switch (unwrap(payload, body)) {
+    case Encoding::Json: {
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(body, &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject()) return false;
+        out = doc.object();
+        return true;
+    }
+    case Encoding::Cbor: {
+        QCborParserError error;
+        const QCborValue value = QCborValue::fromCbor(body, &error);
+        if (error.error != QCborError::NoError || !value.isMap()) return false;
+        out = value.toMap().toJsonObject();
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+QByteArray WireCodec::encode(const QJsonObject &object, Encoding encoding)
+{
+    switch (encoding) {
+    case Encoding::Json:
+        return QJsonDocument(object).toJson(QJsonDocument::Compact);
+    case Encoding::Cbor:
+        // 소수점 없는 숫자(timestamp 등)는 정수로 들어간다
+        return QCborMap::fromJsonObject(object).toCborValue().toCbor();
+    case Encoding::CborZlib:
+        return QByteArray(kMagic) + 'C' + qCompress(encode(object, Encoding::Cbor), kCompressLevel);
+    case Encoding::JsonZlib:
+        return QByteArray(kMagic) + 'J' + qCompress(encode(object, Encoding::Json), kCompressLevel);
+    default:
+        return QByteArray();
+    }
+}
+
+WireCodec::Stats WireCodec::stats()
+{
+    Stats stats;
+    stats.json = g_json.load();
+    stats.cbor = g_cbor.load();
+    stats.cborZlib = g_cborZlib.load();
+    stats.jsonZlib = g_jsonZlib.load();
+    stats.wireBytes = g_wireBytes.load();
+    stats.plainBytes = g_plainBytes.load();
+    stats.inflateNs = g_inflateNs.load();
+    stats.errors = g_errors.load();
+    return stats;
+}
@@ -0,0 +1,55 @@
+#ifndef WIRE_CODEC_H
+#define WIRE_CODEC_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QString>
+
+// 쿼리 트래픽 전송 형식 (요청의 accept_encoding으로 협상, 응답은 앞 바이트로 판별)
+// - json        : 구 서버 그대로
+// - cbor        : QCborValue 직렬화 (같은 키 2000번 반복이어도 훨씬 작고 파싱이 빠름)
+// - cbor+zlib   : 큰 응답용, "VCZC" + qCompress(cbor)
+// - json+zlib   : "VCZJ" + qCompress(json) (CBOR을 못 쓰는 서버용)
+class WireCodec
+{
+public:
+    enum class Encoding {
+        Unknown,
+        Json,
+        Cbor,
+        CborZlib,
+        JsonZlib
+    };
+
+    struct Stats {
+        quint64 json = 0;
+        quint64 cbor = 0;
+        quint64 cborZlib = 0;
+        quint64 jsonZlib = 0;
+        quint64 wireBytes = 0;                    // 받은 그대로의 크기
+        quint64 plainBytes = 0;                    // 압축 해제 후 크기
+        quint64 inflateNs = 0;
+        quint64 errors = 0;
+    };
+
+    // 요청에 실을 선호 순서 (서버는 아는 것 중 첫 번째를 고르고, 모르면 json)
+    static QJsonArray acceptedEncodings();
+
+    static Encoding sniff(const QByteArray &payload);
+    static QString name(Encoding encoding);
+    static Encoding fromName(const QString &name);
+
+    // 압축이면 풀고 실제 본문 형식(Json/Cbor)을 돌려준다. 실패하면 Unknown
+    static Encoding unwrap(const QByteArray &payload, QByteArray &body);
+
+    // 형식과 관계없이 객체로 (비디오 응답 등 작은 응답용)
+    static bool toJsonObject(const QByteArray &payload, QJsonObject &out);
+
+    // 변환 도구 / 서버 쪽 참고 구현용
+    static QByteArray encode(const QJsonObject &object, Encoding encoding);
+
+    static Stats stats();
+};
+
+#endif // WIRE_CODEC_H
@@ -0,0 +1,91 @@
+// 캡처 저널 형식 - 세그먼트 경계를 넘는 쓰기/읽기, seek
+
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "../mqtt/journal_format.h"
+
+class JournalFormatTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTripAcrossSegments();
+    void emptyFolderIsInvalid();
+};
+
+void JournalFormatTest::roundTripAcrossSegments()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QVector<Journal::Record> written;
+    for (int i = 0; i < 50; ++i) {
+        Journal::Record record;
+        record.receivedAtMs = 1700000000000 + i * 10;
+        record.qos = static_cast<quint8>(i % 3);
+        record.retain = i % 7 == 0;
+        record.topic = QString("factory/feeder_%1/log/error").arg(i % 4).toUtf8();
+        record.payload = QByteArray(i * 3, static_cast<char>('a' + i % 26));
+        written.append(record);
+    }
+
+    // 작은 세그먼트 여러 개에 나눠 씀 (경계를 넘어 읽는지)
+    const qint64 segmentBytes = 2048;
+    JournalSegmentWriter writer;
+    int sequence = 0;
+    QVERIFY(writer.open(dir.filePath(Journal::segmentFileName(1700000000000, sequence++)), segmentBytes, 1700000000000));
+    for (const Journal::Record &record : std::as_const(written)) {
+        const QByteArray encoded = Journal::encode(record);
+        if (writer.append(encoded)) continue;
+        QVERIFY(writer.open(dir.filePath(Journal::segmentFileName(record.receivedAtMs, sequence++)),
+                            segmentBytes, record.receivedAtMs));
+        QVERIFY(writer.append(encoded));
+    }
+    writer.close();
+    QVERIFY(sequence > 1);
+
+    JournalReader reader;
+    QVERIFY(reader.open(dir.path()));
+    QCOMPARE(reader.segments().size(), sequence);
+
+    Journal::Record record;
+    int count = 0;
+    while (reader.next(record)) {
+        QVERIFY(count < written.size());
+        const Journal::Record &expected = written.at(count);
+        QCOMPARE(record.receivedAtMs, expected.receivedAtMs);
+        QCOMPARE(record.qos, expected.qos);
+        QCOMPARE(record.retain, expected.retain);
+        QCOMPARE(record.topic, expected.topic);
+        QCOMPARE(record.payload, expected.payload);
+        count++;
+    }
+    QCOMPARE(count, written.size());
+
+    // seek는 그 시각 이후 첫 레코드로 (세그먼트 중간이어도)
+    reader.seek(written.at(30).receivedAtMs);
+    QVERIFY(reader.next(record));
+    QCOMPARE(record.receivedAtMs, written.at(30).receivedAtMs);
+    reader.seek(written.at(30).receivedAtMs - 5);
+    QVERIFY(reader.next(record));
+    QCOMPARE(record.receivedAtMs, written.at(30).receivedAtMs);
+
+    reader.rewind();
+    QVERIFY(reader.next(record));
+    QCOMPARE(record.receivedAtMs, written.first().receivedAtMs);
+}
+
+void JournalFormatTest::emptyFolderIsInvalid()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    JournalReader reader;
+    reader.open(dir.path());
+    QVERIFY(!reader.isValid());
+    Journal::Record record;
+    QVERIFY(!reader.next(record));
+}
+
+QTEST_GUILESS_MAIN(JournalFormatTest)
+#include "tst_journal_format.moc"
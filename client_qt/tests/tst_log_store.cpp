@@ -0,0 +1,364 @@
+// LogStore - 열 단위 저장 왕복, 최신순 조회, 기기/코드 집계, 스냅샷 불변
+// 최신순은 들어온 순서가 아니라 timestamp 순 (백필/복원으로 과거 로그가 나중에 들어와도)
+// 검색은 색인으로 좁힌 결과가 행을 하나씩 거른 결과와 같은지
+
+#include <QtTest>
+#include <QJsonObject>
+#include <algorithm>
+
+#include "../mqtt/log_store.h"
+
+namespace {
+
+QJsonObject makeLog(const QString &deviceId, const QString &code, const QString &level,
+                    const QString &message, qint64 timestamp)
+{
+    QJsonObject log;
+    log["device_id"] = deviceId;
+    log["log_code"] = code;
+    log["log_level"] = level;
+    log["message"] = message;
+    log["timestamp"] = timestamp;
+    return log;
+}
+
+qint64 timestampOf(const QJsonObject &log)
+{
+    return log.value("timestamp").toVariant().toLongLong();
+}
+
+}
+
+class LogStoreTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void rowRoundTrip();
+    void newestAcrossChunks();
+    void newestForDevice();
+    void newestByTimestampAfterBackfill();
+    void countsByDeviceAndCode();
+    void snapshotIsStable();
+
+    void searchByDevice();
+    void searchByLevel();
+    void searchByCode();
+    void searchByText();
+    void searchByTimeRange();
+    void searchLimit();
+    void searchUnknownValues();
+    void searchMatchesLinearScan();
+};
+
+void LogStoreTest::init()
+{
+    LogStore::instance()->clear();
+}
+
+void LogStoreTest::rowRoundTrip()
+{
+    LogStore *store = LogStore::instance();
+    QJsonObject log = makeLog("feeder_01", "E100", "warning", "모터 과열", 1700000000123);
+    log["repeat_count"] = 3;
+    store->append(log);
+
+    const QList<QJsonObject> rows = store->snapshot().newest(0);
+    QCOMPARE(rows.size(), 1);
+    const QJsonObject &row = rows.first();
+    QCOMPARE(row.value("device_id").toString(), QString("feeder_01"));
+    QCOMPARE(row.value("log_code").toString(), QString("E100"));
+    QCOMPARE(row.value("log_level").toString(), QString("warning"));
+    QCOMPARE(row.value("message").toString(), QString("모터 과열"));
+    QCOMPARE(timestampOf(row), qint64(1700000000123));
+    QCOMPARE(row.value("repeat_count").toInt(), 3);
+}
+
+void LogStoreTest::newestAcrossChunks()
+{
+    LogStore *store = LogStore::instance();
+    const int rows = LogColumns::kChunkRows + 10;
+    for (int i = 1; i <= rows; ++i) store->append(makeLog("feeder_01", "E100", "error", "tick", i));
+    QCOMPARE(store->size(), rows);
+
+    const LogSnapshot snapshot = store->snapshot();
+    QCOMPARE(snapshot.size(), rows);
+    const QList<QJsonObject> newest = snapshot.newest(3);
+    QCOMPARE(newest.size(), 3);
+    QCOMPARE(timestampOf(newest.at(0)), qint64(rows));
+    QCOMPARE(timestampOf(newest.at(2)), qint64(rows - 2));
+    QCOMPARE(snapshot.newest(0).size(), rows);
+}
+
+void LogStoreTest::newestForDevice()
+{
+    LogStore *store = LogStore::instance();
+    for (int i = 1; i <= 30; ++i) {
+        store->append(makeLog(i % 3 == 0 ? "conveyor_01" : "feeder_01", "E100", "error", "tick", i));
+    }
+
+    const LogSnapshot snapshot = store->snapshot();
+    const QList<QJsonObject> conveyor = snapshot.newestForDevice("conveyor_01", 4);
+    QCOMPARE(conveyor.size(), 4);
+    QCOMPARE(timestampOf(conveyor.first()), qint64(30));
+    for (const QJsonObject &log : conveyor) {
+        QCOMPARE(log.value("device_id").toString(), QString("conveyor_01"));
+    }
+    QCOMPARE(snapshot.newestForDevices({"conveyor_01", "feeder_01"}, 0).size(), 30);
+    QVERIFY(snapshot.newestForDevice("robot_arm_09", 0).isEmpty());
+}
+
+void LogStoreTest::newestByTimestampAfterBackfill()
+{
+    // 실시간 로그로 청크 하나 이상 채운 뒤, 그 사이 시각의 과거 로그가 뒤 청크로 들어옴
+    LogStore *store = LogStore::instance();
+    const int live = LogColumns::kChunkRows + 10;
+    for (int i = 0; i < live; ++i) {
+        store->append(makeLog(i % 2 ? "conveyor_01" : "feeder_01", "E100", "error", "live", 100000 + i * 2));
+    }
+    for (int i = 0; i < 200; ++i) {
+        store->append(makeLog("feeder_01", "E100", "error", "backfill", 100000 + (live - 1 - i) * 2 + 1));
+    }
+    for (int i = 0; i < 50; ++i) store->append(makeLog("feeder_01", "E100", "error", "old", 1000 + i));
+
+    const LogSnapshot snapshot = store->snapshot();
+    const QList<QJsonObject> all = snapshot.newest(0);
+    QCOMPARE(all.size(), live + 250);
+    for (int i = 1; i < all.size(); ++i) QVERIFY(timestampOf(all.at(i - 1)) >= timestampOf(all.at(i)));
+
+    // 가장 최신 실시간 로그 바로 아래에 백필분이 끼어야 함
+    const QList<QJsonObject> top = snapshot.newest(3);
+    QCOMPARE(timestampOf(top.at(0)), qint64(100000 + (live - 1) * 2 + 1));
+    QCOMPARE(top.at(0).value("message").toString(), QString("backfill"));
+    QCOMPARE(timestampOf(top.at(1)), qint64(100000 + (live - 1) * 2));
+    QCOMPARE(top.at(1).value("message").toString(), QString("live"));
+
+    // 맨 뒤에 들어온 과거 로그는 맨 끝
+    QCOMPARE(all.last().value("message").toString(), QString("old"));
+    QCOMPARE(timestampOf(all.last()), qint64(1000));
+
+    const QList<QJsonObject> feeder = snapshot.newestForDevice("feeder_01", 5);
+    QCOMPARE(feeder.size(), 5);
+    QCOMPARE(timestampOf(feeder.first()), qint64(100000 + (live - 1) * 2 + 1));
+    for (int i = 1; i < feeder.size(); ++i) QVERIFY(timestampOf(feeder.at(i - 1)) > timestampOf(feeder.at(i)));
+
+    // 검색도 같은 순서 - limit이 있어도 최신 청크를 놓치지 않음
+    const QList<QJsonObject> results = store->search(LogQuery(), 4);
+    QCOMPARE(results.size(), 4);
+    for (int i = 0; i < results.size(); ++i) QCOMPARE(timestampOf(results.at(i)), timestampOf(all.at(i)));
+
+    LogQuery old;
+    old.text = "old";
+    const QList<QJsonObject> oldRows = store->search(old, 2);
+    QCOMPARE(oldRows.size(), 2);
+    QCOMPARE(timestampOf(oldRows.first()), qint64(1049));
+}
+
+void LogStoreTest::countsByDeviceAndCode()
+{
+    LogStore *store = LogStore::instance();
+    store->append(makeLog("feeder_01", "E100", "error", "a", 1));
+    store->append(makeLog("feeder_01", "E200", "error", "b", 2));
+    store->append(makeLog("feeder_02", "E100", "error", "c", 3));
+
+    const LogSnapshot snapshot = store->snapshot();
+    QCOMPARE(snapshot.countForDevice("feeder_01"), 2);
+    QCOMPARE(snapshot.countForDevice("feeder_02"), 1);
+    QCOMPARE(snapshot.countForCode("E100"), 2);
+    QCOMPARE(snapshot.countForCode("E999"), 0);
+    QVERIFY(snapshot.deviceIds().contains("feeder_02"));
+}
+
+void LogStoreTest::snapshotIsStable()
+{
+    LogStore *store = LogStore::instance();
+    store->append(makeLog("feeder_01", "E100", "error", "first", 1000));
+    const LogSnapshot snapshot = store->snapshot();
+    QCOMPARE(snapshot.size(), 1);
+
+    // 스냅샷을 뜬 뒤의 추가/비우기는 들고 있는 스냅샷에 보이지 않음
+    store->append(makeLog("feeder_01", "E100", "error", "second", 2000));
+    store->clear();
+    QCOMPARE(snapshot.size(), 1);
+    QCOMPARE(snapshot.newest(0).first().value("message").toString(), QString("first"));
+    QCOMPARE(store->size(), 0);
+}
+
+void LogStoreTest::searchByDevice()
+{
+    LogStore *store = LogStore::instance();
+    store->append(makeLog("feeder_01", "E100", "error", "motor stall", 1000));
+    store->append(makeLog("feeder_02", "E100", "error", "motor stall", 2000));
+    store->append(makeLog("conveyor_01", "E200", "error", "belt slip", 3000));
+
+    LogQuery query;
+    query.deviceIds = {"feeder_02"};
+    const QList<QJsonObject> results = store->search(query, 0);
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().value("device_id").toString(), QString("feeder_02"));
+
+    query.deviceIds = {"feeder_01", "conveyor_01"};
+    QCOMPARE(store->search(query, 0).size(), 2);
+}
+
+void LogStoreTest::searchByLevel()
+{
+    LogStore *store = LogStore::instance();
+    store->append(makeLog("feeder_01", "E100", "error", "motor stall", 1000));
+    store->append(makeLog("feeder_01", "W100", "warning", "motor warm", 2000));
+    store->append(makeLog("feeder_02", "E100", "error", "motor stall", 3000));
+
+    LogQuery query;
+    query.level = LogLevel::Warning;
+    const QList<QJsonObject> warnings = store->search(query, 0);
+    QCOMPARE(warnings.size(), 1);
+    QCOMPARE(timestampOf(warnings.first()), qint64(2000));
+
+    query.level = LogLevel::Error;
+    query.deviceIds = {"feeder_01"};
+    QCOMPARE(store->search(query, 0).size(), 1);
+}
+
+void LogStoreTest::searchByCode()
+{
+    LogStore *store = LogStore::instance();
+    store->append(makeLog("feeder_01", "E100", "error", "motor stall", 1000));
+    store->append(makeLog("feeder_01", "E1000", "error", "motor stall", 2000));
+    store->append(makeLog("feeder_02", "E100", "warning", "motor warm", 3000));
+
+    // logCode는 정확히 같은 코드만 (E100으로 E1000이 걸리면 안 됨)
+    LogQuery query;
+    query.logCode = "E100";
+    QCOMPARE(store->search(query, 0).size(), 2);
+
+    query.level = LogLevel::Error;
+    const QList<QJsonObject> errors = store->search(query, 0);
+    QCOMPARE(errors.size(), 1);
+    QCOMPARE(timestampOf(errors.first()), qint64(1000));
+
+    query.logCode = "E999";
+    QVERIFY(store->search(query, 0).isEmpty());
+}
+
+void LogStoreTest::searchByText()
+{
+    LogStore *store = LogStore::instance();
+    store->append(makeLog("feeder_01", "E100", "error", "Motor overheat detected", 1000));
+    store->append(makeLog("feeder_02", "E200", "error", "Sensor timeout", 2000));
+    store->append(makeLog("conveyor_01", "E300", "error", "motor current high", 3000));
+
+    LogQuery query;
+    query.text = "motor";
+    QCOMPARE(store->search(query, 0).size(), 2);
+
+    // 단어 앞부분, 대소문자 무시
+    query.text = "OVERH";
+    QCOMPARE(store->search(query, 0).size(), 1);
+
+    // 여러 단어는 모두 맞아야 함 (기기/코드/메시지 어디든)
+    query.text = "conveyor motor";
+    const QList<QJsonObject> both = store->search(query, 0);
+    QCOMPARE(both.size(), 1);
+    QCOMPARE(both.first().value("device_id").toString(), QString("conveyor_01"));
+
+    query.text = "e200";
+    QCOMPARE(store->search(query, 0).size(), 1);
+
+    query.text = "nothing";
+    QVERIFY(store->search(query, 0).isEmpty());
+}
+
+void LogStoreTest::searchByTimeRange()
+{
+    LogStore *store = LogStore::instance();
+    for (int i = 1; i <= 10; ++i) store->append(makeLog("feeder_01", "E100", "error", "tick", i * 1000));
+
+    LogQuery query;
+    query.startMs = 3000;
+    query.endMs = 6000;     // 포함
+    const QList<QJsonObject> results = store->search(query, 0);
+    QCOMPARE(results.size(), 4);
+    for (const QJsonObject &log : results) {
+        QVERIFY(timestampOf(log) >= 3000);
+        QVERIFY(timestampOf(log) <= 6000);
+    }
+}
+
+void LogStoreTest::searchLimit()
+{
+    LogStore *store = LogStore::instance();
+    for (int i = 1; i <= 100; ++i) store->append(makeLog("feeder_01", "E100", "error", "tick", i));
+
+    const QList<QJsonObject> results = store->search(LogQuery(), 5);
+    QCOMPARE(results.size(), 5);
+    QCOMPARE(timestampOf(results.first()), qint64(100));
+}
+
+void LogStoreTest::searchUnknownValues()
+{
+    LogStore *store = LogStore::instance();
+    store->append(makeLog("feeder_01", "E100", "error", "tick", 1000));
+
+    LogQuery query;
+    query.deviceIds = {"robot_arm_09"};
+    QVERIFY(store->search(query, 0).isEmpty());
+}
+
+void LogStoreTest::searchMatchesLinearScan()
+{
+    // 청크 경계를 넘게 채우고, 색인 검색 결과가 LogQuery::matches로 하나씩 거른 결과와 같은지
+    LogStore *store = LogStore::instance();
+    const QStringList devices = {"feeder_01", "feeder_02", "conveyor_01", "conveyor_03"};
+    const QStringList codes = {"E100", "E200", "W300"};
+    const QStringList words = {"motor", "belt", "sensor", "jam", "overheat"};
+    const QStringList levels = {"error", "warning", "info"};
+
+    QList<QJsonObject> all;
+    const int rows = LogColumns::kChunkRows * 2 + 123;
+    for (int i = 0; i < rows; ++i) {
+        // 시각은 들어온 순서와 다르게 섞음
+        const qint64 timestamp = 1000000 + (i * 7919) % rows;
+        const QString message = words.at(i % words.size()) + " " + words.at((i / 3) % words.size()) + " #" + QString::number(i);
+        const QJsonObject log = makeLog(devices.at(i % devices.size()), codes.at((i / 2) % codes.size()),
+                                        levels.at((i / 5) % levels.size()), message, timestamp);
+        store->append(log);
+        all.prepend(log);
+    }
+    QCOMPARE(store->size(), rows);
+    // 기대 순서: timestamp 최신순, 같은 시각이면 나중에 들어온 것 먼저 (prepend + stable_sort)
+    std::stable_sort(all.begin(), all.end(), [](const QJsonObject &a, const QJsonObject &b) {
+        return timestampOf(a) > timestampOf(b);
+    });
+
+    QVector<LogQuery> queries(6);
+    queries[0].text = "motor jam";
+    queries[1].deviceIds = {"feeder_02"};
+    queries[1].level = LogLevel::Error;
+    queries[2].startMs = 1000000 + rows / 4;
+    queries[2].endMs = 1000000 + rows / 2;
+    queries[3].logCode = "E200";
+    queries[3].level = LogLevel::Warning;
+    queries[3].deviceIds = {"conveyor_01", "feeder_01"};
+    queries[4].text = "sens";
+    queries[4].startMs = 1000000 + 100;
+    queries[4].endMs = 1000000 + rows - 100;
+    queries[5].text = "feeder e100 overheat";
+
+    for (const LogQuery &query : std::as_const(queries)) {
+        QList<QJsonObject> expected;
+        for (const QJsonObject &log : std::as_const(all)) {
+            if (query.matches(log)) expected.append(log);
+        }
+        const QList<QJsonObject> results = store->search(query, 0);
+        QCOMPARE(results.size(), expected.size());
+        for (int i = 0; i < results.size(); ++i) {
+            QCOMPARE(timestampOf(results.at(i)), timestampOf(expected.at(i)));
+            QCOMPARE(results.at(i).value("message"), expected.at(i).value("message"));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(LogStoreTest)
+#include "tst_log_store.moc"
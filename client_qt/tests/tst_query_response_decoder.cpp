@@ -0,0 +1,165 @@
+// QueryResponseDecoder - 한 번 훑는 디코더(JSON/CBOR)가 QJsonDocument 경로와 같은 결과를 내는지
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "../mqtt/query_response_decoder.h"
+#include "../mqtt/wire_codec.h"
+
+namespace {
+
+QJsonObject logResponse()
+{
+    QJsonObject first;
+    first["_id"] = "a1";
+    first["device_id"] = "feeder_01";
+    first["log_level"] = "error";
+    first["log_code"] = "E100";
+    first["message"] = "motor stall";
+    first["timestamp"] = 1700000000123.0;
+
+    // 문자열 timestamp, 모르는 필드, 객체 message
+    QJsonObject detail;
+    detail["axis"] = 2;
+    detail["text"] = "belt \"slip\"";
+    QJsonObject second;
+    second["_id"] = "a2";
+    second["device_id"] = "conveyor_01";
+    second["log_level"] = "error";
+    second["log_code"] = "E200";
+    second["message"] = detail;
+    second["timestamp"] = "1704164645678";
+    second["line"] = 3;
+
+    QJsonObject response;
+    response["query_id"] = "q-1";
+    response["status"] = "success";
+    response["data"] = QJsonArray{first, second};
+    return response;
+}
+
+// 정수/실수 저장 방식이 경로마다 달라서 직렬화한 모양으로 비교
+QByteArray compact(const QJsonObject &object)
+{
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+}
+
+class QueryResponseDecoderTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesDom();
+    void emptyData();
+    void rejectsGarbage();
+    void timestamps();
+    void skipsUnwanted();
+};
+
+void QueryResponseDecoderTest::matchesDom()
+{
+    const QJsonObject response = logResponse();
+    const LogQueryResponse dom = QueryResponseDecoder::fromJson(response);
+
+    for (WireCodec::Encoding format : {WireCodec::Encoding::Json, WireCodec::Encoding::Cbor,
+                                       WireCodec::Encoding::CborZlib, WireCodec::Encoding::JsonZlib}) {
+        LogQueryResponse scanned;
+        QVERIFY(QueryResponseDecoder::decodeLogs(WireCodec::encode(response, format), scanned));
+        QCOMPARE(scanned.queryId, QString("q-1"));
+        QVERIFY(scanned.isSuccess());
+        QCOMPARE(scanned.rows.size(), dom.rows.size());
+        for (int i = 0; i < dom.rows.size(); ++i) {
+            QCOMPARE(scanned.rows.at(i).id, dom.rows.at(i).id);
+            QCOMPARE(scanned.rows.at(i).deviceId, dom.rows.at(i).deviceId);
+            QCOMPARE(scanned.rows.at(i).logCode, dom.rows.at(i).logCode);
+            QCOMPARE(scanned.rows.at(i).message, dom.rows.at(i).message);
+            QCOMPARE(scanned.rows.at(i).timestamp, dom.rows.at(i).timestamp);
+            QCOMPARE(compact(scanned.rows.at(i).toJson()), compact(dom.rows.at(i).toJson()));
+        }
+        QCOMPARE(scanned.rows.at(1).timestamp, qint64(1704164645678));
+        QCOMPARE(scanned.rows.at(1).toJson().value("line").toInt(), 3);
+        QCOMPARE(scanned.rows.at(1).toJson().value("message").toObject().value("text").toString(), QString("belt \"slip\""));
+    }
+}
+
+void QueryResponseDecoderTest::emptyData()
+{
+    LogQueryResponse scanned;
+    QVERIFY(QueryResponseDecoder::decodeLogs(R"({"query_id":"q-2","status":"error","error":"timeout","data":[]})", scanned));
+    QCOMPARE(scanned.queryId, QString("q-2"));
+    QVERIFY(!scanned.isSuccess());
+    QCOMPARE(scanned.error, QString("timeout"));
+    QVERIFY(scanned.rows.isEmpty());
+}
+
+void QueryResponseDecoderTest::rejectsGarbage()
+{
+    LogQueryResponse scanned;
+    scanned.queryId = "stale";
+    QVERIFY(!QueryResponseDecoder::decodeLogs("{\"query_id\":\"q-3\",\"data\":[{", scanned));
+    QVERIFY(scanned.queryId.isEmpty());
+    QVERIFY(scanned.rows.isEmpty());
+}
+
+void QueryResponseDecoderTest::timestamps()
+{
+    QCOMPARE(QueryResponseDecoder::timestampFromText("1700000000123"), qint64(1700000000123));
+    QCOMPARE(QueryResponseDecoder::timestampFromText("2024-01-02T03:04:05.678Z"), qint64(1704164645678));
+    QCOMPARE(QueryResponseDecoder::timestampFromText("yesterday"), LogRecord::kInvalidTimestamp);
+
+    QJsonObject row;
+    row["device_id"] = "feeder_01";
+    row["timestamp"] = "not a time";
+    const LogRecord invalid = QueryResponseDecoder::recordFromJson(row);
+    QVERIFY(!invalid.hasValidTimestamp());
+    // 시각을 지어내지 않음
+    QVERIFY(!invalid.toJson().contains("timestamp"));
+
+    // 스캐너 경로도 같은 규칙
+    LogQueryResponse scanned;
+    QVERIFY(QueryResponseDecoder::decodeLogs(R"({"query_id":"q-4","data":[{"device_id":"feeder_01","timestamp":"2024-01-02T03:04:05.678Z"},{"device_id":"feeder_01","timestamp":"bad"}]})", scanned));
+    QCOMPARE(scanned.rows.size(), 2);
+    QCOMPARE(scanned.rows.at(0).timestamp, qint64(1704164645678));
+    QVERIFY(!scanned.rows.at(1).hasValidTimestamp());
+
+    row.remove("timestamp");
+    QCOMPARE(QueryResponseDecoder::recordFromJson(row).timestamp, qint64(0));
+}
+
+void QueryResponseDecoderTest::skipsUnwanted()
+{
+    const QJsonObject response = logResponse();
+    const auto onlyOthers = [](const QString &queryId) { return queryId != "q-1"; };
+    const quint64 skippedBefore = QueryResponseDecoder::stats().skipped;
+
+    // 직렬화하면 data가 query_id보다 앞 - 그래도 행을 만들지 않고 건너뜀
+    for (WireCodec::Encoding format : {WireCodec::Encoding::Json, WireCodec::Encoding::Cbor,
+                                       WireCodec::Encoding::CborZlib, WireCodec::Encoding::JsonZlib}) {
+        LogQueryResponse scanned;
+        QVERIFY(QueryResponseDecoder::decodeLogs(WireCodec::encode(response, format), scanned, onlyOthers));
+        QVERIFY(scanned.skipped);
+        QCOMPARE(scanned.queryId, QString("q-1"));
+        QVERIFY(scanned.rows.isEmpty());
+    }
+    QCOMPARE(QueryResponseDecoder::stats().skipped, skippedBefore + 4);
+
+    // 원하는 쿼리면 평소처럼
+    LogQueryResponse wanted;
+    QVERIFY(QueryResponseDecoder::decodeLogs(compact(response), wanted, [](const QString &) { return true; }));
+    QVERIFY(!wanted.skipped);
+    QCOMPARE(wanted.rows.size(), 2);
+
+    // query_id가 없으면 판단하지 않고 전부 디코딩
+    LogQueryResponse noId;
+    QVERIFY(QueryResponseDecoder::decodeLogs(R"({"status":"success","data":[{"device_id":"feeder_01","timestamp":1}]})",
+                                             noId, [](const QString &) { return false; }));
+    QVERIFY(!noId.skipped);
+    QCOMPARE(noId.rows.size(), 1);
+}
+
+QTEST_GUILESS_MAIN(QueryResponseDecoderTest)
+#include "tst_query_response_decoder.moc"
@@ -0,0 +1,56 @@
+// RingBuffer - 꽉 차면 가장 오래된 것을 덮어씀, 용량을 바꿔도 최신 것 유지
+
+#include <QtTest>
+
+#include "../charts/ring_buffer.h"
+
+class RingBufferTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void overwritesOldest();
+    void setCapacityKeepsNewest();
+};
+
+void RingBufferTest::overwritesOldest()
+{
+    RingBuffer<int> buffer(3);
+    QVERIFY(buffer.isEmpty());
+    for (int i = 1; i <= 5; ++i) buffer.push(i);
+
+    QVERIFY(buffer.isFull());
+    QCOMPARE(buffer.size(), 3);
+    QCOMPARE(buffer.first(), 3);
+    QCOMPARE(buffer.at(1), 4);
+    QCOMPARE(buffer.last(), 5);
+
+    buffer.clear();
+    QVERIFY(buffer.isEmpty());
+    buffer.push(7);
+    QCOMPARE(buffer.first(), 7);
+    QCOMPARE(buffer.last(), 7);
+}
+
+void RingBufferTest::setCapacityKeepsNewest()
+{
+    RingBuffer<int> buffer(5);
+    for (int i = 1; i <= 7; ++i) buffer.push(i);    // 3..7
+
+    buffer.setCapacity(2);
+    QCOMPARE(buffer.size(), 2);
+    QCOMPARE(buffer.first(), 6);
+    QCOMPARE(buffer.last(), 7);
+
+    buffer.setCapacity(4);
+    QCOMPARE(buffer.size(), 2);
+    buffer.push(8);
+    buffer.push(9);
+    buffer.push(10);
+    QCOMPARE(buffer.size(), 4);
+    QCOMPARE(buffer.first(), 7);
+    QCOMPARE(buffer.last(), 10);
+}
+
+QTEST_GUILESS_MAIN(RingBufferTest)
+#include "tst_ring_buffer.moc"
@@ -0,0 +1,107 @@
+// SeriesDecimator - 작은 시계열은 그대로, MinMax는 튀는 값 유지, LTTB는 양 끝 유지, 점을 나눠 넣어도 같은 결과
+
+#include <QtTest>
+#include <QPointF>
+#include <cmath>
+
+#include "../charts/series_decimator.h"
+
+class SeriesDecimatorTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void passesSmallSeries();
+    void minMaxKeepsSpikes();
+    void lttbKeepsEnds();
+    void dropBefore();
+    void incrementalMatchesRebuild();
+    void modeFromString();
+};
+
+void SeriesDecimatorTest::passesSmallSeries()
+{
+    SeriesDecimator decimator(SeriesDecimator::Mode::Lttb);
+    decimator.setTarget(100.0, 100);
+    for (int i = 0; i < 150; ++i) decimator.append(QPointF(i, i % 7));
+
+    // 그림 너비의 2배 이하면 그대로
+    const QVector<QPointF> &points = decimator.points();
+    QCOMPARE(points.size(), 150);
+    QCOMPARE(points.first(), QPointF(0, 0));
+    QCOMPARE(points.last(), QPointF(149, 149 % 7));
+}
+
+void SeriesDecimatorTest::minMaxKeepsSpikes()
+{
+    SeriesDecimator decimator(SeriesDecimator::Mode::MinMax);
+    const int count = 10000;
+    decimator.setTarget(count, 100);
+    for (int i = 0; i < count; ++i) {
+        double y = std::sin(i / 50.0);
+        if (i == 4321) y = 100.0;       // 한 점짜리 튀는 값
+        if (i == 8765) y = -100.0;
+        decimator.append(QPointF(i, y));
+    }
+
+    const QVector<QPointF> &points = decimator.points();
+    QVERIFY(points.size() <= 2 * 100 + 2);
+    QVERIFY(points.contains(QPointF(4321, 100.0)));
+    QVERIFY(points.contains(QPointF(8765, -100.0)));
+    for (int i = 1; i < points.size(); ++i) QVERIFY(points.at(i - 1).x() <= points.at(i).x());
+}
+
+void SeriesDecimatorTest::lttbKeepsEnds()
+{
+    SeriesDecimator decimator(SeriesDecimator::Mode::Lttb);
+    const int count = 5000;
+    decimator.setTarget(count, 50);
+    for (int i = 0; i < count; ++i) decimator.append(QPointF(i, (i * 37) % 101));
+
+    const QVector<QPointF> &points = decimator.points();
+    QVERIFY(points.size() <= 2 * 50 + 2);
+    QCOMPARE(points.first().x(), 0.0);
+    QCOMPARE(points.last().x(), double(count - 1));
+    QCOMPARE(decimator.rawCount(), count);
+}
+
+void SeriesDecimatorTest::dropBefore()
+{
+    SeriesDecimator decimator(SeriesDecimator::Mode::MinMax);
+    decimator.setTarget(1000.0, 10);
+    for (int i = 0; i < 1000; ++i) decimator.append(QPointF(i, i));
+
+    decimator.dropBefore(250.5);
+    QCOMPARE(decimator.rawCount(), 749);
+    const QVector<QPointF> &points = decimator.points();
+    QVERIFY(!points.isEmpty());
+    QCOMPARE(points.first().x(), 251.0);
+}
+
+void SeriesDecimatorTest::incrementalMatchesRebuild()
+{
+    // 점을 나눠 넣으며 중간에 points()를 불러도 (캐시 사용) 한 번에 넣은 것과 같은 결과
+    SeriesDecimator incremental(SeriesDecimator::Mode::Lttb);
+    SeriesDecimator batch(SeriesDecimator::Mode::Lttb);
+    incremental.setTarget(3000.0, 40);
+    batch.setTarget(3000.0, 40);
+
+    for (int i = 0; i < 3000; ++i) {
+        const QPointF point(i, std::fmod(i * 13.7, 97.0));
+        incremental.append(point);
+        batch.append(point);
+        if (i % 250 == 0) incremental.points();
+    }
+    QCOMPARE(incremental.points(), batch.points());
+}
+
+void SeriesDecimatorTest::modeFromString()
+{
+    QCOMPARE(SeriesDecimator::modeFromString("MinMax"), SeriesDecimator::Mode::MinMax);
+    QCOMPARE(SeriesDecimator::modeFromString("lttb"), SeriesDecimator::Mode::Lttb);
+    // 모르는 이름은 기본값
+    QCOMPARE(SeriesDecimator::modeFromString(""), SeriesDecimator::Mode::Lttb);
+}
+
+QTEST_GUILESS_MAIN(SeriesDecimatorTest)
+#include "tst_series_decimator.moc"
@@ -0,0 +1,220 @@
+// StatsRollup - 증분 구간 응답 합치기, 하루치 전체 요청으로 되돌리기
+
+#include <QtTest>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+
+#include "../mqtt/stats_rollup.h"
+
+namespace {
+
+SpeedStatsPtr speedReply(const QString &deviceId, const QJsonObject &json)
+{
+    auto stats = std::make_shared<SpeedStats>();
+    stats->deviceId = deviceId;
+    stats->average = json.value("average").toDouble();
+    stats->currentSpeed = json.value("current_speed").toDouble();
+    stats->json = json;
+    return stats;
+}
+
+QJsonObject request(const QString &deviceId)
+{
+    return QJsonDocument::fromJson(StatsRollup::instance()->nextRequest(deviceId)).object();
+}
+
+qint64 rangeValue(const QJsonObject &request, const char *key)
+{
+    return static_cast<qint64>(request.value("time_range").toObject().value(key).toDouble());
+}
+
+}
+
+class StatsRollupTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void mergesOwnReply();
+    void nextRequestIsDelta();
+    void passesOtherRequestId();
+    void missingCountFallsBackToFullDay();
+    void foreignReplyKeepsPending();
+    void matchesEchoedTimeRange();
+    void uncorrelatedReplyFallsBack();
+};
+
+void StatsRollupTest::initTestCase()
+{
+    // 사용자 데이터 폴더의 stats_rollup.json을 건드리지 않게 (instance() 전에)
+    QStandardPaths::setTestModeEnabled(true);
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QFile::remove(dir + "/stats_rollup.json");
+}
+
+void StatsRollupTest::mergesOwnReply()
+{
+    StatsRollup *rollup = StatsRollup::instance();
+    const QJsonObject sent = request("feeder_11");
+    QVERIFY(!sent.value("request_id").toString().isEmpty());
+
+    QJsonObject reply;
+    reply["request_id"] = sent.value("request_id");
+    reply["average"] = 50.0;
+    reply["current_speed"] = 55.0;
+    reply["count"] = 10;
+    reply["sum"] = 500.0;
+    reply["min"] = 40.0;
+    reply["max"] = 60.0;
+
+    const SpeedStatsPtr stats = speedReply("feeder_11", reply);
+    const SpeedStatsPtr merged = rollup->absorb(stats);
+    QVERIFY(merged != stats);
+    QCOMPARE(rollup->aggregate("feeder_11").count, quint64(10));
+    QCOMPARE(merged->average, 50.0);
+    QCOMPARE(merged->json.value("window_average").toDouble(), 50.0);
+    QCOMPARE(merged->json.value("min").toDouble(), 40.0);
+    QCOMPARE(merged->json.value("max").toDouble(), 60.0);
+    QVERIFY(!merged->json.value("min_max_approximate").toBool());
+
+    // 같은 응답이 또 와도 기다리는 요청이 없으니 합치지 않음
+    QCOMPARE(rollup->absorb(stats), stats);
+    QCOMPARE(rollup->aggregate("feeder_11").count, quint64(10));
+}
+
+void StatsRollupTest::nextRequestIsDelta()
+{
+    // 10:00 전에도 구간은 자정부터라 두 번째 요청은 증분
+    StatsRollup *rollup = StatsRollup::instance();
+    const QJsonObject first = request("feeder_12");
+    QJsonObject reply;
+    reply["request_id"] = first.value("request_id");
+    reply["average"] = 20.0;
+    reply["count"] = 4;
+    reply["sum"] = 80.0;
+    rollup->absorb(speedReply("feeder_12", reply));
+
+    // 다음 요청은 합쳐진 구간 끝 바로 뒤부터
+    const QJsonObject second = request("feeder_12");
+    QCOMPARE(rangeValue(second, "start"), rangeValue(first, "end") + 1);
+
+    reply["request_id"] = second.value("request_id");
+    reply["average"] = 40.0;
+    reply["count"] = 4;
+    reply["sum"] = 160.0;
+    const SpeedStatsPtr merged = rollup->absorb(speedReply("feeder_12", reply));
+    QCOMPARE(rollup->aggregate("feeder_12").count, quint64(8));
+    QCOMPARE(merged->average, 30.0);
+    // min/max를 안 준 응답 → 근사 표시
+    QVERIFY(merged->json.value("min_max_approximate").toBool());
+}
+
+void StatsRollupTest::passesOtherRequestId()
+{
+    StatsRollup *rollup = StatsRollup::instance();
+    request("feeder_13");
+
+    QJsonObject other;
+    other["request_id"] = "someone-else";
+    other["average"] = 99.0;
+    other["count"] = 3;
+    const SpeedStatsPtr stats = speedReply("feeder_13", other);
+    QCOMPARE(rollup->absorb(stats), stats);
+    QCOMPARE(rollup->aggregate("feeder_13").count, quint64(0));
+}
+
+void StatsRollupTest::foreignReplyKeepsPending()
+{
+    StatsRollup *rollup = StatsRollup::instance();
+    const QJsonObject sent = request("feeder_15");
+    const quint64 foreignBefore = rollup->counters().foreign;
+
+    // 다른 창의 1분 통계 요청 응답 - 그대로 넘기고 기다리는 요청은 남김
+    QJsonObject foreign;
+    foreign["request_id"] = "feeder_15/stats-1min/other";
+    foreign["average"] = 99.0;
+    foreign["count"] = 3;
+    const SpeedStatsPtr foreignStats = speedReply("feeder_15", foreign);
+    QCOMPARE(rollup->absorb(foreignStats), foreignStats);
+    QCOMPARE(rollup->counters().foreign, foreignBefore + 1);
+    QCOMPARE(rollup->aggregate("feeder_15").count, quint64(0));
+
+    QJsonObject ours;
+    ours["request_id"] = sent.value("request_id");
+    ours["average"] = 20.0;
+    ours["count"] = 4;
+    ours["sum"] = 80.0;
+    QVERIFY(rollup->absorb(speedReply("feeder_15", ours)) != nullptr);
+    QCOMPARE(rollup->aggregate("feeder_15").count, quint64(4));
+    QCOMPARE(rollup->aggregate("feeder_15").mean(), 20.0);
+}
+
+void StatsRollupTest::matchesEchoedTimeRange()
+{
+    StatsRollup *rollup = StatsRollup::instance();
+    const QJsonObject sent = request("feeder_16");
+
+    // request_id를 돌려주지 않는 서버 - 구간이 다르면 남의 응답
+    QJsonObject shifted;
+    QJsonObject otherRange;
+    otherRange["start"] = sent.value("time_range").toObject().value("start").toDouble() + 1;
+    otherRange["end"] = sent.value("time_range").toObject().value("end");
+    shifted["time_range"] = otherRange;
+    shifted["count"] = 5;
+    const SpeedStatsPtr shiftedStats = speedReply("feeder_16", shifted);
+    QCOMPARE(rollup->absorb(shiftedStats), shiftedStats);
+    QCOMPARE(rollup->aggregate("feeder_16").count, quint64(0));
+
+    QJsonObject echoed;
+    echoed["time_range"] = sent.value("time_range");
+    echoed["average"] = 30.0;
+    echoed["count"] = 6;
+    echoed["sum"] = 180.0;
+    rollup->absorb(speedReply("feeder_16", echoed));
+    QCOMPARE(rollup->aggregate("feeder_16").count, quint64(6));
+}
+
+void StatsRollupTest::uncorrelatedReplyFallsBack()
+{
+    StatsRollup *rollup = StatsRollup::instance();
+    request("feeder_17");
+    QVERIFY(rollup->aggregate("feeder_17").exact);
+
+    // 짝을 지을 수 없는 응답 → 합치지 않고 그날은 하루치 전체 요청으로
+    QJsonObject bare;
+    bare["average"] = 10.0;
+    bare["count"] = 2;
+    const SpeedStatsPtr stats = speedReply("feeder_17", bare);
+    QCOMPARE(rollup->absorb(stats), stats);
+    QVERIFY(!rollup->aggregate("feeder_17").exact);
+    QCOMPARE(rollup->aggregate("feeder_17").count, quint64(0));
+}
+
+void StatsRollupTest::missingCountFallsBackToFullDay()
+{
+    StatsRollup *rollup = StatsRollup::instance();
+    const QJsonObject sent = request("feeder_14");
+    QVERIFY(rollup->aggregate("feeder_14").exact);
+
+    QJsonObject bare;
+    bare["request_id"] = sent.value("request_id");
+    bare["average"] = 10.0;
+    const SpeedStatsPtr stats = speedReply("feeder_14", bare);
+    QCOMPARE(rollup->absorb(stats), stats);
+    QVERIFY(!rollup->aggregate("feeder_14").exact);
+
+    // 그날은 하루치 전체 요청 - 10:00부터, 10:00 전이면 자정부터
+    const QJsonObject next = request("feeder_14");
+    const QDateTime now = QDateTime::currentDateTime();
+    const qint64 shiftStart = now.time() < QTime(10, 0) ? now.date().startOfDay().toMSecsSinceEpoch()
+                                                         : QDateTime(now.date(), QTime(10, 0)).toMSecsSinceEpoch();
+    QCOMPARE(rangeValue(next, "start"), shiftStart);
+    QVERIFY(rangeValue(next, "start") <= rangeValue(next, "end"));
+}
+
+QTEST_GUILESS_MAIN(StatsRollupTest)
+#include "tst_stats_rollup.moc"
@@ -0,0 +1,94 @@
+// TopicRouter - 리터럴/와일드카드 매칭, 캡처, 구체성, 제거
+
+#include <QtTest>
+#include <algorithm>
+
+#include "../mqtt/topic_router.h"
+
+namespace {
+
+QVector<int> routeIds(const QVector<TopicRouter::Match> &matches)
+{
+    QVector<int> ids;
+    for (const TopicRouter::Match &match : matches) ids.append(match.routeId);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+}
+
+class TopicRouterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void literalAndWildcards();
+    void specificity();
+    void removeAndClear();
+    void validFilter();
+};
+
+void TopicRouterTest::literalAndWildcards()
+{
+    TopicRouter router;
+    router.insert("factory/feeder_01/log/error", 1);
+    router.insert("factory/+/log/error", 2);
+    router.insert("factory/#", 3);
+    router.insert("factory/+/msg/statistics", 4);
+
+    const QVector<TopicRouter::Match> matches = router.match("factory/feeder_01/log/error");
+    QCOMPARE(routeIds(matches), (QVector<int>{1, 2, 3}));
+    for (const TopicRouter::Match &match : matches) {
+        if (match.routeId == 2) QCOMPARE(match.captures, QStringList{"feeder_01"});
+        if (match.routeId == 3) QCOMPARE(match.captures, QStringList{"feeder_01/log/error"});
+        if (match.routeId == 1) QVERIFY(match.captures.isEmpty());
+    }
+
+    QCOMPARE(routeIds(router.match("factory/conveyor_03/msg/statistics")), (QVector<int>{3, 4}));
+    // 깊이가 다르면 '+' 필터는 안 맞음
+    QCOMPARE(routeIds(router.match("factory/feeder_01/log/error/extra")), (QVector<int>{3}));
+    QVERIFY(router.match("other/feeder_01/log/error").isEmpty());
+}
+
+void TopicRouterTest::specificity()
+{
+    TopicRouter router;
+    router.insert("factory/+/+/error", 1);
+    router.insert("factory/+/log/error", 2);
+    router.insert("factory/feeder_01/log/error", 3);
+
+    int best = -1;
+    int bestSpecificity = -1;
+    for (const TopicRouter::Match &match : router.match("factory/feeder_01/log/error")) {
+        if (match.specificity > bestSpecificity) {
+            best = match.routeId;
+            bestSpecificity = match.specificity;
+        }
+    }
+    QCOMPARE(best, 3);
+    QCOMPARE(bestSpecificity, 4);
+}
+
+void TopicRouterTest::removeAndClear()
+{
+    TopicRouter router;
+    router.insert("factory/+/status", 1);
+    router.insert("factory/+/status", 2);
+    router.remove("factory/+/status", 1);
+    QCOMPARE(routeIds(router.match("factory/feeder_01/status")), (QVector<int>{2}));
+
+    router.clear();
+    QVERIFY(router.match("factory/feeder_01/status").isEmpty());
+}
+
+void TopicRouterTest::validFilter()
+{
+    QVERIFY(TopicRouter::isValidFilter("factory/+/log/error"));
+    QVERIFY(TopicRouter::isValidFilter("factory/#"));
+    QVERIFY(!TopicRouter::isValidFilter(""));
+    QVERIFY(!TopicRouter::isValidFilter("factory/#/error"));
+    QVERIFY(!TopicRouter::isValidFilter("factory/feeder+/status"));
+}
+
+QTEST_GUILESS_MAIN(TopicRouterTest)
+#include "tst_topic_router.moc"
@@ -0,0 +1,88 @@
+// WireCodec - 네 가지 전송 형식 왕복, 형식 판별, 깨진 페이로드
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "../mqtt/wire_codec.h"
+
+namespace {
+
+QJsonObject sampleResponse()
+{
+    QJsonObject row;
+    row["_id"] = "a1";
+    row["device_id"] = "feeder_01";
+    row["log_code"] = "E100";
+    row["message"] = "motor stall";
+    row["timestamp"] = 1700000000123.0;
+
+    QJsonObject response;
+    response["query_id"] = "q-1";
+    response["status"] = "success";
+    response["data"] = QJsonArray{row, row};
+    return response;
+}
+
+// 정수/실수 저장 방식이 형식마다 달라서 직렬화한 모양으로 비교
+QByteArray compact(const QJsonObject &object)
+{
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+}
+
+class WireCodecTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip_data();
+    void roundTrip();
+    void sniffPrettyJson();
+    void rejectsGarbage();
+};
+
+void WireCodecTest::roundTrip_data()
+{
+    QTest::addColumn<int>("encoding");
+    QTest::newRow("json") << static_cast<int>(WireCodec::Encoding::Json);
+    QTest::newRow("cbor") << static_cast<int>(WireCodec::Encoding::Cbor);
+    QTest::newRow("cbor+zlib") << static_cast<int>(WireCodec::Encoding::CborZlib);
+    QTest::newRow("json+zlib") << static_cast<int>(WireCodec::Encoding::JsonZlib);
+}
+
+void WireCodecTest::roundTrip()
+{
+    QFETCH(int, encoding);
+    const auto format = static_cast<WireCodec::Encoding>(encoding);
+    const QJsonObject original = sampleResponse();
+
+    const QByteArray encoded = WireCodec::encode(original, format);
+    QCOMPARE(WireCodec::sniff(encoded), format);
+    QCOMPARE(WireCodec::fromName(WireCodec::name(format)), format);
+
+    QJsonObject decoded;
+    QVERIFY(WireCodec::toJsonObject(encoded, decoded));
+    QCOMPARE(compact(decoded), compact(original));
+}
+
+void WireCodecTest::sniffPrettyJson()
+{
+    const QByteArray pretty = "\n  " + QJsonDocument(sampleResponse()).toJson(QJsonDocument::Indented);
+    QCOMPARE(WireCodec::sniff(pretty), WireCodec::Encoding::Json);
+    QCOMPARE(WireCodec::fromName(" CBOR+ZLIB "), WireCodec::Encoding::CborZlib);
+    QCOMPARE(WireCodec::fromName("msgpack"), WireCodec::Encoding::Unknown);
+}
+
+void WireCodecTest::rejectsGarbage()
+{
+    QByteArray body;
+    QCOMPARE(WireCodec::unwrap(QByteArray("VCZC\x00\x01", 6), body), WireCodec::Encoding::Unknown);
+    QJsonObject object;
+    QVERIFY(!WireCodec::toJsonObject(QByteArray("not a payload"), object));
+}
+
+QTEST_GUILESS_MAIN(WireCodecTest)
+#include "tst_wire_codec.moc"
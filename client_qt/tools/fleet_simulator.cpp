@@ -0,0 +1,553 @@
+// 가상 기기 플릿 시뮬레이터 (부하 테스트용)
+//
+//   fleet_simulator [--host localhost] [--port 1883] [--feeders 4] [--conveyors 4] [--robots 1] [--scale 10]
+//                   [--profile steady|burst|storm] [--duration 600]
+//
+// 로컬 브로커에 붙어서 실제 공장처럼 발행하고, 클라이언트가 보내는 요청에 응답한다
+//   <device>/status                     라인 기기: 오류 상태 (SPEED_xx, reverse ...), 제어 대상: <device>/cmd 에 on/off 응답
+//   factory/<device>/msg/statistics     속도 통계 (주기 발행 + factory/statistics 요청 응답, count/sum/min/max 포함)
+//   factory/<device>/log/info           불량률 (message.failure ...)
+//   factory/<device>/log/error          오류 로그 (QoS 1)
+//   factory/<device>/log/response       factory/<device>/log/request 응답 (불량률)
+//   factory/query/logs|videos/...       로그/영상 조회 응답 (response_topic, accept_encoding 지원)
+//
+// 기기 번호가 홀수면 라인 기기, 짝수면 제어 대상 (피더1/피더2, 컨베이어1/컨베이어3 구성과 같은 꼴), 로봇팔은 모두 제어 대상
+// --scale 10 / 100 이면 기기 수를 그만큼 곱한다 (발행 빈도는 기기당이므로 전체 부하도 같이 늘어남)
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QTimer>
+#include <QVector>
+#include <QtMqtt/QMqttClient>
+#include <QtMqtt/QMqttMessage>
+#include <QtMqtt/QMqttSubscription>
+#include <QtMqtt/QMqttTopicFilter>
+#include <QtMqtt/QMqttTopicName>
+#include <deque>
+
+#include "../mqtt/wire_codec.h"
+
+namespace {
+
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+struct Device {
+    QString id;
+    QString kind;           // feeder, conveyor, robot_arm
+    bool actuator = false;
+    QString state = "off";  // 제어 대상의 현재 상태
+    double baseSpeed = 0.0;
+    int total = 0;          // 불량률 누적
+    int fail = 0;
+};
+
+// 초당 발행 빈도 (기기당, 분당 값으로 입력 받음)
+struct Rates {
+    double statusPerMin = 1.0;
+    double statsPerMin = 1.0;
+    double infoPerMin = 2.0;
+    double errorPerMin = 0.5;
+};
+
+enum class Profile { Steady, Burst, Storm };
+
+struct Options {
+    QString host = "localhost";
+    quint16 port = 1883;
+    int feeders = 4;
+    int conveyors = 4;
+    int robots = 1;
+    int scale = 1;
+    Rates rates;
+    Profile profile = Profile::Steady;
+    int burstEverySec = 60;
+    int burstLengthSec = 5;
+    double burstFactor = 20.0;
+    int tickMs = 50;
+    int durationSec = 0;        // 0이면 무한
+    int ackDelayMs = 80;
+    int historyCap = 200000;    // 로그 조회용으로 기억하는 최대 행 수
+    QString encoding = "auto";  // auto: 요청의 accept_encoding 첫 번째 / json 고정
+};
+
+class FleetSimulator : public QObject
+{
+public:
+    explicit FleetSimulator(const Options &options)
+        : m_options(options)
+    {
+        buildFleet();
+
+        m_client.setHostname(options.host);
+        m_client.setPort(options.port);
+        m_client.setClientId(QString("fleet_simulator_%1").arg(QRandomGenerator::global()->generate(), 8, 16, QChar('0')));
+
+        QObject::connect(&m_client, &QMqttClient::connected, this, [this]() { onConnected(); });
+        QObject::connect(&m_client, &QMqttClient::disconnected, this, [this]() {
+            QTextStream(stderr) << "브로커 연결 끊김 - 2초 뒤 재시도" << Qt::endl;
+            QTimer::singleShot(2000, this, [this]() { m_client.connectToHost(); });
+        });
+        QObject::connect(&m_client, &QMqttClient::messageReceived, this,
+                         [this](const QByteArray &payload, const QMqttTopicName &topic) { onMessage(topic.name(), payload); });
+
+        m_tickTimer.setInterval(options.tickMs);
+        QObject::connect(&m_tickTimer, &QTimer::timeout, this, [this]() { tick(); });
+
+        m_reportTimer.setInterval(5000);
+        QObject::connect(&m_reportTimer, &QTimer::timeout, this, [this]() { report(); });
+    }
+
+    void start()
+    {
+        out() << "기기 " << m_devices.size() << "대 (라인 " << m_lineDevices.size() << ", 제어 대상 "
+              << m_devices.size() - m_lineDevices.size() << "), 브로커 " << m_options.host << ':' << m_options.port
+              << Qt::endl;
+        m_client.connectToHost();
+
+        if (m_options.durationSec > 0) {
+            QTimer::singleShot(m_options.durationSec * 1000, this, [this]() {
+                report();
+                QCoreApplication::quit();
+            });
+        }
+    }
+
+private:
+    /* ---------- 구성 ---------- */
+
+    static QString deviceId(const QString &kind, int number)
+    {
+        return QString("%1_%2").arg(kind).arg(number, 2, 10, QChar('0'));
+    }
+
+    void addDevices(const QString &kind, int count, bool allActuators, double baseSpeed)
+    {
+        for (int n = 1; n <= count; ++n) {
+            Device device;
+            device.id = deviceId(kind, n);
+            device.kind = kind;
+            device.actuator = allActuators || (n % 2 == 0);
+            device.baseSpeed = baseSpeed * (0.8 + 0.4 * QRandomGenerator::global()->generateDouble());
+
+            const int index = m_devices.size();
+            m_index.insert(device.id, index);
+            if (!device.actuator) m_lineDevices.append(index);
+            m_devices.append(device);
+        }
+    }
+
+    void buildFleet()
+    {
+        const int scale = qMax(1, m_options.scale);
+        addDevices("feeder", m_options.feeders * scale, false, 60.0);
+        addDevices("conveyor", m_options.conveyors * scale, false, 40.0);
+        addDevices("robot_arm", m_options.robots * scale, true, 0.0);
+    }
+
+    void onConnected()
+    {
+        out() << "브로커 연결됨: " << m_client.clientId() << Qt::endl;
+
+        // 제어 명령 (feeder_02/cmd, factory/conveyor_02/cmd 둘 다)
+        m_client.subscribe(QMqttTopicFilter("+/cmd"), 1);
+        m_client.subscribe(QMqttTopicFilter("factory/+/cmd"), 1);
+        // 통계 / 불량률 / 조회 요청
+        m_client.subscribe(QMqttTopicFilter("factory/statistics"), 0);
+        m_client.subscribe(QMqttTopicFilter("factory/+/log/request"), 0);
+        m_client.subscribe(QMqttTopicFilter("factory/query/logs/request"), 1);
+        m_client.subscribe(QMqttTopicFilter("factory/query/videos/request"), 1);
+
+        m_started.start();
+        m_tickTimer.start();
+        m_reportTimer.start();
+    }
+
+    /* ---------- 주기 발행 ---------- */
+
+    double loadFactor() const
+    {
+        if (m_options.profile == Profile::Steady) return 1.0;
+        const qint64 second = m_started.elapsed() / 1000;
+        const bool inBurst = (second % qMax(1, m_options.burstEverySec)) < m_options.burstLengthSec;
+        return inBurst ? m_options.burstFactor : 1.0;
+    }
+
+    // 이번 틱에 나갈 건수 (분당 빈도 × 기기 수 × 경과 시간, 소수점은 다음 틱으로 이월)
+    int due(double &carry, double perMinute, int devices, double elapsedMs, double factor)
+    {
+        carry += perMinute / 60000.0 * devices * elapsedMs * factor;
+        const int count = static_cast<int>(carry);
+        carry -= count;
+        return count;
+    }
+
+    int randomLineDevice() const
+    {
+        return m_lineDevices.at(QRandomGenerator::global()->bounded(m_lineDevices.size()));
+    }
+
+    void tick()
+    {
+        if (m_client.state() != QMqttClient::Connected || m_lineDevices.isEmpty()) return;
+
+        const double elapsed = m_lastTick.isValid() ? m_lastTick.restart() : m_options.tickMs;
+        if (!m_lastTick.isValid()) m_lastTick.start();
+
+        const double factor = loadFactor();
+        const int lines = m_lineDevices.size();
+
+        // storm: 폭주 구간에는 모든 라인 기기가 동시에 오류
+        if (m_options.profile == Profile::Storm && factor > 1.0 && !m_stormFired) {
+            m_stormFired = true;
+            for (int index : std::as_const(m_lineDevices)) publishError(m_devices[index]);
+        } else if (factor == 1.0) {
+            m_stormFired = false;
+        }
+
+        for (int i = due(m_carry[0], m_options.rates.statusPerMin, lines, elapsed, factor); i > 0; --i)
+            publishLineStatus(m_devices[randomLineDevice()]);
+        for (int i = due(m_carry[1], m_options.rates.statsPerMin, lines, elapsed, 1.0); i > 0; --i)
+            publishStatistics(m_devices[randomLineDevice()], QString(), 0, 0);
+        for (int i = due(m_carry[2], m_options.rates.infoPerMin, lines, elapsed, 1.0); i > 0; --i)
+            publishInfo(m_devices[randomLineDevice()]);
+        for (int i = due(m_carry[3], m_options.rates.errorPerMin, lines, elapsed, factor); i > 0; --i)
+            publishError(m_devices[randomLineDevice()]);
+    }
+
+    void publish(const QString &topic, const QByteArray &payload, quint8 qos = 0)
+    {
+        m_client.publish(QMqttTopicName(topic), payload, qos);
+        m_published++;
+        m_publishedBytes += payload.size();
+    }
+
+    static QByteArray compact(const QJsonObject &object)
+    {
+        return QJsonDocument(object).toJson(QJsonDocument::Compact);
+    }
+
+    void publishLineStatus(const Device &device)
+    {
+        static const QStringList feederStates = {"reverse", "SPEED_LOW", "SPEED_HIGH", "MOTOR_HEAT"};
+        static const QStringList conveyorStates = {"error_mode", "SPEED_LOW", "SPEED_HIGH"};
+        const QStringList &states = device.kind == "feeder" ? feederStates : conveyorStates;
+        publish(device.id + "/status", states.at(QRandomGenerator::global()->bounded(states.size())).toUtf8());
+    }
+
+    double sampleSpeed(const Device &device) const
+    {
+        return qMax(0.0, device.baseSpeed + (QRandomGenerator::global()->generateDouble() - 0.5) * device.baseSpeed * 0.2);
+    }
+
+    // start/end가 있으면 그 구간의 통계 (1초에 한 샘플로 계산), 없으면 최근 1분
+    void publishStatistics(const Device &device, const QString &requestId, qint64 start, qint64 end)
+    {
+        const qint64 windowMs = (start > 0 && end > start) ? end - start : 60000;
+        const qint64 count = qMax<qint64>(1, windowMs / 1000);
+        const double average = sampleSpeed(device);
+        const double spread = device.baseSpeed * 0.1;
+
+        QJsonObject stats;
+        stats["device_id"] = device.id;
+        stats["current_speed"] = qRound(sampleSpeed(device));
+        stats["average"] = average;
+        stats["count"] = static_cast<double>(count);
+        stats["sum"] = average * count;
+        stats["min"] = qMax(0.0, average - spread);
+        stats["max"] = average + spread;
+        if (!requestId.isEmpty()) stats["request_id"] = requestId;
+        publish("factory/" + device.id + "/msg/statistics", compact(stats));
+    }
+
+    QJsonObject failureMessage(Device &device)
+    {
+        const int batch = 10 + QRandomGenerator::global()->bounded(20);
+        device.total += batch;
+        device.fail += QRandomGenerator::global()->bounded(batch / 5 + 1);
+
+        QJsonObject failure;
+        failure["failure"] = device.total ? static_cast<double>(device.fail) / device.total : 0.0;
+        failure["total"] = device.total;
+        failure["pass"] = device.total - device.fail;
+        failure["fail"] = device.fail;
+        return failure;
+    }
+
+    void publishInfo(Device &device)
+    {
+        QJsonObject log;
+        log["log_code"] = "INF";
+        log["message"] = failureMessage(device);
+        log["timestamp"] = QDateTime::currentMSecsSinceEpoch();
+        remember(device.id, "info", log);
+        publish("factory/" + device.id + "/log/info", compact(log));
+    }
+
+    void publishError(const Device &device)
+    {
+        static const QStringList codes = {"SPD", "MOT", "OVH", "JAM"};
+        const QString code = codes.at(QRandomGenerator::global()->bounded(codes.size()));
+
+        QJsonObject log;
+        log["log_code"] = code;
+        log["message"] = QString("%1 시뮬레이션 오류 (%2)").arg(device.id, code);
+        log["timestamp"] = QDateTime::currentMSecsSinceEpoch();
+        remember(device.id, "error", log);
+        publish("factory/" + device.id + "/log/error", compact(log), 1);
+    }
+
+    // 로그 조회 응답용 - 발행한 로그를 최근 historyCap 행만 기억
+    void remember(const QString &deviceId, const QString &logLevel, QJsonObject log)
+    {
+        log["_id"] = QString::number(++m_logSequence);
+        log["device_id"] = deviceId;
+        log["log_level"] = logLevel;
+        m_history.push_back(log);
+        while (static_cast<int>(m_history.size()) > m_options.historyCap) m_history.pop_front();
+    }
+
+    /* ---------- 요청 응답 ---------- */
+
+    void onMessage(const QString &topic, const QByteArray &payload)
+    {
+        m_received++;
+        const QStringList parts = topic.split('/');
+
+        if (parts.last() == "cmd") {
+            onCommand(parts.at(parts.size() - 2), QString::fromUtf8(payload));
+        } else if (topic == "factory/statistics") {
+            const QJsonObject request = QJsonDocument::fromJson(payload).object();
+            const int index = m_index.value(request.value("device_id").toString(), -1);
+            if (index < 0) return;
+            const QJsonObject range = request.value("time_range").toObject();
+            publishStatistics(m_devices[index], request.value("request_id").toString(),
+                              range.value("start").toVariant().toLongLong(), range.value("end").toVariant().toLongLong());
+        } else if (parts.size() == 4 && parts.at(2) == "log" && parts.at(3) == "request") {
+            const int index = m_index.value(parts.at(1), -1);
+            if (index < 0) return;
+            QJsonObject data;
+            data["message"] = failureMessage(m_devices[index]);
+            QJsonObject response;
+            response["data"] = data;
+            publish("factory/" + parts.at(1) + "/log/response", compact(response));
+        } else if (topic == "factory/query/logs/request") {
+            answerLogQuery(QJsonDocument::fromJson(payload).object());
+        } else if (topic == "factory/query/videos/request") {
+            answerVideoQuery(QJsonDocument::fromJson(payload).object());
+        }
+    }
+
+    void onCommand(const QString &deviceId, const QString &command)
+    {
+        const int index = m_index.value(deviceId, -1);
+        if (index < 0 || !m_devices[index].actuator) return;
+        if (command != "on" && command != "off") return;
+
+        m_commands++;
+        // 실제 기기처럼 조금 뒤에 상태 보고
+        const int delay = m_options.ackDelayMs + QRandomGenerator::global()->bounded(qMax(1, m_options.ackDelayMs));
+        QTimer::singleShot(delay, this, [this, index, command]() {
+            m_devices[index].state = command;
+            publish(m_devices[index].id + "/status", command.toUtf8());
+        });
+    }
+
+    WireCodec::Encoding responseEncoding(const QJsonObject &request) const
+    {
+        if (m_options.encoding != "auto") {
+            const WireCodec::Encoding fixed = WireCodec::fromName(m_options.encoding);
+            return fixed == WireCodec::Encoding::Unknown ? WireCodec::Encoding::Json : fixed;
+        }
+        for (const QJsonValue &name : request.value("accept_encoding").toArray()) {
+            const WireCodec::Encoding encoding = WireCodec::fromName(name.toString());
+            if (encoding != WireCodec::Encoding::Unknown) return encoding;
+        }
+        return WireCodec::Encoding::Json;
+    }
+
+    void reply(const QJsonObject &request, const QString &legacyTopic, const QJsonObject &response)
+    {
+        const QString topic = request.value("response_topic").toString(legacyTopic);
+        publish(topic, WireCodec::encode(response, responseEncoding(request)), 1);
+        m_queries++;
+    }
+
+    static bool matches(const QJsonObject &row, const QJsonObject &filters)
+    {
+        for (const char *key : {"device_id", "log_level", "log_code"}) {
+            const QJsonValue wanted = filters.value(key);
+            if (wanted.isString() && !wanted.toString().isEmpty() && row.value(key).toString() != wanted.toString())
+                return false;
+        }
+        const QJsonObject range = filters.value("time_range").toObject();
+        if (!range.isEmpty()) {
+            const qint64 timestamp = row.value("timestamp").toVariant().toLongLong();
+            const qint64 start = range.value("start").toVariant().toLongLong();
+            const qint64 end = range.value("end").toVariant().toLongLong();
+            if ((start && timestamp < start) || (end && timestamp > end)) return false;
+        }
+        return true;
+    }
+
+    void answerLogQuery(const QJsonObject &request)
+    {
+        const QJsonObject filters = request.value("filters").toObject();
+        const int limit = filters.value("limit").toInt(2000);
+        const int offset = filters.value("offset").toInt(0);
+
+        // 최신순
+        QJsonArray rows;
+        int skipped = 0;
+        for (auto it = m_history.rbegin(); it != m_history.rend() && rows.size() < limit; ++it) {
+            if (!matches(*it, filters)) continue;
+            if (skipped++ < offset) continue;
+            rows.append(*it);
+        }
+
+        QJsonObject response;
+        response["query_id"] = request.value("query_id");
+        response["status"] = "success";
+        response["data"] = rows;
+        reply(request, "factory/query/logs/response", response);
+    }
+
+    void answerVideoQuery(const QJsonObject &request)
+    {
+        const QJsonObject filters = request.value("filters").toObject();
+        const QString deviceId = filters.value("device_id").toString();
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+        QJsonArray videos;
+        const int count = qMin(filters.value("limit").toInt(3), 3);
+        for (int i = 0; i < count; ++i) {
+            QJsonObject video;
+            video["_id"] = QString("sim_video_%1").arg(++m_logSequence);
+            video["error_log_id"] = filters.value("error_log_id").toString();
+            video["device_id"] = deviceId;
+            video["http_url"] = QString("http://%1:8080/videos/sim_%2.mp4").arg(m_options.host).arg(i);
+            video["file_path"] = QString("/videos/sim_%1.mp4").arg(i);
+            video["video_duration"] = 10;
+            video["file_size"] = 1024 * 1024;
+            video["video_created_time"] = now - i * 60000;
+            video["video_quality"] = "720p";
+            videos.append(video);
+        }
+
+        QJsonObject response;
+        response["query_id"] = request.value("query_id");
+        response["status"] = "success";
+        response["data"] = videos;
+        reply(request, "factory/query/videos/response", response);
+    }
+
+    void report()
+    {
+        const double seconds = qMax<qint64>(1, m_started.elapsed()) / 1000.0;
+        out() << QString("[%1s] 발행 %2건 (%3/s, %4 KB/s), 수신 %5, 명령 응답 %6, 조회 응답 %7, 부하 x%8")
+                     .arg(seconds, 0, 'f', 0).arg(m_published).arg(m_published / seconds, 0, 'f', 1)
+                     .arg(m_publishedBytes / 1024.0 / seconds, 0, 'f', 1)
+                     .arg(m_received).arg(m_commands).arg(m_queries).arg(loadFactor(), 0, 'f', 0)
+              << Qt::endl;
+    }
+
+    Options m_options;
+    QMqttClient m_client;
+    QTimer m_tickTimer;
+    QTimer m_reportTimer;
+    QElapsedTimer m_started;
+    QElapsedTimer m_lastTick;
+
+    QVector<Device> m_devices;
+    QHash<QString, int> m_index;
+    QVector<int> m_lineDevices;
+    std::deque<QJsonObject> m_history;
+
+    double m_carry[4] = {0, 0, 0, 0};
+    bool m_stormFired = false;
+    quint64 m_logSequence = 0;
+
+    quint64 m_published = 0;
+    quint64 m_publishedBytes = 0;
+    quint64 m_received = 0;
+    quint64 m_commands = 0;
+    quint64 m_queries = 0;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fleet_simulator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("가상 피더/컨베이어/로봇팔 플릿 - 로컬 브로커로 클라이언트 부하 테스트");
+    parser.addHelpOption();
+
+    QCommandLineOption hostOption("host", "브로커 주소", "host", "localhost");
+    QCommandLineOption portOption("port", "브로커 포트", "port", "1883");
+    QCommandLineOption feedersOption("feeders", "피더 수", "n", "4");
+    QCommandLineOption conveyorsOption("conveyors", "컨베이어 수", "n", "4");
+    QCommandLineOption robotsOption("robots", "로봇팔 수", "n", "1");
+    QCommandLineOption scaleOption("scale", "기기 수 배율 (10, 100 ...)", "k", "1");
+    QCommandLineOption statusOption("status-rate", "라인 기기당 분당 상태 발행", "per-min", "1");
+    QCommandLineOption statsOption("stats-rate", "라인 기기당 분당 통계 발행", "per-min", "1");
+    QCommandLineOption infoOption("info-rate", "라인 기기당 분당 불량률(info) 발행", "per-min", "2");
+    QCommandLineOption errorOption("error-rate", "라인 기기당 분당 오류 로그", "per-min", "0.5");
+    QCommandLineOption profileOption("profile", "steady | burst (주기적으로 오류·상태 폭주) | storm (폭주 때 전 기기 동시 오류)", "profile", "steady");
+    QCommandLineOption burstEveryOption("burst-every", "폭주 주기 (초)", "sec", "60");
+    QCommandLineOption burstLengthOption("burst-length", "폭주 지속 (초)", "sec", "5");
+    QCommandLineOption burstFactorOption("burst-factor", "폭주 중 빈도 배율", "x", "20");
+    QCommandLineOption tickOption("tick", "발행 틱 (ms)", "ms", "50");
+    QCommandLineOption durationOption("duration", "실행 시간 (초, 0이면 계속)", "sec", "0");
+    QCommandLineOption ackDelayOption("ack-delay", "명령 → 상태 보고 지연 (ms, 0~2배 무작위)", "ms", "80");
+    QCommandLineOption encodingOption("encoding", "조회 응답 형식 (auto | json | cbor | cbor+zlib | json+zlib)", "encoding", "auto");
+
+    parser.addOptions({hostOption, portOption, feedersOption, conveyorsOption, robotsOption, scaleOption,
+                       statusOption, statsOption, infoOption, errorOption, profileOption, burstEveryOption,
+                       burstLengthOption, burstFactorOption, tickOption, durationOption, ackDelayOption, encodingOption});
+    parser.process(app);
+
+    Options options;
+    options.host = parser.value(hostOption);
+    options.port = static_cast<quint16>(parser.value(portOption).toUInt());
+    options.feeders = qMax(0, parser.value(feedersOption).toInt());
+    options.conveyors = qMax(0, parser.value(conveyorsOption).toInt());
+    options.robots = qMax(0, parser.value(robotsOption).toInt());
+    options.scale = qMax(1, parser.value(scaleOption).toInt());
+    options.rates.statusPerMin = parser.value(statusOption).toDouble();
+    options.rates.statsPerMin = parser.value(statsOption).toDouble();
+    options.rates.infoPerMin = parser.value(infoOption).toDouble();
+    options.rates.errorPerMin = parser.value(errorOption).toDouble();
+    options.burstEverySec = qMax(1, parser.value(burstEveryOption).toInt());
+    options.burstLengthSec = qMax(0, parser.value(burstLengthOption).toInt());
+    options.burstFactor = qMax(1.0, parser.value(burstFactorOption).toDouble());
+    options.tickMs = qMax(5, parser.value(tickOption).toInt());
+    options.durationSec = qMax(0, parser.value(durationOption).toInt());
+    options.ackDelayMs = qMax(0, parser.value(ackDelayOption).toInt());
+    options.encoding = parser.value(encodingOption);
+
+    const QString profile = parser.value(profileOption);
+    if (profile == "burst") options.profile = Profile::Burst;
+    else if (profile == "storm") options.profile = Profile::Storm;
+    else if (profile != "steady") {
+        QTextStream(stderr) << "알 수 없는 프로파일: " << profile << Qt::endl;
+        return 1;
+    }
+
+    FleetSimulator simulator(options);
+    simulator.start();
+    return app.exec();
+}
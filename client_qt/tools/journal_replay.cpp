@@ -0,0 +1,226 @@
+// 캡처 저널 재생 도구 - 기록한 MQTT 수신 내역을 브로커로 다시 발행
+//
+//   journal_replay info <폴더|파일>                                        기록 구간, 건수, 토픽별 건수
+//   journal_replay play <폴더|파일> [--host localhost] [--port 1883] [--speed 1] [--from <ms>] [--to <ms>]
+//                       [--filter 'factory/+/log/#'] [--loop]
+//
+// --speed 0 이면 기다리지 않고 최대한 빨리 (수신 처리 벤치마크)
+// 클라이언트에 직접 넣으려면 브로커 없이 VISIONCRAFT_REPLAY=<폴더> ./client_qt
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTextStream>
+#include <QTimer>
+#include <QtMqtt/QMqttClient>
+#include <QtMqtt/QMqttTopicFilter>
+#include <QtMqtt/QMqttTopicName>
+#include <algorithm>
+#include <limits>
+
+#include "../mqtt/journal_format.h"
+
+namespace {
+
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+QString formatTime(qint64 ms)
+{
+    return QDateTime::fromMSecsSinceEpoch(ms).toString("yyyy-MM-dd HH:mm:ss.zzz");
+}
+
+int runInfo(const QString &path)
+{
+    JournalReader reader(path);
+    if (!reader.isValid()) return 1;
+
+    Journal::Record record;
+    quint64 count = 0;
+    quint64 bytes = 0;
+    qint64 first = 0;
+    qint64 last = 0;
+    QHash<QString, quint64> perTopic;
+
+    while (reader.next(record)) {
+        if (count == 0) first = record.receivedAtMs;
+        last = record.receivedAtMs;
+        count++;
+        bytes += record.payload.size();
+        perTopic[QString::fromUtf8(record.topic)]++;
+    }
+
+    out() << "세그먼트 " << reader.segments().size() << "개, 메시지 " << count << "건, 페이로드 "
+          << QString::number(bytes / 1048576.0, 'f', 1) << " MB" << Qt::endl;
+    if (count == 0) return 0;
+
+    const double seconds = qMax<qint64>(1, last - first) / 1000.0;
+    out() << formatTime(first) << " ~ " << formatTime(last) << " (" << QString::number(seconds, 'f', 0)
+          << "초, 평균 " << QString::number(count / seconds, 'f', 1) << "건/s)" << Qt::endl;
+
+    QVector<QPair<quint64, QString>> topics;
+    for (auto it = perTopic.cbegin(); it != perTopic.cend(); ++it) topics.append({it.value(), it.key()});
+    std::sort(topics.begin(), topics.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+    for (int i = 0; i < qMin(topics.size(), 20); ++i) {
+        out() << QString("  %1  %2").arg(topics[i].first, 8).arg(topics[i].second) << Qt::endl;
+    }
+    return 0;
+}
+
+class Player : public QObject
+{
+public:
+    struct Options {
+        QString path;
+        double speed = 1.0;
+        qint64 fromMs = 0;
+        qint64 toMs = 0;
+        QString filter;
+        bool loop = false;
+    };
+
+    Player(const Options &options, QMqttClient *client)
+        : m_options(options), m_client(client), m_reader(options.path)
+    {
+        m_timer.setInterval(5);
+        QObject::connect(&m_timer, &QTimer::timeout, this, [this]() { tick(); });
+        QObject::connect(m_client, &QMqttClient::connected, this, [this]() { begin(); });
+    }
+
+    bool isValid() const { return m_reader.isValid(); }
+
+private:
+    void begin()
+    {
+        if (m_options.fromMs > 0) m_reader.seek(m_options.fromMs);
+        m_hasNext = advance();
+        m_firstAt = m_hasNext ? m_record.receivedAtMs : 0;
+        m_wall.start();
+        m_lastReport = 0;
+        m_timer.start();
+        out() << "재생 시작" << (m_hasNext ? " - 첫 메시지 " + formatTime(m_firstAt) : QString(" - 메시지 없음"))
+              << Qt::endl;
+    }
+
+    // 필터/구간에 맞는 다음 레코드
+    bool advance()
+    {
+        const QMqttTopicFilter filter(m_options.filter);
+        while (m_reader.next(m_record)) {
+            if (m_options.toMs > 0 && m_record.receivedAtMs > m_options.toMs) return false;
+            if (!m_options.filter.isEmpty() && !filter.match(QMqttTopicName(QString::fromUtf8(m_record.topic)))) continue;
+            return true;
+        }
+        return false;
+    }
+
+    void tick()
+    {
+        const qint64 due = m_options.speed > 0 ? m_firstAt + static_cast<qint64>(m_wall.elapsed() * m_options.speed)
+                                               : std::numeric_limits<qint64>::max();
+        int sent = 0;
+        while (m_hasNext && m_record.receivedAtMs <= due && sent < 5000) {
+            // retain 플래그는 그대로 두면 재생이 끝난 뒤에도 브로커에 남으므로 빼고 발행
+            m_client->publish(QMqttTopicName(QString::fromUtf8(m_record.topic)), m_record.payload, m_record.qos, false);
+            m_published++;
+            sent++;
+            m_hasNext = advance();
+        }
+
+        if (m_wall.elapsed() - m_lastReport >= 5000) {
+            m_lastReport = m_wall.elapsed();
+            report();
+        }
+        if (m_hasNext) return;
+
+        report();
+        if (m_options.loop) {
+            m_reader.rewind();
+            m_timer.stop();
+            begin();
+            return;
+        }
+        m_timer.stop();
+        // QoS 1 발행이 브로커로 다 나갈 시간
+        QTimer::singleShot(1000, qApp, &QCoreApplication::quit);
+    }
+
+    void report()
+    {
+        const double seconds = qMax<qint64>(1, m_wall.elapsed()) / 1000.0;
+        out() << QString("[%1s] 발행 %2건 (%3건/s), 기록 시각 %4")
+                     .arg(seconds, 0, 'f', 1).arg(m_published).arg(m_published / seconds, 0, 'f', 0)
+                     .arg(m_hasNext ? formatTime(m_record.receivedAtMs) : QString("끝"))
+              << Qt::endl;
+    }
+
+    Options m_options;
+    QMqttClient *m_client;
+    JournalReader m_reader;
+    Journal::Record m_record;
+    bool m_hasNext = false;
+    qint64 m_firstAt = 0;
+    QElapsedTimer m_wall;
+    qint64 m_lastReport = 0;
+    QTimer m_timer;
+    quint64 m_published = 0;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("journal_replay");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("캡처 저널 정보 보기 / 브로커로 재생");
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "info | play");
+    parser.addPositionalArgument("path", "저널 폴더 또는 세그먼트 파일");
+
+    QCommandLineOption hostOption("host", "브로커 주소", "host", "localhost");
+    QCommandLineOption portOption("port", "브로커 포트", "port", "1883");
+    QCommandLineOption speedOption("speed", "배속 (0 = 최대 속도)", "x", "1");
+    QCommandLineOption fromOption("from", "이 시각(epoch ms)부터", "ms");
+    QCommandLineOption toOption("to", "이 시각(epoch ms)까지", "ms");
+    QCommandLineOption filterOption("filter", "토픽 필터 (예: factory/+/log/#)", "filter");
+    QCommandLineOption loopOption("loop", "끝나면 처음부터 반복");
+    parser.addOptions({hostOption, portOption, speedOption, fromOption, toOption, filterOption, loopOption});
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 2) parser.showHelp(1);
+
+    if (args[0] == "info") return runInfo(args[1]);
+    if (args[0] != "play") parser.showHelp(1);
+
+    Player::Options options;
+    options.path = args[1];
+    options.speed = qMax(0.0, parser.value(speedOption).toDouble());
+    options.fromMs = parser.value(fromOption).toLongLong();
+    options.toMs = parser.value(toOption).toLongLong();
+    options.filter = parser.value(filterOption);
+    options.loop = parser.isSet(loopOption);
+
+    QMqttClient client;
+    client.setHostname(parser.value(hostOption));
+    client.setPort(static_cast<quint16>(parser.value(portOption).toUInt()));
+
+    Player player(options, &client);
+    if (!player.isValid()) return 1;
+
+    QObject::connect(&client, &QMqttClient::errorChanged, &app, [](QMqttClient::ClientError error) {
+        if (error != QMqttClient::NoError) {
+            QTextStream(stderr) << "브로커 오류: " << static_cast<int>(error) << Qt::endl;
+            QCoreApplication::exit(1);
+        }
+    });
+    client.connectToHost();
+    return app.exec();
+}
@@ -0,0 +1,159 @@
+// TopicRouter 조회 비용 측정
+//
+//   topic_router_bench                       기기 10/100/1000대로 등록한 필터에 대해 메시지당 조회 시간
+//   topic_router_bench --devices 50,5000     기기 수 지정
+//
+// 기기마다 리터럴 필터 4개 (factory/<id>/status 등) + 공통 와일드카드 필터를 등록하고,
+// 실제 수신 토픽 모양의 메시지를 돌려가며 match() 한다.
+// 비교용으로 예전 if/else 체인처럼 필터를 하나씩 세그먼트 비교하는 선형 탐색도 함께 잰다.
+// 트라이는 기기 수가 늘어도 메시지당 시간이 거의 같아야 하고, 선형 탐색은 필터 수에 비례해 늘어난다.
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+#include <functional>
+
+#include "../mqtt/topic_router.h"
+
+namespace {
+
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+const QStringList kDeviceFilters = {
+    "factory/%1/status",
+    "factory/%1/log/error",
+    "factory/%1/msg/statistics",
+    "factory/%1/log/info",
+};
+
+// 기기와 무관한 공통 필터 - 앱이 거는 필터 모양(기기 자리 '+' 와일드카드, 쿼리 응답 리터럴)을 본뜬 대표 목록
+// 실제 등록 목록을 그대로 옮긴 것은 아님 (창/기능에 따라 달라짐), 수가 기기별 필터보다 훨씬 적다는 점만 같음
+const QStringList kSharedFilters = {
+    "factory/+/log/error",
+    "factory/+/log/info",
+    "factory/+/msg/statistics",
+    "factory/+/status",
+    "factory/query/response",
+    "factory/query/logs/response",
+    "factory/query/videos/response",
+};
+
+QString deviceId(int index)
+{
+    return QString("device_%1").arg(index, 4, 10, QChar('0'));
+}
+
+// 예전 체인처럼 필터마다 토픽을 세그먼트 비교
+bool matchesFilter(const QStringList &filter, const QStringList &topic)
+{
+    for (int i = 0; i < filter.size(); ++i) {
+        const QString &segment = filter.at(i);
+        if (segment == "#") return true;
+        if (i >= topic.size()) return false;
+        if (segment != "+" && segment != topic.at(i)) return false;
+    }
+    return filter.size() == topic.size();
+}
+
+// 평균 나노초 (최소 minMs 동안)
+double measureNs(int minMs, int batch, const std::function<int(int)> &run)
+{
+    QElapsedTimer timer;
+    timer.start();
+    qint64 calls = 0;
+    quint64 sink = 0;
+    while (timer.elapsed() < minMs) {
+        for (int i = 0; i < batch; ++i) sink += run(static_cast<int>(calls + i));
+        calls += batch;
+    }
+    const double ns = static_cast<double>(timer.nsecsElapsed()) / calls;
+    // 결과를 쓰지 않으면 컴파일러가 조회를 지울 수 있음
+    if (sink == ~quint64(0)) out() << sink;
+    return ns;
+}
+
+void bench(int devices, int minMs)
+{
+    TopicRouter router;
+    QVector<QStringList> linear;
+    int routeId = 0;
+    for (const QString &filter : kSharedFilters) {
+        router.insert(filter, routeId++);
+        linear.append(filter.split('/'));
+    }
+    for (int device = 0; device < devices; ++device) {
+        for (const QString &pattern : kDeviceFilters) {
+            const QString filter = pattern.arg(deviceId(device));
+            router.insert(filter, routeId++);
+            linear.append(filter.split('/'));
+        }
+    }
+
+    // 수신 토픽 모양 - 기기는 고르게, 쿼리 응답도 섞음
+    QStringList topics;
+    QRandomGenerator random(42);
+    for (int i = 0; i < 4096; ++i) {
+        const int kind = random.bounded(5);
+        if (kind == 4) {
+            topics << QString("factory/query/logs/response/%1").arg(random.generate(), 8, 16, QChar('0'));
+        } else {
+            topics << kDeviceFilters.at(kind).arg(deviceId(random.bounded(devices)));
+        }
+    }
+    const int mask = topics.size() - 1;
+
+    const double trieNs = measureNs(minMs, 1024, [&](int i) {
+        return router.match(topics.at(i & mask)).size();
+    });
+    // 선형 탐색은 매 메시지 split도 포함 (예전 체인과 같은 조건)
+    const double linearNs = measureNs(minMs, 64, [&](int i) {
+        const QStringList segments = topics.at(i & mask).split('/');
+        int matched = 0;
+        for (const QStringList &filter : linear) {
+            if (matchesFilter(filter, segments)) matched++;
+        }
+        return matched;
+    });
+
+    out() << devices << '\t' << routeId << '\t' << QString::number(trieNs, 'f', 0) << '\t'
+          << QString::number(linearNs, 'f', 0) << '\t' << QString::number(linearNs / trieNs, 'f', 1) << 'x'
+          << Qt::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("topic_router_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("TopicRouter 조회 비용 (기기 수별, 선형 탐색과 비교)");
+    parser.addHelpOption();
+
+    QCommandLineOption devicesOption("devices", "기기 수 목록 (쉼표로)", "list", "10,100,1000");
+    QCommandLineOption durationOption("ms", "측정마다 최소 시간 (ms)", "ms", "300");
+    parser.addOption(devicesOption);
+    parser.addOption(durationOption);
+    parser.process(app);
+
+    const int minMs = qMax(10, parser.value(durationOption).toInt());
+    out() << "기기\t필터\t트라이(ns/메시지)\t선형(ns/메시지)\t차이" << Qt::endl;
+    for (const QString &value : parser.value(devicesOption).split(',', Qt::SkipEmptyParts)) {
+        const int devices = value.trimmed().toInt();
+        if (devices <= 0) {
+            QTextStream(stderr) << "기기 수가 아님: " << value << Qt::endl;
+            return 1;
+        }
+        bench(devices, minMs);
+    }
+    return 0;
+}
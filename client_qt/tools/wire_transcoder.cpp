@@ -0,0 +1,211 @@
+// 쿼리 응답 전송 형식 변환/비교 도구
+//
+//   wire_transcoder bench <파일|폴더>...                 녹화한 응답마다 형식별 크기와 디코딩 시간 비교
+//   wire_transcoder convert --to <형식> <입력> <출력>     형식 변환 (json, cbor, cbor+zlib, json+zlib)
+//
+// 응답 녹화 예: mosquitto_sub -t 'factory/query/logs/response/#' -C 1 > logs_2000.json
+// 입력은 어떤 형식이어도 된다 (앞 바이트로 판별)
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <functional>
+
+#include "../mqtt/wire_codec.h"
+#include "../mqtt/query_response_decoder.h"
+
+namespace {
+
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+// 디코더의 qDebug가 측정을 방해하지 않게
+void quietHandler(QtMsgType type, const QMessageLogContext &, const QString &message)
+{
+    if (type != QtDebugMsg && type != QtInfoMsg) {
+        QTextStream(stderr) << message << Qt::endl;
+    }
+}
+
+bool readFile(const QString &path, QByteArray &data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        QTextStream(stderr) << "열 수 없음: " << path << Qt::endl;
+        return false;
+    }
+    data = file.readAll();
+    return true;
+}
+
+QStringList expandInputs(const QStringList &inputs)
+{
+    QStringList files;
+    for (const QString &input : inputs) {
+        const QFileInfo info(input);
+        if (info.isDir()) {
+            const QDir dir(input);
+            for (const QString &name : dir.entryList(QDir::Files, QDir::Name)) {
+                files << dir.filePath(name);
+            }
+        } else {
+            files << input;
+        }
+    }
+    return files;
+}
+
+// 평균 마이크로초 (최소 iterations번, 최소 200ms 동안)
+double measureUs(int iterations, const std::function<bool()> &decode)
+{
+    QElapsedTimer timer;
+    timer.start();
+    int runs = 0;
+    while (runs < iterations || timer.elapsed() < 200) {
+        if (!decode()) return -1;
+        ++runs;
+    }
+    return static_cast<double>(timer.nsecsElapsed()) / 1000.0 / runs;
+}
+
+QString cell(double us)
+{
+    return us < 0 ? QString("실패") : QString::number(us, 'f', 1);
+}
+
+int bench(const QStringList &inputs, int iterations)
+{
+    const QStringList files = expandInputs(inputs);
+    if (files.isEmpty()) {
+        QTextStream(stderr) << "입력 파일 없음" << Qt::endl;
+        return 1;
+    }
+
+    qInstallMessageHandler(quietHandler);
+
+    out() << "파일\t행\tjson(pretty)\tjson\tcbor\tcbor+zlib\tjson+zlib\t"
+          << "DOM(us)\t스캐너(us)\tcbor(us)\tcbor+zlib(us)" << Qt::endl;
+
+    quint64 totals[5] = {0, 0, 0, 0, 0};
+    for (const QString &path : files) {
+        QByteArray recorded;
+        if (!readFile(path, recorded)) continue;
+
+        QJsonObject object;
+        if (!WireCodec::toJsonObject(recorded, object)) {
+            QTextStream(stderr) << "응답으로 읽을 수 없음: " << path << Qt::endl;
+            continue;
+        }
+
+        const QByteArray pretty = QJsonDocument(object).toJson(QJsonDocument::Indented);
+        const QByteArray json = WireCodec::encode(object, WireCodec::Encoding::Json);
+        const QByteArray cbor = WireCodec::encode(object, WireCodec::Encoding::Cbor);
+        const QByteArray cborZlib = WireCodec::encode(object, WireCodec::Encoding::CborZlib);
+        const QByteArray jsonZlib = WireCodec::encode(object, WireCodec::Encoding::JsonZlib);
+
+        // 기존 경로: QJsonDocument → QJsonArray → 행마다 QJsonObject
+        LogQueryResponse decoded;
+        const double domUs = measureUs(iterations, [&]() {
+            const QJsonDocument doc = QJsonDocument::fromJson(pretty);
+            if (!doc.isObject()) return false;
+            decoded = QueryResponseDecoder::fromJson(doc.object());
+            return true;
+        });
+        const double scannerUs = measureUs(iterations, [&]() { return QueryResponseDecoder::decodeLogs(json, decoded); });
+        const double cborUs = measureUs(iterations, [&]() { return QueryResponseDecoder::decodeLogs(cbor, decoded); });
+        const double cborZlibUs = measureUs(iterations, [&]() { return QueryResponseDecoder::decodeLogs(cborZlib, decoded); });
+
+        totals[0] += pretty.size();
+        totals[1] += json.size();
+        totals[2] += cbor.size();
+        totals[3] += cborZlib.size();
+        totals[4] += jsonZlib.size();
+
+        out() << QFileInfo(path).fileName() << '\t' << object.value("data").toArray().size() << '\t'
+              << pretty.size() << '\t' << json.size() << '\t' << cbor.size() << '\t'
+              << cborZlib.size() << '\t' << jsonZlib.size() << '\t'
+              << cell(domUs) << '\t' << cell(scannerUs) << '\t' << cell(cborUs) << '\t' << cell(cborZlibUs)
+              << Qt::endl;
+    }
+
+    if (totals[0] > 0) {
+        out() << "합계(bytes)\t-\t" << totals[0] << '\t' << totals[1] << '\t' << totals[2] << '\t'
+              << totals[3] << '\t' << totals[4] << Qt::endl;
+        out() << "pretty JSON 대비: json " << QString::number(100.0 * totals[1] / totals[0], 'f', 1)
+              << "%, cbor " << QString::number(100.0 * totals[2] / totals[0], 'f', 1)
+              << "%, cbor+zlib " << QString::number(100.0 * totals[3] / totals[0], 'f', 1) << '%' << Qt::endl;
+    }
+    return 0;
+}
+
+int convert(const QString &to, const QString &inputPath, const QString &outputPath)
+{
+    const WireCodec::Encoding target = WireCodec::fromName(to);
+    if (target == WireCodec::Encoding::Unknown) {
+        QTextStream(stderr) << "알 수 없는 형식: " << to << Qt::endl;
+        return 1;
+    }
+
+    QByteArray input;
+    if (!readFile(inputPath, input)) return 1;
+
+    QJsonObject object;
+    if (!WireCodec::toJsonObject(input, object)) {
+        QTextStream(stderr) << "응답으로 읽을 수 없음: " << inputPath << Qt::endl;
+        return 1;
+    }
+
+    const QByteArray encoded = WireCodec::encode(object, target);
+    QFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(encoded) != encoded.size()) {
+        QTextStream(stderr) << "쓸 수 없음: " << outputPath << Qt::endl;
+        return 1;
+    }
+
+    out() << WireCodec::name(WireCodec::sniff(input)) << ' ' << input.size() << " bytes → "
+          << WireCodec::name(target) << ' ' << encoded.size() << " bytes" << Qt::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("wire_transcoder");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("쿼리 응답 전송 형식 변환/비교 (json, cbor, cbor+zlib, json+zlib)");
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "bench | convert");
+    parser.addPositionalArgument("inputs", "녹화한 응답 파일 또는 폴더");
+
+    QCommandLineOption toOption("to", "convert 대상 형식", "encoding", "cbor+zlib");
+    QCommandLineOption iterationsOption("iterations", "bench 반복 횟수 (최소)", "n", "20");
+    parser.addOption(toOption);
+    parser.addOption(iterationsOption);
+    parser.process(app);
+
+    QStringList args = parser.positionalArguments();
+    if (args.isEmpty()) parser.showHelp(1);
+
+    const QString command = args.takeFirst();
+    if (command == "bench" && !args.isEmpty()) {
+        return bench(args, qMax(1, parser.value(iterationsOption).toInt()));
+    }
+    if (command == "convert" && args.size() == 2) {
+        return convert(parser.value(toOption), args.at(0), args.at(1));
+    }
+    parser.showHelp(1);
+    return 1;
+}
@@ -16,23 +16,36 @@
 #include "../video/video_client_functions.hpp"
 
 #include <QMouseEvent>
-#include "../widgets/cardhovereffect.h"
 #include "../widgets/error_message_card.h"
 #include <QKeyEvent>
 
 #include "../utils/font_manager.h"
 #include "../widgets/sectionboxwidget.h"
-
+#include "../mqtt/mqtt_hub.h"
+#include "../mqtt/message_ingest.h"
+#include "../mqtt/command_queue.h"
+#include "../mqtt/poll_scheduler.h"
+#include "../mqtt/time_travel.h"
+#include "../mqtt/log_store.h"
+#include "../mqtt/device_registry.h"
+#include "../mqtt/log_categories.h"
+#include <QUuid>
+#include <algorithm>
+
+namespace {
+// PollScheduler key 뒷부분 - <라인 기기>/failure-rate 등, 같은 key를 쓰는 다른 창(챗봇 등)과 발행이 합쳐짐
+const QString kFailureRatePollSuffix = QStringLiteral("/failure-rate");
+const QString kStatisticsPollSuffix = QStringLiteral("/stats-1min");
+const int kRecentLogLimit = 5000;       // 창을 열 때 LogStore에서 꺼내 보여줄 최근 오류 수
+}
 
 ConveyorWindow::ConveyorWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::ConveyorWindow)
     , m_client(nullptr)
-    , subscription(nullptr)
     , DeviceLockActive(false) //초기는 정상!
     , conveyorStartDateEdit(nullptr)  //  초기화 추가
     , conveyorEndDateEdit(nullptr)    //  초기화 추가
-    , statisticsTimer(nullptr)
 {
 
     ui->setupUi(this);
@@ -127,9 +140,6 @@ ConveyorWindow::ConveyorWindow(QWidget *parent)
     connect(hwStreamer, &Streamer::newFrame, this, &ConveyorWindow::updateHWImage);
     hwStreamer->start();
 
-    statisticsTimer = new QTimer(this);
-    connect(statisticsTimer, &QTimer::timeout, this, &ConveyorWindow::requestStatisticsData);
-
     //차트
     deviceChart = new DeviceChart("컨베이어", this);
     connect(deviceChart, &DeviceChart::refreshRequested, this, &ConveyorWindow::onChartRefreshRequested);
@@ -152,9 +162,7 @@ ConveyorWindow::~ConveyorWindow()
     hwStreamer->stop();
     hwStreamer->wait();
 
-    if(m_client && m_client->state() == QMqttClient::Connected){
-        m_client->disconnectFromHost();
-    }
+    // 공유 연결이므로 여기서 끊지 않음 (구독은 MqttHub가 자동 정리)
     delete ui;
 }
 
@@ -173,180 +181,105 @@ void ConveyorWindow::keyPressEvent(QKeyEvent *event)
     }
 }
 
-void ConveyorWindow::setupMqttClient(){ //mqtt 클라이언트 초기 설정 MQTT 클라이언트 설정 (주소, 포트, 시그널 연결 등)
-    m_client = new QMqttClient(this);
-    reconnectTimer = new QTimer(this);
-    m_client->setHostname(mqttBroker); //브로커 서버에 연결 공용 mqtt 서버
-    m_client->setPort(mqttPort);
-    m_client->setClientId("VisionCraft_conveyor" + QString::number(QDateTime::currentMSecsSinceEpoch()));
-    connect(m_client, &QMqttClient::connected, this, &ConveyorWindow::onMqttConnected); // QMqttClient가 연결이 되었다면 ConveyorWindow에 있는 저 함수중에 onMQTTCONNECTED를 실행
-    connect(m_client, &QMqttClient::disconnected, this, &ConveyorWindow::onMqttDisConnected);
-    //connect(m_client, &QMqttClient::messageReceived, this, &ConveyorWindow::onMqttMessageReceived);
-    connect(reconnectTimer, &QTimer::timeout, this, &ConveyorWindow::connectToMqttBroker);
+void ConveyorWindow::setupMqttClient(){ //mqtt 클라이언트 초기 설정 (연결은 MqttHub 공유, 구독만 등록)
+    MqttHub *hub = MqttHub::instance();
+    m_client = hub->client();
+    connect(hub, &MqttHub::connected, this, &ConveyorWindow::onMqttConnected);
+    connect(hub, &MqttHub::disconnected, this, &ConveyorWindow::onMqttDisConnected);
+
+    // 상태/통계/불량률/로그는 수신 계층에서 한 번만 파싱된 것을 컨베이어 기기 것만 받음
+    MessageIngest *ingest = MessageIngest::instance();
+    ingest->subscribeDevice(lineDeviceId(), this, &ConveyorWindow::onDeviceStatus);
+    ingest->subscribeDevice(controlDeviceId(), this, &ConveyorWindow::onDeviceStatus);  // 제어 명령 응답
+    ingest->subscribeDevice(lineDeviceId(), this, &ConveyorWindow::onSpeedStats);
+    ingest->subscribeDevice(lineDeviceId(), this, &ConveyorWindow::onFailureStats);
+    ingest->subscribeDevice(lineDeviceId(), this, &ConveyorWindow::onLogEvent);
+
+    // 타임 트래블로 다른 시점으로 가면 차트를 비우고 그 시점의 통계로 다시 채움
+    if (TimeTravel::isEnabled()) {
+        connect(TimeTravel::instance(), &TimeTravel::rewound, this, [this]() {
+            if (deviceChart) deviceChart->clearAllData();
+        });
+    }
+
+    // 정기 요청은 PollScheduler가 담당 (창이 안 보이면 멈춤, 연결 직후엔 흩어서)
+    PollScheduler *scheduler = PollScheduler::instance();
+    scheduler->registerPoll(lineDeviceId() + kFailureRatePollSuffix,                      // 60초마다 불량률 요청
+                            QString("factory/%1/log/request").arg(lineDeviceId()), 60000,
+                            []() { return QByteArray("{}"); }, this);
+    scheduler->registerPoll(lineDeviceId() + kStatisticsPollSuffix, "factory/statistics", 0,   // 차트 새로고침 때만
+                            [this]() { return statisticsPayload(); }, this);
+
     connect(ui->pushButton, &QPushButton::clicked, this, &ConveyorWindow::onSearchClicked);
 }
 
 void ConveyorWindow::connectToMqttBroker(){ //브로커 연결  실제 연결 시도만!
-
-    if(m_client->state() == QMqttClient::Disconnected){
-        m_client->connectToHost();
-    }
-
+    MqttHub::instance()->connectToBroker();
 }
 
 void ConveyorWindow::onMqttConnected(){
     qDebug() << "MQTT Connected - conveyor Control";
-    subscription = m_client->subscribe(mqttTopic);
-    if(subscription){
-        connect(subscription, &QMqttSubscription::messageReceived,
-                this, &ConveyorWindow::onMqttMessageReceived);
-    }
-
-    auto statsSubscription = m_client->subscribe(QString("factory/conveyor_01/msg/statistics"));
-    if(statsSubscription){
-        connect(statsSubscription, &QMqttSubscription::messageReceived,
-                this, &ConveyorWindow::onMqttMessageReceived);
-        qDebug() << "ConveyorWindow - 통계 토픽 구독됨";
-    }
-
-    auto failureSubscription = m_client->subscribe(QString("factory/conveyor_01/log/response"));
-    if(failureSubscription){
-        connect(failureSubscription, &QMqttSubscription::messageReceived,
-                this, &ConveyorWindow::onMqttMessageReceived);
-    }
-
-    auto failureTimer = new QTimer(this);
-    connect(failureTimer, &QTimer::timeout, this, &ConveyorWindow::requestFailureRate);
-    failureTimer->start(60000); // 60초마다 불량률 요청
-
-    //if(statisticsTimer && !statisticsTimer->isActive()) {
-    //    statisticsTimer->start(60000);  // 3초마다 요청
-    //}
-
-
-    reconnectTimer->stop(); //연결이 성공하면 재연결 타이며 멈추기!
-
-
 }
 
 void ConveyorWindow::onMqttDisConnected(){
     qDebug() << "MQTT 연결이 끊어졌습니다!";
-    if(!reconnectTimer->isActive()){
-        reconnectTimer->start(5000);
-    }
-
-    if(statisticsTimer && statisticsTimer->isActive()) {
-        statisticsTimer->stop();
-    }
-    subscription=NULL; //초기화
 }
 
-void ConveyorWindow::onMqttMessageReceived(const QMqttMessage &message){  //매개변수 수정
-    QString messageStr = QString::fromUtf8(message.payload());  // message.payload() 사용
-    QString topicStr = message.topic().name();  //토픽 정보도 가져올 수 있음
+void ConveyorWindow::onLogEvent(const LogEventPtr &event){
+    if(event->logLevel != "info") return;
 
-    if(isConveyorDateSearchMode && (topicStr.contains("/log/error") || topicStr.contains("/log/info"))) {
-        qDebug() << "[컨베이어] 날짜 검색 모드이므로 실시간 로그 무시:" << topicStr;
+    if(isConveyorDateSearchMode) {
+        qCDebug(lcLive) << "[컨베이어] 날짜 검색 모드이므로 실시간 로그 무시:" << event->deviceId;
         return;  // 실시간 로그 무시!
     }
 
-    // 🐛 모든 메시지 디버깅
-    qDebug() << "=== MainWindow 메시지 수신 ===";
-    qDebug() << "토픽:" << topicStr;
-    qDebug() << "내용:" << messageStr;
-
-    qDebug() << "받은 메시지:" << topicStr << messageStr;  // 디버그 추가
+    showConveyorNormal(); // 에러 상태 초기화
+    logMessage("컨베이어 정상 동작");
+}
 
-    if(topicStr.contains("factory/conveyor_01/log/info")){
-        QStringList parts = topicStr.split('/');
-        QString deviceId = parts[1];
+void ConveyorWindow::onSpeedStats(const SpeedStatsPtr &stats){
+    onDeviceStatsReceived(lineDeviceId(), stats->json);
+}
 
-        if(deviceId == "conveyor_01"){
-            showConveyorNormal(); // 에러 상태 초기화
-            logMessage("컨베이어 정상 동작");
-        }
-        return;
-    }
+void ConveyorWindow::onFailureStats(const FailureStatsPtr &stats){
+    double rate = stats->failureRate;   // 이미 백분율
 
-    if(topicStr == "factory/conveyor_01/msg/statistics") {
-        QJsonDocument doc = QJsonDocument::fromJson(messageStr.toUtf8());
-        QJsonObject data = doc.object();
-        onDeviceStatsReceived("conveyor_01", data);
-        // logMessage(QString("컨베이어 통계 - 평균:%1 현재:%2")
-        //                .arg(data["average"].toInt())
-        //                .arg(data["current_speed"].toInt()));
-        return;
+    if (failureRateSeries) {
+        updateFailureRate(rate);
+        qDebug() << "불량률 자동 업데이트:" << rate << "%";
     }
 
-    if(topicStr == "factory/conveyor_01/log/response") {
-        QJsonDocument doc = QJsonDocument::fromJson(messageStr.toUtf8());
-        QJsonObject response = doc.object();
-
-        if(response.contains("data")) {
-            QJsonObject data = response["data"].toObject();
-            if(data.contains("message")) {
-                QJsonObject message = data["message"].toObject();
-                QString failureRate = message["failure"].toString();
-
-                // 백분률로 변환 (1.0000 → 100%)
-                double rate = failureRate.toDouble() * 100;
+    QString displayRate = QString::number(rate, 'f', 2) + "%";
 
-                if (failureRateSeries) {
-                    updateFailureRate(rate);
-                    qDebug() << "불량률 자동 업데이트:" << rate << "%";
-                }
-
-                QString displayRate = QString::number(rate, 'f', 2) + "%";
-
-                //  textErrorStatus에 불량률 업데이트
-                if(textErrorStatus) {
-                    QString currentText = textErrorStatus->toPlainText();
-                    // "불량률: 계산중..." 부분을 실제 값으로 교체
-                    currentText.replace("불량률: 계산중...", "불량률: " + displayRate);
-                    textErrorStatus->setText(currentText);
-                }
-            }
-        }
-        return;
+    //  textErrorStatus에 불량률 업데이트
+    if(textErrorStatus) {
+        QString currentText = textErrorStatus->toPlainText();
+        // "불량률: 계산중..." 부분을 실제 값으로 교체
+        currentText.replace("불량률: 계산중...", "불량률: " + displayRate);
+        textErrorStatus->setText(currentText);
     }
+}
 
-    // if (topicStr.contains("factory/feeder_01/log/error") ||
-    //     topicStr.contains("factory/feeder_01/log/info")) {
-
-    //     QJsonDocument doc = QJsonDocument::fromJson(message.payload());
-    //     QJsonObject logData = doc.object();
-
-    //     QString logCode = logData["log_code"].toString();
-    //     QString logMsg = logData["message"].toString();  // ✅ 변수명 변경!
-
-    //     if (logCode == "SPD") {
-    //         logMessage("SPD 오류: " + logMsg);  // ✅ logMsg 사용
-    //         showConveyorError("SPD 오류");
-    //         addErrorCardUI(logData);
-    //     } else if (logCode == "INF") {
-    //         logMessage("정보: " + logMsg);      // ✅ logMsg 사용
-    //         showConveyorNormal();
-    //     }
-    //     return;
-    // }
+void ConveyorWindow::onDeviceStatus(const DeviceStatusPtr &status){
+    const QString &messageStr = status->status;
 
-    if(topicStr == "conveyor_03/status"){
+    if(status->deviceId == controlDeviceId()){
+        // 제어 명령 응답
         if(messageStr == "on"){
-            //logMessage("컨베이어가 시작되었습니다.");
             logError("컨베이어가 시작되었습니다.");
             showConveyorNormal();
             showConveyorError("컨베이어가 시작되었습니다.");
             updateErrorStatus();
-            emit deviceStatusChanged("conveyor_03", "on");
+            emit deviceStatusChanged(controlDeviceId(), "on");
         } else if(messageStr == "off"){
             logMessage("컨베이어가 정지되었습니다.");
             showConveyorNormal();
-            emit deviceStatusChanged("conveyor_03", "off");
+            emit deviceStatusChanged(controlDeviceId(), "off");
         }
         // 나머지 명령은 무시
-    } else if(topicStr == "conveyor_01/status"){
+    } else if(status->deviceId == lineDeviceId()){
         if(messageStr != "on" && messageStr != "off"){
-            // error_mode, speed 등 기타 명령 처리 (필요시 기존 코드 복사)
+            // error_mode, speed 등 기타 명령 처리
             if(messageStr == "error_mode"){
                 logError("컨베이어 속도 오류");
             } else if(messageStr.startsWith("SPEED_")){
@@ -362,16 +295,19 @@ void ConveyorWindow::onMqttError(QMqttClient::ClientError error){
 }
 
 void ConveyorWindow::publishControlMessage(const QString &cmd){
-    if(m_client && m_client->state() == QMqttClient::Connected){
-        m_client->publish(mqttControllTopic, cmd.toUtf8());
-        logMessage("제어 명령 전송: " + cmd);
-        qDebug() << "MQTT 발송:" << mqttControllTopic << cmd;
-    }
-    else{
-        logMessage("MQTT 연결 안됨");
-        qDebug() << "MQTT 상태:" << m_client->state(); // 이 줄 추가
-
-    }
+    // 명령 큐로 전달 - 연결이 끊겨 있으면 보관했다가 전송, 제어 기기 status로 동작 확인
+    CommandQueue::instance()->submit(mqttControllTopic, cmd, "conveyor", this, [this](const CommandResult &result) {
+        if (result.ok()) {
+            logMessage(QString("제어 확인: %1 (응답 %2ms)").arg(result.command).arg(result.rttMs));
+        } else if (result.outcome == CommandResult::TimedOut) {
+            logMessage("제어 응답 없음: " + result.command + " (마지막 상태: " + result.lastStatus + ")");
+        } else if (result.outcome == CommandResult::Superseded) {
+            logMessage("정지 명령으로 취소: " + result.command);
+        } else {
+            logMessage("연결되지 않아 제어 명령 취소: " + result.command);
+        }
+    });
+    logMessage("제어 명령 요청: " + cmd);
 }
 
 
@@ -527,7 +463,7 @@ void ConveyorWindow::onConveyorOnClicked(){
     // 공통 제어 - JSON 형태로
     QJsonObject logData;
     logData["log_code"] = "SHD";
-    logData["message"] = "conveyor_03";
+    logData["message"] = controlDeviceId();
     logData["timestamp"] = QDateTime::currentMSecsSinceEpoch();
 
     QJsonDocument doc(logData);
@@ -559,7 +495,7 @@ void ConveyorWindow::onConveyorOffClicked(){
     // 공통 제어 - JSON 형태로
     QJsonObject logData;
     logData["log_code"] = "SHD";
-    logData["message"] = "conveyor_03";
+    logData["message"] = controlDeviceId();
     logData["timestamp"] = QDateTime::currentMSecsSinceEpoch();
 
     QJsonDocument doc(logData);
@@ -589,9 +525,7 @@ void ConveyorWindow::onConveyorOffClicked(){
 }
 
 void ConveyorWindow::requestFailureRate() {
-    if(m_client && m_client->state() == QMqttClient::Connected){
-        m_client->publish(QMqttTopicName("factory/conveyor_01/log/request"), "{}");
-    }
+    PollScheduler::instance()->requestNow(lineDeviceId() + kFailureRatePollSuffix);
 }
 void ConveyorWindow::onDeviceLock(){
     if(!DeviceLockActive){
@@ -726,22 +660,27 @@ void ConveyorWindow::gobackhome(){
 
 }
 
-void ConveyorWindow::requestStatisticsData() {
-    if(m_client && m_client->state() == QMqttClient::Connected) {
-        QJsonObject request;
-        request["device_id"] = "conveyor_01";
+QByteArray ConveyorWindow::statisticsPayload() const {
+    QJsonObject request;
+    request["device_id"] = lineDeviceId();
 
-        QDateTime now = QDateTime::currentDateTime();
-        QDateTime oneMinuteAgo = now.addSecs(-60);
-        QJsonObject timeRange;
-        timeRange["start"] = oneMinuteAgo.toMSecsSinceEpoch();
-        timeRange["end"] = now.toMSecsSinceEpoch();
-        request["time_range"] = timeRange;
+    QDateTime now = QDateTime::currentDateTime();
+    QDateTime oneMinuteAgo = now.addSecs(-60);
+    QJsonObject timeRange;
+    timeRange["start"] = oneMinuteAgo.toMSecsSinceEpoch();
+    timeRange["end"] = now.toMSecsSinceEpoch();
+    request["time_range"] = timeRange;
+    // 같은 토픽의 오늘 통계 요청(StatsRollup)과 응답을 구분하도록 key를 붙인 request_id
+    request["request_id"] = QString("%1/%2").arg(lineDeviceId() + kStatisticsPollSuffix, QUuid::createUuid().toString(QUuid::WithoutBraces));
 
-        QJsonDocument doc(request);
+    return QJsonDocument(request).toJson(QJsonDocument::Compact);
+}
 
-        m_client->publish(QString("factory/statistics"), doc.toJson(QJsonDocument::Compact));
-        m_client->publish(QMqttTopicName("factory/conveyor_01/log/request"), "{}");
+void ConveyorWindow::requestStatisticsData() {
+    // 정기 불량률 요청과 겹치면 스케줄러가 합침
+    PollScheduler *scheduler = PollScheduler::instance();
+    if(scheduler->requestNow(lineDeviceId() + kStatisticsPollSuffix)) {
+        scheduler->requestNow(lineDeviceId() + kFailureRatePollSuffix);
         qDebug() << "ConveyorWindow - 컨베이어 통계 요청 전송";
     }
 }
@@ -898,6 +837,15 @@ void ConveyorWindow::setupRightPanel() {
     disconnect(ui->lineEdit, &QLineEdit::returnPressed, this, &ConveyorWindow::onConveyorSearchClicked);
     connect(ui->lineEdit, &QLineEdit::returnPressed, this, &ConveyorWindow::onConveyorSearchClicked);
 
+    // 입력하는 대로 로컬 색인 검색 - 같은 프레임에 들어온 입력은 한 번으로
+    if (!localFilterTimer) {
+        localFilterTimer = new QTimer(this);
+        localFilterTimer->setSingleShot(true);
+        localFilterTimer->setInterval(0);
+        connect(localFilterTimer, &QTimer::timeout, this, &ConveyorWindow::applyLocalFilter);
+        connect(ui->lineEdit, &QLineEdit::textEdited, localFilterTimer, qOverload<>(&QTimer::start));
+    }
+
     QWidget* searchContainer = new QWidget();
     QHBoxLayout* searchLayout = new QHBoxLayout(searchContainer);
     searchLayout->setContentsMargins(0, 0, 0, 0);
@@ -1058,40 +1006,42 @@ void ConveyorWindow::setupRightPanel() {
         //emit requestConveyorLogSearch("", QDate(), QDate());
         emit requestConveyorLogSearch("", today, today);
     });
-    // 4. QScrollArea+QVBoxLayout(카드 쌓기) 구조 적용
+    // 4. QScrollArea 안에 오류 로그 목록 (보이는 카드만 그림)
     if (ui->scrollArea) {
-        if (!errorCardContainer) {
-            errorCardContainer = new QWidget();
-            errorCardLayout = new QVBoxLayout(errorCardContainer);
-            errorCardLayout->setSpacing(6);
-            errorCardLayout->setContentsMargins(4, 2, 4, 4);
-            errorCardLayout->addStretch();
-            ui->scrollArea->setWidget(errorCardContainer);
+        if (!errorLogView) {
+            errorLogView = new ErrorLogView();
+            ui->scrollArea->setWidget(errorLogView);
             ui->scrollArea->setWidgetResizable(true);
+            ui->scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+            connect(errorLogView, &ErrorLogView::errorLogDoubleClicked, this, &ConveyorWindow::onErrorLogDoubleClicked);
+
+            logPager = new LogPager(lineDeviceId(), this);
+            connect(errorLogView, &ErrorLogView::nearEnd, this, [this]() {
+                logPager->fetchOlder(errorLogView->logModel()->oldestRows());
+            });
+            connect(logPager, &LogPager::pageReady, this, [this](const QList<QJsonObject> &rows) {
+                errorLogView->logModel()->mergeLogs(rows);     // offset 페이지면 목록 중간에 들어갈 행도 있음
+            });
         }
     }
 }
 
 void ConveyorWindow::clearErrorCards() {
-    if (!errorCardLayout) return;
-    // stretch 제외 모두 삭제
-    while (errorCardLayout->count() > 1) {
-        QLayoutItem* item = errorCardLayout->takeAt(0);
-        if (QWidget* w = item->widget()) w->deleteLater();
-        delete item;
-    }
+    if (!errorLogView) return;
+    errorLogView->logModel()->clear();
+    errorLogView->setNoResultsVisible(false);
 }
 
-void ConveyorWindow::onErrorLogsReceived(const QList<QJsonObject> &logs){
-
-    clearErrorCards();
-    for(int i = logs.size() - 1; i >= 0; --i) {
-        const QJsonObject &log = logs[i];
-        if(log["device_id"].toString() == "conveyor_01") {
-            if (log["log_level"].toString() != "error") continue;
-            addErrorCardUI(log);
-        }
-    }
+void ConveyorWindow::onErrorLogsReceived(const LogSnapshot &logs){
+    if (!errorLogView) return;
+    // 이 기기 색인으로 최신 것만 꺼냄 (스냅샷 전체를 훑거나 복사하지 않음)
+    QList<QJsonObject> recent = logs.newestForDevice(lineDeviceId(), kRecentLogLimit);
+    std::reverse(recent.begin(), recent.end());     // 오래된 것부터 넣어야 최신이 맨 위
+    errorLogView->logModel()->clear();
+    errorLogView->setNoResultsVisible(false);
+    errorLogView->logModel()->prependLogs(recent);
+    if (logPager) logPager->setEnabled(true);
+    if (!localFilter.text.isEmpty()) applyLocalFilter();     // 입력해 둔 검색어가 있으면 다시 거름
 }
 
 // void ConveyorWindow::onErrorLogBroadcast(const QJsonObject &errorData){
@@ -1132,7 +1082,7 @@ void ConveyorWindow::onErrorLogsReceived(const QList<QJsonObject> &logs){
 void ConveyorWindow::onErrorLogBroadcast(const QJsonObject &errorData){
     QString deviceId = errorData["device_id"].toString();
 
-    if(deviceId.startsWith("conveyor_")) {  // conveyor_01, conveyor_03 모두
+    if(deviceId == lineDeviceId() || deviceId == controlDeviceId()) {  // 라인 기기, 제어 기기 모두
         QString logCode = errorData["log_code"].toString();
         QString logLevel = errorData["log_level"].toString();
 
@@ -1167,13 +1117,21 @@ void ConveyorWindow::onErrorLogBroadcast(const QJsonObject &errorData){
 //  기본 검색 함수 (기존 onSearchClicked 유지)
 void ConveyorWindow::onSearchClicked(){
     QString searchText = ui->lineEdit->text().trimmed();
-    emit requestFilteredLogs("conveyor_01", searchText);
+    emit requestFilteredLogs(lineDeviceId(), searchText);
 }
 
 
 void ConveyorWindow::onSearchResultsReceived(const QList<QJsonObject> &results) {
-    qDebug() << "ConveyorWindow 검색 결과 수신:" << results.size() << "개";
-    clearErrorCards();
+    onSearchResultsUpdated(results, true, true);
+}
+
+void ConveyorWindow::onSearchResultsUpdated(const QList<QJsonObject> &results, bool reset, bool complete) {
+    qDebug() << "ConveyorWindow 검색 결과 수신:" << results.size() << "개" << (reset ? "(새 검색)" : "(추가)");
+    if (reset) {
+        clearErrorCards();
+        if (logPager) logPager->setEnabled(false);     // 검색 결과는 이어 붙일 이전 페이지가 없음
+        localFilter = LogQuery();                       // 목록은 서버 검색 결과 (아래에서 같은 검색어로 거름)
+    }
 
     // 현재 검색어 확인
     QString searchText = ui->lineEdit ? ui->lineEdit->text().trimmed() : "";
@@ -1195,14 +1153,18 @@ void ConveyorWindow::onSearchResultsReceived(const QList<QJsonObject> &results)
         qDebug() << "  - 종료일:" << currentEndDate.toString("yyyy-MM-dd");
         qDebug() << "  - 필터 활성:" << hasDateFilter;
     }
+    // 날짜 경계는 한 번만 계산 (행마다 QDateTime을 만들지 않음)
+    const qint64 startMs = hasDateFilter ? currentStartDate.startOfDay().toMSecsSinceEpoch() : 0;
+    const qint64 endMs = hasDateFilter ? currentEndDate.addDays(1).startOfDay().toMSecsSinceEpoch() - 1 : 0;
 
     int errorCount = 0;
+    QList<QJsonObject> shown;       // 오래된 것부터
 
     //  HOME 방식으로 변경: 역순 for loop (최신순)
     for(int i = results.size() - 1; i >= 0; --i) {
         const QJsonObject &log = results[i];
 
-        if(log["device_id"].toString() != "conveyor_01") continue;
+        if(log["device_id"].toString() != lineDeviceId()) continue;
         if(log["log_level"].toString() != "error") continue;
 
         bool shouldInclude = true;
@@ -1210,14 +1172,8 @@ void ConveyorWindow::onSearchResultsReceived(const QList<QJsonObject> &results)
         // 날짜 필터링 적용
         if(hasDateFilter) {
             qint64 timestamp = log["timestamp"].toVariant().toLongLong();
-            if(timestamp > 0) {
-                QDateTime logDateTime = QDateTime::fromMSecsSinceEpoch(timestamp);
-                QDate logDate = logDateTime.date();
-
-                if(logDate < currentStartDate || logDate > currentEndDate) {
-                    shouldInclude = false;
-                    qDebug() << "ConveyorWindow 날짜 필터로 제외:" << logDate.toString("yyyy-MM-dd");
-                }
+            if(timestamp > 0 && (timestamp < startMs || timestamp > endMs)) {
+                shouldInclude = false;
             }
         }
 
@@ -1232,13 +1188,22 @@ void ConveyorWindow::onSearchResultsReceived(const QList<QJsonObject> &results)
         }
 
         if(shouldInclude) {
-            addErrorCardUI(log);
+            shown.append(log);
             errorCount++;
         }
     }
 
-    if(errorCount == 0) {
-        addNoResultsMessage();
+    if (errorLogView) {
+        ErrorLogModel *model = errorLogView->logModel();
+        if (reset) {
+            model->prependLogs(shown);      // 마지막(최신)이 맨 위로
+        } else {
+            // 날짜 검색 중간 결과 - 새로 받은 행만 제자리에 (목록 전체를 다시 만들지 않음)
+            std::reverse(shown.begin(), shown.end());
+            model->mergeLogs(shown);
+        }
+        if (!shown.isEmpty()) errorLogView->setNoResultsVisible(false);
+        if (complete && model->rowCount() == 0) addNoResultsMessage();
     }
 
     updateErrorStatus();
@@ -1246,22 +1211,22 @@ void ConveyorWindow::onSearchResultsReceived(const QList<QJsonObject> &results)
 }
 
 void ConveyorWindow::onDeviceStatsReceived(const QString &deviceId, const QJsonObject &statsData){
-    if(deviceId != "conveyor_01" || !textErrorStatus) {
+    if(deviceId != lineDeviceId() || !textErrorStatus) {
         return;
     }
 
-    qDebug() << "컨베이어 통계 데이터 수신:" << QJsonDocument(statsData).toJson(QJsonDocument::Compact);
+    qCDebug(lcLive) << "컨베이어 통계 데이터 수신:" << QJsonDocument(statsData).toJson(QJsonDocument::Compact);
 
     int currentSpeed = statsData.value("current_speed").toInt();
     int average = statsData.value("average").toInt();
     //double failureRate = statsData.value("failure_rate").toDouble();
 
-    qDebug() << "컨베이어 통계 - 현재속도:" << currentSpeed << "평균속도:" << average;
+    qCDebug(lcLive) << "컨베이어 통계 - 현재속도:" << currentSpeed << "평균속도:" << average;
 
     //  0 데이터여도 차트 리셋하지 않음 (addSpeedData에서 처리)
     if (deviceChart) {
         deviceChart->addSpeedData(currentSpeed, average);
-        qDebug() << "컨베이어 차트 데이터 추가 완료";
+        qCDebug(lcLive) << "컨베이어 차트 데이터 추가 완료";
     } else {
         qDebug() << "컨베이어 차트가 아직 초기화되지 않음";
 
@@ -1291,7 +1256,7 @@ void ConveyorWindow::on_listWidget_itemDoubleClicked(QListWidgetItem* item) {
     QRegularExpressionMatch match = re.match(logText);
 
     QString month, day, hour, minute, second = "00";
-    QString deviceId = "conveyor_01";
+    QString deviceId = lineDeviceId();
 
     if (match.hasMatch()) {
         month = match.captured(1);
@@ -1479,167 +1444,58 @@ void ConveyorWindow::onConveyorSearchClicked() {
     });
 }
 
-void ConveyorWindow::addErrorCardUI(const QJsonObject& errorData) {
-    if (errorData["device_id"].toString() != "conveyor_01") return;
-    QWidget* card = new QWidget();
-    card->setFixedHeight(84);
-    card->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-    card->setStyleSheet(R"(
-        background-color: #F3F4F6;
-        border: 1px solid #E5E7EB;
-        border-radius: 12px;
-    )");
-    card->setProperty("errorData", QVariant::fromValue(errorData));
-
-    // 카드 더블클릭 이벤트 필터 설치
-    static CardEventFilter* filter = nullptr;
-    if (!filter) {
-        filter = new CardEventFilter(this);
-        connect(filter, &CardEventFilter::cardDoubleClicked, this, &ConveyorWindow::onCardDoubleClicked);
-    }
-    card->installEventFilter(filter);
-
-    QVBoxLayout* outer = new QVBoxLayout(card);
-    outer->setContentsMargins(12, 10, 12, 10);
-    outer->setSpacing(6);
-
-    // 상단: 오류 배지 + 시간
-    QHBoxLayout* topRow = new QHBoxLayout();
-    topRow->setSpacing(6);
-    topRow->setContentsMargins(0, 0, 0, 0);
-
-    QLabel* badge = new QLabel();
-    QPixmap errorPixmap(":/ui/icons/images/error.png");
-    if (!errorPixmap.isNull()) {
-        badge->setPixmap(errorPixmap.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        badge->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        badge->setText("⚠");
-        badge->setStyleSheet("color: #ef4444; font-size: 14px; border: none; background: transparent;");
-    }
-
-    QHBoxLayout* left = new QHBoxLayout();
-    left->addWidget(badge);
-    left->setSpacing(4);
-    left->setContentsMargins(0, 0, 0, 0);
-
-    // 에러 메시지 라벨 추가
-    QString logCode = errorData["log_code"].toString();
-    QString messageText = (logCode == "SPD") ? "SPD(모터속도 오류)" : logCode;
-    QLabel* errorLabel = new QLabel(messageText);
-    errorLabel->setStyleSheet("color: #374151; font-size: 12px; font-weight: 500; border: none;");
-    left->addWidget(errorLabel);
-    left->addStretch();
-
-    QLabel* timeLabel = new QLabel(
-        QDateTime::fromMSecsSinceEpoch(errorData["timestamp"].toVariant().toLongLong()).toString("MM-dd hh:mm")
-        );
-    timeLabel->setStyleSheet("color: #6b7280; font-size: 10px; border: none;");
-    timeLabel->setMaximumWidth(70);
-    timeLabel->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Preferred);
-    timeLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-
-    topRow->addLayout(left);
-    topRow->addStretch();
-
-    // 하단: 사람 아이콘 + 디바이스명 + 시간 (하얀 상자로 감싸기)
-    QWidget* whiteContainer = new QWidget();
-    whiteContainer->setStyleSheet(R"(
-        background-color: #FFF;
-        border-radius: 12px;
-    )");
-    QHBoxLayout* whiteLayout = new QHBoxLayout(whiteContainer);
-    whiteLayout->setContentsMargins(12, 10, 12, 10);
-    whiteLayout->setSpacing(6);
-
-    // 사람 아이콘
-    QLabel* personIcon = new QLabel();
-    QPixmap personPixmap(":/ui/icons/images/person.png");
-    if (!personPixmap.isNull()) {
-        personIcon->setPixmap(personPixmap.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        personIcon->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        personIcon->setText("👤");
-        personIcon->setStyleSheet("color: #6b7280; font-size: 14px; border: none; background: transparent;");
-    }
-    whiteLayout->addWidget(personIcon);
-
-    // 디바이스명 배지
-    QLabel* device = new QLabel(errorData["device_id"].toString());
-    device->setMinimumHeight(24);
-    QString dev = errorData["device_id"].toString();
-    QString devStyle = dev.contains("conveyor")
-                           ? R"(
-            background-color: #E1F5FF;
-            color: #56A5FF;
-            border: none;
-            padding: 4px 8px;
-            border-radius: 12px;
-            font-size: 11px;
-            font-weight: 500;
-        )"
-                           : R"(
-            background-color: #FFF4DE;
-            color: #FF9138;
-            border: none;
-            padding: 4px 8px;
-            border-radius: 12px;
-            font-size: 11px;
-            font-weight: 500;
-        )";
-    device->setStyleSheet(devStyle);
-
-    whiteLayout->addWidget(device);
-    whiteLayout->addStretch();
-
-    // 시간 아이콘과 텍스트
-    QLabel* clockIcon = new QLabel();
-    QPixmap clockPixmap(":/ui/icons/images/clock.png");
-    if (!clockPixmap.isNull()) {
-        clockIcon->setPixmap(clockPixmap.scaled(14, 14, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        clockIcon->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        clockIcon->setText("🕐");
-        clockIcon->setStyleSheet("color: #6b7280; font-size: 12px; border: none; background: transparent;");
+QString ConveyorWindow::lineDeviceId() const {
+    // 처음 물을 때 한 번 정함 - 구독/폴링 key와 목록 거르기가 같은 기기를 보도록
+    if (m_lineDeviceId.isEmpty()) {
+        m_lineDeviceId = DeviceRegistry::instance()->firstOf("conveyor", DeviceRegistry::Sensor);
     }
-    whiteLayout->addWidget(clockIcon);
+    return m_lineDeviceId;
+}
 
-    QLabel* timeText = new QLabel(
-        QDateTime::fromMSecsSinceEpoch(errorData["timestamp"].toVariant().toLongLong()).toString("MM-dd hh:mm")
-        );
-    timeText->setStyleSheet("color: #6b7280; font-size: 10px; border: none;");
-    whiteLayout->addWidget(timeText);
-
-    // 조립
-    outer->addLayout(topRow);
-    outer->addWidget(whiteContainer);
-
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect(card);
-    shadow->setBlurRadius(24);
-    shadow->setColor(QColor(255, 140, 0, 0));
-    shadow->setOffset(0, 0);
-    card->setGraphicsEffect(shadow);
-    QPropertyAnimation* anim = new QPropertyAnimation(shadow, "color", card);
-    anim->setDuration(200);
-    anim->setStartValue(QColor(255, 140, 0, 0));
-    anim->setEndValue(QColor(255, 140, 0, 64));
-    anim->setEasingCurve(QEasingCurve::InOutQuad);
-    card->installEventFilter(new CardHoverEffect(card, shadow, anim));
-
-    if (errorCardLayout) {
-        errorCardLayout->insertWidget(0, card);
+QString ConveyorWindow::controlDeviceId() const {
+    return CommandQueue::deviceIdForTopic(mqttControllTopic);
+}
+
+void ConveyorWindow::applyLocalFilter() {
+    if (!errorLogView || !ui->lineEdit) return;
+
+    LogQuery query;
+    query.text = ui->lineEdit->text().trimmed();
+    query.deviceIds = QStringList{lineDeviceId()};
+
+    // 검색 결과 화면과 같은 날짜 조건 (오늘~오늘이면 날짜 제한 없음)
+    bool hasDateFilter = false;
+    if (conveyorStartDateEdit && conveyorEndDateEdit) {
+        const QDate startDate = conveyorStartDateEdit->date();
+        const QDate endDate = conveyorEndDateEdit->date();
+        const QDate today = QDate::currentDate();
+        hasDateFilter = startDate.isValid() && endDate.isValid() && (startDate != today || endDate != today);
+        if (hasDateFilter) {
+            query.startMs = startDate.startOfDay().toMSecsSinceEpoch();
+            query.endMs = endDate.addDays(1).startOfDay().toMSecsSinceEpoch() - 1;
+        }
     }
+
+    QList<QJsonObject> rows = LogStore::instance()->search(query, kRecentLogLimit);
+    std::reverse(rows.begin(), rows.end());     // 오래된 것부터 넣어야 최신이 맨 위
+    errorLogView->logModel()->clear();
+    errorLogView->setNoResultsVisible(false);
+    errorLogView->logModel()->prependLogs(rows);
+    if (rows.isEmpty() && !query.text.isEmpty()) addNoResultsMessage();
+
+    localFilter = query.text.isEmpty() ? LogQuery() : query;
+    if (logPager) logPager->setEnabled(query.text.isEmpty() && !hasDateFilter);
+}
+
+void ConveyorWindow::addErrorCardUI(const QJsonObject& errorData) {
+    if (errorData["device_id"].toString() != lineDeviceId()) return;
+    if (!localFilter.text.isEmpty() && !localFilter.matches(errorData)) return;    // 입력 중인 검색어에 안 맞음
+    if (errorLogView) errorLogView->logModel()->prependLog(errorData);
 }
 
-void ConveyorWindow::onCardDoubleClicked(QObject* cardWidgetObj) {
-    QWidget* cardWidget = qobject_cast<QWidget*>(cardWidgetObj);
-    if (!cardWidget) return;
-    QJsonObject logData = cardWidget->property("errorData").toJsonObject();
+void ConveyorWindow::onErrorLogDoubleClicked(const QJsonObject& logData) {
     QString deviceId = logData["device_id"].toString();
-    if (deviceId != "conveyor_01") return;
+    if (deviceId != lineDeviceId()) return;
     qint64 timestamp = logData["timestamp"].toVariant().toLongLong();
     qint64 startTime = timestamp - 60 * 1000;
     qint64 endTime = timestamp + 5 * 60 * 1000;
@@ -1668,11 +1524,11 @@ void ConveyorWindow::onCardDoubleClicked(QObject* cardWidgetObj) {
 }
 
 void ConveyorWindow::loadPastLogs() {
-    emit requestErrorLogs("conveyor_01");
+    emit requestErrorLogs(lineDeviceId());
 }
 
 void ConveyorWindow::addErrorLog(const QJsonObject &errorData) {
-    if(errorData["device_id"].toString() != "conveyor_01") return;
+    if(errorData["device_id"].toString() != lineDeviceId()) return;
     if(errorData["log_level"].toString() != "error") return;
     addErrorCardUI(errorData);
 }
@@ -2163,44 +2019,9 @@ void ConveyorWindow::updateFailureRate(double failureRate) {
     qDebug() << " 페트병 분리 현황 업데이트 - 12시부터 시계방향: 투명(녹색)" << transparentRate << "% → 색상(주황)" << failureRate << "%";
 }
 void ConveyorWindow::addNoResultsMessage() {
-    if (!errorCardLayout) return;
-
-    QWidget* noResultCard = new QWidget();
-    noResultCard->setFixedHeight(100);
-    noResultCard->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-    noResultCard->setStyleSheet(R"(
-        background-color: #f8f9fa;
-        border: 2px dashed #dee2e6;
-        border-radius: 12px;
-    )");
-
-    QVBoxLayout* layout = new QVBoxLayout(noResultCard);
-    layout->setContentsMargins(20, 15, 20, 15);
-    layout->setSpacing(5);
-
-    // 아이콘
-    QLabel* iconLabel = new QLabel("🔍");
-    iconLabel->setAlignment(Qt::AlignCenter);
-    iconLabel->setStyleSheet("font-size: 24px; color: #6c757d; border: none;");
-
-    // 메시지
-    QLabel* messageLabel = new QLabel("검색 결과가 없습니다");
-    messageLabel->setAlignment(Qt::AlignCenter);
-    messageLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: #6c757d; border: none;");
-
-    // 서브 메시지
-    QLabel* subMessageLabel = new QLabel("다른 검색 조건을 시도해보세요");
-    subMessageLabel->setAlignment(Qt::AlignCenter);
-    subMessageLabel->setStyleSheet("font-size: 12px; color: #868e96; border: none;");
-
-    layout->addWidget(iconLabel);
-    layout->addWidget(messageLabel);
-    layout->addWidget(subMessageLabel);
-
-    // 카드를 레이아웃에 추가 (stretch 위에)
-    errorCardLayout->insertWidget(0, noResultCard);
-
-    qDebug() << "📝 '검색 결과 없음' 메시지 카드 추가됨";
+    if (!errorLogView) return;
+    errorLogView->setNoResultsVisible(true);
+    qDebug() << "📝 '검색 결과 없음' 메시지 표시";
 }
 
 
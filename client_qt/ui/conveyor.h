@@ -29,9 +29,12 @@
 #include <QJsonArray>
 #include "../video/streamer.h"
 #include <qlistwidget.h>
-#include "../widgets/cardevent.h"
+#include "../widgets/error_log_view.h"
+#include "../mqtt/log_pager.h"
 #include "../widgets/error_message_card.h"
 #include "../charts/device_chart.h"
+#include "../mqtt/message_types.h"
+#include "../mqtt/log_store.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class ConveyorWindow; }
@@ -46,10 +49,12 @@ public:
     ~ConveyorWindow();
 
 public slots:
-    void onErrorLogsReceived(const QList<QJsonObject> &logs);  // 로그 응답 슬롯
+    void onErrorLogsReceived(const LogSnapshot &logs);  // 로그 응답 슬롯 (Home의 LogStore 스냅샷)
     void onErrorLogBroadcast(const QJsonObject &errorData);
     void onDeviceStatsReceived(const QString &deviceId, const QJsonObject &statsData);
     void onSearchResultsReceived(const QList<QJsonObject> &results);
+    // 날짜 검색(LogQueryPlanner) 결과 - reset이면 목록을 바꾸고, 아니면 새로 받은 행만 끼워 넣음
+    void onSearchResultsUpdated(const QList<QJsonObject> &results, bool reset, bool complete);
 
 signals:
     void errorLogGenerated(const QJsonObject &errorData);     // 오류 로그 발생 시그널
@@ -64,7 +69,10 @@ signals:
 private slots: //행동하는 것
     void onMqttConnected(); //연결 되었는지
     void onMqttDisConnected(); //연결 안되었을 때
-    void onMqttMessageReceived(const QMqttMessage &message); //메시지 내용, 토픽 on, myled/status
+    void onDeviceStatus(const DeviceStatusPtr &status);    // 라인 기기 상태, 제어 기기 상태 (명령 응답)
+    void onSpeedStats(const SpeedStatsPtr &stats);         // 통계
+    void onFailureStats(const FailureStatsPtr &stats);     // 불량률
+    void onLogEvent(const LogEventPtr &event);             // 정상 로그
     void onMqttError(QMqttClient::ClientError error); //에러 났을 때
     void connectToMqttBroker(); //브로커 연결
 
@@ -93,12 +101,7 @@ private:
     Streamer* rpiStreamer;
     Streamer* hwStreamer;  // 한화 카메라 스트리머
 
-    QMqttClient *m_client;
-    QMqttSubscription *subscription;
-    QTimer *reconnectTimer;
-
-    QString mqttBroker = "mqtt.kwon.pics";
-    int mqttPort = 1883;
+    QMqttClient *m_client;   // MqttHub 공유 연결
     QString mqttTopic = "conveyor_01/status";
     QString mqttControllTopic = "conveyor_03/cmd";
 
@@ -151,17 +154,23 @@ private:
     //void setupConveyorSearchPanel();
 
     void downloadAndPlayVideoFromUrl(const QString& httpUrl, const QString& deviceId);
-    QTimer *statisticsTimer;
+    QByteArray statisticsPayload() const;
 
 
-    QVBoxLayout* errorCardLayout = nullptr; // 카드 레이아웃
-    QWidget* errorCardContainer = nullptr;  // 카드 컨테이너
-    // 카드 더블클릭 이벤트 필터
-    CardEventFilter* cardEventFilter = nullptr;
+    ErrorLogView* errorLogView = nullptr;   // 오류 로그 목록 (보이는 카드만 그림)
+    LogPager* logPager = nullptr;          // 맨 아래로 내리면 이전 라인 기기 오류 로그 (최근 목록일 때만)
     void addErrorCardUI(const QJsonObject& logData); // 카드 UI 추가 함수
-    void onCardDoubleClicked(QObject* cardWidget); // 시그널과 맞춤
+    void onErrorLogDoubleClicked(const QJsonObject& logData); // 카드 더블클릭 → 그 시각 영상
     void clearErrorCards();
 
+    // 입력하는 대로 LogStore 색인으로 목록 거르기 (서버 검색은 엔터/검색 버튼)
+    QTimer* localFilterTimer = nullptr;
+    LogQuery localFilter;                   // 거르는 중인 조건 (검색어가 없으면 비어있음) - 실시간 로그도 이걸로 거름
+    void applyLocalFilter();
+    QString lineDeviceId() const;           // 이 창이 보여주는 라인 기기 (DeviceRegistry의 컨베이어 라인 기기)
+    QString controlDeviceId() const;        // 제어 명령을 받는 기기 (mqttControllTopic의 기기)
+    mutable QString m_lineDeviceId;
+
     //헤더
     ErrorMessageCard* errorCard = nullptr;
     void setupErrorCardUI();
@@ -22,8 +22,24 @@
 #include <QFile>
 #include <QDesktopServices>
 #include <QTimeZone>
+#include <algorithm>
 #include "../video/video_mqtt.h"
 #include "../video/video_client_functions.hpp"
+#include "../mqtt/mqtt_hub.h"
+#include "../mqtt/message_ingest.h"
+#include "../mqtt/query_response_decoder.h"
+#include "../mqtt/poll_scheduler.h"
+#include "../mqtt/stats_rollup.h"
+#include "../mqtt/device_registry.h"
+#include "../mqtt/response_pipeline.h"
+#include "../mqtt/query_engine.h"
+#include "../mqtt/command_queue.h"
+#include "../mqtt/journal_replayer.h"
+#include "../mqtt/time_travel.h"
+#include "../mqtt/local_history.h"
+#include "../mqtt/log_query_planner.h"
+#include "../mqtt/log_categories.h"
+#include "../widgets/time_travel_bar.h"
 
 // mcp
 #include <QProcess>
@@ -33,8 +49,6 @@
 
 #include <QMouseEvent>
 
-#include "../widgets/cardevent.h"
-#include "../widgets/cardhovereffect.h"
 #include "../widgets/chartcardwidget.h"
 #include <QtCharts/QChartView>
 
@@ -47,8 +61,6 @@ Home::Home(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::Home)
     , m_client(nullptr)
-    , subscription(nullptr)
-    , queryResponseSubscription(nullptr)
     , factoryRunning(false)
     , feederWindow(nullptr)
     , startDateEdit(nullptr)      // 추가
@@ -77,6 +89,8 @@ Home::Home(QWidget *parent)
     setupPanelStyles();
 
     m_errorChartManager = new ErrorChartManager(this);
+    m_errorCoalescer = new ErrorBurstCoalescer(this);
+    connect(m_errorCoalescer, &ErrorBurstCoalescer::aggregateReady, this, &Home::onErrorAggregate);
     if (ui->chartWidget) {
         auto* card = new ChartCardWidget(
             m_errorChartManager->chartView(),
@@ -87,12 +101,10 @@ Home::Home(QWidget *parent)
         lay->addWidget(card);
     }
 
-    statisticsTimer = new QTimer(this);
-    connect(statisticsTimer, &QTimer::timeout, this, [this](){
-        qDebug() << " Home - 정기 통계 요청 (60초마다)";
-        requestStatisticsToday("feeder_01");
-        requestStatisticsToday("conveyor_01");
-    });
+    // 오늘 통계는 라인 기기마다 PollScheduler가 60초마다 (새 기기가 발견되면 그때 등록)
+    DeviceRegistry *registry = DeviceRegistry::instance();
+    for (int i = 0; i < registry->count(); ++i) updateDevicePolls(i);
+    connect(registry, &DeviceRegistry::roleChanged, this, &Home::updateDevicePolls);
 
 
     setupRightPanel();
@@ -252,63 +264,61 @@ void Home::connectChildWindow(QObject *childWindow)
     }
 }
 
-void Home::requestStatisticsToday(const QString &deviceId)
+void Home::updateDevicePolls(int deviceIndex)
 {
-    if (m_client && m_client->state() == QMqttClient::Connected)
-    {
-        QJsonObject request;
-        request["device_id"] = deviceId;
+    DeviceRegistry *registry = DeviceRegistry::instance();
+    const QString deviceId = registry->idAt(deviceIndex);
+    const QString key = "home/stats-today/" + deviceId;
 
-        QJsonObject timeRange;
-        QDateTime now = QDateTime::currentDateTime();
-        QDateTime startOfDay = QDateTime(now.date(), QTime(10, 0, 0)); // 시간 변경
-        timeRange["start"] = startOfDay.toMSecsSinceEpoch();
-        timeRange["end"] = now.toMSecsSinceEpoch();
-        request["time_range"] = timeRange;
-
-        QJsonDocument doc(request);
-        m_client->publish(QMqttTopicName("factory/statistics"), doc.toJson(QJsonDocument::Compact));
-        qDebug() << deviceId << " 오늘 하루치 통계 요청! (time_range 포함)";
+    if (registry->roleAt(deviceIndex) == DeviceRegistry::Sensor) {
+        PollScheduler::instance()->registerPoll(key, "factory/statistics", 60000,
+                                                [deviceId]() { return statisticsTodayPayload(deviceId); }, this);
+    } else {
+        PollScheduler::instance()->unregisterPoll(key, this);
     }
 }
 
-void Home::onErrorLogGenerated(const QJsonObject &errorData)
+QString &Home::lastLogCodeFor(const QString &deviceId)
 {
-    addErrorLog(errorData);
-    addErrorLogUI(errorData);
+    static QString noDevice;    // device_id 없는 로그
+    const int index = DeviceRegistry::instance()->ensure(deviceId);
+    if (index < 0) return noDevice;
+    if (index >= lastLogCodes.size()) lastLogCodes.resize(index + 1);
+    return lastLogCodes[index];
 }
 
-void Home::onErrorLogsRequested(const QString &deviceId)
+QByteArray Home::statisticsTodayPayload(const QString &deviceId)
 {
-    QList<QJsonObject> filteredLogs = getErrorLogsForDevice(deviceId);
-    emit errorLogsResponse(filteredLogs);
+    // 10:00~지금 전체가 아니라 마지막으로 합친 구간 이후만 요청 (StatsRollup이 누적)
+    return StatsRollup::instance()->nextRequest(deviceId);
 }
 
-void Home::addErrorLog(const QJsonObject &errorData)
+void Home::requestStatisticsToday(const QString &deviceId)
 {
-    errorLogHistory.prepend(errorData);
-    if (errorLogHistory.size() > 100)
-    {
-        errorLogHistory.removeLast();
+    // 직접 보내지 않고 스케줄러 경유 - 정기 요청과 겹치면 합쳐짐
+    if (PollScheduler::instance()->requestNow("home/stats-today/" + deviceId)) {
+        qCDebug(lcQuery) << deviceId << " 오늘 통계 요청! (마지막 구간 이후만)";
     }
 }
 
-QList<QJsonObject> Home::getAllErrorLogs() const
+void Home::onErrorLogGenerated(const QJsonObject &errorData)
 {
-    return errorLogHistory;
+    addErrorLog(errorData);
+    addErrorLogUI(errorData);
 }
 
-QList<QJsonObject> Home::getErrorLogsForDevice(const QString &deviceId) const
+void Home::onErrorLogsRequested(const QString &deviceId)
 {
-    QList<QJsonObject> filteredLogs;
-    for (const QJsonObject &log : errorLogHistory)
-    {
-        if (log["device_id"].toString() == deviceId)
-        {
-            filteredLogs.append(log);
-        }
-    }
-    return filteredLogs;
+    // 스냅샷은 청크 포인터만 복사 - 창이 자기 기기 색인으로 꺼내 씀
+    LogSnapshot snapshot = LogStore::instance()->snapshot();
+    qDebug() << "Home - 로그 요청:" << deviceId << snapshot.countForDevice(deviceId) << "건 (전체" << snapshot.size() << "건)";
+    emit errorLogsResponse(snapshot);
+}
+
+void Home::addErrorLog(const QJsonObject &errorData)
+{
+    LogStore::instance()->append(errorData);
+    LocalHistory::instance()->recordLog(errorData);
 }
 
 void Home::onFeederTabClicked()
@@ -332,16 +342,10 @@ void Home::onFeederTabClicked()
     feederWindow->showFullScreen();
     QTimer::singleShot(300, [this]()
                        {
-                           QList<QJsonObject> feederLogs;
-                           for(const QJsonObject &log : errorLogHistory) {
-                               QString deviceId = log["device_id"].toString();
-                               if(deviceId.startsWith("feeder_")) {
-                                   feederLogs.append(log);
-                               }
-                           }
-                           qDebug() << "Home - 피더 탭에 피더 로그" << feederLogs.size() << "개 전달";
+                           LogSnapshot snapshot = LogStore::instance()->snapshot();
+                           qDebug() << "Home - 피더 탭에 로그 스냅샷 전달 (feeder_01" << snapshot.countForDevice("feeder_01") << "건)";
                            if(feederWindow) {
-                               feederWindow->onErrorLogsReceived(feederLogs);
+                               feederWindow->onErrorLogsReceived(snapshot);
                            } });
 }
 
@@ -364,16 +368,10 @@ void Home::onContainerTabClicked()
     conveyorWindow->showFullScreen();
     QTimer::singleShot(300, [this]()
                        {
-                           QList<QJsonObject> conveyorLogs;
-                           for(const QJsonObject &log : errorLogHistory) {
-                               QString deviceId = log["device_id"].toString();
-                               if(deviceId.startsWith("conveyor_")) {
-                                   conveyorLogs.append(log);
-                               }
-                           }
-                           qDebug() << "Home - 컨베이어 탭에 컨베이어 로그" << conveyorLogs.size() << "개 전달";
+                           LogSnapshot snapshot = LogStore::instance()->snapshot();
+                           qDebug() << "Home - 컨베이어 탭에 로그 스냅샷 전달 (conveyor_01" << snapshot.countForDevice("conveyor_01") << "건)";
                            if(conveyorWindow) {
-                               conveyorWindow->onErrorLogsReceived(conveyorLogs);
+                               conveyorWindow->onErrorLogsReceived(snapshot);
                            } });
 }
 
@@ -425,303 +423,231 @@ void Home::publicFactoryCommand(const QString &command)
 
 void Home::onMqttConnected()
 {
-    static bool alreadySubscribed = false;
-
-    if (alreadySubscribed)
-    {
-        qDebug() << "Home - 이미 구독됨, 건너뜀";
-        return;
-    }
-
-    subscription = m_client->subscribe(mqttTopic);
-    if (subscription)
-    {
-        connect(subscription, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-    }
-
-    auto feederSubscription = m_client->subscribe(QString("feeder_01/status"));
-    if (feederSubscription)
-    {
-        connect(feederSubscription, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-        qDebug() << " Home - feeder_02/status 구독됨";
-    }
-
-    auto feederSubscription2 = m_client->subscribe(QString("feeder_02/status"));
-    if (feederSubscription2)
-    {
-        connect(feederSubscription2, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-        qDebug() << " Home - feeder_01/status 구독됨";
-    }
-
-    auto conveyorSubscription = m_client->subscribe(QString("conveyor_01/status"));
-    if (conveyorSubscription)
-    {
-        connect(conveyorSubscription, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-        qDebug() << " Home - conveyor_03/status 구독됨";
-    }
-
-    auto conveyorSubscription3 = m_client->subscribe(QString("conveyor_02/status"));
-    if (conveyorSubscription3)
-    {
-        connect(conveyorSubscription3, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-        qDebug() << " Home - conveyor_01/status 구독됨";
+    // 구독은 MqttHub가 재연결 때마다 알아서 복구함 (setupMqttClient 참고)
+    // 과거 로그는 처음 연결될 때만 - 재연결 때는 onMqttReconnected에서 끊긴 구간만 백필
+    if (!initialLogsRequested) {
+        initialLogsRequested = true;
+        if (restoredFromLocal) {
+            // 로컬 이력의 마지막 로그 이후만 (재연결 백필과 같은 경로)
+            QTimer::singleShot(1000, this, &Home::requestReconnectBackfill);
+        } else {
+            QTimer::singleShot(1000, this, &Home::requestPastLogs); // MQTT 연결이 완전히 안정된 후 1초 뒤에 과거 로그를 자동으로 요청
+        }
     }
+    // 오늘 통계는 PollScheduler가 연결 직후 알아서 보냄
 
-    // db 연결 mqtt
-    auto errorSubscription = m_client->subscribe(QString("factory/+/log/error"));
-    connect(errorSubscription, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-    qDebug() << " Home - factory/+/log/error 구독됨";
-
-    queryResponseSubscription = m_client->subscribe(mqttQueryResponseTopic);
-    if (queryResponseSubscription)
-    {
-        connect(queryResponseSubscription, &QMqttSubscription::messageReceived, this, &Home::onQueryResponseReceived); // 응답이 오면 onQueryResponseReceived 함수가 자동으로 호출되도록 연결
-        qDebug() << "response 됨";
+    if (LocalHistory::instance()->isChartSynced()) {
+        qDebug() << "[CHART] 올해 차트 데이터는 로컬 이력에 있음 - 전체 조회 생략";
+        return;
     }
-
-    // INF 메시지를 받기 위한 info 토픽 구독 추가
-    auto infoSubscription = m_client->subscribe(QString("factory/+/log/info"));
-    connect(infoSubscription, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-    qDebug() << " Home - factory/+/log/info 구독됨";
-
-    //기기 상태
-    //auto feederStatsSubscription = m_client->subscribe(QString("factory/feeder_01/msg/statistics"));
-    //connect(feederStatsSubscription, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-
-    //auto conveyorStatsSubscription = m_client->subscribe(QString("factory/conveyor_01/msg/statistics"));
-    //connect(conveyorStatsSubscription, &QMqttSubscription::messageReceived, this, &Home::onMqttMessageReceived);
-
-    QTimer::singleShot(1000, this, &Home::requestPastLogs); // MQTT 연결이 완전히 안정된 후 1초 뒤에 과거 로그를 자동으로 요청
-    QTimer::singleShot(3000, [this]()
-                       {
-                           requestStatisticsToday("feeder_01");
-                           requestStatisticsToday("conveyor_01"); });
-
-    QTimer::singleShot(1000, this, &Home::requestPastLogs);    // UI용 (2000개)
-    QTimer::singleShot(2000, this, &Home::loadAllChartData);
-    if(statisticsTimer && !statisticsTimer->isActive()) {
-        statisticsTimer->start(60000);  // 60초마다
-        qDebug() << " Home - 통계 정기 타이머 시작됨";
-    }    // 차트용 (전체)
-
+    QTimer::singleShot(2000, this, &Home::loadAllChartData);    // 차트용 (전체)
 }
 
 void Home::onMqttDisConnected()
 {
-    qDebug() << "MQTT 연결이 끊어졌습니다!";
-    if (!reconnectTimer->isActive())
-    {
-        reconnectTimer->start(5000);
-    }
-    subscription = NULL; // 초기화
-
-    if(statisticsTimer && statisticsTimer->isActive()) {
-        statisticsTimer->stop();
-        qDebug() << " Home - 통계 정기 타이머 정지됨";
-    }
-    subscription=NULL; //초기화
-    queryResponseSubscription = NULL;
+    qDebug() << "MQTT 연결이 끊어졌습니다! (재연결은 MqttHub 담당, 정기 요청은 PollScheduler가 멈춤)";
+}
 
+void Home::onMqttReconnected(qint64 offlineMs)
+{
+    qDebug() << "MQTT 재연결 - 끊겨 있던 시간:" << offlineMs << "ms, 마지막 로그 시각:" << lastTimestamp;
+    QTimer::singleShot(1000, this, &Home::requestReconnectBackfill);
 }
 
-void Home::onMqttMessageReceived(const QMqttMessage &message)
+void Home::onLogEvent(const LogEventPtr &event)
 {
-    QString messageStr = QString::fromUtf8(message.payload()); // message.payload() 사용
-    QString topicStr = message.topic().name();                 // 토픽 정보도 가져올 수 있음
-    qDebug() << "받은 메시지:" << topicStr << messageStr;      // 디버그 추가
+    const QString &deviceId = event->deviceId;
 
     //  검색 중이거나 날짜 검색 모드일 때는 실시간 로그 무시
-    if((isLoadingMoreLogs || isDateSearchMode) && (topicStr.contains("/log/error") || topicStr.contains("/log/info"))) {
-        qDebug() << "🚫 검색 중이거나 날짜 검색 모드이므로 실시간 로그 무시:" << topicStr;
-        qDebug() << "  - isLoadingMoreLogs:" << isLoadingMoreLogs;
-        qDebug() << "  - isDateSearchMode:" << isDateSearchMode;
+    if(isLoadingMoreLogs || isDateSearchMode) {
+        qCDebug(lcLive) << "🚫 검색 중이거나 날짜 검색 모드이므로 실시간 로그 무시:" << deviceId << event->logLevel;
+        qCDebug(lcLive) << "  - isLoadingMoreLogs:" << isLoadingMoreLogs;
+        qCDebug(lcLive) << "  - isDateSearchMode:" << isDateSearchMode;
         return;  // 여기서 완전히 차단
     }
 
-    // db 로그 받기 (error와 info 모두 처리)
-    if (topicStr.contains("/log/error") || topicStr.contains("/log/info"))
-    {
-        QStringList parts = topicStr.split('/');
-        QString deviceId = parts[1];
-
-        QJsonDocument doc = QJsonDocument::fromJson(message.payload());
-        QJsonObject logData = doc.object();
-        logData["device_id"] = deviceId;
-
-        // ✅ 추가: log_level 설정 (가장 중요한 수정!)
-        QString logLevel;
-        if (topicStr.contains("/log/error")) {
-            logLevel = "error";
-        } else if (topicStr.contains("/log/info")) {
-            logLevel = "info";
-        }
-        logData["log_level"] = logLevel;  // ✅ 이 줄 추가!
-
-        QString logCode = logData["log_code"].toString();
-
-        qDebug() << " 실시간 로그 수신:" << deviceId << "log_code:" << logCode;
-
-        if(isDateSearchMode) {
-            qDebug() << "🚫 날짜 검색 모드이므로 실시간 로그를 히스토리에 추가하지 않음";
-            return;
-        }
+    const QJsonObject &logData = event->json;   // device_id, log_level 포함 (파싱은 수신 계층에서 한 번만)
+    const QString &logCode = event->logCode;
+    noteLogTimestamp(event->timestamp);
 
-        // 상태가 바뀔 때만 UI 업데이트
-        if (lastDeviceStatus[deviceId] != logCode)
-        {
-            lastDeviceStatus[deviceId] = logCode;
+    qCDebug(lcLive) << " 실시간 로그 수신:" << deviceId << "log_code:" << logCode;
 
-            qDebug() << deviceId << "상태 변경:" << logCode;
+    // 상태 표시(정상 ↔ 에러 코드)는 바뀔 때만
+    QString &lastLogCode = lastLogCodeFor(deviceId);
+    const bool changed = (lastLogCode != logCode);
+    lastLogCode = logCode;
+    if (changed) qCDebug(lcLive) << deviceId << "상태 변경:" << logCode;
 
-            // INF(정상)일 때와 ERROR일 때 구분 처리
-            if (logCode == "INF")
-            {
-                // 정상 상태 처리
-                qDebug() << " 정상 상태 감지:" << deviceId;
-                emit newErrorLogBroadcast(logData); // 자식 윈도우에 정상 상태 전달
-            }
-            else
-            {
-                // 에러 상태 처리 (기존 로직)
-                qDebug() << " 에러 로그 수신:" << deviceId;
-                onErrorLogGenerated(logData);
-                m_errorChartManager->processErrorData(logData);
-                addErrorLog(logData);
-                emit newErrorLogBroadcast(logData);
-            }
-        }
-        else
-        {
-            qDebug() << deviceId << "상태 유지:" << logCode << "(UI 업데이트 스킵)";
+    // INF(정상)일 때와 ERROR일 때 구분 처리
+    if (logCode == "INF")
+    {
+        if (changed) {
+            // 정상 상태 처리
+            qCDebug(lcLive) << " 정상 상태 감지:" << deviceId;
+            emit newErrorLogBroadcast(logData); // 자식 윈도우에 정상 상태 전달
+        } else {
+            qCDebug(lcLive) << deviceId << "상태 유지:" << logCode << "(UI 업데이트 스킵)";
         }
+        return;
+    }
 
+    // 에러는 같은 코드가 이어져도 한 건씩 - 반복은 코얼레서가 묶음
+    // 지속 세션에서 브로커가 다시 보내준 로그가 백필로 이미 올라가 있을 수 있음
+    if (!rememberLogKey(logData)) {
+        qCDebug(lcLive) << " 이미 표시된 에러 로그 (중복 무시):" << deviceId << logCode;
         return;
     }
-    if (topicStr == "factory/status")
+    qCDebug(lcLive) << " 에러 로그 수신:" << deviceId;
+    // 이력(LogStore/LocalHistory)에는 한 건도 빠짐없이 바로
+    addErrorLog(logData);
+    // 카드/차트/자식 창 반영만 프레임 단위로 모아서 (onErrorAggregate)
+    m_errorCoalescer->push(event);
+}
+
+void Home::onFactoryStatusMessage(const QByteArray &message, const QMqttTopicName &topic)
+{
+    Q_UNUSED(topic);
+    QString messageStr = QString::fromUtf8(message);
+
+    if (messageStr == "RUNNING")
     {
-        if (messageStr == "RUNNING")
-        {
-            factoryRunning = true;
-            updateFactoryStatus(true);
-        }
-        else if (messageStr == "STOPPED")
-        {
-            factoryRunning = false;
-            updateFactoryStatus(false);
-        }
+        factoryRunning = true;
+        updateFactoryStatus(true);
     }
-    else if (topicStr == "feeder_02/status")
+    else if (messageStr == "STOPPED")
     {
-        if (messageStr == "on" || messageStr == "off")
-        {
-            qDebug() << "Home - 피더_01 on/off 처리";
-            // 기존 on/off 처리 코드 유지
-            if (messageStr == "on")
-            {
-                qDebug() << "Home - 피더 정방향 시작";
-            }
-            else if (messageStr == "off")
-            {
-                qDebug() << "Home - 피더 정지됨";
-            }
-        }
-        // 나머지 명령은 무시
+        factoryRunning = false;
+        updateFactoryStatus(false);
     }
-    else if (topicStr == "feeder_01/status")
+}
+
+void Home::onDeviceStatus(const DeviceStatusPtr &status)
+{
+    const QString &deviceId = status->deviceId;
+    const QString &messageStr = status->status;
+    const bool onOff = (messageStr == "on" || messageStr == "off");
+
+    // 명령 응답(on/off)은 제어 대상 기기 / 오류·기타 상태는 라인 기기 (DeviceRegistry가 구분)
+    if (DeviceRegistry::instance()->isActuator(deviceId))
     {
-        if (messageStr != "on" && messageStr != "off")
+        if (onOff)
         {
-            qDebug() << "Home - 피더_02 기타 명령 처리";
-            // reverse, speed 등 기타 명령 처리 (필요시 기존 코드 복사)
-            if (messageStr == "reverse")
-            {
-                qDebug() << "Home - 피더 역방향 시작";
-            }
-            else if (messageStr.startsWith("SPEED_") || messageStr.startsWith("MOTOR_"))
-            {
-                qDebug() << "Home - 피더 오류 감지:" << messageStr;
-            }
+            qDebug() << "Home -" << deviceId << (messageStr == "on" ? "시작됨" : "정지됨");
         }
     }
-    else if (topicStr == "robot_arm_01/status")
+    else if (deviceId.startsWith("feeder_"))
     {
-        if (messageStr == "on")
+        if (messageStr == "reverse")
         {
-            qDebug() << "Home - 로봇팔 시작됨";
+            qDebug() << "Home - 피더 역방향 시작";
         }
-        else if (messageStr == "off")
+        else if (messageStr.startsWith("SPEED_") || messageStr.startsWith("MOTOR_"))
         {
-            qDebug() << "Home - 로봇팔 정지됨";
+            qDebug() << "Home - 피더 오류 감지:" << messageStr;
         }
     }
-    else if (topicStr == "conveyor_03/status")
+    else if (deviceId.startsWith("conveyor_"))
     {
-        if (messageStr == "on" || messageStr == "off")
+        if (messageStr == "error_mode")
         {
-            qDebug() << "Home - 컨베이어_01 on/off 처리";
-            // 기존 on/off 처리 코드 유지
-            if (messageStr == "on")
-            {
-                qDebug() << "Home - 컨베이어 정방향 시작";
-            }
-            else if (messageStr == "off")
-            {
-                qDebug() << "Home - 컨베이어 정지됨";
-            }
+            qDebug() << "Home - 컨베이어 속도";
         }
-        // 나머지 명령은 무시
-    }
-    else if (topicStr == "conveyor_02/status")
-    {
-        if (messageStr != "on" && messageStr != "off")
+        else if (messageStr.startsWith("SPEED_"))
         {
-            qDebug() << "Home - 컨베이어_02 기타 명령 처리";
-            // error_mode, speed 등 기타 명령 처리 (필요시 기존 코드 복사)
-            if (messageStr == "error_mode")
-            {
-                qDebug() << "Home - 컨베이어 속도";
-            }
-            else if (messageStr.startsWith("SPEED_"))
-            {
-                qDebug() << "Home - 컨베이어 오류 감지:" << messageStr;
-            }
+            qDebug() << "Home - 컨베이어 오류 감지:" << messageStr;
         }
     }
-    else if (topicStr == "conveyor_01/status")
-    {
-        if (messageStr != "on" && messageStr != "off")
-        {
-            qDebug() << "Home - 컨베이어_03 기타 명령 처리";
-            // error_mode, speed 등 기타 명령 처리 (필요시 기존 코드 복사)
-            if (messageStr == "error_mode")
-            {
-                qDebug() << "Home - 컨베이어 속도";
-            }
-            else if (messageStr.startsWith("SPEED_"))
-            {
-                qDebug() << "Home - 컨베이어 오류 감지:" << messageStr;
-            }
-        }
+}
+
+void Home::connectToMqttBroker()
+{
+    // VISIONCRAFT_TIME_TRAVEL이 있으면 저널로 지난 시점의 화면을 재구성
+    if (TimeTravel::startFromEnvironment()) {
+        connect(TimeTravel::instance(), &TimeTravel::rewound, this, &Home::onTimeTravelRewound);
+        TimeTravelBar *timeTravelBar = new TimeTravelBar(this);
+        timeTravelBar->show();
+        return;
     }
-    else if (topicStr.contains("/msg/statistics"))
-    {
-        QStringList parts = topicStr.split('/');
-        QString deviceId = parts[1]; // feeder_02 또는 conveyor_03
+    // VISIONCRAFT_REPLAY가 있으면 브로커 대신 캡처 저널을 재생
+    if (JournalReplayer::startFromEnvironment()) return;
+    // 로컬 이력을 다 읽으면 브로커에 연결 (onLocalHistoryScanned), LogStore가 다 차면 화면을 그림 (onLocalHistoryRestored)
+    // 자식 창/챗봇/영상 클라이언트도 생성자에서 연결을 부르므로 이력을 다 읽을 때까지 허브에서 잡아 둠
+    // (마지막 로그 시각을 알기 전에 연결되면 전체 과거 로그를 요청하고, 복원된 로그와 겹쳐 두 번 들어감)
+    MqttHub::instance()->holdConnect();
+    connect(LocalHistory::instance(), &LocalHistory::scanned, this, &Home::onLocalHistoryScanned);
+    connect(LocalHistory::instance(), &LocalHistory::restored, this, &Home::onLocalHistoryRestored);
+    // 날짜 검색 계획기는 복원 전에 - 저장된 덮인 구간을 불러오고 복원 때 빠진 시간대를 받아야 함
+    LogQueryPlanner::instance();
+    LocalHistory::instance()->restore();
+}
 
-        QJsonDocument doc = QJsonDocument::fromJson(message.payload());
-        QJsonObject statsData = doc.object();
+void Home::onLocalHistoryScanned(int logCount, qint64 lastLogAt)
+{
+    // 마지막 로그 시각을 알았으니 연결 - 로그를 LogStore에 넣는 건 연결과 함께 이어서
+    if (logCount > 0) {
+        noteLogTimestamp(lastLogAt);
+        restoredFromLocal = true;
+    }
+    MqttHub::instance()->connectToBroker();
+    MqttHub::instance()->releaseConnect();
+}
 
-        // 해당 탭으로 전달
-        emit deviceStatsReceived(deviceId, statsData);
+void Home::onLocalHistoryRestored(int logCount, qint64 lastLogAt)
+{
+    Q_UNUSED(lastLogAt);
+    if (logCount > 0) {
+        LogSnapshot snapshot = LogStore::instance()->snapshot();
+
+        // 오른쪽 목록: 최근 로그 - 복원하는 동안 실시간/백필로 먼저 올라간 행이 있을 수 있어 시각 순서대로 끼워 넣음
+        const QList<QJsonObject> recent = snapshot.newest(100);
+        for (const QJsonObject &logData : recent) rememberLogKey(logData);
+        if (errorLogView) errorLogView->logModel()->mergeLogs(recent);
+
+        // 차트: 올해 오류 로그 (날짜별 집계라 서버에서 같은 로그를 다시 받아도 그대로)
+        const int year = QDate::currentDate().year();
+        QVector<LogRecord> records;
+        snapshot.forEach([&records, year](const LogSnapshot::Row &row) {
+            if (row.level != LogLevel::Error) return;
+            if (QDateTime::fromMSecsSinceEpoch(row.timestamp).date().year() != year) return;
+            LogRecord record;
+            record.deviceId = row.deviceId;
+            record.logLevel = LogStore::levelToString(row.level);
+            record.logCode = row.logCode;
+            record.timestamp = row.timestamp;
+            records.append(std::move(record));
+        });
+        if (m_errorChartManager) m_errorChartManager->processErrorRecords(records);
+
+        qDebug() << "[Home] 로컬 이력 반영: 로그" << logCount << "건 (목록" << recent.size() << "건, 차트"
+                 << records.size() << "건), 이후 구간만 서버에서 받음";
     }
 }
 
-void Home::connectToMqttBroker()
+void Home::onErrorAggregate(const ErrorAggregate &aggregate)
 {
-    if (m_client->state() == QMqttClient::Disconnected)
-    {
-        m_client->connectToHost();
+    QJsonObject logData = aggregate.latest->json;
+    if (aggregate.count > 1) {
+        // 한 프레임에 같은 기기·코드로 여러 건 → 한 건으로 보여주고 건수 표시
+        logData["repeat_count"] = aggregate.count;
+        logData["first_timestamp"] = aggregate.firstTimestamp;
+        qCDebug(lcLive) << " 에러 로그 묶음:" << aggregate.latest->deviceId << aggregate.latest->logCode << "×" << aggregate.count;
     }
+
+    addErrorLogUI(logData);             // 카드만 - 이력은 onLogEvent에서 건마다 기록됨
+    m_errorChartManager->processErrorData(logData);
+    emit newErrorLogBroadcast(logData);
+}
+
+void Home::onTimeTravelRewound(qint64 timestampMs)
+{
+    // 쌓아둔 오류 카드/이력/중복 판정을 비움 - 직후에 그 시점까지의 메시지가 다시 들어옴
+    qDebug() << "[Home] 타임 트래블 이동:" << QDateTime::fromMSecsSinceEpoch(timestampMs);
+    m_errorCoalescer->clear();
+    clearAllErrorLogsFromUI();
+    LogStore::instance()->clear();
+    receivedLogIds.clear();
+    receivedLogOrder.clear();
+    lastLogCodes.fill(QString());
 }
 
 void Home::setupNavigationPanel()
@@ -764,15 +690,23 @@ void Home::setupNavigationPanel()
 
 void Home::setupMqttClient()
 {
-    m_client = new QMqttClient(this);
-    reconnectTimer = new QTimer(this);
-    m_client->setHostname(mqttBroker); // 브로커 서버에 연결 공용 mqtt 서버
-    m_client->setPort(mqttPort);
-    m_client->setClientId("VisionCraft_Home" + QString::number(QDateTime::currentMSecsSinceEpoch()));
-    connect(m_client, &QMqttClient::connected, this, &Home::onMqttConnected); // QMqttClient가 연결이 되었다면 mainwindow에 있는 저 함수중에 onMQTTCONNECTED를 실행
-    connect(m_client, &QMqttClient::disconnected, this, &Home::onMqttDisConnected);
-    // connect(m_client, &QMqttClient::messageReceived, this, &MainWindow::onMqttMessageReceived);
-    connect(reconnectTimer, &QTimer::timeout, this, &Home::connectToMqttBroker);
+    // 연결은 앱 전체가 MqttHub 하나를 공유 (발행은 기존처럼 m_client로)
+    MqttHub *hub = MqttHub::instance();
+    m_client = hub->client();
+    connect(hub, &MqttHub::connected, this, &Home::onMqttConnected);
+    connect(hub, &MqttHub::disconnected, this, &Home::onMqttDisConnected);
+    connect(hub, &MqttHub::reconnected, this, &Home::onMqttReconnected);
+
+    // 공장 상태는 허브에서 직접
+    hub->subscribe(mqttTopic, this, &Home::onFactoryStatusMessage);
+
+    // 기기 로그(error/info)와 상태는 수신 계층에서 한 번만 파싱된 것을 받음
+    MessageIngest *ingest = MessageIngest::instance();
+    connect(ingest, &MessageIngest::logEvent, this, &Home::onLogEvent);
+    connect(ingest, &MessageIngest::deviceStatus, this, &Home::onDeviceStatus);
+
+    // 로그 쿼리 응답은 QueryEngine이 받아서 쿼리별 콜백으로 전달 (sendLogQuery)
+    QueryEngine::instance();
 }
 
 void Home::updateFactoryStatus(bool running)
@@ -1169,17 +1103,25 @@ void Home::setupRightPanel()
         qDebug() << "날짜 필터 구성 완료";
     }
 
-    // scrollArea 설정
+    // scrollArea 설정 - 카드는 ErrorLogView가 보이는 것만 그림 (스크롤도 뷰가 직접)
     if (ui->scrollArea)
     {
-        QWidget *content = new QWidget();
-        content->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-        QVBoxLayout *layout = new QVBoxLayout(content);
-        layout->setSpacing(6);
-        layout->setContentsMargins(4, 2, 4, 4);
-        layout->addStretch();
-        ui->scrollArea->setWidget(content);
+        errorLogView = new ErrorLogView();
+        ui->scrollArea->setWidget(errorLogView);
         ui->scrollArea->setWidgetResizable(true);
+        ui->scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        connect(errorLogView, &ErrorLogView::errorLogDoubleClicked, this, &Home::onErrorLogDoubleClicked);
+
+        // 무한 스크롤 - 날짜/코드 검색 결과 목록은 이미 완전하거나 조건이 달라 이어 붙이지 않음
+        m_logPager = new LogPager(QString(), this);
+        connect(errorLogView, &ErrorLogView::nearEnd, this, [this]() {
+            if (isDateSearchMode || isLoadingMoreLogs) return;
+            m_logPager->fetchOlder(errorLogView->logModel()->oldestRows());
+        });
+        connect(m_logPager, &LogPager::pageReady, this, [this](const QList<QJsonObject> &rows) {
+            const int added = errorLogView->logModel()->mergeLogs(rows);
+            qDebug() << "[Home] 이전 오류 로그" << added << "개 목록 아래에 추가";
+        });
     }
 
     disconnect(ui->pushButton, &QPushButton::clicked, this, &Home::onSearchClicked);
@@ -1242,6 +1184,11 @@ void Home::setupRightPanel()
 
 void Home::addErrorLogUI(const QJsonObject &errorData)
 {
+    static const qint64 kMergeWindowMs = 60000;    // 1분 넘게 떨어진 같은 오류는 새 카드
+
+    if (!errorLogView) return;
+    // 맨 위 카드와 같은 기기·코드면 새 카드 대신 ×N
+    if (errorLogView->logModel()->mergeIntoTop(errorData, kMergeWindowMs)) return;
     addErrorCardUI(errorData);
 }
 
@@ -1260,17 +1207,21 @@ void Home::onMqttPublishRequested(const QString &topic, const QString &message)
 
 void Home::controlALLDevices(bool start)
 {
-    if (m_client && m_client->state() == QMqttClient::Connected)
-    {
-        QString command = start ? "on" : "off";
-
-        m_client->publish(QMqttTopicName("feeder_02/cmd"), command.toUtf8());
-        m_client->publish(QMqttTopicName("conveyor_03/cmd"), command.toUtf8());
-        m_client->publish(QMqttTopicName("factory/conveyor_02/cmd"), command.toUtf8());
-        m_client->publish(QMqttTopicName("robot_arm_01/cmd"), command.toUtf8());
-        qDebug() << "전체 기기 제어: " << command;
+    // 명령 큐가 기기별로 순서대로 보내고 <device>/status로 동작을 확인 (연결이 끊겨 있으면 보관)
+    QString command = start ? "on" : "off";
+    DeviceRegistry *registry = DeviceRegistry::instance();
 
+    for (int index : registry->indicesWithRole(DeviceRegistry::Actuator))
+    {
+        const QString topic = registry->commandTopic(index);
+        CommandQueue::instance()->submit(topic, command, "home", this, [](const CommandResult &result) {
+            if (result.ok())
+                qDebug() << "전체 기기 제어 확인:" << result.deviceId << result.command << result.rttMs << "ms";
+            else
+                qDebug() << "전체 기기 제어 확인 실패:" << result.deviceId << result.command << "마지막 상태:" << result.lastStatus;
+        });
     }
+    qDebug() << "전체 기기 제어: " << command;
 }
 
 // 라즈베리 카메라 feeder
@@ -1296,97 +1247,36 @@ void Home::updateHWImage(const QImage &image)
         ui->cam3->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
 }
 
-void Home::onQueryResponseReceived(const QMqttMessage &message)
+QueryHandle Home::sendLogQuery(const QString &tag, const QJsonObject &filters, const LogShape &shape,
+                               std::function<void(const LogBatch &)> onBatch, int timeoutMs)
 {
-    qDebug() << "=== 서버 응답 수신됨! ===";
-    QString messageStr = QString::fromUtf8(message.payload());
-    QJsonDocument doc = QJsonDocument::fromJson(message.payload());
-    if (!doc.isObject())
-    {
-        qDebug() << " 잘못된 JSON 응답";
-        return;
-    }
-    QJsonObject response = doc.object();
-    QString responseQueryId = response["query_id"].toString();
-    QString status = response["status"].toString();
-    qDebug() << "응답 쿼리 ID:" << responseQueryId;
-    qDebug() << "응답 상태:" << status;
-
-    // 순서 변경: 쿼리 맵을 먼저 체크!
-    if(feederQueryMap.contains(responseQueryId)) {
-        //  피더 쿼리 맵에서 처리
-        qDebug() << "피더 쿼리 맵 응답 처리";
-        MainWindow* targetWindow = feederQueryMap.take(responseQueryId);
-        if(targetWindow) {
-            processFeederSearchResponse(response, targetWindow);
-        }
-    }
-    else if (conveyorQueryMap.contains(responseQueryId))
-    {
-        //  컨베이어 쿼리 맵에서 처리
-        qDebug() << " 컨베이어 쿼리 맵 응답 처리";
-        ConveyorWindow *targetWindow = conveyorQueryMap.take(responseQueryId);
-        if (targetWindow)
-        {
-            processConveyorSearchResponse(response, targetWindow);
-        }
-    } else if(responseQueryId == chartQueryId) {
-        // 차트용 데이터
-        qDebug() << " 차트용 응답 처리";
-        processChartDataResponse(response);
-    } else if(responseQueryId == currentQueryId) {
-        // UI 로그용 데이터 이제 맨 뒤로!
-        qDebug() << " UI 로그용 응답 처리";
-        processPastLogsResponse(response);
-    } else if(responseQueryId == feederQueryId) {
-        qDebug() << "피더 전용 응답 처리";
-        processFeederResponse(response);
-    } else if(responseQueryId == conveyorQueryId) {
-        //  컨베이어 전용 응답 처리 추가
-        qDebug() << "컨베이어 전용 응답 처리";
-        processConveyorResponse(response);
-    } else {
-        qDebug() << " 알 수 없는 쿼리 ID:" << responseQueryId;
-    }
-}
-
-void Home::processConveyorResponse(const QJsonObject &response)
-{
-    qDebug() << "컨베이어 응답 처리 시작";
-
-    QString status = response["status"].toString();
-    if (status != "success")
-    {
-        qDebug() << " 컨베이어 쿼리 실패:" << response["error"].toString();
-        return;
-    }
-
-    QJsonArray dataArray = response["data"].toArray();
-    QList<QJsonObject> conveyorResults;
-
-    // 컨베이어 로그만 필터링
-    for (const QJsonValue &value : dataArray)
-    {
-        QJsonObject logData = value.toObject();
-        if (logData["device_id"].toString() == "conveyor_01" && logData["log_level"].toString() == "error")
+    // query_id/마감/대체/늦은 응답 처리는 QueryEngine, 응답 정리는 워커(LogShape)에서
+    // 같은 tag로 진행 중인 이전 쿼리는 새 쿼리로 대체된다
+    QueryEngine::Request request;
+    request.queryType = "logs";
+    request.tag = tag;
+    request.supersedeKey = "home/" + tag;
+    request.filters = filters;
+    request.timeoutMs = timeoutMs;
+    request.prepare = [shape](const QString &queryId) {
+        ResponsePipeline::instance()->expectLogQuery(queryId, shape);
+    };
+
+    return QueryEngine::instance()->send(request, this, [onBatch](const QueryResult &result) {
+        if (result.outcome == QueryResult::TimedOut)
         {
-            conveyorResults.append(logData);
-            qDebug() << " 컨베이어 에러 로그 추가:" << logData["log_code"].toString();
+            // 시간 초과도 실패 응답처럼 처리 (로딩 상태 해제 등)
+            LogBatch batch;
+            batch.queryId = result.queryId;
+            batch.status = result.status;
+            batch.error = result.error;
+            batch.known = true;
+            onBatch(batch);
+            return;
         }
-    }
-
-    qDebug() << " 컨베이어 결과:" << conveyorResults.size() << "개";
-
-    //  ConveyorWindow로 결과 전달
-    if (conveyorWindow)
-    {
-        conveyorWindow->onSearchResultsReceived(conveyorResults);
-    }
-}
-
-QString Home::generateQueryId()
-{ // 고유한 id 만들어줌
-    return QUuid::createUuid().toString(QUuid::WithoutBraces);
+        qDebug() << "응답 쿼리 ID:" << result.queryId << "상태:" << result.status << "지연:" << result.latencyMs << "ms";
+        onBatch(result.value<LogBatch>());
+    });
 }
 
 void Home::requestPastLogs()
@@ -1397,30 +1287,23 @@ void Home::requestPastLogs()
         return;
     }
 
-    currentQueryId = generateQueryId();
-
-    QJsonObject queryRequest;
-    queryRequest["query_id"] = currentQueryId;
-    queryRequest["query_type"] = "logs";
-    queryRequest["client_id"] = m_client->clientId();
-
     QJsonObject filters;
     filters["log_level"] = "error";
 
     filters["limit"] = 100;    //  500개씩 나눠서 받기
     filters["offset"] = 0;     //  첫 페이지
 
+    LogShape pastShape;
+    pastShape.logLevel = "error";
+    pastShape.reversed = true;
 
-    queryRequest["filters"] = filters;
-
-    QJsonDocument doc(queryRequest);
-    QByteArray payload = doc.toJson(QJsonDocument::Compact);
-
-    qDebug() << "초기 로그 요청 (500개): " << payload;
-    m_client->publish(mqttQueryRequestTopic, payload);
+    qDebug() << "초기 로그 요청 (500개): " << filters;
+    sendLogQuery("past", filters, pastShape, [this](const LogBatch &batch) {
+        processPastLogsResponse(batch);
+    });
 }
 
-void Home::processPastLogsResponse(const QJsonObject &response)
+void Home::processPastLogsResponse(const LogBatch &response)
 {
     isLoadingMoreLogs = false;
 
@@ -1433,23 +1316,23 @@ void Home::processPastLogsResponse(const QJsonObject &response)
 
     qDebug() << "=== 로그 응답 수신 ===";
 
-    QString status = response["status"].toString();
-    if (status != "success")
+    if (!response.isSuccess())
     {
-        QString errorMsg = response["error"].toString();
+        QString errorMsg = response.error;
         qDebug() << " 쿼리 실패:" << errorMsg;
         QMessageBox::warning(this, "조회 실패", "로그 조회에 실패했습니다: " + errorMsg);
         return;
     }
 
-    QJsonArray dataArray = response["data"].toArray();
+    // 에러 로그만, 화면에 쌓는 순서(역순)로 워커에서 정리된 상태
+    const QList<QJsonObject> &rows = response.rows;
     bool isFirstPage = (currentPage == 0);
 
     // 날짜 검색인지 확인
     bool isDateSearch = (lastSearchStartDate.isValid() && lastSearchEndDate.isValid());
 
     qDebug() << " 로그 응답 상세:";
-    qDebug() << "  - 받은 로그 수:" << dataArray.size();
+    qDebug() << "  - 받은 로그 수:" << response.receivedRows;
     qDebug() << "  - 첫 페이지:" << isFirstPage;
     qDebug() << "  - 날짜 검색:" << isDateSearch;
 
@@ -1460,19 +1343,14 @@ void Home::processPastLogsResponse(const QJsonObject &response)
         qDebug() << "📅 날짜 검색 모드 - 기존 로그 무시하고 서버 결과만 표시";
         // UI는 이미 clearAllErrorLogsFromUI()로 클리어된 상태
         // 서버 결과만 추가
-        for(int i = dataArray.size() - 1; i >= 0; --i){
-            QJsonObject logData = dataArray[i].toObject();
-            if (logData["log_level"].toString() != "error") continue;
-
-            // 날짜 검색 모드에서는 히스토리에 추가하지 않고 UI에만 표시
-            addErrorLogUI(logData);  // UI에만 표시
-            displayedLogCount++;    // 카운터 증가
-        }
+        // 날짜 검색 모드에서는 히스토리에 추가하지 않고 UI에만 표시 (합치지 않고 한 번에)
+        if (errorLogView) errorLogView->logModel()->prependLogs(rows);
+        displayedLogCount = static_cast<int>(rows.size());
     } else {
         // 실시간 모드에서는 기존 방식 유지
-        for(int i = dataArray.size() - 1; i >= 0; --i){
-            QJsonObject logData = dataArray[i].toObject();
-            if (logData["log_level"].toString() != "error") continue;
+        for(const QJsonObject &logData : rows){
+            if (!rememberLogKey(logData)) continue;  // 실시간으로 이미 받은 로그
+            noteLogTimestamp(logData.value("timestamp").toVariant().toLongLong());
             addErrorLog(logData);    // 히스토리에 추가
             addErrorLogUI(logData);  // UI에 표시
             displayedLogCount++;    // 🔥 카운터 증가
@@ -1489,6 +1367,118 @@ void Home::processPastLogsResponse(const QJsonObject &response)
     qDebug() << " 더보기 버튼 없음 - 현재 결과만 표시";
 }
 
+namespace {
+const int kReceivedLogKeyLimit = 5000;
+const int kBackfillPageSize = 500;
+const int kBackfillMaxPages = 4;            // 한 번의 재연결에 최대 2000건
+const qint64 kBackfillOverlapMs = 5000;     // 기기 간 시계 차이 여유 (겹치는 건 중복 제거로 걸러짐)
+}
+
+bool Home::rememberLogKey(const QJsonObject &logData)
+{
+    const qint64 timestamp = logData.value("timestamp").toVariant().toLongLong();
+    if (timestamp <= 0) return true;    // 시각 없는 로그는 구분할 수 없으니 그대로 표시
+
+    const QString key = logData.value("device_id").toString() + '|' + QString::number(timestamp)
+                        + '|' + logData.value("log_code").toString();
+    if (receivedLogIds.contains(key)) return false;
+
+    receivedLogIds.insert(key);
+    receivedLogOrder.append(key);
+    while (receivedLogOrder.size() > kReceivedLogKeyLimit) {
+        receivedLogIds.remove(receivedLogOrder.takeFirst());
+    }
+    return true;
+}
+
+void Home::noteLogTimestamp(qint64 timestamp)
+{
+    if (timestamp > lastTimestamp) lastTimestamp = timestamp;
+}
+
+void Home::requestReconnectBackfill()
+{
+    if (!m_client || m_client->state() != QMqttClient::Connected) return;
+
+    if (lastTimestamp <= 0) {
+        // 아직 받은 로그가 없음 → 초기 조회로 충분
+        requestPastLogs();
+        return;
+    }
+
+    backfillRows.clear();
+    const qint64 since = lastTimestamp - kBackfillOverlapMs;
+    const qint64 until = QDateTime::currentMSecsSinceEpoch();
+    qDebug() << "[백필] 끊긴 구간 오류 로그 요청:" << QDateTime::fromMSecsSinceEpoch(since).toString("hh:mm:ss")
+             << "~" << QDateTime::fromMSecsSinceEpoch(until).toString("hh:mm:ss");
+    requestBackfillPage(since, until, 0);
+}
+
+void Home::requestBackfillPage(qint64 sinceMs, qint64 untilMs, int page)
+{
+    // 구간을 고정하고 offset으로 넘기므로 서버 정렬 방향과 관계없이 빠짐없이 받는다
+    QJsonObject timeRange;
+    timeRange["start"] = sinceMs;
+    timeRange["end"] = untilMs;
+
+    QJsonObject filters;
+    filters["log_level"] = "error";
+    filters["time_range"] = timeRange;
+    filters["limit"] = kBackfillPageSize;
+    filters["offset"] = page * kBackfillPageSize;
+
+    LogShape shape;
+    shape.logLevel = "error";
+    shape.startMs = sinceMs;
+    shape.endMs = untilMs;
+
+    sendLogQuery("backfill", filters, shape, [this, sinceMs, untilMs, page](const LogBatch &batch) {
+        if (!batch.isSuccess()) {
+            qDebug() << "[백필] 실패:" << batch.status << batch.error << "- 받은 것까지만 반영";
+            applyBackfill();
+            return;
+        }
+
+        backfillRows.append(batch.rows);
+        if (batch.receivedRows < kBackfillPageSize) {
+            applyBackfill();
+        } else if (page + 1 >= kBackfillMaxPages) {
+            qDebug() << "[백필] 상한" << kBackfillMaxPages * kBackfillPageSize << "건 도달 - 나머지는 검색으로 확인";
+            applyBackfill();
+        } else {
+            requestBackfillPage(sinceMs, untilMs, page + 1);
+        }
+    });
+}
+
+void Home::applyBackfill()
+{
+    QList<QJsonObject> rows = std::move(backfillRows);
+    backfillRows.clear();
+
+    // 오래된 것부터 올려야 화면 맨 위가 최신
+    std::stable_sort(rows.begin(), rows.end(), [](const QJsonObject &a, const QJsonObject &b) {
+        return a.value("timestamp").toVariant().toLongLong() < b.value("timestamp").toVariant().toLongLong();
+    });
+
+    int applied = 0;
+    for (const QJsonObject &logData : std::as_const(rows)) {
+        if (!rememberLogKey(logData)) continue;
+        noteLogTimestamp(logData.value("timestamp").toVariant().toLongLong());
+        lastLogCodeFor(logData.value("device_id").toString()) = logData.value("log_code").toString();
+
+        if (isDateSearchMode) {
+            addErrorLog(logData);       // 검색 결과 화면은 건드리지 않고 히스토리에만
+        } else {
+            onErrorLogGenerated(logData);
+        }
+        m_errorChartManager->processErrorData(logData);
+        emit newErrorLogBroadcast(logData);
+        applied++;
+    }
+    qDebug() << "[백필] 받은" << rows.size() << "건 중" << applied << "건 반영 (나머지는 이미 표시됨)";
+}
+
 void Home::updateLoadMoreButton(bool showButton)
 {
     //  더보기 버튼 완전 제거 - 사용자 요구사항
@@ -1524,92 +1514,53 @@ void Home::requestFeederLogs(const QString &errorCode, const QDate &startDate, c
         return;
     }
 
-    //  피더 전용 쿼리 ID 생성
-    QString feederQueryId = generateQueryId();
-    qDebug() << " 피더 쿼리 ID:" << feederQueryId;
-
-    //  피더 쿼리 ID와 대상 윈도우 매핑 저장
-    feederQueryMap[feederQueryId] = targetWindow;
+    //  날짜 검색은 로컬 우선 계획기로 (피더 창은 feeder_01 로그만 보여주므로 그 범위로 받음)
+    if (startDate.isValid() && endDate.isValid())
+    {
+        LogSearchRequest request;
+        request.owner = "feeder";
+        request.deviceId = "feeder_01";
+        request.logCode = errorCode;
+        startDateSearch(request, startDate, endDate, targetWindow);
+        return;
+    }
 
-    //  서버가 기대하는 JSON 구조로 생성
-    QJsonObject queryRequest;
-    queryRequest["query_id"] = feederQueryId;
-    queryRequest["query_type"] = "logs";
-    queryRequest["client_id"] = m_client->clientId();
+    //  응답 필터 조건 (워커에서 적용)
+    LogShape searchShape;
+    searchShape.deviceId = "feeder_01";
+    searchShape.logLevel = "error";
 
+    //  서버가 기대하는 filters 구조로 생성 (query_id 등은 QueryEngine이 채움)
     QJsonObject filters;
 
     //  에러 코드 필터 (피더만)
     if (!errorCode.isEmpty())
     {
         filters["log_code"] = errorCode;
-        //filters["device_id"] = "feeder_02";
         qDebug() << " 에러 코드 필터:" << errorCode;
     }
 
     //  디바이스 필터 (피더만)
-    filters["device_id"] = "feeder_02";
-    qDebug() << " 디바이스 필터: feeder_02";
+    filters["device_id"] = searchShape.deviceId;
+    qDebug() << " 디바이스 필터:" << searchShape.deviceId;
 
-    //  날짜 필터 설정
-    if (startDate.isValid() && endDate.isValid())
-    {
-        qDebug() << " 날짜 검색 모드 활성화";
-
-        // 안전한 날짜 변환
-        QDateTime startDateTime;
-        startDateTime.setDate(startDate);
-        startDateTime.setTime(QTime(0, 0, 0, 0));
-        startDateTime.setTimeZone(QTimeZone::systemTimeZone());
-        qint64 startTimestamp = startDateTime.toMSecsSinceEpoch();
-
-        QDateTime endDateTime;
-        endDateTime.setDate(endDate);
-        endDateTime.setTime(QTime(23, 59, 59, 999));
-        endDateTime.setTimeZone(QTimeZone::systemTimeZone());
-        qint64 endTimestamp = endDateTime.toMSecsSinceEpoch();
-
-        //  서버가 기대하는 time_range 구조
-        QJsonObject timeRange;
-        timeRange["start"] = startTimestamp;
-        timeRange["end"] = endTimestamp;
-        filters["time_range"] = timeRange;
-
-        // 날짜 검색에서는 충분한 limit 설정
-        filters["limit"] = 100;
-
-        qDebug() << " time_range 필터 설정:";
-        qDebug() << "  - 시작:" << startDate.toString("MM-dd") << "→" << startTimestamp;
-        qDebug() << "  - 종료:" << endDate.toString("MM-dd") << "→" << endTimestamp;
-        qDebug() << "  - limit:" << 10000;
-    }
-    else
-    {
-        qDebug() << " 일반 최신 로그 모드";
-        filters["limit"] = 100;
-        filters["offset"] = 0;
-    }
+    //  최신 로그 (날짜 검색은 위에서 계획기로)
+    qDebug() << " 일반 최신 로그 모드";
+    filters["limit"] = 100;
+    filters["offset"] = 0;
 
     //  로그 레벨 필터
     filters["log_level"] = "error";
 
-    queryRequest["filters"] = filters;
-
-    // JSON 문서 생성 및 전송
-    QJsonDocument doc(queryRequest);
-    QByteArray payload = doc.toJson(QJsonDocument::Compact);
+    qDebug() << "=== 피더 쿼리 전송 ===";
+    qDebug() << "필터:" << filters;
 
-    qDebug() << "=== 피더 MQTT 전송 시도 ===";
-    qDebug() << "토픽:" << mqttQueryRequestTopic;
-    qDebug() << "페이로드 크기:" << payload.size() << "bytes";
-    qDebug() << "전송할 JSON:";
-    qDebug() << doc.toJson(QJsonDocument::Indented);
-
-    //  MQTT 전송
-    bool result = m_client->publish(mqttQueryRequestTopic, payload);
-    qDebug() << "MQTT 전송 결과:" << (result ? " 성공" : "️ 비동기 (정상)");
-
-    qDebug() << " 피더 MQTT 전송 완료! 응답 대기 중...";
+    //  전송 (응답은 대상 윈도우가 살아있을 때만 전달)
+    QPointer<MainWindow> window(targetWindow);
+    QueryHandle handle = sendLogQuery("feeder-search", filters, searchShape, [this, window](const LogBatch &batch) {
+        processFeederSearchResponse(batch, window);
+    });
+    qDebug() << " 피더 쿼리 ID:" << handle.id() << "- 응답 대기 중...";
 }
 
 //  requestFilteredLogs 함수 완전 수정 - 서버 JSON 구조에 맞춤
@@ -1662,6 +1613,7 @@ void Home::requestFilteredLogs(const QString &errorCode, const QDate &startDate,
             clearAllErrorLogsFromUI();
         }
         qDebug() << "=== 모드 설정 완료 - isDateSearchMode:" << isDateSearchMode << "===";
+        if (m_logPager) m_logPager->setEnabled(!isDateSearchMode && errorCode.isEmpty());
 
         qDebug() << "🔧 새 검색 - 조건 저장됨:";
         qDebug() << "  - errorCode:" << lastSearchErrorCode;
@@ -1673,6 +1625,30 @@ void Home::requestFilteredLogs(const QString &errorCode, const QDate &startDate,
         qDebug() << "🔧 더보기 - 저장된 조건 사용 (페이지:" << currentPage << ")";
     }
 
+    //  피더 창에서 온 검색이면 결과는 그 창으로, 아니면 홈 목록으로
+    QPointer<MainWindow> targetFeederWindow(currentFeederWindow);
+
+    // 날짜 검색은 로컬 우선 계획기로 - 진행 중인 같은 창의 검색은 새 검색이 대체
+    const QDate searchStartDate = loadMore ? lastSearchStartDate : startDate;
+    const QDate searchEndDate = loadMore ? lastSearchEndDate : endDate;
+    if(searchStartDate.isValid() && searchEndDate.isValid()) {
+        const QString searchCode = loadMore ? lastSearchErrorCode : errorCode;
+        LogSearchRequest request;
+        if(searchCode == "feeder_01" || searchCode == "conveyor_01") {
+            request.deviceId = searchCode;
+        } else {
+            request.logCode = searchCode;
+        }
+        if(targetFeederWindow) {
+            request.owner = "feeder";
+            request.deviceId = "feeder_01";    // 피더 창은 feeder_01 로그만 보여줌
+        } else {
+            request.owner = "home";
+        }
+        startDateSearch(request, searchStartDate, searchEndDate, targetFeederWindow);
+        return;
+    }
+
     // 로딩 상태 방지
     if(isLoadingMoreLogs) {
         qDebug() << "⚠️ 이미 로딩 중입니다!";
@@ -1680,36 +1656,27 @@ void Home::requestFilteredLogs(const QString &errorCode, const QDate &startDate,
     }
     isLoadingMoreLogs = true;
 
-    // 쿼리 ID 생성
-    currentQueryId = generateQueryId();
     qDebug() << "🔧 쿼리 정보:";
-    qDebug() << "  - 쿼리 ID:" << currentQueryId;
     qDebug() << "  - 페이지:" << currentPage;
     qDebug() << "  - 페이지 크기:" << pageSize;
 
-    //  핵심 수정: feederQueryMap에 저장
-    if(currentFeederWindow) {
-        feederQueryMap[currentQueryId] = currentFeederWindow;
-        qDebug() << "🎯 핵심 수정: feederQueryMap에 저장됨!";
-        qDebug() << "  - 쿼리 ID:" << currentQueryId;
-        qDebug() << "  - MainWindow 포인터:" << currentFeederWindow;
-    } else {
-        qDebug() << " currentFeederWindow가 null입니다!";
+    if(!targetFeederWindow) {
+        qDebug() << " currentFeederWindow가 null입니다! - 홈 목록에 표시";
     }
-    //  핵심 수정 끝
 
-    //  서버가 기대하는 JSON 구조로 변경
-    QJsonObject queryRequest;
-    queryRequest["query_id"] = currentQueryId;
-    queryRequest["query_type"] = "logs";
-    queryRequest["client_id"] = m_client->clientId();
+    //  응답 필터 조건 (워커에서 적용) - 결과 전달 대상과 같은 기준
+    LogShape searchShape;
+    searchShape.logLevel = "error";
+    if(targetFeederWindow) {
+        searchShape.deviceId = "feeder_01";    // processFeederSearchResponse로 감
+    } else {
+        searchShape.reversed = true;           // processPastLogsResponse: 목록 위로 쌓는 순서
+    }
 
     QJsonObject filters;
 
     // 더보기일 때 저장된 조건 사용
     QString useErrorCode = loadMore ? lastSearchErrorCode : errorCode;
-    QDate useStartDate = loadMore ? lastSearchStartDate : startDate;
-    QDate useEndDate = loadMore ? lastSearchEndDate : endDate;
 
     // 에러 코드 필터
     // if(!useErrorCode.isEmpty()) {
@@ -1727,74 +1694,33 @@ void Home::requestFilteredLogs(const QString &errorCode, const QDate &startDate,
         }
     }
 
-    //  핵심: time_range 객체 사용 (서버가 기대하는 구조)
-    if(useStartDate.isValid() && useEndDate.isValid()) {
-        qDebug() << "🔧 날짜 검색 모드 - 모든 데이터 한번에 가져오기";
-
-        // 안전한 날짜 변환
-        QDateTime startDateTime;
-        startDateTime.setDate(useStartDate);
-        startDateTime.setTime(QTime(0, 0, 0, 0));
-        startDateTime.setTimeZone(QTimeZone::systemTimeZone());
-        qint64 startTimestamp = startDateTime.toMSecsSinceEpoch();
-
-        QDateTime endDateTime;
-        endDateTime.setDate(useEndDate);
-        endDateTime.setTime(QTime(23, 59, 59, 999));
-        endDateTime.setTimeZone(QTimeZone::systemTimeZone());
-        qint64 endTimestamp = endDateTime.toMSecsSinceEpoch();
-
-        //  서버가 기대하는 time_range 구조
-        QJsonObject timeRange;
-        timeRange["start"] = startTimestamp;
-        timeRange["end"] = endTimestamp;
-        filters["time_range"] = timeRange;
-
-        qDebug() << "🔧 시간 범위 설정:";
-        qDebug() << "  - start timestamp:" << startTimestamp;
-        qDebug() << "  - end timestamp:" << endTimestamp;
-        qDebug() << "  - start 날짜:" << startDateTime.toString("yyyy-MM-dd hh:mm:ss");
-        qDebug() << "  - end 날짜:" << endDateTime.toString("yyyy-MM-dd hh:mm:ss");
-
-        // 날짜 검색에서는 한번에 많이 가져오기
-        filters["limit"] = 100; //2000
-        filters["offset"] = 0;
-        filters["log_level"] = "error";
-
-    } else {
-        qDebug() << "🔧 실시간/일반 검색 모드";
-        filters["limit"] = pageSize;
-        filters["offset"] = currentPage * pageSize;
-        filters["log_level"] = "error";
-    }
-
-    queryRequest["filters"] = filters;
-
-    QJsonDocument doc(queryRequest);
-    QByteArray payload = doc.toJson(QJsonDocument::Compact);
+    // 최신 로그 페이지 (날짜 검색은 위에서 계획기로)
+    qDebug() << "🔧 실시간/일반 검색 모드";
+    filters["limit"] = pageSize;
+    filters["offset"] = currentPage * pageSize;
+    filters["log_level"] = "error";
 
     qDebug() << "🔧 MQTT 쿼리 요청:";
-    qDebug() << "  - 토픽:" << mqttQueryRequestTopic;
-    qDebug() << "  - 페이로드:" << payload;
+    qDebug() << "  - 필터:" << filters;
 
-    // 타임아웃 타이머 설정
-    QTimer::singleShot(30000, this, [this]() {
-        if(isLoadingMoreLogs) {
+    //  전송 (30초 마감 - 시간 초과도 콜백으로 옴)
+    const bool toFeederWindow = !targetFeederWindow.isNull();
+    QueryHandle handle = sendLogQuery(toFeederWindow ? "feeder-search" : "search", filters, searchShape,
+                                      [this, targetFeederWindow, toFeederWindow](const LogBatch &batch) {
+        if(batch.status == "timeout") {
             isLoadingMoreLogs = false;
             qDebug() << "⏰ 로그 요청 타임아웃";
             QMessageBox::warning(this, "타임아웃", "로그 요청 시간이 초과되었습니다.");
+            return;
         }
-    });
-
-    //  MQTT 전송
-    qDebug() << "📡 MQTT publish 시도...";
-    qDebug() << "  - 클라이언트 ID:" << m_client->clientId();
-    qDebug() << "  - 호스트:" << m_client->hostname() << ":" << m_client->port();
-
-    bool result = m_client->publish(mqttQueryRequestTopic, payload);
-    qDebug() << "MQTT 전송 결과:" << (result ? " 성공" : "⚠️ 비동기 (정상)");
+        if(toFeederWindow) {
+            processFeederSearchResponse(batch, targetFeederWindow);
+        } else {
+            processPastLogsResponse(batch);
+        }
+    }, 30000);
 
-    qDebug() << "🔧 MQTT 전송 완료! 응답 대기 중...";
+    qDebug() << "🔧 쿼리 전송 완료! 응답 대기 중... (쿼리 ID:" << handle.id() << ")";
 }
 
 void Home::onSearchClicked() {
@@ -1844,72 +1770,22 @@ void Home::onSearchClicked() {
     requestFilteredLogs(searchText, startDate, endDate, false);
 }
 
-void Home::processFeederResponse(const QJsonObject &response)
-{
-    qDebug() << " 피더 응답 처리 시작";
-
-    QString status = response["status"].toString();
-    if (status != "success")
-    {
-        qDebug() << " 피더 쿼리 실패:" << response["error"].toString();
-        return;
-    }
-
-    QJsonArray dataArray = response["data"].toArray();
-    QList<QJsonObject> feederResults;
-
-    // 피더 로그만 필터링
-    for (const QJsonValue &value : dataArray)
-    {
-        QJsonObject logData = value.toObject();
-        if (logData["device_id"].toString() == "feeder_02" && logData["log_level"].toString() == "error")
-        {
-            feederResults.append(logData);
-            qDebug() << " 에러 로그 추가:" << logData["log_code"].toString();
-        }
-
-        qDebug() << " 피더 결과:" << feederResults.size() << "개";
-
-        //  MainWindow로 결과 전달 (기존 함수 재사용)
-        if (feederWindow)
-        {
-            feederWindow->onSearchResultsReceived(feederResults);
-        }
-    }
-}
-
-void Home::processFeederSearchResponse(const QJsonObject &response, MainWindow *targetWindow)
+void Home::processFeederSearchResponse(const LogBatch &response, MainWindow *targetWindow)
 {
     qDebug() << " 피더 검색 응답 처리 시작";
 
-    QString status = response["status"].toString();
-    if (status != "success")
+    if (!response.isSuccess())
     {
-        QString errorMsg = response["error"].toString();
+        QString errorMsg = response.error;
         qDebug() << " 피더 쿼리 실패:" << errorMsg;
         QMessageBox::warning(this, "조회 실패", "피더 로그 조회에 실패했습니다: " + errorMsg);
         return;
     }
 
-    QJsonArray dataArray = response["data"].toArray();
-    qDebug() << " 피더 로그 수신:" << dataArray.size() << "개";
-
-    //  QJsonObject 리스트로 변환
-    QList<QJsonObject> feederLogs;
-
-    for (const QJsonValue &value : dataArray)
-    {
-        QJsonObject logData = value.toObject();
+    qDebug() << " 피더 로그 수신:" << response.receivedRows << "개";
 
-        //  피더 로그만 필터링 (서버에서 필터링되지만 클라이언트에서도 확인)
-        QString deviceId = logData["device_id"].toString();
-        if (deviceId == "feeder_01" &&
-            logData["log_level"].toString() == "error")
-        {
-            feederLogs.append(logData);
-            qDebug() << " 에러 로그 추가:" << logData["log_code"].toString();
-        }
-    }
+    //  피더 에러 로그만 남기는 필터링/변환은 워커에서 끝난 상태
+    const QList<QJsonObject> &feederLogs = response.rows;
 
     qDebug() << " 최종 피더 로그:" << feederLogs.size() << "개";
 
@@ -1930,38 +1806,22 @@ void Home::processFeederSearchResponse(const QJsonObject &response, MainWindow *
     qDebug() << "🔧 피더 응답 처리 완료";
 }
 
-void Home::processConveyorSearchResponse(const QJsonObject &response, ConveyorWindow *targetWindow)
+void Home::processConveyorSearchResponse(const LogBatch &response, ConveyorWindow *targetWindow)
 {
     qDebug() << " 컨베이어 검색 응답 처리 시작";
 
-    QString status = response["status"].toString();
-    if (status != "success")
+    if (!response.isSuccess())
     {
-        QString errorMsg = response["error"].toString();
+        QString errorMsg = response.error;
         qDebug() << " 컨베이어 쿼리 실패:" << errorMsg;
         QMessageBox::warning(this, "조회 실패", "컨베이어 로그 조회에 실패했습니다: " + errorMsg);
         return;
     }
 
-    QJsonArray dataArray = response["data"].toArray();
-    qDebug() << " 컨베이어 로그 수신:" << dataArray.size() << "개";
-
-    //  QJsonObject 리스트로 변환
-    QList<QJsonObject> conveyorLogs;
-
-    for (const QJsonValue &value : dataArray)
-    {
-        QJsonObject logData = value.toObject();
+    qDebug() << " 컨베이어 로그 수신:" << response.receivedRows << "개";
 
-        //  컨베이어 로그만 필터링 (서버에서 필터링되지만 클라이언트에서도 확인)
-        QString deviceId = logData["device_id"].toString();
-        if (deviceId == "conveyor_01" &&
-            logData["log_level"].toString() == "error")
-        {
-            conveyorLogs.append(logData);
-            qDebug() << " 컨베이어 에러 로그 추가:" << logData["log_code"].toString();
-        }
-    }
+    //  컨베이어 에러 로그만 남기는 필터링/변환은 워커에서 끝난 상태
+    const QList<QJsonObject> &conveyorLogs = response.rows;
 
     qDebug() << " 최종 컨베이어 로그:" << conveyorLogs.size() << "개";
 
@@ -2000,13 +1860,6 @@ void Home::loadChartDataSingle()
         return;
     }
 
-    chartQueryId = generateQueryId();
-
-    QJsonObject queryRequest;
-    queryRequest["query_id"] = chartQueryId;
-    queryRequest["query_type"] = "logs";
-    queryRequest["client_id"] = m_client->clientId();
-
     QJsonObject filters;
     filters["log_level"] = "error";
 
@@ -2025,34 +1878,33 @@ void Home::loadChartDataSingle()
     filters["limit"] = 2000; // 충분히 큰 값
     filters["offset"] = 0;
 
-    queryRequest["filters"] = filters;
-
-    QJsonDocument doc(queryRequest);
-    QByteArray payload = doc.toJson(QJsonDocument::Compact);
-
     qDebug() << "[CHART] 1-6월 전체 데이터 단일 요청";
     qDebug() << "[CHART] time_range:" << startDateTime.toString("yyyy-MM-dd") << "~" << endDateTime.toString("yyyy-MM-dd");
     qDebug() << "[CHART] limit: 2000";
 
-    m_client->publish(mqttQueryRequestTopic, payload);
+    // 차트는 레코드 그대로 받아서 일괄 집계 (2000행이라 마감을 넉넉히)
+    LogShape chartShape;
+    chartShape.asRecords = true;
+    sendLogQuery("chart", filters, chartShape, [this](const LogBatch &batch) {
+        processChartDataResponse(batch);
+    }, 30000);
 }
 
-void Home::processChartDataResponse(const QJsonObject &response)
+void Home::processChartDataResponse(const LogBatch &response)
 {
     qDebug() << "[HOME] ===== 차트용 데이터 응답 수신 =====";
-    qDebug() << "[HOME] 응답 상태:" << response["status"].toString();
+    qDebug() << "[HOME] 응답 상태:" << response.status;
 
-    QString status = response["status"].toString();
-    if (status != "success")
+    if (!response.isSuccess())
     {
-        qDebug() << "[HOME] 차트 데이터 쿼리 실패:" << response["error"].toString();
-        qDebug() << "[HOME] 전체 응답:" << response;
+        qDebug() << "[HOME] 차트 데이터 쿼리 실패:" << response.error;
         isLoadingChartData = false;
         return;
     }
 
-    QJsonArray dataArray = response["data"].toArray();
-    int totalDataCount = dataArray.size();
+    // 타임스탬프 보정까지 워커에서 끝난 레코드
+    const QVector<LogRecord> &rows = response.records;
+    int totalDataCount = rows.size();
 
     qDebug() << "[HOME] 차트 배치 처리: " << totalDataCount << "개";
 
@@ -2066,73 +1918,36 @@ void Home::processChartDataResponse(const QJsonObject &response)
 
     // 샘플 데이터 확인
     qDebug() << "[HOME] 첫 번째 데이터 샘플:";
+    qDebug() << "  device_id:" << rows[0].deviceId;
+    qDebug() << "  timestamp:" << rows[0].timestamp;
+    qDebug() << "  log_level:" << rows[0].logLevel;
+    qDebug() << "  log_code:" << rows[0].logCode;
 
-    if (totalDataCount > 0)
-    {
-        QJsonObject firstData = dataArray[0].toObject();
-        qDebug() << "  device_id:" << firstData["device_id"].toString();
-        qDebug() << "  timestamp:" << firstData["timestamp"];
-        qDebug() << "  log_level:" << firstData["log_level"].toString();
-        qDebug() << "  log_code:" << firstData["log_code"].toString();
-    }
-
-    int processedCount = 0;
     int validDateCount = 0;
     int feederCount = 0;
     int conveyorCount = 0;
     int errorLevelCount = 0;
 
-    for (const QJsonValue &value : dataArray)
+    for (const LogRecord &record : rows)
     {
-        QJsonObject logData = value.toObject();
-
         // 로그 레벨 체크
-        if (logData["log_level"].toString() == "error")
+        if (record.logLevel == "error")
         {
             errorLevelCount++;
         }
 
         // 디바이스 타입 체크
-        QString deviceId = logData["device_id"].toString();
-        if (deviceId.contains("feeder"))
+        if (record.deviceId.contains("feeder"))
         {
             feederCount++;
         }
-        else if (deviceId.contains("conveyor"))
+        else if (record.deviceId.contains("conveyor"))
         {
             conveyorCount++;
         }
 
-        // 타임스탬프 처리
-        qint64 timestamp = 0;
-        QJsonValue timestampValue = logData["timestamp"];
-        if (timestampValue.isDouble())
-        {
-            timestamp = static_cast<qint64>(timestampValue.toDouble());
-        }
-        else if (timestampValue.isString())
-        {
-            bool ok;
-            timestamp = timestampValue.toString().toLongLong(&ok);
-            if (!ok)
-                timestamp = QDateTime::currentMSecsSinceEpoch();
-        }
-        else
-        {
-            timestamp = timestampValue.toVariant().toLongLong();
-        }
-
-        if (timestamp == 0)
-        {
-            timestamp = QDateTime::currentMSecsSinceEpoch();
-        }
-
-        // 날짜 확인
-        QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(timestamp);
-        QString dateStr = dateTime.toString("yyyy-MM-dd");
-
         // 1-6월 범위인지 확인
-        QDate targetDate = dateTime.date();
+        QDate targetDate = QDateTime::fromMSecsSinceEpoch(record.timestamp).date();
         QDate startRange(targetDate.year(), 1, 1);
         QDate endRange(targetDate.year(), 6, 30);
 
@@ -2141,19 +1956,21 @@ void Home::processChartDataResponse(const QJsonObject &response)
             validDateCount++;
             if (validDateCount <= 5)
             {
-                qDebug() << "[HOME] 유효한 날짜 데이터" << validDateCount << ":" << dateStr;
+                qDebug() << "[HOME] 유효한 날짜 데이터" << validDateCount << ":" << targetDate.toString("yyyy-MM-dd");
             }
         }
+    }
 
-        QJsonObject completeLogData = logData;
-        completeLogData["timestamp"] = timestamp;
+    // 로컬 이력에 남겨서 다음 실행부터는 전체 조회 생략 (이미 있는 로그는 건너뜀)
+    LocalHistory::instance()->recordLogs(rows);
+    LocalHistory::instance()->markChartSynced();
 
-        // 차트에 전달
-        if (m_errorChartManager)
-        {
-            m_errorChartManager->processErrorData(completeLogData);
-            processedCount++;
-        }
+    // 차트에 일괄 전달 (막대 갱신은 한 번만)
+    int processedCount = 0;
+    if (m_errorChartManager)
+    {
+        m_errorChartManager->processErrorRecords(rows);
+        processedCount = rows.size();
     }
 
     qDebug() << "[HOME] ===== 차트 데이터 처리 완료 =====";
@@ -2164,6 +1981,11 @@ void Home::processChartDataResponse(const QJsonObject &response)
     qDebug() << "[HOME] 피더 데이터:" << feederCount << "개";
     qDebug() << "[HOME] 컨베이어 데이터:" << conveyorCount << "개";
 
+    const QueryResponseDecoder::Stats decodeStats = QueryResponseDecoder::stats();
+    qDebug() << "[HOME] 응답 디코더 누적:" << decodeStats.responses << "건"
+             << decodeStats.rows << "행, 최대" << (decodeStats.maxNs / 1000) << "us, 폴백" << decodeStats.fallbacks
+             << ", 건너뜀" << decodeStats.skipped;
+
     // 차트 데이터 로딩 완료
     isLoadingChartData = false;
     qDebug() << "[HOME] 차트 데이터 로딩 완료!";
@@ -2188,19 +2010,23 @@ void Home::handleConveyorLogSearch(const QString &errorCode, const QDate &startD
         return;
     }
 
-    //  컨베이어 전용 쿼리 ID 생성
-    QString conveyorQueryId = generateQueryId();
-    qDebug() << " 컨베이어 쿼리 ID:" << conveyorQueryId;
-
-    //  컨베이어 쿼리 ID와 대상 윈도우 매핑 저장
-    conveyorQueryMap[conveyorQueryId] = currentConveyorWindow;
+    //  날짜 검색은 로컬 우선 계획기로
+    if (startDate.isValid() && endDate.isValid())
+    {
+        LogSearchRequest request;
+        request.owner = "conveyor";
+        request.deviceId = "conveyor_01";
+        request.logCode = errorCode;
+        startDateSearch(request, startDate, endDate, currentConveyorWindow);
+        return;
+    }
 
-    //  서버가 기대하는 JSON 구조로 생성
-    QJsonObject queryRequest;
-    queryRequest["query_id"] = conveyorQueryId;
-    queryRequest["query_type"] = "logs";
-    queryRequest["client_id"] = m_client->clientId();
+    //  응답 필터 조건 (워커에서 적용)
+    LogShape searchShape;
+    searchShape.deviceId = "conveyor_01";
+    searchShape.logLevel = "error";
 
+    //  서버가 기대하는 filters 구조로 생성 (query_id 등은 QueryEngine이 채움)
     QJsonObject filters;
 
     //  에러 코드 필터 (컨베이어만)
@@ -2214,65 +2040,85 @@ void Home::handleConveyorLogSearch(const QString &errorCode, const QDate &startD
     filters["device_id"] = "conveyor_01";
     qDebug() << " 디바이스 필터: conveyor_01";
 
-    //  날짜 필터 설정
-    if (startDate.isValid() && endDate.isValid())
-    {
-        qDebug() << " 날짜 검색 모드 활성화";
-
-        // 안전한 날짜 변환
-        QDateTime startDateTime;
-        startDateTime.setDate(startDate);
-        startDateTime.setTime(QTime(0, 0, 0, 0));
-        startDateTime.setTimeZone(QTimeZone::systemTimeZone());
-        qint64 startTimestamp = startDateTime.toMSecsSinceEpoch();
-
-        QDateTime endDateTime;
-        endDateTime.setDate(endDate);
-        endDateTime.setTime(QTime(23, 59, 59, 999));
-        endDateTime.setTimeZone(QTimeZone::systemTimeZone());
-        qint64 endTimestamp = endDateTime.toMSecsSinceEpoch();
-
-        //  서버가 기대하는 time_range 구조
-        QJsonObject timeRange;
-        timeRange["start"] = startTimestamp;
-        timeRange["end"] = endTimestamp;
-        filters["time_range"] = timeRange;
-
-        // 날짜 검색에서는 충분한 limit 설정
-        filters["limit"] = 10000;
-
-        qDebug() << " 컨베이어 time_range 필터 설정:";
-        qDebug() << "  - 시작:" << startDate.toString("yyyy-MM-dd") << "→" << startTimestamp;
-        qDebug() << "  - 종료:" << endDate.toString("yyyy-MM-dd") << "→" << endTimestamp;
-        qDebug() << "  - limit:" << 10000;
-    }
-    else
-    {
-        qDebug() << " 일반 최신 로그 모드";
-        filters["limit"] = 2000;
-        filters["offset"] = 0;
-    }
+    //  최신 로그 (날짜 검색은 위에서 계획기로)
+    qDebug() << " 일반 최신 로그 모드";
+    filters["limit"] = 2000;
+    filters["offset"] = 0;
 
     //  로그 레벨 필터
     filters["log_level"] = "error";
 
-    queryRequest["filters"] = filters;
+    qDebug() << "=== 컨베이어 쿼리 전송 ===";
+    qDebug() << "필터:" << filters;
 
-    // JSON 문서 생성 및 전송
-    QJsonDocument doc(queryRequest);
-    QByteArray payload = doc.toJson(QJsonDocument::Compact);
+    //  전송 (응답은 대상 윈도우가 살아있을 때만 전달)
+    QPointer<ConveyorWindow> window(currentConveyorWindow);
+    QueryHandle handle = sendLogQuery("conveyor-search", filters, searchShape, [this, window](const LogBatch &batch) {
+        processConveyorSearchResponse(batch, window);
+    });
+    qDebug() << " 컨베이어 쿼리 ID:" << handle.id() << "- 응답 대기 중...";
+}
 
-    qDebug() << "=== 컨베이어 MQTT 전송 시도 ===";
-    qDebug() << "토픽:" << mqttQueryRequestTopic;
-    qDebug() << "페이로드 크기:" << payload.size() << "bytes";
-    qDebug() << "전송할 JSON:";
-    qDebug() << doc.toJson(QJsonDocument::Indented);
+void Home::startDateSearch(LogSearchRequest request, const QDate &startDate, const QDate &endDate, QObject *targetWindow)
+{
+    request.startMs = QDateTime(startDate, QTime(0, 0, 0, 0), QTimeZone::systemTimeZone()).toMSecsSinceEpoch();
+    request.endMs = QDateTime(endDate, QTime(23, 59, 59, 999), QTimeZone::systemTimeZone()).toMSecsSinceEpoch();
+
+    // 결과 대상 (창이 먼저 닫히면 그 뒤 결과는 버림)
+    QPointer<QObject> window(targetWindow);
+    const bool toWindow = (targetWindow != nullptr);
+    LogQueryPlanner::instance()->search(request, this, [this, window, toWindow](const LogSearchUpdate &update) {
+        if (toWindow) {
+            deliverDateSearchUpdate(window, update);
+        } else {
+            showDateSearchUpdate(update);
+        }
+    });
+}
 
-    //  MQTT 전송
-    bool result = m_client->publish(mqttQueryRequestTopic, payload);
-    qDebug() << "MQTT 전송 결과:" << (result ? " 성공" : "️ 비동기 (정상)");
+void Home::showDateSearchUpdate(const LogSearchUpdate &update)
+{
+    if (!errorLogView) return;
+
+    ErrorLogModel *model = errorLogView->logModel();
+    if (update.reset) {
+        // 로컬에 있던 결과 전체 (최신순) → 목록 맨 위가 최신이 되도록 오래된 것부터
+        QList<QJsonObject> rows = update.rows;
+        std::reverse(rows.begin(), rows.end());
+        model->clear();
+        model->prependLogs(rows);
+    } else {
+        // 새로 받은 행만 제자리에 (목록 전체를 다시 만들지 않음)
+        model->mergeLogs(update.rows);
+    }
+    if (!update.complete) return;
 
-    qDebug() << " 컨베이어 MQTT 전송 완료! 응답 대기 중...";
+    qDebug() << "📅 날짜 검색 완료:" << update.totalRows << "건";
+    if (update.totalRows == 0) addNoResultsMessage();
+    if (update.failedSlices > 0) {
+        QMessageBox::warning(this, "조회 실패", QString("일부 구간(%1개)을 서버에서 받지 못했습니다.\n받은 결과만 표시합니다.")
+                                                .arg(update.failedSlices));
+    }
+}
+
+void Home::deliverDateSearchUpdate(QObject *targetWindow, const LogSearchUpdate &update)
+{
+    if (!targetWindow) {
+        qDebug() << " targetWindow가 null입니다!";
+        return;
+    }
+    // 비어 있는 중간 추가분은 보낼 것이 없음 (첫 결과는 비어 있어도 이전 목록을 지워야 하므로 보냄)
+    if (!update.reset && !update.complete && update.rows.isEmpty()) return;
+
+    QMetaObject::invokeMethod(targetWindow, "onSearchResultsUpdated",
+                              Qt::QueuedConnection,
+                              Q_ARG(QList<QJsonObject>, update.rows),
+                              Q_ARG(bool, update.reset),
+                              Q_ARG(bool, update.complete));
+    if (update.complete && update.failedSlices > 0) {
+        QMessageBox::warning(this, "조회 실패", QString("일부 구간(%1개)을 서버에서 받지 못했습니다.\n받은 결과만 표시합니다.")
+                                                .arg(update.failedSlices));
+    }
 }
 
 // db에 SHD 추가
@@ -2474,175 +2320,11 @@ void Home::resizeEvent(QResizeEvent *event)
 // 로그 카드
 void Home::addErrorCardUI(const QJsonObject &errorData)
 {
-    QWidget *card = new QWidget();
-    card->setFixedHeight(84);
-    card->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-    card->setStyleSheet(R"(
-        background-color: #F3F4F6;
-        border: 1px solid #E5E7EB;
-        border-radius: 12px;
-    )");
-    card->setProperty("errorData", QVariant::fromValue(errorData));
-
-    // 카드 더블클릭 이벤트 필터 설치
-    static CardEventFilter *filter = nullptr;
-    if (!filter)
-    {
-        filter = new CardEventFilter(this);
-        connect(filter, &CardEventFilter::cardDoubleClicked, this, &Home::onCardDoubleClicked);
-    }
-    card->installEventFilter(filter);
-
-    QVBoxLayout* outer = new QVBoxLayout(card);
-    outer->setContentsMargins(12, 10, 12, 10);
-    outer->setSpacing(6);
-
-
-
-    // 상단: 오류 배지 + 시간
-    QHBoxLayout *topRow = new QHBoxLayout();
-    topRow->setSpacing(6);
-    topRow->setContentsMargins(0, 0, 0, 0);
-
-    QLabel* badge = new QLabel();
-    QPixmap errorPixmap(":/ui/icons/images/error.png");
-    if (!errorPixmap.isNull()) {
-        badge->setPixmap(errorPixmap.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        badge->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        badge->setText("⚠");
-        badge->setStyleSheet("color: #ef4444; font-size: 14px; border: none; background: transparent;");
-    }
-
-    QHBoxLayout *left = new QHBoxLayout();
-    left->addWidget(badge);
-    left->setSpacing(4);
-    left->setContentsMargins(0, 0, 0, 0);
-
-    // 에러 메시지 라벨 추가
-    QString logCode = errorData["log_code"].toString();
-    QString messageText = (logCode == "SPD") ? "SPD(모터속도 오류)" : logCode;
-    QLabel* errorLabel = new QLabel(messageText);
-    errorLabel->setStyleSheet("color: #374151; font-size: 12px; font-weight: 500; border: none;");
-    left->addWidget(errorLabel);
-    left->addStretch();
-
-    QLabel *timeLabel = new QLabel(
-        QDateTime::fromMSecsSinceEpoch(errorData["timestamp"].toVariant().toLongLong()).toString("MM-dd hh:mm"));
-    timeLabel->setStyleSheet("color: #6b7280; font-size: 10px; border: none;");
-    timeLabel->setMaximumWidth(70); // 최대 폭 제한
-    timeLabel->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Preferred);
-    timeLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-
-    topRow->addLayout(left);
-    topRow->addStretch();
-
-    // 하단: 사람 아이콘 + 디바이스명 + 시간 (하얀 상자로 감싸기)
-    QWidget* whiteContainer = new QWidget();
-    whiteContainer->setStyleSheet(R"(
-        background-color: #FFF;
-        border-radius: 12px;
-    )");
-    QHBoxLayout* whiteLayout = new QHBoxLayout(whiteContainer);
-    whiteLayout->setContentsMargins(12, 10, 12, 10);
-    whiteLayout->setSpacing(6);
-
-    // 사람 아이콘
-    QLabel* personIcon = new QLabel();
-    QPixmap personPixmap(":/ui/icons/images/person.png");
-    if (!personPixmap.isNull()) {
-        personIcon->setPixmap(personPixmap.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        personIcon->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        personIcon->setText("👤");
-        personIcon->setStyleSheet("color: #6b7280; font-size: 14px; border: none; background: transparent;");
-    }
-    whiteLayout->addWidget(personIcon);
-
-    // 디바이스명 배지
-    QLabel* device = new QLabel(errorData["device_id"].toString());
-    device->setMinimumHeight(24);
-    QString dev = errorData["device_id"].toString();
-    QString devStyle = dev.contains("feeder")
-                           ? R"(
-            background-color: #FFF4DE;
-            color: #FF9138;
-            border: none;
-            padding: 4px 8px;
-            border-radius: 12px;
-            font-size: 11px;
-            font-weight: 500;
-        )"
-                           : R"(
-            background-color: #E1F5FF;
-            color: #56A5FF;
-            border: none;
-            padding: 4px 8px;
-            border-radius: 12px;
-            font-size: 11px;
-            font-weight: 500;
-        )";
-    device->setStyleSheet(devStyle);
-
-    whiteLayout->addWidget(device);
-    whiteLayout->addStretch();
-
-    // 시간 아이콘과 텍스트
-    QLabel* clockIcon = new QLabel();
-    QPixmap clockPixmap(":/ui/icons/images/clock.png");
-    if (!clockPixmap.isNull()) {
-        clockIcon->setPixmap(clockPixmap.scaled(14, 14, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        clockIcon->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        clockIcon->setText("🕐");
-        clockIcon->setStyleSheet("color: #6b7280; font-size: 12px; border: none; background: transparent;");
-    }
-    whiteLayout->addWidget(clockIcon);
-
-    QLabel* timeText = new QLabel(
-        QDateTime::fromMSecsSinceEpoch(errorData["timestamp"].toVariant().toLongLong()).toString("MM-dd hh:mm")
-        );
-    timeText->setStyleSheet("color: #6b7280; font-size: 10px; border: none;");
-    whiteLayout->addWidget(timeText);
-
-    // 조립
-    outer->addLayout(topRow);
-    outer->addWidget(whiteContainer);
-
-    // 삽입
-    QVBoxLayout *layout = qobject_cast<QVBoxLayout *>(ui->scrollArea->widget()->layout());
-    if (layout)
-    {
-        layout->insertWidget(0, card);
-    }
-
-    // 카드 생성 후 아래 코드 추가
-    QGraphicsDropShadowEffect *shadow = new QGraphicsDropShadowEffect(card);
-    shadow->setBlurRadius(24);
-    shadow->setColor(QColor(255, 140, 0, 0));
-    shadow->setOffset(0, 0);
-    card->setGraphicsEffect(shadow);
-    QPropertyAnimation *anim = new QPropertyAnimation(shadow, "color", card);
-    anim->setDuration(200);
-    anim->setStartValue(QColor(255, 140, 0, 0));
-    anim->setEndValue(QColor(255, 140, 0, 64));
-    anim->setEasingCurve(QEasingCurve::InOutQuad);
-    card->installEventFilter(new CardHoverEffect(card, shadow, anim));
+    if (errorLogView) errorLogView->logModel()->prependLog(errorData);
 }
 
-void Home::onCardDoubleClicked(QObject *cardWidget)
+void Home::onErrorLogDoubleClicked(const QJsonObject &errorData)
 {
-    QWidget *card = qobject_cast<QWidget *>(cardWidget);
-    if (!card)
-        return;
-    QVariant v = card->property("errorData");
-    if (!v.isValid())
-        return;
-    QJsonObject errorData = v.value<QJsonObject>();
-
     // 로그 정보 추출
     qint64 timestamp = errorData["timestamp"].toVariant().toLongLong();
     QString deviceId = errorData["device_id"].toString();
@@ -2716,6 +2398,7 @@ void Home::enableRealTimeMode() {
 
     // 기존 로그 클리어하고 최신 로그 요청
     clearAllErrorLogsFromUI();
+    if (m_logPager) m_logPager->setEnabled(true);
     // requestPastLogs();  // 이 함수가 있다면 주석 해제
 }
 
@@ -2723,32 +2406,12 @@ void Home::enableRealTimeMode() {
 void Home::clearAllErrorLogsFromUI() {
     qDebug() << "=== 에러 로그 UI 클리어 시작 ===";
 
-    // scrollArea 내부의 모든 카드 위젯 제거
-    if (ui->scrollArea && ui->scrollArea->widget()) {
-        QWidget* content = ui->scrollArea->widget();
-        if (content && content->layout()) {
-            QVBoxLayout* vboxLayout = qobject_cast<QVBoxLayout*>(content->layout());
-            if (vboxLayout) {
-                // 모든 아이템을 역순으로 제거 (안전한 제거)
-                while (QLayoutItem* item = vboxLayout->takeAt(0)) {
-                    if (QWidget* widget = item->widget()) {
-                        widget->deleteLater();  // 메모리 안전 삭제
-                    }
-                    delete item;
-                }
-
-                // stretch 다시 추가 (setupRightPanel()과 동일하게)
-                vboxLayout->addStretch();
-
-                qDebug() << "scrollArea 내부 위젯들 모두 제거 완료";
-            } else {
-                qDebug() << "경고: VBoxLayout으로 캐스팅 실패";
-            }
-        } else {
-            qDebug() << "경고: scrollArea content 또는 layout이 없음";
-        }
+    if (errorLogView) {
+        errorLogView->logModel()->clear();
+        errorLogView->setNoResultsVisible(false);
+        qDebug() << "오류 로그 목록 비움 완료";
     } else {
-        qDebug() << "경고: scrollArea 또는 widget이 없음";
+        qDebug() << "경고: errorLogView가 없음";
     }
 }
 
@@ -2771,47 +2434,7 @@ void Home::setupSidebarStyles() {
 }
 
 void Home::addNoResultsMessage() {
-    if (!ui->scrollArea || !ui->scrollArea->widget()) return;
-
-    QWidget* content = ui->scrollArea->widget();
-    if (!content || !content->layout()) return;
-
-    QVBoxLayout* layout = qobject_cast<QVBoxLayout*>(content->layout());
-    if (!layout) return;
-
-    // 검색 결과 없음 카드 생성
-    QWidget* noResultCard = new QWidget();
-    noResultCard->setFixedHeight(100);
-    noResultCard->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-    noResultCard->setStyleSheet(R"(
-        background-color: #f8f9fa;
-        border: 2px dashed #dee2e6;
-        border-radius: 12px;
-    )");
-
-    QVBoxLayout* cardLayout = new QVBoxLayout(noResultCard);
-    cardLayout->setContentsMargins(20, 15, 20, 15);
-    cardLayout->setSpacing(5);
-
-    QLabel* iconLabel = new QLabel("🔍");
-    iconLabel->setAlignment(Qt::AlignCenter);
-    iconLabel->setStyleSheet("font-size: 24px; color: #6c757d; border: none;");
-
-    QLabel* messageLabel = new QLabel("검색 결과가 없습니다");
-    messageLabel->setAlignment(Qt::AlignCenter);
-    messageLabel->setFont(FontManager::getFont(FontManager::HANWHA_BOLD, 16));
-    messageLabel->setStyleSheet("color: #6c757d; border: none;");
-
-    QLabel* subMessageLabel = new QLabel("다른 검색 조건을 시도해보세요");
-    subMessageLabel->setAlignment(Qt::AlignCenter);
-    subMessageLabel->setStyleSheet("font-size: 12px; color: #868e96; border: none;");
-
-    cardLayout->addWidget(iconLabel);
-    cardLayout->addWidget(messageLabel);
-    cardLayout->addWidget(subMessageLabel);
-
-    // stretch 위에 삽입 (맨 위에)
-    layout->insertWidget(0, noResultCard);
-
-    qDebug() << " Home '검색 결과 없음' 메시지 카드 추가됨";
+    if (!errorLogView) return;
+    errorLogView->setNoResultsVisible(true);
+    qDebug() << " Home '검색 결과 없음' 메시지 표시";
 }
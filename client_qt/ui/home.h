@@ -12,6 +12,7 @@
 #include <QtMqtt/QMqttMessage>
 #include <QtMqtt/QMqttSubscription>
 #include <QTimer>
+#include <QPointer>
 #include <QDateEdit>  // 추가!
 #include <QGroupBox>
 #include <QDate>
@@ -30,6 +31,14 @@
 #include "conveyor.h"
 #include "../video/streamer.h"
 #include "../charts/errorchartmanager.h"
+#include "../mqtt/message_types.h"
+#include "../mqtt/response_pipeline.h"
+#include "../mqtt/query_engine.h"
+#include "../mqtt/error_burst_coalescer.h"
+#include "../mqtt/log_store.h"
+#include "../mqtt/log_query_planner.h"
+#include "../mqtt/log_pager.h"
+#include "../widgets/error_log_view.h"
 
 
 #include "../mcp/factory_mcp.h" //mcp용
@@ -49,15 +58,11 @@ public:
     Home(QWidget *parent = nullptr);
     ~Home();
 
-    // 자식들이 사용할 메서드들
-    QList<QJsonObject> getAllErrorLogs() const;
-    QList<QJsonObject> getErrorLogsForDevice(const QString &deviceId) const;
-
 public slots:
     void onErrorLogGenerated(const QJsonObject &errorData);     // 오류 로그 수신 슬롯
     void onErrorLogsRequested(const QString &deviceId);        // 로그 요청 수신 슬롯
     void onMqttPublishRequested(const QString &topic, const QString &message); // MQTT 발송 요청 슬롯
-    void onCardDoubleClicked(QObject* cardWidget);
+    void onErrorLogDoubleClicked(const QJsonObject &errorData);   // 카드 더블클릭 → 그 시각 영상
 
     void onDeviceStatusChanged(const QString &deviceId, const QString &status); //off
 
@@ -74,7 +79,7 @@ protected:
 
 
 signals:
-    void errorLogsResponse(const QList<QJsonObject> &logs);     // 로그 응답 시그널
+    void errorLogsResponse(const LogSnapshot &logs);            // 로그 응답 시그널 (LogStore 스냅샷)
     void newErrorLogBroadcast(const QJsonObject &errorData);
     void deviceStatsReceived(const QString &deviceId, const QJsonObject &statsData);
 
@@ -88,9 +93,15 @@ private slots:
     // MQTT 관련 슬롯들
     void onMqttConnected();
     void onMqttDisConnected();
-    void onMqttMessageReceived(const QMqttMessage &message);
+    void onMqttReconnected(qint64 offlineMs);
+    void onFactoryStatusMessage(const QByteArray &message, const QMqttTopicName &topic);
+    void onLogEvent(const LogEventPtr &event);
+    void onDeviceStatus(const DeviceStatusPtr &status);
+    void onTimeTravelRewound(qint64 timestampMs);
+    void onLocalHistoryScanned(int logCount, qint64 lastLogAt);
+    void onLocalHistoryRestored(int logCount, qint64 lastLogAt);
+    void onErrorAggregate(const ErrorAggregate &aggregate);
     void connectToMqttBroker();
-    void onQueryResponseReceived(const QMqttMessage &message);
 
     // stream
     void updateFeederImage(const QImage& image); // v피더캠 영상 표시
@@ -98,7 +109,7 @@ private slots:
     void updateHWImage(const QImage& image); //한화 카메라
 
     void onSearchClicked();
-    void processFeederSearchResponse(const QJsonObject &response, MainWindow* targetWindow);
+    void processFeederSearchResponse(const LogBatch &response, MainWindow* targetWindow);
 
     void enableRealTimeMode();
     //void clearAllErrorLogsFromUI();
@@ -110,12 +121,8 @@ private:
     Streamer* conveyorStreamer; //컨베이어
     Streamer* hwStreamer;  // 한화 카메라 스트리머
 
-    // MQTT 관련
+    // MQTT 관련 (연결은 MqttHub 소유, 여기선 빌려씀)
     QMqttClient *m_client;
-    QMqttSubscription *subscription;
-    QTimer *reconnectTimer;
-    QString mqttBroker = "mqtt.kwon.pics";
-    int mqttPort = 1883;
     QString mqttTopic = "factory/status"; //sub
     QString mqttControlTopic = "factory/control"; //pub
 
@@ -126,7 +133,7 @@ private:
     QLabel *lblConnectionStatus;
     QLabel *lblFactoryStatus;
     QTableWidget *logTable;
-    QList<QJsonObject> errorLogHistory;
+    // 오류 로그 이력은 LogStore (열 단위, 최대 logstore/max_rows 행)
 
 
     // 상태 변수들
@@ -152,9 +159,6 @@ private:
     void addErrorLogUI(const QJsonObject &errorData);
     void controlALLDevices(bool start);
     void initializeChildWindows();
-    QMqttSubscription *queryResponseSubscription;  // 쿼리 응답 구독 추가
-    QString mqttQueryRequestTopic = "factory/query/logs/request";    // 쿼리 요청 토픽
-    QString mqttQueryResponseTopic = "factory/query/logs/response";  // 쿼리 응답 토픽
 
     bool isDateSearchMode;
     QDate currentSearchStartDate;
@@ -162,12 +166,13 @@ private:
 
     //QString mqttQueryRequestTopic = "factory/query/videos/request";    // 쿼리 요청 토픽
     //QString mqttQueryResponseTopic = "factory/query/videos/response";  // 쿼리 응답 토픽
-    QString currentQueryId;
     MainWindow* currentFeederWindow = nullptr;
 
     void requestPastLogs(); //db에게 과거로그 요청 보내기
-    void processPastLogsResponse(const QJsonObject &response); //db에게 받은거 화면에 표시
-    QString generateQueryId();
+    void processPastLogsResponse(const LogBatch &response); //db에게 받은거 화면에 표시
+    // 로그 쿼리 전송 (QueryEngine) - onBatch는 워커에서 정리된 결과 또는 시간 초과(status "timeout")
+    QueryHandle sendLogQuery(const QString &tag, const QJsonObject &filters, const LogShape &shape,
+                             std::function<void(const LogBatch &)> onBatch, int timeoutMs = 15000);
 
     //mcp
     FactoryMCP* mcpHandler = nullptr;
@@ -186,13 +191,13 @@ private:
     QBarSet *conveyorBarSet;
     QMap<QString, QMap<QString, QSet<QString>>> monthlyErrorDays;
 
-    QMap<QString, QString> lastDeviceStatus;
+    QVector<QString> lastLogCodes;      // DeviceRegistry 인덱스 → 마지막으로 반영한 log_code
+    QString &lastLogCodeFor(const QString &deviceId);
+    void updateDevicePolls(int deviceIndex);
 
     // 날짜 선택 위젯들
     QDateEdit* startDateEdit;
     QDateEdit* endDateEdit;
-    void processFeederResponse(const QJsonObject &response);
-    QString feederQueryId;
     // 페이지네이션
     int pageSize = 500;
     int currentPage = 0;
@@ -206,31 +211,48 @@ private:
 
     ErrorChartManager *m_errorChartManager;
 
+    // 실시간 오류 로그는 프레임 단위로 모아서 반영, 같은 기기·코드가 이어지면 맨 위 카드에 ×N
+    ErrorBurstCoalescer *m_errorCoalescer = nullptr;
+    ErrorLogView *errorLogView = nullptr;       // 오른쪽 오류 로그 목록
+    LogPager *m_logPager = nullptr;             // 목록 맨 아래로 내리면 이전 오류 로그 (모든 기기, 필터 없는 목록일 때만)
+
     void requestFilteredLogs(const QString &errorCode, const QDate &startDate = QDate(), const QDate &endDate = QDate(), bool loadMore = false);
     void updateLoadMoreButton(bool showButton);
     bool isLoadingChartData = false;
-    QString chartQueryId;
 
     // 차트용 별도 함수
     void loadAllChartData();
     //void loadChartDataBatch(int offset);
-    void processChartDataResponse(const QJsonObject &response);
+    void processChartDataResponse(const LogBatch &response);
 
     void sendFactoryStatusLog(const QString &logCode, const QString &message);
     qint64 lastOldestTimestamp = 0;
-    qint64 lastTimestamp = 0;
-    QSet<QString> receivedLogIds;
-    QMap<QString, MainWindow*> feederQueryMap;
+    qint64 lastTimestamp = 0;                   // 실시간으로 받은 로그의 최신 timestamp (재연결 백필 기준)
+    QSet<QString> receivedLogIds;               // 화면에 올린 오류 로그 키 (기기|timestamp|코드)
+    QList<QString> receivedLogOrder;            // receivedLogIds 크기 제한용 (오래된 것부터 제거)
+    bool initialLogsRequested = false;
+    bool restoredFromLocal = false;             // 로컬 이력으로 먼저 그림 → 연결되면 빠진 구간만 받음
+
+    bool rememberLogKey(const QJsonObject &logData);    // 처음 보는 로그면 true
+    void noteLogTimestamp(qint64 timestamp);
+
+    // 재연결 백필: 끊겨 있던 동안의 오류 로그를 페이지 상한까지 받아서 시간순으로 반영
+    void requestReconnectBackfill();
+    void requestBackfillPage(qint64 sinceMs, qint64 untilMs, int page);
+    void applyBackfill();
+    QList<QJsonObject> backfillRows;
 
     void handleConveyorLogSearch(const QString& errorCode, const QDate& startDate, const QDate& endDate);
-    void processConveyorSearchResponse(const QJsonObject &response, ConveyorWindow* targetWindow);
+    void processConveyorSearchResponse(const LogBatch &response, ConveyorWindow* targetWindow);
     ConveyorWindow* currentConveyorWindow = nullptr;
 
+    // 날짜 검색 (LogQueryPlanner): 로컬에 있는 구간은 바로, 빠진 구간은 받는 대로 결과 갱신
+    void startDateSearch(LogSearchRequest request, const QDate &startDate, const QDate &endDate, QObject *targetWindow);
+    void showDateSearchUpdate(const LogSearchUpdate &update);
+    void deliverDateSearchUpdate(QObject *targetWindow, const LogSearchUpdate &update);
+
     void loadChartDataSingle();
 
-    QString conveyorQueryId;
-    QMap<QString, ConveyorWindow*> conveyorQueryMap;
-    void processConveyorResponse(const QJsonObject &response);
 
     void requestFeederStatistics();
     void requestConveyorStatistics();
@@ -241,13 +263,13 @@ private:
     //void tryNextUrl(QStringList* urls, int index);
     void downloadAndPlayVideoFromUrl(const QString &httpUrl, const QString &deviceId);
     void requestStatisticsToday(const QString& deviceId);
+    static QByteArray statisticsTodayPayload(const QString& deviceId);
 
     void handleFeederLogSearch(const QString& errorCode, const QDate& startDate, const QDate& endDate);  // ✅ 피더 검색 처리
 
 private:
     QStringList getVideoServerUrls() const;
     void addErrorCardUI(const QJsonObject &errorData);
-    QTimer *statisticsTimer;
     void addNoResultsMessage();
 
     void setupSidebarStyles();
@@ -13,26 +13,38 @@
 #include "../video/videoplayer.h"
 #include "../video/video_mqtt.h"
 #include "../video/video_client_functions.hpp"
-#include "../widgets/cardevent.h"
+#include "../mqtt/mqtt_hub.h"
+#include "../mqtt/message_ingest.h"
+#include "../mqtt/command_queue.h"
+#include "../mqtt/poll_scheduler.h"
+#include "../mqtt/time_travel.h"
+#include "../mqtt/log_store.h"
+#include "../mqtt/device_registry.h"
+#include "../mqtt/log_categories.h"
 //#include "ui_mainwindow.h"
 
 #include <QMouseEvent>
-#include "../widgets/cardhovereffect.h"
 #include "../widgets/error_message_card.h"
 #include <QKeyEvent>
 #include "../utils/font_manager.h"
 #include "../widgets/sectionboxwidget.h"
+#include <QUuid>
+#include <algorithm>
+
+namespace {
+// PollScheduler key 뒷부분 - <라인 기기>/stats-1min, 최근 1분 통계 (Home의 home/stats-today/<id>와 같은 factory/statistics 토픽을 씀)
+const QString kStatisticsPollSuffix = QStringLiteral("/stats-1min");
+const int kRecentLogLimit = 5000;       // 창을 열 때 LogStore에서 꺼내 보여줄 최근 오류 수
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , m_client(nullptr)
-    , subscription(nullptr)
     , DeviceLockActive(false) //초기는 정상!
     , startDateEdit(nullptr)
     , endDateEdit(nullptr)
     , btnDateRangeSearch(nullptr)
-    , statisticsTimer(nullptr)
     , errorCard(nullptr) // 추가
 {
 
@@ -76,8 +88,9 @@ MainWindow::MainWindow(QWidget *parent)
     connect(hwStreamer, &Streamer::newFrame, this, &MainWindow::updateHWImage);
     hwStreamer->start();
 
-    statisticsTimer = new QTimer(this);
-    connect(statisticsTimer, &QTimer::timeout, this, &MainWindow::requestStatisticsData);
+    // 통계는 차트 새로고침 때만 - PollScheduler 경유로 중복 요청은 합쳐짐
+    PollScheduler::instance()->registerPoll(lineDeviceId() + kStatisticsPollSuffix, "factory/statistics", 0,
+                                            [this]() { return statisticsPayload(); }, this);
 
     //차트
 
@@ -118,177 +131,79 @@ void MainWindow::keyPressEvent(QKeyEvent *event)
     }
 }
 
-void MainWindow::setupMqttClient(){ //mqtt 클라이언트 초기 설정 MQTT 클라이언트 설정 (주소, 포트, 시그널 연결 등)
-    m_client = new QMqttClient(this);
-    reconnectTimer = new QTimer(this);
-    m_client->setHostname(mqttBroker); //브로커 서버에 연결 공용 mqtt 서버
-    m_client->setPort(mqttPort);
-    m_client->setClientId("VisionCraft_Feeder" + QString::number(QDateTime::currentMSecsSinceEpoch()));
-    connect(m_client, &QMqttClient::connected, this, &MainWindow::onMqttConnected); // QMqttClient가 연결이 되었다면 mainwindow에 있는 저 함수중에 onMQTTCONNECTED를 실행
-    connect(m_client, &QMqttClient::disconnected, this, &MainWindow::onMqttDisConnected);
-    //connect(m_client, &QMqttClient::messageReceived, this, &MainWindow::onMqttMessageReceived);
-    connect(reconnectTimer, &QTimer::timeout, this, &MainWindow::connectToMqttBroker);
+void MainWindow::setupMqttClient(){ //mqtt 클라이언트 초기 설정 (연결은 MqttHub 공유, 구독만 등록)
+    MqttHub *hub = MqttHub::instance();
+    m_client = hub->client();
+    connect(hub, &MqttHub::connected, this, &MainWindow::onMqttConnected);
+    connect(hub, &MqttHub::disconnected, this, &MainWindow::onMqttDisConnected);
+
+    // 상태/통계/로그는 수신 계층에서 한 번만 파싱된 것을 피더 기기 것만 받음
+    MessageIngest *ingest = MessageIngest::instance();
+    ingest->subscribeDevice(lineDeviceId(), this, &MainWindow::onDeviceStatus);
+    ingest->subscribeDevice(controlDeviceId(), this, &MainWindow::onDeviceStatus);    // 제어 명령 응답
+    ingest->subscribeDevice(lineDeviceId(), this, &MainWindow::onSpeedStats);
+    ingest->subscribeDevice(lineDeviceId(), this, &MainWindow::onLogEvent);
+
+    // 타임 트래블로 다른 시점으로 가면 차트를 비우고 그 시점의 통계로 다시 채움
+    if (TimeTravel::isEnabled()) {
+        connect(TimeTravel::instance(), &TimeTravel::rewound, this, [this]() {
+            if (deviceChart) deviceChart->clearAllData();
+        });
+    }
+
     connect(ui->pushButton, &QPushButton::clicked, this, &MainWindow::onSearchClicked);
 }
 
 void MainWindow::connectToMqttBroker(){ //브로커 연결  실제 연결 시도만!
-
-    if(m_client->state() == QMqttClient::Disconnected){
-        m_client->connectToHost();
-    }
-
+    MqttHub::instance()->connectToBroker();
 }
 
 void MainWindow::onMqttConnected(){
-    qDebug() << "MQTT Connected - Feeder Control";
     qDebug() << " MQTT Connected - Feeder Control";
     qDebug() << " 클라이언트 ID:" << m_client->clientId();
-    qDebug() << " 연결 상태:" << m_client->state();
-    subscription = m_client->subscribe(mqttTopic);
-    if(subscription){
-        connect(subscription, &QMqttSubscription::messageReceived,
-                this, &MainWindow::onMqttMessageReceived);
-    }
-
-    // auto statsSubscription = m_client->subscribe(QString("factory/feeder_01/msg/statistics"));
-    // if(statsSubscription){
-    //     connect(statsSubscription, &QMqttSubscription::messageReceived,
-    //             this, &MainWindow::onMqttMessageReceived);
-    //     qDebug() << "MainWindow - feeder_01 통계 토픽 구독됨";
-    // }
-
-    // if(statisticsTimer && !statisticsTimer->isActive()) {
-    //     statisticsTimer->start(60000);  // 3초마다 요청
-    // }
-    auto statsSubscription = m_client->subscribe(QString("factory/feeder_01/msg/statistics"));
-    if(statsSubscription){
-        connect(statsSubscription, &QMqttSubscription::messageReceived,
-                this, &MainWindow::onMqttMessageReceived);
-        qDebug() << " MainWindow - feeder_01 통계 토픽 구독됨";
-
-        // 구독 상태 확인
-        connect(statsSubscription, &QMqttSubscription::stateChanged, [](QMqttSubscription::SubscriptionState state) {
-            if (state == QMqttSubscription::Subscribed) {
-                qDebug() << " feeder_01 통계 토픽 구독 성공!";
-            } else if (state == QMqttSubscription::Error) {
-                qDebug() << " feeder_01 통계 토픽 구독 실패!";
-            }
-        });
-    } else {
-        qDebug() << " statsSubscription 생성 실패!";
-    }
-
-    //if(statisticsTimer && !statisticsTimer->isActive()) {
-    //    statisticsTimer->start(60000);
-    //    qDebug() << " 통계 타이머 시작됨 (60초마다)";
-    //}
-
-
-    reconnectTimer->stop(); //연결이 성공하면 재연결 타이며 멈추기!
-
+    qDebug() << " 구독 필터:" << MqttHub::instance()->activeFilters();
 }
 
 void MainWindow::onMqttDisConnected(){
     qDebug() << "MQTT 연결이 끊어졌습니다!";
-    if(!reconnectTimer->isActive()){
-        reconnectTimer->start(3000);
-    }
+}
 
-    if(statisticsTimer && statisticsTimer->isActive()) {
-        statisticsTimer->stop();
-    }
-    subscription=NULL; //초기화
+void MainWindow::onSpeedStats(const SpeedStatsPtr &stats){
+    qCDebug(lcLive) << " 피더 통계 수신 - 현재:" << stats->currentSpeed << "평균:" << stats->average;
+    onDeviceStatsReceived(lineDeviceId(), stats->json);
 }
 
-void MainWindow::onMqttMessageReceived(const QMqttMessage &message){  //매개변수 수정
-    QString messageStr = QString::fromUtf8(message.payload());  // message.payload() 사용
-    QString topicStr = message.topic().name();  //토픽 정보도 가져올 수 있음
-    qDebug() << "받은 메시지:" << topicStr << messageStr;  // 디버그 추가
+void MainWindow::onLogEvent(const LogEventPtr &event){
+    if(event->logLevel != "info") return;
 
-    if(isFeederDateSearchMode && (topicStr.contains("/log/error") || topicStr.contains("/log/info"))) {
-        qDebug() << "[피더] 날짜 검색 모드이므로 실시간 로그 무시:" << topicStr;
+    if(isFeederDateSearchMode) {
+        qCDebug(lcLive) << "[피더] 날짜 검색 모드이므로 실시간 로그 무시:" << event->deviceId;
         return;  // 실시간 로그 무시!
     }
 
-    if(topicStr == "factory/feeder_01/msg/statistics") {
-        qDebug() << " [SUCCESS] 피더 통계 메시지 감지됨!";
-        qDebug() << " 메시지 내용:" << messageStr;
-
-        QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson(messageStr.toUtf8(), &parseError);
-
-        if(parseError.error != QJsonParseError::NoError) {
-            qDebug() << " JSON 파싱 오류:" << parseError.errorString();
-            return;
-        }
-
-        QJsonObject data = doc.object();
-        qDebug() << " 파싱된 데이터:" << data;
-
-        onDeviceStatsReceived("feeder_01", data);
-        qDebug() << " onDeviceStatsReceived 호출 완료";
-        return;
-    }
-
-    if(topicStr.contains("factory/feeder_01/log/info")){
-        QStringList parts = topicStr.split('/');
-        QString deviceId = parts[1];
-
-        if(deviceId == "feeder_01"){
-            showFeederNormal(); // 에러 상태 초기화
-            logMessage("피더 정상 동작");
-        }
-        return;
-    }
-
-    if(topicStr == "factory/feeder_01/msg/statistics") {
-        qDebug() << "[DEBUG] 피더 통계 메시지 감지됨!";
-        qDebug() << "  - 메시지 내용:" << messageStr;
-
-        QJsonDocument doc = QJsonDocument::fromJson(messageStr.toUtf8());
-        QJsonObject data = doc.object();
-        onDeviceStatsReceived("feeder_01", data); //02로 되어있었음
-        return;
-    }
-
-    // if (topicStr.contains("factory/feeder_01/log/error") ||
-    //     topicStr.contains("factory/feeder_01/log/info")) {
-
-    //     QJsonDocument doc = QJsonDocument::fromJson(message.payload());
-    //     QJsonObject logData = doc.object();
-
-    //     QString logCode = logData["log_code"].toString();
-    //     QString logMsg = logData["message"].toString();  // ✅ 변수명 변경!
-
-    //     if (logCode == "SPD") {
-    //         logMessage("SPD 오류: " + logMsg);  // ✅ logMsg 사용
-    //         showFeederError("SPD 오류");
-    //         addErrorCardUI(logData);
-    //     } else if (logCode == "INF") {
-    //         logMessage("정보: " + logMsg);      // ✅ logMsg 사용
-    //         showFeederNormal();
+    showFeederNormal(); // 에러 상태 초기화
+    logMessage("피더 정상 동작");
+}
 
-    //     }
-    //     return;
-    // }
+void MainWindow::onDeviceStatus(const DeviceStatusPtr &status){
+    const QString &messageStr = status->status;
 
-    if(topicStr == "feeder_02/status"){
+    if(status->deviceId == controlDeviceId()){
+        // 제어 명령 응답
         if(messageStr == "on"){
             logMessage("피더가 시작되었습니다.");
-            //logError("피더가 시작되었습니다.");
             showFeederNormal();
-            //showFeederError("피더가 시작되었습니다.");
             updateErrorStatus();
-            emit deviceStatusChanged("feeder_02", "on");
+            emit deviceStatusChanged(controlDeviceId(), "on");
         } else if(messageStr == "off"){
             logMessage("피더가 정지되었습니다.");
             showFeederNormal();
-            emit deviceStatusChanged("feeder_02", "off");
+            emit deviceStatusChanged(controlDeviceId(), "off");
         }
         // 나머지 명령은 무시
-    } else if(topicStr == "feeder_01/status"){
+    } else if(status->deviceId == lineDeviceId()){
         if(messageStr != "on" && messageStr != "off"){
-            // reverse, speed 등 기타 명령 처리 (필요시 기존 코드 복사)
+            // reverse, speed 등 기타 명령 처리
             if(messageStr == "reverse"){
                 logError("피더가 반대로 돌았습니다.");
                 showFeederError("피더가 반대로 돌았습니다.");
@@ -298,7 +213,6 @@ void MainWindow::onMqttMessageReceived(const QMqttMessage &message){  //매개
             }
         }
     }
-
 }
 
 
@@ -308,8 +222,18 @@ void MainWindow::onMqttError(QMqttClient::ClientError error){
 }
 
 void MainWindow::publishControlMessage(const QString &command){
-    // Home에서 MQTT 처리 - 시그널로 전달
-    emit requestMqttPublish(mqttControllTopic, command);
+    // 명령 큐로 전달 - 연결이 끊겨 있으면 보관했다가 전송, 제어 기기 status로 동작 확인
+    CommandQueue::instance()->submit(mqttControllTopic, command, "feeder", this, [this](const CommandResult &result) {
+        if (result.ok()) {
+            logMessage(QString("제어 확인: %1 (응답 %2ms)").arg(result.command).arg(result.rttMs));
+        } else if (result.outcome == CommandResult::TimedOut) {
+            logMessage("제어 응답 없음: " + result.command + " (마지막 상태: " + result.lastStatus + ")");
+        } else if (result.outcome == CommandResult::Superseded) {
+            logMessage("정지 명령으로 취소: " + result.command);
+        } else {
+            logMessage("연결되지 않아 제어 명령 취소: " + result.command);
+        }
+    });
     logMessage("제어 명령 요청: " + command);
 }
 
@@ -465,7 +389,7 @@ void MainWindow::onFeederOnClicked(){
     // 공통 제어 - JSON 형태로
     QJsonObject logData;
     logData["log_code"] = "SHD";
-    logData["message"] = "feeder_01";
+    logData["message"] = lineDeviceId();
     logData["timestamp"] = QDateTime::currentMSecsSinceEpoch();
 
     QJsonDocument doc(logData);
@@ -496,7 +420,7 @@ void MainWindow::onFeederOffClicked(){
     // 공통 제어 - JSON 형태로
     QJsonObject logData;
     logData["log_code"] = "SHD";
-    logData["message"] = "feeder_01";
+    logData["message"] = lineDeviceId();
     logData["timestamp"] = QDateTime::currentMSecsSinceEpoch();
 
     QJsonDocument doc(logData);
@@ -1094,6 +1018,15 @@ void MainWindow::setupRightPanel() {
     disconnect(ui->lineEdit, &QLineEdit::returnPressed, this, &MainWindow::onSearchClicked);
     connect(ui->lineEdit, &QLineEdit::returnPressed, this, &MainWindow::onSearchClicked);
 
+    // 입력하는 대로 로컬 색인 검색 - 같은 프레임에 들어온 입력은 한 번으로
+    if (!localFilterTimer) {
+        localFilterTimer = new QTimer(this);
+        localFilterTimer->setSingleShot(true);
+        localFilterTimer->setInterval(0);
+        connect(localFilterTimer, &QTimer::timeout, this, &MainWindow::applyLocalFilter);
+        connect(ui->lineEdit, &QLineEdit::textEdited, localFilterTimer, qOverload<>(&QTimer::start));
+    }
+
     QWidget* searchContainer = new QWidget();
     QHBoxLayout* searchLayout = new QHBoxLayout(searchContainer);
     searchLayout->setContentsMargins(0, 0, 0, 0);
@@ -1269,15 +1202,21 @@ void MainWindow::setupRightPanel() {
     });
 
     // 4. 스크롤 영역 설정
-    if (!errorCardLayout) {
+    if (!errorLogView) {
         if (ui->scrollArea) {
-            QWidget* errorCardContent = new QWidget();
-            errorCardLayout = new QVBoxLayout(errorCardContent);
-            errorCardLayout->setSpacing(6);
-            errorCardLayout->setContentsMargins(4, 2, 4, 4);
-            errorCardLayout->addStretch();
-            ui->scrollArea->setWidget(errorCardContent);
+            errorLogView = new ErrorLogView();
+            ui->scrollArea->setWidget(errorLogView);
             ui->scrollArea->setWidgetResizable(true);
+            ui->scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+            connect(errorLogView, &ErrorLogView::errorLogDoubleClicked, this, &MainWindow::onErrorLogDoubleClicked);
+
+            logPager = new LogPager(lineDeviceId(), this);
+            connect(errorLogView, &ErrorLogView::nearEnd, this, [this]() {
+                logPager->fetchOlder(errorLogView->logModel()->oldestRows());
+            });
+            connect(logPager, &LogPager::pageReady, this, [this](const QList<QJsonObject> &rows) {
+                errorLogView->logModel()->mergeLogs(rows);     // offset 페이지면 목록 중간에 들어갈 행도 있음
+            });
         }
     }
 
@@ -1296,19 +1235,20 @@ void MainWindow::addErrorLog(const QJsonObject &errorData){
 void MainWindow::loadPastLogs(){
     // 부모에게 시그널로 과거 로그 요청
     qDebug() << "MainWindow - 과거 로그 요청";
-    emit requestErrorLogs("feeder_01");
+    emit requestErrorLogs(lineDeviceId());
 }
 
 // 부모로부터 로그 응답 받는 슬롯
-void MainWindow::onErrorLogsReceived(const QList<QJsonObject> &logs){
-    if(!errorCardLayout) return;
-    for(int i = logs.size() - 1; i >= 0; --i) {
-        const QJsonObject &log = logs[i];
-        if(log["device_id"].toString() == "feeder_01") {
-            if (log["log_level"].toString() != "error") continue;
-            addErrorCardUI(log);
-        }
-    }
+void MainWindow::onErrorLogsReceived(const LogSnapshot &logs){
+    if(!errorLogView) return;
+    // 이 기기 색인으로 최신 것만 꺼냄 (스냅샷 전체를 훑거나 복사하지 않음)
+    QList<QJsonObject> recent = logs.newestForDevice(lineDeviceId(), kRecentLogLimit);
+    std::reverse(recent.begin(), recent.end());     // 오래된 것부터 넣어야 최신이 맨 위
+    errorLogView->logModel()->clear();
+    errorLogView->setNoResultsVisible(false);
+    errorLogView->logModel()->prependLogs(recent);
+    if(logPager) logPager->setEnabled(true);
+    if (!localFilter.text.isEmpty()) applyLocalFilter();     // 입력해 둔 검색어가 있으면 다시 거름
 
     if(textErrorStatus) {
         QString initialText = "현재 속도: 0\n";
@@ -1488,15 +1428,20 @@ void MainWindow::onSearchClicked() {
 
 
 void MainWindow::onSearchResultsReceived(const QList<QJsonObject> &results) {
-    qDebug() << "🔧 MainWindow 검색 결과 수신:" << results.size() << "개";
-
-    // 기존 카드들 클리어
-    if (errorCardLayout) {
-        while (errorCardLayout->count() > 1) {
-            QLayoutItem* item = errorCardLayout->takeAt(0);
-            if (QWidget* w = item->widget()) w->deleteLater();
-            delete item;
+    onSearchResultsUpdated(results, true, true);
+}
+
+void MainWindow::onSearchResultsUpdated(const QList<QJsonObject> &results, bool reset, bool complete) {
+    qDebug() << "🔧 MainWindow 검색 결과 수신:" << results.size() << "개" << (reset ? "(새 검색)" : "(추가)");
+
+    // 새 검색이면 기존 카드들 클리어 - 검색 결과는 이어 붙일 이전 페이지가 없음
+    if (reset) {
+        if (errorLogView) {
+            errorLogView->logModel()->clear();
+            errorLogView->setNoResultsVisible(false);
         }
+        if (logPager) logPager->setEnabled(false);
+        localFilter = LogQuery();       // 목록은 서버 검색 결과 (아래에서 같은 검색어로 거름)
     }
 
     // 현재 검색어 확인
@@ -1520,8 +1465,12 @@ void MainWindow::onSearchResultsReceived(const QList<QJsonObject> &results) {
         qDebug() << "  - 종료일:" << currentEndDate.toString("yyyy-MM-dd");
         qDebug() << "  - 필터 활성:" << hasDateFilter;
     }
+    // 날짜 경계는 한 번만 계산 (행마다 QDateTime을 만들지 않음)
+    const qint64 startMs = hasDateFilter ? currentStartDate.startOfDay().toMSecsSinceEpoch() : 0;
+    const qint64 endMs = hasDateFilter ? currentEndDate.addDays(1).startOfDay().toMSecsSinceEpoch() - 1 : 0;
 
     int errorCount = 0;
+    QList<QJsonObject> shown;       // 오래된 것부터
 
     // HOME 방식으로 변경: 역순 for loop (최신순)
     for(int i = results.size() - 1; i >= 0; --i) {
@@ -1537,14 +1486,8 @@ void MainWindow::onSearchResultsReceived(const QList<QJsonObject> &results) {
         // 날짜 필터링 적용
         if(hasDateFilter) {
             qint64 timestamp = log["timestamp"].toVariant().toLongLong();
-            if(timestamp > 0) {
-                QDateTime logDateTime = QDateTime::fromMSecsSinceEpoch(timestamp);
-                QDate logDate = logDateTime.date();
-
-                if(logDate < currentStartDate || logDate > currentEndDate) {
-                    shouldInclude = false;
-                    qDebug() << "MainWindow 피더 날짜 필터로 제외:" << logDate.toString("yyyy-MM-dd");
-                }
+            if(timestamp > 0 && (timestamp < startMs || timestamp > endMs)) {
+                shouldInclude = false;
             }
         }
 
@@ -1559,13 +1502,22 @@ void MainWindow::onSearchResultsReceived(const QList<QJsonObject> &results) {
         }
 
         if(shouldInclude) {
-            addErrorCardUI(log);
+            if(log["device_id"].toString() == lineDeviceId()) shown.append(log);
             errorCount++;
         }
     }
 
-    if(errorCount == 0) {
-        addNoResultsMessage();
+    if (errorLogView) {
+        ErrorLogModel *model = errorLogView->logModel();
+        if (reset) {
+            model->prependLogs(shown);      // 마지막(최신)이 맨 위로
+        } else {
+            // 날짜 검색 중간 결과 - 새로 받은 행만 제자리에 (목록 전체를 다시 만들지 않음)
+            std::reverse(shown.begin(), shown.end());
+            model->mergeLogs(shown);
+        }
+        if (!shown.isEmpty()) errorLogView->setNoResultsVisible(false);
+        if (complete && model->rowCount() == 0) addNoResultsMessage();
     }
 
     updateErrorStatus();
@@ -1578,7 +1530,7 @@ void MainWindow::updateErrorStatus(){
 }
 
 void MainWindow::onDeviceStatsReceived(const QString &deviceId, const QJsonObject &statsData) {
-    if(deviceId != "feeder_01") {
+    if(deviceId != lineDeviceId()) {
         return;
     }
 
@@ -1590,12 +1542,12 @@ void MainWindow::onDeviceStatsReceived(const QString &deviceId, const QJsonObjec
     int currentSpeed = statsData.value("current_speed").toInt();
     int average = statsData.value("average").toInt();
 
-    qDebug() << "피더 통계 데이터 수신 - 현재:" << currentSpeed << "평균:" << average;
+    qCDebug(lcLive) << "피더 통계 데이터 수신 - 현재:" << currentSpeed << "평균:" << average;
 
     // 0 데이터든 아니든 무조건 차트에 추가 (ConveyorWindow와 동일)
     if (deviceChart) {
         deviceChart->addSpeedData(currentSpeed, average);
-        qDebug() << "피더 차트 데이터 추가 완료";
+        qCDebug(lcLive) << "피더 차트 데이터 추가 완료";
     } else {
         qDebug() << "차트가 아직 초기화되지 않음";
     }
@@ -1737,171 +1689,57 @@ void MainWindow::downloadAndPlayVideoFromUrl(const QString& httpUrl, const QStri
     });
 }
 
-void MainWindow::addErrorCardUI(const QJsonObject &errorData) {
-    if (errorData["device_id"].toString() != "feeder_01") return;
-    QWidget* card = new QWidget();
-    card->setFixedHeight(84);
-    card->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-    card->setStyleSheet(R"(
-        background-color: #F3F4F6;
-        border: 1px solid #E5E7EB;
-        border-radius: 12px;
-    )");
-    card->setProperty("errorData", QVariant::fromValue(errorData));
-
-    // 카드 생성 시 이벤트 필터 및 시그널 연결, 디버깅 로그 추가
-    static CardEventFilter* filter = nullptr;
-    if (!filter) {
-        filter = new CardEventFilter(this);
-        connect(filter, &CardEventFilter::cardDoubleClicked, this, &MainWindow::onCardDoubleClicked);
-    }
-    qDebug() << "[MainWindow] 카드에 이벤트 필터 설치";
-    card->installEventFilter(filter);
-
-    QVBoxLayout* outer = new QVBoxLayout(card);
-    outer->setContentsMargins(12, 10, 12, 10);
-    outer->setSpacing(6);
-
-    // 상단: 오류 배지 + 시간
-    QHBoxLayout* topRow = new QHBoxLayout();
-    topRow->setSpacing(6);
-    topRow->setContentsMargins(0, 0, 0, 0);
-
-    QLabel* badge = new QLabel();
-    QPixmap errorPixmap(":/ui/icons/images/error.png");
-    if (!errorPixmap.isNull()) {
-        badge->setPixmap(errorPixmap.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        badge->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        badge->setText("⚠");
-        badge->setStyleSheet("color: #ef4444; font-size: 14px; border: none; background: transparent;");
+QString MainWindow::lineDeviceId() const {
+    // 처음 물을 때 한 번 정함 - 구독/폴링 key와 목록 거르기가 같은 기기를 보도록
+    if (m_lineDeviceId.isEmpty()) {
+        m_lineDeviceId = DeviceRegistry::instance()->firstOf("feeder", DeviceRegistry::Sensor);
     }
+    return m_lineDeviceId;
+}
 
-    QHBoxLayout* left = new QHBoxLayout();
-    left->addWidget(badge);
-    left->setSpacing(4);
-    left->setContentsMargins(0, 0, 0, 0);
-
-    // 에러 메시지 라벨 추가
-    QString logCode = errorData["log_code"].toString();
-    QString messageText = (logCode == "SPD") ? "SPD(모터속도 오류)" : logCode;
-    QLabel* errorLabel = new QLabel(messageText);
-    errorLabel->setStyleSheet("color: #374151; font-size: 12px; font-weight: 500; border: none;");
-    left->addWidget(errorLabel);
-    left->addStretch();
-
-    QLabel* timeLabel = new QLabel(
-        QDateTime::fromMSecsSinceEpoch(errorData["timestamp"].toVariant().toLongLong()).toString("MM-dd hh:mm")
-        );
-    timeLabel->setStyleSheet("color: #6b7280; font-size: 10px; border: none;");
-    timeLabel->setMaximumWidth(70);
-    timeLabel->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Preferred);
-    timeLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-
-    topRow->addLayout(left);
-    topRow->addStretch();
-
-    // 하단: 사람 아이콘 + 디바이스명 + 시간 (하얀 상자로 감싸기)
-    QWidget* whiteContainer = new QWidget();
-    whiteContainer->setStyleSheet(R"(
-        background-color: #FFF;
-        border-radius: 12px;
-    )");
-    QHBoxLayout* whiteLayout = new QHBoxLayout(whiteContainer);
-    whiteLayout->setContentsMargins(12, 10, 12, 10);
-    whiteLayout->setSpacing(6);
-
-    // 사람 아이콘
-    QLabel* personIcon = new QLabel();
-    QPixmap personPixmap(":/ui/icons/images/person.png");
-    if (!personPixmap.isNull()) {
-        personIcon->setPixmap(personPixmap.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        personIcon->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        personIcon->setText("👤");
-        personIcon->setStyleSheet("color: #6b7280; font-size: 14px; border: none; background: transparent;");
-    }
-    whiteLayout->addWidget(personIcon);
-
-    // 디바이스명 배지
-    QLabel* device = new QLabel(errorData["device_id"].toString());
-    device->setMinimumHeight(24);
-    QString dev = errorData["device_id"].toString();
-    QString devStyle = dev.contains("feeder")
-                           ? R"(
-            background-color: #FFF4DE;
-            color: #FF9138;
-            border: none;
-            padding: 4px 8px;
-            border-radius: 12px;
-            font-size: 11px;
-            font-weight: 500;
-        )"
-                           : R"(
-            background-color: #E1F5FF;
-            color: #56A5FF;
-            border: none;
-            padding: 4px 8px;
-            border-radius: 12px;
-            font-size: 11px;
-            font-weight: 500;
-        )";
-    device->setStyleSheet(devStyle);
-
-    whiteLayout->addWidget(device);
-    whiteLayout->addStretch();
-
-    // 시간 아이콘과 텍스트
-    QLabel* clockIcon = new QLabel();
-    QPixmap clockPixmap(":/ui/icons/images/clock.png");
-    if (!clockPixmap.isNull()) {
-        clockIcon->setPixmap(clockPixmap.scaled(14, 14, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        clockIcon->setStyleSheet("border: none; background: transparent;");
-    } else {
-        // 아이콘이 로드되지 않으면 텍스트로 대체
-        clockIcon->setText("🕐");
-        clockIcon->setStyleSheet("color: #6b7280; font-size: 12px; border: none; background: transparent;");
-    }
-    whiteLayout->addWidget(clockIcon);
+QString MainWindow::controlDeviceId() const {
+    return CommandQueue::deviceIdForTopic(mqttControllTopic);
+}
 
-    QLabel* timeText = new QLabel(
-        QDateTime::fromMSecsSinceEpoch(errorData["timestamp"].toVariant().toLongLong()).toString("MM-dd hh:mm")
-        );
-    timeText->setStyleSheet("color: #6b7280; font-size: 10px; border: none;");
-    whiteLayout->addWidget(timeText);
+void MainWindow::applyLocalFilter() {
+    if (!errorLogView || !ui->lineEdit) return;
 
-    // 조립
-    outer->addLayout(topRow);
-    outer->addWidget(whiteContainer);
+    LogQuery query;
+    query.text = ui->lineEdit->text().trimmed();
+    query.deviceIds = QStringList{lineDeviceId()};
 
-    // 삽입
-    if (errorCardLayout) {
-        errorCardLayout->insertWidget(0, card);
+    // 검색 결과 화면과 같은 날짜 조건 (오늘~오늘이면 날짜 제한 없음)
+    bool hasDateFilter = false;
+    if (startDateEdit && endDateEdit) {
+        const QDate startDate = startDateEdit->date();
+        const QDate endDate = endDateEdit->date();
+        const QDate today = QDate::currentDate();
+        hasDateFilter = startDate.isValid() && endDate.isValid() && (startDate != today || endDate != today);
+        if (hasDateFilter) {
+            query.startMs = startDate.startOfDay().toMSecsSinceEpoch();
+            query.endMs = endDate.addDays(1).startOfDay().toMSecsSinceEpoch() - 1;
+        }
     }
 
-    // 카드 생성 후 아래 코드 추가
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect(card);
-    shadow->setBlurRadius(24);
-    shadow->setColor(QColor(255, 140, 0, 0));
-    shadow->setOffset(0, 0);
-    card->setGraphicsEffect(shadow);
-    QPropertyAnimation* anim = new QPropertyAnimation(shadow, "color", card);
-    anim->setDuration(200);
-    anim->setStartValue(QColor(255, 140, 0, 0));
-    anim->setEndValue(QColor(255, 140, 0, 64));
-    anim->setEasingCurve(QEasingCurve::InOutQuad);
-    card->installEventFilter(new CardHoverEffect(card, shadow, anim));
+    QList<QJsonObject> rows = LogStore::instance()->search(query, kRecentLogLimit);
+    std::reverse(rows.begin(), rows.end());     // 오래된 것부터 넣어야 최신이 맨 위
+    errorLogView->logModel()->clear();
+    errorLogView->setNoResultsVisible(false);
+    errorLogView->logModel()->prependLogs(rows);
+    if (rows.isEmpty() && !query.text.isEmpty()) addNoResultsMessage();
+
+    localFilter = query.text.isEmpty() ? LogQuery() : query;
+    if (logPager) logPager->setEnabled(query.text.isEmpty() && !hasDateFilter);
+}
+
+void MainWindow::addErrorCardUI(const QJsonObject &errorData) {
+    if (errorData["device_id"].toString() != lineDeviceId()) return;
+    if (!localFilter.text.isEmpty() && !localFilter.matches(errorData)) return;    // 입력 중인 검색어에 안 맞음
+    if (errorLogView) errorLogView->logModel()->prependLog(errorData);
 }
 
-void MainWindow::onCardDoubleClicked(QObject* cardWidget) {
-    qDebug() << "[MainWindow] onCardDoubleClicked 호출됨";
-    QWidget* card = qobject_cast<QWidget*>(cardWidget);
-    if (!card) return;
-    QVariant v = card->property("errorData");
-    if (!v.isValid()) return;
-    QJsonObject errorData = v.value<QJsonObject>();
+void MainWindow::onErrorLogDoubleClicked(const QJsonObject &errorData) {
+    qDebug() << "[MainWindow] onErrorLogDoubleClicked 호출됨";
 
     // 로그 정보 추출
     qint64 timestamp = errorData["timestamp"].toVariant().toLongLong();
@@ -1925,14 +1763,9 @@ void MainWindow::onCardDoubleClicked(QObject* cardWidget) {
 
     // --- 여기서 MQTT 명령 전송 ---
     if (m_client && m_client->state() != QMqttClient::Connected) {
-        qDebug() << "[MainWindow] MQTT disconnected, retry";
-        m_client->connectToHost();
-        // 연결 완료 시 publish하도록 콜백 등록 필요
-        connect(m_client, &QMqttClient::connected, this, [this]() {
-            qDebug() << "[MainWindow] MQTT reconnected success, publish 시도";
-            m_client->publish(QMqttTopicName("factory/hanwha/cctv/zoom"), QByteArray("100"));
-            m_client->publish(QMqttTopicName("factory/hanwha/cctv/cmd"), QByteArray("autoFocus"));
-        });
+        // 재연결은 MqttHub가 처리 - 여기서 connected에 람다를 매번 붙이면 누적됨
+        qDebug() << "[MainWindow] MQTT disconnected, 줌 명령 생략";
+        MqttHub::instance()->connectToBroker();
     } else if (m_client && m_client->state() == QMqttClient::Connected) {
         m_client->publish(QMqttTopicName("factory/hanwha/cctv/zoom"), QByteArray("100"));
         m_client->publish(QMqttTopicName("factory/hanwha/cctv/cmd"), QByteArray("autoFocus"));
@@ -1967,70 +1800,31 @@ void MainWindow::setupErrorCardUI() {
 }
 
 
-void MainWindow::requestStatisticsData() {
-    if(m_client && m_client->state() == QMqttClient::Connected) {
-        qDebug() << " 피더 통계 요청 시작";
-
-        QJsonObject request;
-        request["device_id"] = "feeder_01";
+QByteArray MainWindow::statisticsPayload() const {
+    QJsonObject request;
+    request["device_id"] = lineDeviceId();
 
-        QDateTime now = QDateTime::currentDateTime();
-        QDateTime oneMinuteAgo = now.addSecs(-60);
-        QJsonObject timeRange;
-        timeRange["start"] = oneMinuteAgo.toMSecsSinceEpoch();
-        timeRange["end"] = now.toMSecsSinceEpoch();
-        request["time_range"] = timeRange;
+    QDateTime now = QDateTime::currentDateTime();
+    QDateTime oneMinuteAgo = now.addSecs(-60);
+    QJsonObject timeRange;
+    timeRange["start"] = oneMinuteAgo.toMSecsSinceEpoch();
+    timeRange["end"] = now.toMSecsSinceEpoch();
+    request["time_range"] = timeRange;
+    // 같은 토픽의 오늘 통계 요청(StatsRollup)과 응답을 구분하도록 key를 붙인 request_id
+    request["request_id"] = QString("%1/%2").arg(lineDeviceId() + kStatisticsPollSuffix, QUuid::createUuid().toString(QUuid::WithoutBraces));
 
-        QJsonDocument doc(request);
-        QByteArray payload = doc.toJson(QJsonDocument::Compact);
+    return QJsonDocument(request).toJson(QJsonDocument::Compact);
+}
 
-        qDebug() << " 요청 JSON:" << doc.toJson(QJsonDocument::Indented);
+void MainWindow::requestStatisticsData() {
+    qDebug() << " 피더 통계 요청 시작";
 
-        bool result = m_client->publish(QString("factory/statistics"), payload);
-        qDebug() << " MQTT 전송 결과:" << (result ? "성공" : "실패");
-        qDebug() << " MainWindow - 피더 통계 요청 전송 (1분마다)";
-    } else {
-        qDebug() << " MQTT 연결 안됨! 현재 상태:" << m_client->state();
-    }
+    bool result = PollScheduler::instance()->requestNow(lineDeviceId() + kStatisticsPollSuffix);
+    qDebug() << " MQTT 전송 결과:" << (result ? "성공" : "실패 (연결 안됨)");
 }
 
 void MainWindow::addNoResultsMessage() {
-    if (!errorCardLayout) return;
-
-    QWidget* noResultCard = new QWidget();
-    noResultCard->setFixedHeight(100);
-    noResultCard->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-    noResultCard->setStyleSheet(R"(
-        background-color: #f8f9fa;
-        border: 2px dashed #dee2e6;
-        border-radius: 12px;
-    )");
-
-    QVBoxLayout* layout = new QVBoxLayout(noResultCard);
-    layout->setContentsMargins(20, 15, 20, 15);
-    layout->setSpacing(5);
-
-    // 아이콘
-    QLabel* iconLabel = new QLabel("🔍");
-    iconLabel->setAlignment(Qt::AlignCenter);
-    iconLabel->setStyleSheet("font-size: 24px; color: #6c757d; border: none;");
-
-    // 메시지
-    QLabel* messageLabel = new QLabel("검색 결과가 없습니다");
-    messageLabel->setAlignment(Qt::AlignCenter);
-    messageLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: #6c757d; border: none;");
-
-    // 서브 메시지
-    QLabel* subMessageLabel = new QLabel("다른 검색 조건을 시도해보세요");
-    subMessageLabel->setAlignment(Qt::AlignCenter);
-    subMessageLabel->setStyleSheet("font-size: 12px; color: #868e96; border: none;");
-
-    layout->addWidget(iconLabel);
-    layout->addWidget(messageLabel);
-    layout->addWidget(subMessageLabel);
-
-    // 카드를 레이아웃에 추가 (stretch 위에)
-    errorCardLayout->insertWidget(0, noResultCard);
-
-    qDebug() << "📝 '검색 결과 없음' 메시지 카드 추가됨";
+    if (!errorLogView) return;
+    errorLogView->setNoResultsVisible(true);
+    qDebug() << "📝 '검색 결과 없음' 메시지 표시";
 }
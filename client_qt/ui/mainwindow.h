@@ -31,9 +31,13 @@
 #include <QKeyEvent>
 #include "../video/streamer.h"
 #include "../charts/device_chart.h"
+#include "../mqtt/message_types.h"
+#include "../mqtt/log_store.h"
 #include <qlistwidget.h>
 #include <QScrollArea>
 #include "../widgets/error_message_card.h"
+#include "../widgets/error_log_view.h"
+#include "../mqtt/log_pager.h"
 
 class Home;
 
@@ -50,13 +54,15 @@ public:
     ~MainWindow();
 
 public slots:
-    void onErrorLogsReceived(const QList<QJsonObject> &logs);  // 로그 응답 슬롯
+    void onErrorLogsReceived(const LogSnapshot &logs);  // 로그 응답 슬롯 (Home의 LogStore 스냅샷)
     void onErrorLogBroadcast(const QJsonObject &errorData);
     void onDeviceStatsReceived(const QString &deviceId, const QJsonObject &statsData);
     void onSearchResultsReceived(const QList<QJsonObject> &results);
+    // 날짜 검색(LogQueryPlanner) 결과 - reset이면 목록을 바꾸고, 아니면 새로 받은 행만 끼워 넣음
+    void onSearchResultsUpdated(const QList<QJsonObject> &results, bool reset, bool complete);
     //void onDateRangeSearchClicked();
     void addErrorCardUI(const QJsonObject &errorData);
-    void onCardDoubleClicked(QObject* cardWidget);
+    void onErrorLogDoubleClicked(const QJsonObject &errorData);
     void requestStatisticsData();
 signals:
     void errorLogGenerated(const QJsonObject &errorData);     // 오류 로그 발생 시그널
@@ -71,7 +77,9 @@ signals:
 private slots: //행동하는 것
     void onMqttConnected(); //연결 되었는지
     void onMqttDisConnected(); //연결 안되었을 때
-    void onMqttMessageReceived(const QMqttMessage &message); //메시지 내용, 토픽 on, myled/status
+    void onDeviceStatus(const DeviceStatusPtr &status);   // 라인 기기 상태, 제어 기기 상태 (명령 응답)
+    void onSpeedStats(const SpeedStatsPtr &stats);        // 통계
+    void onLogEvent(const LogEventPtr &event);            // 정상 로그
     void onMqttError(QMqttClient::ClientError error); //에러 났을 때
     void connectToMqttBroker(); //브로커 연결
     //void requestStatisticsData();
@@ -103,13 +111,9 @@ private:
     Streamer* rpiStreamer;
     Streamer* hwStreamer;  // 한화 카메라 스트리머
 
-    QMqttClient *m_client;
-    QMqttSubscription *subscription;
-    QTimer *reconnectTimer;
+    QMqttClient *m_client;   // MqttHub 공유 연결
     //Home* parentHome;
 
-    QString mqttBroker = "mqtt.kwon.pics";
-    int mqttPort = 1883;
     QString mqttTopic = "feeder_01/status";
     QString mqttControllTopic = "feeder_02/cmd";
 
@@ -193,14 +197,21 @@ private:
     //QPushButton *feederSearchButton = nullptr;
 
     QPushButton *btnDateSearch;
-    QTimer *statisticsTimer;
+    QByteArray statisticsPayload() const;
 
-    QScrollArea* errorScrollArea = nullptr;
-    QWidget* errorCardContent = nullptr;
-    QVBoxLayout* errorCardLayout = nullptr;
+    ErrorLogView* errorLogView = nullptr;     // 오류 로그 목록 (보이는 카드만 그림)
+    LogPager* logPager = nullptr;            // 맨 아래로 내리면 이전 라인 기기 오류 로그 (최근 목록일 때만)
     ErrorMessageCard* errorCard;
     void setupErrorCardUI();
 
+    // 입력하는 대로 LogStore 색인으로 목록 거르기 (서버 검색은 엔터/검색 버튼)
+    QTimer* localFilterTimer = nullptr;
+    LogQuery localFilter;                   // 거르는 중인 조건 (검색어가 없으면 비어있음) - 실시간 로그도 이걸로 거름
+    void applyLocalFilter();
+    QString lineDeviceId() const;           // 이 창이 보여주는 라인 기기 (DeviceRegistry의 피더 라인 기기)
+    QString controlDeviceId() const;        // 제어 명령을 받는 기기 (mqttControllTopic의 기기)
+    mutable QString m_lineDeviceId;
+
     //device_chart
     void setupChartInUI();
     DeviceChart *deviceChart;
@@ -4,37 +4,42 @@
 #include <QDebug>
 #include <QtMqtt/QMqttTopicFilter>
 #include <QtMqtt/QMqttTopicName>
+#include "../mqtt/mqtt_hub.h"
+#include "../mqtt/query_engine.h"
+#include "../mqtt/wire_codec.h"
 
 MqttClient::MqttClient(QObject *parent)
     : QObject(parent)
-    , m_client(new QMqttClient(this))
-    , m_timeoutTimer(new QTimer(this))
+    , m_client(MqttHub::instance()->client())
 {
-    m_client->setHostname("mqtt.kwon.pics");
-    m_client->setPort(1883);
-
-    connect(m_client, &QMqttClient::connected, this, &MqttClient::onConnected);
-    connect(m_client, &QMqttClient::messageReceived, this, &MqttClient::onMessageReceived);
-
-    m_timeoutTimer->setSingleShot(true);
-    m_timeoutTimer->setInterval(10000); // 10초 타임아웃
+    // 영상 조회마다 새 연결을 만들지 않고 공유 연결 + QueryEngine 사용
+    MqttHub *hub = MqttHub::instance();
+    connect(hub, &MqttHub::connected, this, &MqttClient::onConnected);
+
+    // 여러 MqttClient가 만들어져도 엔드포인트 등록은 한 번만 적용됨
+    QueryEngine::instance()->registerEndpoint(
+        "videos", "factory/query/videos/request", "factory/query/videos/response",
+        [](const QByteArray &payload) {
+            const VideoQueryResult result = parseVideoResponse(payload);
+            QueryReply reply;
+            reply.queryId = result.query_id;
+            reply.status = result.status;
+            reply.error = result.error;
+            reply.body = QVariant::fromValue(result);
+            return reply;
+        }, nullptr, 1);
 }
 
 MqttClient::~MqttClient() {
-    if (m_client->state() == QMqttClient::Connected) {
-        m_client->disconnectFromHost();
-    }
+    // 공유 연결이므로 끊지 않음 (진행 중인 조회 콜백은 QueryEngine이 버림)
 }
 
 void MqttClient::connectToHost() {
-    if (m_client->state() != QMqttClient::Connected) {
-        m_client->connectToHost();
-    }
+    MqttHub::instance()->connectToBroker();
 }
 
 void MqttClient::onConnected() {
-    qDebug() << "MQTT Connected";
-    m_client->subscribe(QMqttTopicFilter("factory/query/videos/response"), 1);
+    qDebug() << "MQTT Connected (video)";
 }
 
 void MqttClient::queryVideos(const QString& device_id,
@@ -44,20 +49,11 @@ void MqttClient::queryVideos(const QString& device_id,
                              int limit,
                              VideoQueryCallback callback) {
 
+    // 연결 전이면 QueryEngine 대기열에 들어갔다가 연결되면 전송됨
     if (m_client->state() != QMqttClient::Connected) {
         connectToHost();
-        QTimer::singleShot(2000, [=]() {
-            queryVideos(device_id, error_log_id, start_time, end_time, limit, callback);
-        });
-        return;
     }
 
-    QString query_id = QString("video_query_%1").arg(QDateTime::currentMSecsSinceEpoch());
-
-    QJsonObject query;
-    query["query_id"] = query_id;
-    query["query_type"] = "videos";
-
     QJsonObject filters;
     if (!device_id.isEmpty()) filters["device_id"] = device_id;
     if (!error_log_id.isEmpty()) filters["error_log_id"] = error_log_id;
@@ -68,44 +64,55 @@ void MqttClient::queryVideos(const QString& device_id,
         filters["time_range"] = time_range;
     }
     filters["limit"] = limit;
-    query["filters"] = filters;
 
-    if (callback) {
-        m_pendingQueries[query_id] = callback;
-    }
-
-    QJsonDocument doc(query);
-    m_client->publish(QMqttTopicName("factory/query/videos/request"), doc.toJson(), 1);
-
-    qDebug() << "Published query:" << query_id;
+    QueryEngine::Request request;
+    request.queryType = "videos";
+    request.filters = filters;
+    request.timeoutMs = 10000; // 10초 타임아웃
+    request.qos = 1;
+
+    QueryHandle handle = QueryEngine::instance()->send(request, this, [callback](const QueryResult &result) {
+        if (!callback) return;
+
+        if (result.outcome == QueryResult::TimedOut) {
+            qWarning() << "Video query timed out:" << result.queryId;
+            callback(QList<VideoInfo>());
+            return;
+        }
+
+        const VideoQueryResult videos = result.value<VideoQueryResult>();
+        if (!result.ok()) {
+            qWarning() << "Query failed:" << result.error;
+            callback(QList<VideoInfo>());
+            return;
+        }
+
+        qDebug() << "Received" << videos.videos.size() << "videos for query" << result.queryId
+                 << "(" << result.latencyMs << "ms)";
+        callback(videos.videos);
+    });
+
+    qDebug() << "Published query:" << handle.id();
 }
 
-void MqttClient::onMessageReceived(const QByteArray &message, const QMqttTopicName &topic) {
-    if (topic.name() != "factory/query/videos/response") return;
+VideoQueryResult MqttClient::parseVideoResponse(const QByteArray &message) {
+    VideoQueryResult result;
 
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(message, &error);
-    if (error.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error:" << error.errorString();
-        return;
+    // JSON / CBOR / 압축 어느 쪽으로 와도 (QueryEngine이 accept_encoding으로 협상)
+    QJsonObject response;
+    if (!WireCodec::toJsonObject(message, response)) {
+        result.error = "응답 형식 해석 실패";
+        return result;
     }
 
-    QJsonObject response = doc.object();
-    QString query_id = response["query_id"].toString();
-    QString status = response["status"].toString();
-
-    if (!m_pendingQueries.contains(query_id)) return;
-
-    VideoQueryCallback callback = m_pendingQueries.take(query_id);
+    result.valid = true;
+    result.query_id = response["query_id"].toString();
+    result.status = response["status"].toString();
+    result.error = response["error"].toString();
+    if (result.status != "success") return result;
 
-    if (status != "success") {
-        qWarning() << "Query failed:" << response["error"].toString();
-        callback(QList<VideoInfo>());
-        return;
-    }
-
-    QList<VideoInfo> videos;
     QJsonArray data = response["data"].toArray();
+    result.videos.reserve(data.size());
 
     for (const auto& item : data) {
         QJsonObject obj = item.toObject();
@@ -119,9 +126,7 @@ void MqttClient::onMessageReceived(const QByteArray &message, const QMqttTopicNa
         video.file_size = obj["file_size"].toVariant().toLongLong();
         video.video_created_time = obj["video_created_time"].toVariant().toLongLong();
         video.video_quality = obj["video_quality"].toString();
-        videos.append(video);
+        result.videos.append(video);
     }
-
-    qDebug() << "Received" << videos.size() << "videos for query" << query_id;
-    callback(videos);
+    return result;
 }
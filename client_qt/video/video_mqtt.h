@@ -20,6 +20,17 @@ struct VideoInfo {
     QString video_quality;
 };
 
+// 워커에서 파싱한 영상 조회 응답
+struct VideoQueryResult {
+    bool valid = false;
+    QString query_id;
+    QString status;
+    QString error;
+    QList<VideoInfo> videos;
+};
+
+Q_DECLARE_METATYPE(VideoQueryResult)
+
 using VideoQueryCallback = std::function<void(const QList<VideoInfo>&)>;
 
 class MqttClient : public QObject {
@@ -37,12 +48,12 @@ public:
                      int limit = 50,
                      VideoQueryCallback callback = nullptr);
 
+    // 응답 파싱 (QueryEngine 워커에서 호출)
+    static VideoQueryResult parseVideoResponse(const QByteArray &message);
+
 private slots:
     void onConnected();
-    void onMessageReceived(const QByteArray &message, const QMqttTopicName &topic);
 
 private:
     QMqttClient* m_client;
-    QMap<QString, VideoQueryCallback> m_pendingQueries;
-    QTimer* m_timeoutTimer;
 };
@@ -0,0 +1,129 @@
+#include "error_log_delegate.h"
+#include "error_log_model.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QDateTime>
+
+namespace {
+QPixmap loadIcon(const QString &path, int size)
+{
+    QPixmap pixmap(path);
+    if (pixmap.isNull()) return pixmap;
+    return pixmap.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+QFont pixelFont(const QFont &base, int pixelSize, QFont::Weight weight = QFont::Normal)
+{
+    QFont font(base);
+    font.setPixelSize(pixelSize);
+    font.setWeight(weight);
+    return font;
+}
+
+// 아이콘이 없으면 예전 카드처럼 글자로 대체
+void drawIcon(QPainter *painter, const QRect &rect, const QPixmap &icon, const QString &fallback, const QColor &color)
+{
+    if (!icon.isNull()) {
+        painter->drawPixmap(rect.x() + (rect.width() - icon.width()) / 2,
+                            rect.y() + (rect.height() - icon.height()) / 2, icon);
+        return;
+    }
+    painter->setPen(color);
+    painter->drawText(rect, Qt::AlignCenter, fallback);
+}
+}
+
+ErrorLogDelegate::ErrorLogDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+    , errorIcon(loadIcon(":/ui/icons/images/error.png", 16))
+    , personIcon(loadIcon(":/ui/icons/images/person.png", 16))
+    , clockIcon(loadIcon(":/ui/icons/images/clock.png", 14))
+{
+}
+
+QSize ErrorLogDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &) const
+{
+    return QSize(option.rect.width(), CardHeight + CardSpacing);
+}
+
+void ErrorLogDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const QString deviceId = index.data(ErrorLogModel::DeviceIdRole).toString();
+    const QString logCode = index.data(ErrorLogModel::LogCodeRole).toString();
+    const qint64 timestamp = index.data(ErrorLogModel::TimestampRole).toLongLong();
+    const int repeatCount = index.data(ErrorLogModel::RepeatCountRole).toInt();
+
+    QString messageText = (logCode == "SPD") ? "SPD(모터속도 오류)" : logCode;
+    if (repeatCount > 1) messageText += QString("  ×%1").arg(repeatCount);
+    const QString timeText = QDateTime::fromMSecsSinceEpoch(timestamp).toString("MM-dd hh:mm");
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setClipRect(option.rect);
+
+    const QRectF card = QRectF(option.rect).adjusted(4.5, CardSpacing / 2 + 0.5, -4.5, -CardSpacing / 2 - 0.5);
+
+    // 마우스를 올리면 주황 그림자 (예전 CardHoverEffect 최종 색)
+    if (option.state & QStyle::State_MouseOver) {
+        painter->setBrush(Qt::NoBrush);
+        for (int i = 3; i >= 1; --i) {
+            painter->setPen(QPen(QColor(255, 140, 0, 64 / i), 1.0));
+            painter->drawRoundedRect(card.adjusted(-i, -i, i, i), 12 + i, 12 + i);
+        }
+    }
+
+    // 카드 바탕
+    painter->setPen(QPen(QColor("#E5E7EB"), 1.0));
+    painter->setBrush(QColor("#F3F4F6"));
+    painter->drawRoundedRect(card, 12, 12);
+
+    const QRect inner = card.toRect().adjusted(12, 10, -12, -10);
+
+    // 상단: 오류 아이콘 + 코드
+    const QRect topRow(inner.left(), inner.top(), inner.width(), 16);
+    drawIcon(painter, QRect(topRow.left(), topRow.top(), 16, 16), errorIcon, "⚠", QColor("#ef4444"));
+
+    const QFont codeFont = pixelFont(option.font, 12, QFont::Medium);
+    painter->setFont(codeFont);
+    painter->setPen(QColor("#374151"));
+    const QRect codeRect = topRow.adjusted(20, 0, 0, 0);
+    painter->drawText(codeRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      QFontMetrics(codeFont).elidedText(messageText, Qt::ElideRight, codeRect.width()));
+
+    // 하단 하얀 상자: 사람 아이콘 + 기기 배지 ... 시계 아이콘 + 시간
+    const QRect white(inner.left(), topRow.bottom() + 1 + 6, inner.width(), inner.bottom() - topRow.bottom() - 6);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(Qt::white);
+    painter->drawRoundedRect(white, 12, 12);
+
+    const QRect whiteInner = white.adjusted(12, 0, -12, 0);
+    const int centerY = whiteInner.center().y();
+    drawIcon(painter, QRect(whiteInner.left(), centerY - 8, 16, 16), personIcon, "👤", QColor("#6b7280"));
+
+    const QFont badgeFont = pixelFont(option.font, 11, QFont::Medium);
+    const QFontMetrics badgeMetrics(badgeFont);
+    const bool feeder = deviceId.contains("feeder");
+    const int badgeHeight = qMin(24, whiteInner.height());
+    QRect badge(whiteInner.left() + 16 + 6, centerY - badgeHeight / 2,
+                badgeMetrics.horizontalAdvance(deviceId) + 16, badgeHeight);
+
+    const QFont timeFont = pixelFont(option.font, 10);
+    const int timeWidth = QFontMetrics(timeFont).horizontalAdvance(timeText);
+    const QRect timeRect(whiteInner.right() - timeWidth + 1, whiteInner.top(), timeWidth, whiteInner.height());
+    const QRect clockRect(timeRect.left() - 6 - 14, centerY - 7, 14, 14);
+    badge.setRight(qMin(badge.right(), clockRect.left() - 6));
+
+    painter->setBrush(QColor(feeder ? "#FFF4DE" : "#E1F5FF"));
+    painter->drawRoundedRect(badge, badgeHeight / 2.0, badgeHeight / 2.0);
+    painter->setFont(badgeFont);
+    painter->setPen(QColor(feeder ? "#FF9138" : "#56A5FF"));
+    painter->drawText(badge, Qt::AlignCenter,
+                      badgeMetrics.elidedText(deviceId, Qt::ElideRight, qMax(0, badge.width() - 16)));
+
+    drawIcon(painter, clockRect, clockIcon, "🕐", QColor("#6b7280"));
+    painter->setFont(timeFont);
+    painter->setPen(QColor("#6b7280"));
+    painter->drawText(timeRect, Qt::AlignRight | Qt::AlignVCenter, timeText);
+
+    painter->restore();
+}
@@ -0,0 +1,28 @@
+#ifndef ERROR_LOG_DELEGATE_H
+#define ERROR_LOG_DELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPixmap>
+
+// 오류 로그 카드 그리기 (예전 카드 위젯과 같은 모양)
+// 보이는 행만 그리고, 아이콘은 한 번만 읽어서 줄여둠
+class ErrorLogDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    static const int CardHeight = 84;
+    static const int CardSpacing = 6;
+
+    explicit ErrorLogDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    QPixmap errorIcon;
+    QPixmap personIcon;
+    QPixmap clockIcon;
+};
+
+#endif // ERROR_LOG_DELEGATE_H
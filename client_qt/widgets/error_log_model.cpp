@@ -0,0 +1,225 @@
+#include "error_log_model.h"
+#include "../mqtt/log_categories.h"
+#include <QDebug>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+ErrorLogModel::ErrorLogModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int ErrorLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant ErrorLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= static_cast<int>(m_rows.size())) return QVariant();
+    const Row &row = m_rows[index.row()];
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case LogCodeRole:
+        return row.logCode;
+    case DeviceIdRole:
+        return row.deviceId;
+    case TimestampRole:
+        return row.timestamp;
+    case RepeatCountRole:
+        return row.repeatCount;
+    case ErrorDataRole:
+        return errorData(index.row());
+    default:
+        return QVariant();
+    }
+}
+
+QString ErrorLogModel::intern(const QString &value)
+{
+    auto it = m_strings.constFind(value);
+    if (it != m_strings.constEnd()) return it.value();
+    // 종류가 너무 많으면(메시지 같은 값이 잘못 들어온 경우) 공유 포기
+    if (m_strings.size() >= 1024) return value;
+    m_strings.insert(value, value);
+    return value;
+}
+
+ErrorLogModel::Row ErrorLogModel::makeRow(const QJsonObject &errorData)
+{
+    Row row;
+    row.deviceId = intern(errorData.value("device_id").toString());
+    row.logCode = intern(errorData.value("log_code").toString());
+    row.logLevel = intern(errorData.value("log_level").toString());
+    row.message = errorData.value("message").toString();
+    row.id = errorData.value("_id").toString();
+    row.timestamp = errorData.value("timestamp").toVariant().toLongLong();
+    row.repeatCount = qMax(1, errorData.value("repeat_count").toInt(1));
+    row.firstTimestamp = errorData.contains("first_timestamp")
+                             ? errorData.value("first_timestamp").toVariant().toLongLong()
+                             : row.timestamp;
+    return row;
+}
+
+QJsonObject ErrorLogModel::errorData(int row) const
+{
+    if (row < 0 || row >= static_cast<int>(m_rows.size())) return QJsonObject();
+    const Row &r = m_rows[row];
+
+    QJsonObject object;
+    object["device_id"] = r.deviceId;
+    object["log_code"] = r.logCode;
+    if (!r.logLevel.isEmpty()) object["log_level"] = r.logLevel;
+    if (!r.message.isEmpty()) object["message"] = r.message;
+    if (!r.id.isEmpty()) object["_id"] = r.id;
+    object["timestamp"] = r.timestamp;
+    if (r.repeatCount > 1) {
+        object["repeat_count"] = r.repeatCount;
+        object["first_timestamp"] = r.firstTimestamp;
+    }
+    return object;
+}
+
+void ErrorLogModel::prependLog(const QJsonObject &errorData)
+{
+    beginInsertRows(QModelIndex(), 0, 0);
+    m_rows.push_front(makeRow(errorData));
+    endInsertRows();
+    trim();
+}
+
+void ErrorLogModel::prependLogs(const QList<QJsonObject> &logs)
+{
+    if (logs.isEmpty()) return;
+
+    // 상한을 넘는 앞쪽(맨 아래로 갈) 로그는 아예 넣지 않음
+    const int count = qMin<int>(logs.size(), m_maxRows);
+    const int skip = logs.size() - count;
+
+    beginInsertRows(QModelIndex(), 0, count - 1);
+    for (int i = skip; i < logs.size(); ++i) {
+        m_rows.push_front(makeRow(logs[i]));
+    }
+    endInsertRows();
+    trim();
+
+    qCDebug(lcLive) << "[ErrorLogModel]" << count << "건 일괄 추가, 전체" << m_rows.size() << "건";
+}
+
+int ErrorLogModel::appendLogs(const QList<QJsonObject> &logs)
+{
+    const int first = static_cast<int>(m_rows.size());
+    const int count = qMin<int>(logs.size(), m_maxRows - first);
+    if (count <= 0) return 0;
+
+    // 맨 아래에 붙이므로 보이는 행은 그대로 (스크롤이 튀지 않음)
+    beginInsertRows(QModelIndex(), first, first + count - 1);
+    for (int i = 0; i < count; ++i) {
+        m_rows.push_back(makeRow(logs[i]));
+    }
+    endInsertRows();
+
+    qCDebug(lcQuery) << "[ErrorLogModel] 이전 로그" << count << "건 아래에 추가, 전체" << m_rows.size() << "건";
+    return count;
+}
+
+int ErrorLogModel::mergeLogs(const QList<QJsonObject> &logs)
+{
+    if (logs.isEmpty()) return 0;
+    // 전부 맨 아래보다 오래됐으면 (이전 페이지 대부분) 그대로 이어 붙임
+    if (m_rows.empty() || logs.first().value("timestamp").toVariant().toLongLong() <= m_rows.back().timestamp) {
+        return appendLogs(logs);
+    }
+
+    int inserted = 0;
+    int next = 0;
+    while (next < logs.size()) {
+        // 같은 시각의 기존 행보다는 아래로
+        const qint64 timestamp = logs[next].value("timestamp").toVariant().toLongLong();
+        const auto at = std::upper_bound(m_rows.begin(), m_rows.end(), timestamp,
+                                         [](qint64 value, const Row &row) { return value > row.timestamp; });
+        const int first = static_cast<int>(at - m_rows.begin());
+        if (first >= m_maxRows) break;     // 상한 밖 - 뒤따르는 것은 더 오래됨
+
+        // 같은 자리에 들어갈 연속 구간을 한 번에
+        const qint64 below = at == m_rows.end() ? std::numeric_limits<qint64>::min() : at->timestamp;
+        std::vector<Row> run;
+        while (next < logs.size()) {
+            Row row = makeRow(logs[next]);
+            if (!run.empty() && row.timestamp <= below) break;
+            run.push_back(std::move(row));
+            next++;
+        }
+
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(run.size()) - 1);
+        m_rows.insert(at, std::make_move_iterator(run.begin()), std::make_move_iterator(run.end()));
+        endInsertRows();
+        inserted += static_cast<int>(run.size());
+    }
+    trim();
+    return inserted;
+}
+
+QList<QJsonObject> ErrorLogModel::oldestRows() const
+{
+    QList<QJsonObject> rows;
+    if (m_rows.empty()) return rows;
+
+    const qint64 oldest = m_rows.back().timestamp;
+    for (int row = static_cast<int>(m_rows.size()) - 1; row >= 0 && m_rows[row].timestamp == oldest; --row) {
+        rows.append(errorData(row));
+    }
+    return rows;
+}
+
+bool ErrorLogModel::mergeIntoTop(const QJsonObject &errorData, qint64 windowMs)
+{
+    if (m_rows.empty()) return false;
+    Row &top = m_rows.front();
+
+    const qint64 timestamp = errorData.value("timestamp").toVariant().toLongLong();
+    if (top.deviceId != errorData.value("device_id").toString()
+        || top.logCode != errorData.value("log_code").toString()
+        || qAbs(timestamp - top.timestamp) > windowMs) {
+        return false;
+    }
+
+    top.repeatCount += qMax(1, errorData.value("repeat_count").toInt(1));
+    top.timestamp = timestamp;
+    const QString message = errorData.value("message").toString();
+    if (!message.isEmpty()) top.message = message;
+    const QString id = errorData.value("_id").toString();
+    if (!id.isEmpty()) top.id = id;
+
+    const QModelIndex topIndex = index(0);
+    emit dataChanged(topIndex, topIndex, {TimestampRole, RepeatCountRole, ErrorDataRole});
+    return true;
+}
+
+void ErrorLogModel::clear()
+{
+    if (m_rows.empty()) return;
+    beginResetModel();
+    m_rows.clear();
+    endResetModel();
+}
+
+void ErrorLogModel::setMaxRows(int rows)
+{
+    m_maxRows = qMax(1, rows);
+    trim();
+}
+
+void ErrorLogModel::trim()
+{
+    const int size = static_cast<int>(m_rows.size());
+    if (size <= m_maxRows) return;
+
+    // 오래된 것(맨 아래)부터 제거
+    beginRemoveRows(QModelIndex(), m_maxRows, size - 1);
+    m_rows.erase(m_rows.begin() + m_maxRows, m_rows.end());
+    endRemoveRows();
+}
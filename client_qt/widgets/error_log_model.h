@@ -0,0 +1,68 @@
+#ifndef ERROR_LOG_MODEL_H
+#define ERROR_LOG_MODEL_H
+
+#include <QAbstractListModel>
+#include <QJsonObject>
+#include <QHash>
+#include <deque>
+
+// 오류 로그 목록 모델 (맨 위 = 최신)
+// 카드 위젯을 로그마다 만들지 않고 필요한 필드만 행으로 들고 있음 - 그리는 건 ErrorLogDelegate
+class ErrorLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        ErrorDataRole = Qt::UserRole + 1,   // 원래 로그 JSON (더블클릭 → 영상 조회)
+        DeviceIdRole,
+        LogCodeRole,
+        TimestampRole,
+        RepeatCountRole
+    };
+
+    explicit ErrorLogModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // 한 건을 맨 위에
+    void prependLog(const QJsonObject &errorData);
+    // 여러 건을 한 번에 (목록의 마지막이 맨 위로 - prependLog를 차례로 부른 것과 같은 순서)
+    void prependLogs(const QList<QJsonObject> &logs);
+    // 더 오래된 로그를 맨 아래에 (최신순으로 받은 그대로, 스크롤 위치는 그대로) - 상한을 넘는 만큼은 버리고 넣은 수
+    int appendLogs(const QList<QJsonObject> &logs);
+    // 최신순으로 받은 로그를 timestamp 순서에 맞는 자리에 끼워 넣음 (날짜 검색 중간 결과) - 넣은 수
+    int mergeLogs(const QList<QJsonObject> &logs);
+    // 맨 위 행과 기기·코드가 같고 windowMs 안이면 건수를 더하고 true
+    bool mergeIntoTop(const QJsonObject &errorData, qint64 windowMs);
+    void clear();
+
+    QJsonObject errorData(int row) const;
+    // 맨 아래(가장 오래된) timestamp의 행들 - 다음 페이지 기준점
+    QList<QJsonObject> oldestRows() const;
+    void setMaxRows(int rows);
+    int maxRows() const { return m_maxRows; }
+
+private:
+    struct Row {
+        QString deviceId;
+        QString logCode;
+        QString logLevel;
+        QString message;
+        QString id;
+        qint64 timestamp = 0;
+        qint64 firstTimestamp = 0;
+        int repeatCount = 1;
+    };
+
+    Row makeRow(const QJsonObject &errorData);
+    QString intern(const QString &value);
+    void trim();
+
+    std::deque<Row> m_rows;
+    QHash<QString, QString> m_strings;      // 기기/코드/레벨 문자열은 몇 종류뿐이라 공유
+    int m_maxRows = 100000;
+};
+
+#endif // ERROR_LOG_MODEL_H
@@ -0,0 +1,95 @@
+#include "error_log_view.h"
+#include "error_log_delegate.h"
+#include "../mqtt/log_categories.h"
+#include <QPainter>
+#include <QScrollBar>
+#include <QDebug>
+
+namespace {
+const int kPrefetchCards = 20;
+}
+
+ErrorLogView::ErrorLogView(QWidget *parent)
+    : QListView(parent)
+    , m_model(new ErrorLogModel(this))
+{
+    setObjectName("errorLogView");
+    setModel(m_model);
+    setItemDelegate(new ErrorLogDelegate(this));
+
+    // 카드 높이가 모두 같음 → 스크롤할 때 행마다 크기를 묻지 않음
+    setUniformItemSizes(true);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    verticalScrollBar()->setSingleStep(24);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setFocusPolicy(Qt::NoFocus);
+    setFrameShape(QFrame::NoFrame);
+    setMouseTracking(true);
+    viewport()->setAttribute(Qt::WA_Hover);
+    setViewportMargins(0, 2, 0, 4);
+    setStyleSheet("QListView#errorLogView { background: transparent; border: none; }");
+
+    connect(this, &QListView::doubleClicked, this, [this](const QModelIndex &index) {
+        const QJsonObject errorData = m_model->errorData(index.row());
+        qCDebug(lcQuery) << "[ErrorLogView] 더블클릭:" << errorData["device_id"].toString() << errorData["log_code"].toString();
+        emit errorLogDoubleClicked(errorData);
+    });
+    // 로그가 들어오면 "검색 결과 없음"은 자연히 사라짐
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, [this]() { m_noResults = false; });
+
+    // 페이지가 붙어도 아직 끝 근처면 (짧은 페이지) 다시 알림
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &ErrorLogView::checkNearEnd);
+    connect(verticalScrollBar(), &QScrollBar::rangeChanged, this, &ErrorLogView::checkNearEnd);
+}
+
+void ErrorLogView::checkNearEnd()
+{
+    if (m_model->rowCount() == 0) return;
+
+    const QScrollBar *bar = verticalScrollBar();
+    const int threshold = kPrefetchCards * (ErrorLogDelegate::CardHeight + ErrorLogDelegate::CardSpacing);
+    if (bar->value() < bar->maximum() - threshold) return;
+    emit nearEnd();
+}
+
+void ErrorLogView::setNoResultsVisible(bool visible)
+{
+    m_noResults = visible;
+    viewport()->update();
+}
+
+void ErrorLogView::paintEvent(QPaintEvent *event)
+{
+    QListView::paintEvent(event);
+    if (!m_noResults || m_model->rowCount() > 0) return;
+
+    // 예전 "검색 결과 없음" 카드와 같은 모양 (점선 테두리)
+    QPainter painter(viewport());
+    painter.setRenderHint(QPainter::Antialiasing);
+    const QRectF card = QRectF(viewport()->rect().adjusted(4, 0, -4, 0)).adjusted(1, 1, -1, 0);
+    const QRectF box(card.left(), card.top(), card.width(), 100);
+
+    QPen dashed(QColor("#dee2e6"), 2, Qt::DashLine);
+    painter.setPen(dashed);
+    painter.setBrush(QColor("#f8f9fa"));
+    painter.drawRoundedRect(box, 12, 12);
+
+    QFont font = this->font();
+    font.setPixelSize(24);
+    painter.setFont(font);
+    painter.setPen(QColor("#6c757d"));
+    painter.drawText(QRectF(box.left(), box.top() + 12, box.width(), 30), Qt::AlignCenter, "🔍");
+
+    font.setPixelSize(16);
+    font.setBold(true);
+    painter.setFont(font);
+    painter.drawText(QRectF(box.left(), box.top() + 44, box.width(), 22), Qt::AlignCenter, "검색 결과가 없습니다");
+
+    font.setPixelSize(12);
+    font.setBold(false);
+    painter.setFont(font);
+    painter.setPen(QColor("#868e96"));
+    painter.drawText(QRectF(box.left(), box.top() + 68, box.width(), 18), Qt::AlignCenter, "다른 검색 조건을 시도해보세요");
+}
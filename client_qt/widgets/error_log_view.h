@@ -0,0 +1,38 @@
+#ifndef ERROR_LOG_VIEW_H
+#define ERROR_LOG_VIEW_H
+
+#include <QListView>
+#include <QJsonObject>
+#include "error_log_model.h"
+
+// 오류 로그 목록 (Home/피더/컨베이어 오른쪽 패널)
+// 로그가 수만 건이어도 화면에 보이는 카드만 그림, 더블클릭하면 그 로그의 JSON을 알려줌
+// 끝 가까이 스크롤하면 nearEnd() → 창이 이전 로그 페이지를 appendLogs로 아래에 붙임 (무한 스크롤)
+class ErrorLogView : public QListView
+{
+    Q_OBJECT
+
+public:
+    explicit ErrorLogView(QWidget *parent = nullptr);
+
+    ErrorLogModel *logModel() const { return m_model; }
+
+    // 로그가 하나도 없을 때 "검색 결과 없음" 카드 표시
+    void setNoResultsVisible(bool visible);
+
+signals:
+    void errorLogDoubleClicked(const QJsonObject &errorData);
+    // 맨 아래에서 카드 20장 이내 (스크롤/행 추가 때마다, 같은 기준점 요청은 LogPager가 합침)
+    void nearEnd();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void checkNearEnd();
+
+    ErrorLogModel *m_model;
+    bool m_noResults = false;
+};
+
+#endif // ERROR_LOG_VIEW_H
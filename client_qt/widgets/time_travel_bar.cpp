@@ -0,0 +1,95 @@
+#include "time_travel_bar.h"
+#include "../mqtt/time_travel.h"
+#include "../utils/font_manager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QDateTime>
+
+namespace {
+QString formatTime(qint64 ms)
+{
+    return QDateTime::fromMSecsSinceEpoch(ms).toString("yyyy-MM-dd HH:mm:ss");
+}
+}
+
+TimeTravelBar::TimeTravelBar(QWidget *parent) : QWidget(parent, Qt::Tool)
+{
+    setObjectName("timeTravelBar");
+    setWindowTitle("타임 트래블 (기록 재생)");
+    setMinimumWidth(640);
+
+    labelTime = new QLabel("저널 색인 중...");
+    labelTime->setFont(FontManager::getFont(FontManager::HANWHA_BOLD, 12));
+    labelRange = new QLabel("-");
+
+    slider = new QSlider(Qt::Horizontal);
+    slider->setEnabled(false);
+
+    btnPlay = new QPushButton("▶ 재생");
+    btnPlay->setEnabled(false);
+
+    comboSpeed = new QComboBox();
+    comboSpeed->addItem("1x", 1.0);
+    comboSpeed->addItem("10x", 10.0);
+    comboSpeed->addItem("60x", 60.0);
+    comboSpeed->addItem("600x", 600.0);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(16, 12, 16, 12);
+    mainLayout->setSpacing(8);
+    mainLayout->addWidget(labelTime);
+    mainLayout->addWidget(slider);
+
+    QHBoxLayout *controlLayout = new QHBoxLayout();
+    controlLayout->addWidget(labelRange);
+    controlLayout->addStretch();
+    controlLayout->addWidget(comboSpeed);
+    controlLayout->addWidget(btnPlay);
+    mainLayout->addLayout(controlLayout);
+
+    TimeTravel *timeTravel = TimeTravel::instance();
+    connect(timeTravel, &TimeTravel::ready, this, &TimeTravelBar::onReady);
+    connect(timeTravel, &TimeTravel::positionChanged, this, &TimeTravelBar::onPositionChanged);
+    connect(slider, &QSlider::sliderMoved, this, &TimeTravelBar::onSliderMoved);
+    connect(slider, &QSlider::actionTriggered, this, [this](int) {
+        // 클릭/키보드로 움직인 경우 (sliderMoved는 끌 때만)
+        if (!slider->isSliderDown()) onSliderMoved(slider->sliderPosition());
+    });
+    connect(btnPlay, &QPushButton::clicked, this, &TimeTravelBar::onPlayClicked);
+    connect(comboSpeed, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        if (TimeTravel::instance()->isPlaying()) TimeTravel::instance()->play(comboSpeed->currentData().toDouble());
+    });
+}
+
+void TimeTravelBar::onReady(qint64 first, qint64 last)
+{
+    firstMs = first;
+    slider->setRange(0, static_cast<int>((last - first) / 1000));
+    slider->setEnabled(true);
+    btnPlay->setEnabled(true);
+    labelRange->setText(formatTime(first) + " ~ " + formatTime(last));
+}
+
+void TimeTravelBar::onPositionChanged(qint64 timestampMs)
+{
+    labelTime->setText(formatTime(timestampMs));
+    if (!slider->isSliderDown()) {
+        const QSignalBlocker blocker(slider);
+        slider->setValue(static_cast<int>((timestampMs - firstMs) / 1000));
+    }
+    btnPlay->setText(TimeTravel::instance()->isPlaying() ? "❚❚ 정지" : "▶ 재생");
+}
+
+void TimeTravelBar::onSliderMoved(int value)
+{
+    const qint64 target = firstMs + value * 1000LL;
+    labelTime->setText(formatTime(target));
+    TimeTravel::instance()->seek(target);
+}
+
+void TimeTravelBar::onPlayClicked()
+{
+    TimeTravel *timeTravel = TimeTravel::instance();
+    timeTravel->play(timeTravel->isPlaying() ? 0.0 : comboSpeed->currentData().toDouble());
+    btnPlay->setText(timeTravel->isPlaying() ? "❚❚ 정지" : "▶ 재생");
+}
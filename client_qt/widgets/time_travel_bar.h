@@ -0,0 +1,34 @@
+#ifndef TIME_TRAVEL_BAR_H
+#define TIME_TRAVEL_BAR_H
+
+#include <QWidget>
+#include <QSlider>
+#include <QLabel>
+#include <QPushButton>
+#include <QComboBox>
+
+// 타임 트래블 조작 창 (슬라이더로 지난 시점 이동, 재생/정지, 배속)
+// 슬라이더 한 칸 = 1초, 끌면 TimeTravel::seek 가 마지막 위치만 처리
+class TimeTravelBar : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TimeTravelBar(QWidget *parent = nullptr);
+
+private slots:
+    void onReady(qint64 firstMs, qint64 lastMs);
+    void onPositionChanged(qint64 timestampMs);
+    void onSliderMoved(int value);
+    void onPlayClicked();
+
+private:
+    QSlider *slider;
+    QLabel *labelTime;
+    QLabel *labelRange;
+    QPushButton *btnPlay;
+    QComboBox *comboSpeed;
+    qint64 firstMs = 0;
+};
+
+#endif // TIME_TRAVEL_BAR_H